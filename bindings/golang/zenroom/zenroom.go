@@ -1,10 +1,13 @@
 package zenroom
 
 import (
+	"bufio"
+	"fmt"
 	"io"
 	"log"
 	"os/exec"
 	"strings"
+	"sync"
 	b64 "encoding/base64"
 )
 
@@ -37,28 +40,7 @@ func ZencodeExecExtra(script string, conf string, keys string, data string, extr
 
 
 
-	io.WriteString(stdin, conf)
-	io.WriteString(stdin, "\n")
-
-	b64script := b64.StdEncoding.EncodeToString([]byte(script))
-	io.WriteString(stdin, b64script)
-	io.WriteString(stdin, "\n")
-
-	b64keys := b64.StdEncoding.EncodeToString([]byte(keys))
-	io.WriteString(stdin, b64keys)
-	io.WriteString(stdin, "\n")
-
-	b64data := b64.StdEncoding.EncodeToString([]byte(data))
-	io.WriteString(stdin, b64data)
-	io.WriteString(stdin, "\n")
-
-	b64extra := b64.StdEncoding.EncodeToString([]byte(extra))
-	io.WriteString(stdin, b64extra)
-	io.WriteString(stdin, "\n")
-
-	b64context := b64.StdEncoding.EncodeToString([]byte(context))
-	io.WriteString(stdin, b64context)
-	io.WriteString(stdin, "\n")
+	writeInput(stdin, script, conf, keys, data, extra, context)
 
 	err = execCmd.Start()
 	if err != nil {
@@ -88,3 +70,126 @@ func captureOutput(pipe io.ReadCloser, output chan<- string) {
 	}
 	output <- buf.String()
 }
+
+func writeInput(w io.Writer, script string, conf string, keys string, data string, extra string, context string) {
+	io.WriteString(w, conf)
+	io.WriteString(w, "\n")
+	for _, arg := range []string{script, keys, data, extra, context} {
+		io.WriteString(w, b64.StdEncoding.EncodeToString([]byte(arg)))
+		io.WriteString(w, "\n")
+	}
+}
+
+type serveWorker struct {
+	cmd    *exec.Cmd
+	stdin  io.WriteCloser
+	stdout *bufio.Reader
+}
+
+// ZencodeServer multiplexes executions over a few long-lived
+// "zencode-exec --serve" processes, each keeping a warm VM
+type ZencodeServer struct {
+	idle    chan *serveWorker
+	mu      sync.Mutex
+	workers []*serveWorker
+}
+
+func NewZencodeServer(workers int) (*ZencodeServer, error) {
+	s := &ZencodeServer{idle: make(chan *serveWorker, workers)}
+	for i := 0; i < workers; i++ {
+		w, err := s.startWorker()
+		if err != nil {
+			s.Close()
+			return nil, err
+		}
+		s.idle <- w
+	}
+	return s, nil
+}
+
+func (s *ZencodeServer) startWorker() (*serveWorker, error) {
+	cmd := exec.Command("zencode-exec", "--serve")
+	stdin, err := cmd.StdinPipe()
+	if err != nil {
+		return nil, err
+	}
+	stdout, err := cmd.StdoutPipe()
+	if err != nil {
+		return nil, err
+	}
+	if err = cmd.Start(); err != nil {
+		return nil, err
+	}
+	w := &serveWorker{cmd: cmd, stdin: stdin, stdout: bufio.NewReader(stdout)}
+	s.mu.Lock()
+	s.workers = append(s.workers, w)
+	s.mu.Unlock()
+	return w, nil
+}
+
+// replaceWorker kills a worker out of sync or terminated and puts a
+// new one in the idle pool, the pool shrinks if it cannot be started
+func (s *ZencodeServer) replaceWorker(w *serveWorker) {
+	w.cmd.Process.Kill()
+	w.cmd.Wait()
+	s.mu.Lock()
+	for i, v := range s.workers {
+		if v == w {
+			s.workers = append(s.workers[:i], s.workers[i+1:]...)
+			break
+		}
+	}
+	s.mu.Unlock()
+	nw, err := s.startWorker()
+	if err != nil {
+		log.Printf("Failed to restart zencode-exec worker: %v", err)
+		return
+	}
+	s.idle <- nw
+}
+
+func (s *ZencodeServer) ZencodeExec(script string, conf string, keys string, data string) (ZenResult, bool) {
+	return s.ZencodeExecExtra(script, conf, keys, data, "", "")
+}
+
+func (s *ZencodeServer) ZencodeExecExtra(script string, conf string, keys string, data string, extra string, context string) (ZenResult, bool) {
+	w := <-s.idle
+
+	writeInput(w.stdin, script, conf, keys, data, extra, context)
+	var exitcode, outlen, errlen int
+	header, err := w.stdout.ReadString('\n')
+	if err == nil {
+		_, err = fmt.Sscanf(header, "%d %d %d", &exitcode, &outlen, &errlen)
+	}
+	if err != nil {
+		log.Printf("Failed to read zencode-exec result: %v", err)
+		s.replaceWorker(w)
+		return ZenResult{}, false
+	}
+	out := make([]byte, outlen)
+	logs := make([]byte, errlen)
+	if _, err = io.ReadFull(w.stdout, out); err == nil {
+		_, err = io.ReadFull(w.stdout, logs)
+	}
+	if err != nil {
+		log.Printf("Failed to read zencode-exec result: %v", err)
+		s.replaceWorker(w)
+		return ZenResult{}, false
+	}
+	s.idle <- w
+	return ZenResult{Output: string(out), Logs: string(logs)}, exitcode == 0
+}
+
+func (s *ZencodeServer) Close() error {
+	var res error
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	for _, w := range s.workers {
+		w.stdin.Close()
+		if err := w.cmd.Wait(); err != nil && res == nil {
+			res = err
+		}
+	}
+	s.workers = nil
+	return res
+}
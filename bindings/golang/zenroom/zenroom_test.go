@@ -100,3 +100,44 @@ res, success := ZencodeExecExtra(script, "", `{"keys": "keys"}`, `{"data": "data
 // 	fmt.Println(string(res))
 // 	// Output: hello
 // }
+
+func TestZencodeServer(t *testing.T) {
+	script := `Given I have a 'string' named 'data'
+Then print data`
+	server, err := NewZencodeServer(2)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer server.Close()
+	for _, data := range []string{"one", "two", "three"} {
+		res, success := server.ZencodeExec(script, "", "", `{"data":"`+data+`"}`)
+		if !success {
+			t.Error(res.Logs)
+		}
+		if res.Output != `{"data":"`+data+`"}`+"\n" {
+			t.Errorf("serve mode got %s", res.Output)
+		}
+	}
+	res, success := server.ZencodeExec(script, "", "", "")
+	if success {
+		t.Errorf("serve mode missing data did not fail: %s", res.Output)
+	}
+}
+
+func TestZencodeServerRestartsWorker(t *testing.T) {
+	script := `Given I have a 'string' named 'data'
+Then print data`
+	server, err := NewZencodeServer(1)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer server.Close()
+	server.workers[0].cmd.Process.Kill()
+	if _, success := server.ZencodeExec(script, "", "", `{"data":"dead"}`); success {
+		t.Error("serve mode with a dead worker did not fail")
+	}
+	res, success := server.ZencodeExec(script, "", "", `{"data":"alive"}`)
+	if !success || res.Output != `{"data":"alive"}`+"\n" {
+		t.Errorf("serve mode did not restart the worker: %s %s", res.Output, res.Logs)
+	}
+}
@@ -2,7 +2,7 @@ import pytest
 import base64
 import json
 from schema import Schema, Regex
-from zenroom import zencode_exec
+from zenroom import zencode_exec, ZencodeServer
 
 
 def test_zencode_call_random_array():
@@ -46,6 +46,31 @@ Then print the data
             found = base64.b64decode(s.split(": ")[1]).decode()
     assert("Cannot find 'string' anywhere " in found)
 
+def test_server():
+    script="""Given I have a 'string' named 'data'
+Then print data
+"""
+    with ZencodeServer(workers=2) as server:
+        for i in range(3):
+            res = server.zencode_exec(script, "", "", '{"data": "%d"}' % i)
+            assert res.exitcode == 0
+            assert res.output == '{"data":"%d"}\n' % i
+        res = server.zencode_exec(script)
+        assert res.exitcode != 0
+        assert res.result is None
+
+def test_serve_restarts_worker():
+    script="""Given I have a 'string' named 'data'
+Then print data
+"""
+    with ZencodeServer(workers=1) as server:
+        server._procs[0].kill()
+        with pytest.raises(Exception):
+            server.zencode_exec(script, "", "", '{"data": "dead"}')
+        res = server.zencode_exec(script, "", "", '{"data": "alive"}')
+        assert res.exitcode == 0
+        assert res.output == '{"data":"alive"}\n'
+
 # def test_lua_call_hello_world():
 #     lua_res = zenroom_exec(
 #         "print('hello world')"
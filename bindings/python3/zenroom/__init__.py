@@ -1,9 +1,11 @@
 from zenroom.zenroom import (
     ZenResult,
+    ZencodeServer,
     zencode_exec,
 )
 
 __all__ = [
     'ZenResult',
+    'ZencodeServer',
     'zencode_exec',
 ]
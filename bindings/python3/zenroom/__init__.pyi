@@ -1,5 +1,6 @@
 from zenroom.zenroom import (
     ZenResult as ZenResult,
+    ZencodeServer as ZencodeServer,
     zencode_call as zencode_call,
     zencode_exec as zencode_exec
 )
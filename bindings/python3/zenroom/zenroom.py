@@ -4,6 +4,7 @@ import json
 from dataclasses import dataclass, field
 import subprocess
 import base64
+import queue
 
 
 @dataclass
@@ -18,7 +19,7 @@ class ZenResult():
             self.result = None
 
 
-def zencode_exec(script, conf=None, keys=None, data=None, extra=None, context=None):
+def _zen_input(script, conf=None, keys=None, data=None, extra=None, context=None):
     zen_input = []
     if conf:
         zen_input.append(conf)
@@ -37,8 +38,77 @@ def zencode_exec(script, conf=None, keys=None, data=None, extra=None, context=No
     if context:
         zen_input.append(base64.b64encode(context.encode()))
     zen_input.append(b'\n')
+    return b''.join(zen_input)
+
+
+def zencode_exec(script, conf=None, keys=None, data=None, extra=None, context=None):
     res = subprocess.run(["zencode-exec"],
                          capture_output=True,
-                         input=b''.join(zen_input))
+                         input=_zen_input(script, conf, keys, data,
+                                          extra, context))
 
     return ZenResult(res.stdout.decode(), res.stderr.decode())
+
+
+class ZencodeServer():
+    """Pool of long-lived `zencode-exec --serve` workers
+
+    Executions are sent to the first idle worker process, which keeps
+    a warm VM across calls instead of being spawned for each one.
+    """
+
+    def __init__(self, workers=1):
+        self._idle = queue.Queue()
+        self._procs = []
+        for _ in range(workers):
+            self._idle.put(self._spawn())
+
+    def _spawn(self):
+        proc = subprocess.Popen(["zencode-exec", "--serve"],
+                                stdin=subprocess.PIPE,
+                                stdout=subprocess.PIPE,
+                                stderr=subprocess.DEVNULL)
+        self._procs.append(proc)
+        return proc
+
+    def _replace(self, proc):
+        """Kill a worker out of sync or terminated and start a new one"""
+        proc.kill()
+        proc.wait()
+        self._procs.remove(proc)
+        return self._spawn()
+
+    def zencode_exec(self, script, conf=None, keys=None, data=None,
+                     extra=None, context=None):
+        proc = self._idle.get()
+        try:
+            proc.stdin.write(_zen_input(script, conf, keys, data,
+                                        extra, context))
+            proc.stdin.flush()
+            header = proc.stdout.readline().split()
+            if len(header) != 3:
+                raise RuntimeError("zencode-exec worker terminated")
+            exitcode, outlen, errlen = (int(h) for h in header)
+            output = proc.stdout.read(outlen)
+            logs = proc.stdout.read(errlen)
+            if len(output) != outlen or len(logs) != errlen:
+                raise RuntimeError("zencode-exec worker terminated")
+        except BaseException:
+            self._idle.put(self._replace(proc))
+            raise
+        self._idle.put(proc)
+        res = ZenResult(output.decode(), logs.decode())
+        res.exitcode = exitcode
+        return res
+
+    def close(self):
+        for proc in self._procs:
+            proc.stdin.close()
+            proc.wait()
+        self._procs = []
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
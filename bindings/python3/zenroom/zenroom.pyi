@@ -41,3 +41,21 @@ def zencode_exec(
         keys: Optional[str],
         data: Optional[str]) -> ZenResult:
     ...
+
+
+class ZencodeServer:
+    def __init__(self, workers: int = ...) -> None:
+        ...
+
+    def zencode_exec(
+            self,
+            script: str,
+            conf: Optional[str] = ...,
+            keys: Optional[str] = ...,
+            data: Optional[str] = ...,
+            extra: Optional[str] = ...,
+            context: Optional[str] = ...) -> ZenResult:
+        ...
+
+    def close(self) -> None:
+        ...
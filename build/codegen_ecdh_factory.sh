@@ -6,13 +6,33 @@ if ! [ -d $PWD/src ] && [ -z "$2" ] ; then
 fi
 
 CN="$1"
-case $CN in
-	"SECP256K1") BN="256_28" ;;
-	*) echo "BIG name not defined for the curve ${CN}"; exit -1;  
+# limb size of milagro's build, see WORD_SIZE in build/init.mk
+WS="${WORD_SIZE:-32}"
+case $CN$WS in
+	"SECP256K132") BN="256_28" ;;
+	"SECP256K164") BN="256_56" ;;
+	*) echo "BIG name not defined for the curve ${CN} at ${WS}bit"; exit -1;  
 esac
 
 FILE="${2:-src/zen_ecdh_factory.c}"
 
+# secp256k1 verification and recovery on 64bit limbs when built with
+# -DSECP256K1_GLV, see src/secp256k1-glv.h
+GLV_INCLUDE=""
+GLV_INIT=""
+if [ "$CN" = "SECP256K1" ]; then
+	GLV_INCLUDE="#include <secp256k1-glv.h>
+"
+	GLV_INIT="#if defined(SECP256K1_GLV)
+	ECDH->ECP__VP_DSA = SECP256K1_GLV_VP_DSA;
+	ECDH->ECP__VP_DSA_NOHASH = SECP256K1_GLV_VP_DSA_NOHASH;
+	ECDH->ECP__PUBLIC_KEY_RECOVERY = SECP256K1_GLV_PUBLIC_KEY_RECOVERY;
+	ECDH->ECP__VP_DSA_NOHASH_BATCH = SECP256K1_GLV_VP_DSA_NOHASH_BATCH;
+	ECDH->ECP__PUBLIC_KEY_RECOVERY_BATCH = SECP256K1_GLV_PUBLIC_KEY_RECOVERY_BATCH;
+#endif
+"
+fi
+
 cat <<EOF > "${FILE}"
 // Generated by build/codegen_ecdh_factory.sh
 // `date`
@@ -22,7 +42,7 @@ cat <<EOF > "${FILE}"
 #include <zen_error.h>
 #include <ecdh_${CN}.h>
 #include <ecp_${CN}.h>
-
+${GLV_INCLUDE}
 static char ORDER[MODBYTES_${BN}];
 static char PRIME[MODBYTES_${BN}];
 
@@ -43,7 +63,7 @@ void ecdh_init(lua_State *L, ecdh *ECDH) {
 	ECDH->ECP__SP_DSA_NOHASH = ECP_${CN}_SP_DSA_NOHASH;
 	ECDH->ECP__VP_DSA_NOHASH = ECP_${CN}_VP_DSA_NOHASH;
 	ECDH->ECP__PUBLIC_KEY_RECOVERY = ECP_${CN}_PUBLIC_KEY_RECOVERY;
-	BIG_${BN} tmp; // toBytes takes a non const BIG
+${GLV_INIT}	BIG_${BN} tmp; // toBytes takes a non const BIG
 	BIG_${BN}_rcopy(tmp, CURVE_Order_${CN});
 	BIG_${BN}_toBytes(ORDER, tmp);
 	ECDH->order = ORDER;
@@ -6,12 +6,25 @@ if ! [ -d $PWD/src ] && [ -z "${MESON_BUILD_ROOT}" ]; then
 fi
 
 CN="${1:-BLS381}"
+# limb size of milagro's build, see WORD_SIZE in build/init.mk
+WS="${WORD_SIZE:-32}"
 BS=""
-case $CN in
-	"BLS383") BS="384_29"; BIGSIZE="384" ;;
-	"BLS381") BS="384_29"; BIGSIZE="384" ;;
-	"BLS461") BS="464_28"; BIGSIZE="464" ;;
-	"BLS48")  BS="560_29"; BIGSIZE="560" ;;
+case $WS in
+	"32")
+		case $CN in
+			"BLS383") BS="384_29"; BIGSIZE="384" ;;
+			"BLS381") BS="384_29"; BIGSIZE="384" ;;
+			"BLS461") BS="464_28"; BIGSIZE="464" ;;
+			"BLS48")  BS="560_29"; BIGSIZE="560" ;;
+		esac ;;
+	"64")
+		case $CN in
+			"BLS383") BS="384_58"; BIGSIZE="384" ;;
+			"BLS381") BS="384_58"; BIGSIZE="384" ;;
+			"BLS461") BS="464_60"; BIGSIZE="464" ;;
+			"BLS48")  BS="560_58"; BIGSIZE="560" ;;
+		esac ;;
+	*) echo "Unsupported word size: ${WS}"; exit 1 ;;
 esac
 
 DIR="${MESON_BUILD_ROOT:-src}"
@@ -97,6 +110,7 @@ cat <<EOF > "${DIR}"/zen_ecp_factory.h
 #define PAIR_fexp(x) PAIR_${CN}_fexp(x)
 #define PAIR_G2mul(p,b)	PAIR_${CN}_G2mul(p,b)
 #define PAIR_G1mul(p,b) PAIR_${CN}_G1mul(p,b)
+#define PAIR_double_ate(r,p,q,s,t) PAIR_${CN}_double_ate(r,p,q,s,t)
 
 #endif
 EOF
@@ -127,7 +141,7 @@ extern void PAIR_${CN}_GTpow(FP12_${CN} *x,BIG_${BS} b);
 
 #define Montgomery MConst_${CN}
 
-// CHUNK is 32bit
+// CHUNK is ${WS}bit
 
 #define BIG  BIG_${BS}
 #define DBIG DBIG_${BS}
@@ -143,6 +157,7 @@ extern void PAIR_${CN}_GTpow(FP12_${CN} *x,BIG_${BS} b);
 #define BIG_dec(b,n) BIG_${BS}_dec(b,n)
 #define BIG_norm(b) BIG_${BS}_norm(b)
 #define BIG_nbits(b) BIG_${BS}_nbits(b)
+#define BIG_bit(b,i) BIG_${BS}_bit(b,i)
 #define BIG_copy(b,a) BIG_${BS}_copy(b,a)
 #define BIG_rcopy(b,a) BIG_${BS}_rcopy(b,a)
 #define BIG_shl(b,a) BIG_${BS}_shl(b,a)
@@ -218,6 +233,7 @@ extern void PAIR_${CN}_GTpow(FP12_${CN} *x,BIG_${BS} b);
 // #define FP12_norm(f) FP12_${CN}_norm(f)
 // #define FP12_qr(f) FP12_${CN}_qr(f)
 #define FP12_inv(d,s) FP12_${CN}_inv(d,s)
+#define FP12_isunity(x) FP12_${CN}_isunity(x)
 
 #endif // _H_
 EOF
@@ -16,13 +16,16 @@ embed-lua:
 	@echo "File generated: src/lualibs_detected.c"
 
 src/zen_ecdh_factory.c:
-	${pwd}/build/codegen_ecdh_factory.sh ${ecdh_curve}
+	WORD_SIZE=${milagro_word_size} \
+		${pwd}/build/codegen_ecdh_factory.sh ${ecdh_curve}
 
 src/zen_ecp_factory.c:
-	${pwd}/build/codegen_ecp_factory.sh ${ecp_curve}
+	WORD_SIZE=${milagro_word_size} \
+		${pwd}/build/codegen_ecp_factory.sh ${ecp_curve}
 
 src/zen_big_factory.c:
-	${pwd}/build/codegen_ecp_factory.sh ${ecp_curve}
+	WORD_SIZE=${milagro_word_size} \
+		${pwd}/build/codegen_ecp_factory.sh ${ecp_curve}
 
 apply-patches: src/zen_ecdh_factory.c src/zen_ecp_factory.c src/zen_big_factory.c
 
@@ -83,7 +86,7 @@ mlkem:
 	LDFLAGS="${mkkem_ldflags} ${ldflags}" \
 	${MAKE} -C ${pwd}/lib/mlkem \
 			test/build/libmlkem512.a \
-			OPT=0 Q="" AUTO=0  MLKEM_K=2 \
+			OPT=1 Q="" AUTO=0  MLKEM_K=2 \
 			MLK_MULTILEVEL_BUILD_NO_SHARED=1
 	CC="${mlkem_cc}" \
 	AR=${ar} \
@@ -93,7 +96,7 @@ mlkem:
 	LDFLAGS="${mkkem_ldflags} ${ldflags}" \
 	${MAKE} -C ${pwd}/lib/mlkem \
 			test/build/libmlkem768.a \
-			OPT=0 Q="" AUTO=0 MLKEM_K=3 \
+			OPT=1 Q="" AUTO=0 MLKEM_K=3 \
 			MLK_MULTILEVEL_BUILD_NO_SHARED=1
 	CC="${mlkem_cc}" \
 	AR=${ar} \
@@ -103,5 +106,5 @@ mlkem:
 	LDFLAGS="${mkkem_ldflags} ${ldflags}" \
 	${MAKE} -C ${pwd}/lib/mlkem \
 			test/build/libmlkem.a \
-			OPT=0 Q="" AUTO=0 MLKEM_K=4 \
+			OPT=1 Q="" AUTO=0 MLKEM_K=4 \
 			MLK_MULTILEVEL_BUILD_WITH_SHARED=1
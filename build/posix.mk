@@ -36,6 +36,21 @@ ifdef LIBRARY
 	cflags += -fPIC -DLIBRARY
 endif
 
+# 64bit limbs for milagro and P-256 when the compiler targets a 64bit
+# host, p256=m keeps the small 32bit P-256 implementation and
+# secp256k1=milagro the ECDSA verification and recovery of milagro
+ifeq ($(shell echo __SIZEOF_POINTER__ | ${cc} -E -P - 2>/dev/null),8)
+	milagro_word_size := 64
+	p256 ?= 64
+	secp256k1 ?= glv
+endif
+ifeq (${p256},64)
+	cflags += -DP256_64
+endif
+ifeq (${secp256k1},glv)
+	cflags += -DSECP256K1_GLV
+endif
+
 # activate CCACHE etc.
 include build/plugins.mk
 
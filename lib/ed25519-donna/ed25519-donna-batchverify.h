@@ -217,7 +217,14 @@ ED25519_FN(ed25519_sign_open_batch) (const unsigned char **m, size_t *mlen, cons
 		batchsize = (num > max_batch_size) ? max_batch_size : num;
 
 		/* generate r (scalars[batchsize+1]..scalars[2*batchsize] */
+#if defined(ED25519_RANDOMBYTES_CHECKED)
+		/* predictable scalars would let forgeries pass: without
+		   entropy check each signature on its own */
+		if (ed25519_randombytes_checked(batch.r, batchsize * 16) != 0)
+			goto fallback;
+#else
 		ED25519_FN(ed25519_randombytes_unsafe) (batch.r, batchsize * 16);
+#endif
 		r_scalars = &batch.scalars[batchsize + 1];
 		for (i = 0; i < batchsize; i++)
 			expand256_modm(r_scalars[i], batch.r[i], 16);
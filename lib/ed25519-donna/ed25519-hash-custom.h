@@ -15,15 +15,14 @@ typedef hash512 ed25519_hash_context;
 
 extern void HASH512_init(hash512 *sh);
 extern void HASH512_process(hash512 *sh,int byt);
+extern void HASH512_process_array(hash512 *sh,const char *b,int len);
 extern void HASH512_hash(hash512 *sh,char *hash);
 
 void ed25519_hash_init(ed25519_hash_context *ctx) {
 	HASH512_init(ctx);
 }
 void ed25519_hash_update(ed25519_hash_context *ctx, const uint8_t *in, size_t inlen) {
-	for(size_t i = 0; i < inlen; i++) {
-		HASH512_process(ctx, in[i]);
-	}
+	HASH512_process_array(ctx, (const char*)in, (int)inlen);
 }
 void ed25519_hash_final(ed25519_hash_context *ctx, uint8_t *hash) {
 	HASH512_hash(ctx, hash);
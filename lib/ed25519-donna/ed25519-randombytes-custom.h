@@ -6,3 +6,20 @@
 	ed25519_randombytes_unsafe is used by the batch verification function
 	to create random scalars
 */
+
+/* the operating system entropy source of Zenroom (src/randombytes.c) */
+extern int randombytes(void *buf, size_t n);
+
+/* as ed25519_randombytes_unsafe, returns 0 on success: the batch
+   verification checks it to fail closed without entropy */
+#define ED25519_RANDOMBYTES_CHECKED
+static int
+ed25519_randombytes_checked(void *p, size_t len) {
+	return randombytes(p, len);
+}
+
+void
+ED25519_FN(ed25519_randombytes_unsafe) (void *p, size_t len) {
+	if (ed25519_randombytes_checked(p, len) != 0)
+		memset(p, 0, len);
+}
@@ -52,20 +52,17 @@ void ehashit(int sha,octet *p,int n,octet *x,octet *w,int pad)
 
     hlen=sha;
 
-    for (i=0; i<p->len; i++)
+    switch(sha)
     {
-        switch(sha)
-        {
-        case SHA256:
-            HASH256_process(&sha256,p->val[i]);
-            break;
-        case SHA384:
-            HASH384_process(&sha512,p->val[i]);
-            break;
-        case SHA512:
-            HASH512_process(&sha512,p->val[i]);
-            break;
-        }
+    case SHA256:
+        HASH256_process_array(&sha256,p->val,p->len);
+        break;
+    case SHA384:
+        HASH384_process_array(&sha512,p->val,p->len);
+        break;
+    case SHA512:
+        HASH512_process_array(&sha512,p->val,p->len);
+        break;
     }
     if (n>0)
     {
@@ -89,20 +86,17 @@ void ehashit(int sha,octet *p,int n,octet *x,octet *w,int pad)
             }
         }
     }
-    if (x!=NULL) for (i=0; i<x->len; i++)
+    if (x!=NULL) switch(sha)
         {
-            switch(sha)
-            {
-            case SHA256:
-                HASH256_process(&sha256,x->val[i]);
-                break;
-            case SHA384:
-                HASH384_process(&sha512,x->val[i]);
-                break;
-            case SHA512:
-                HASH512_process(&sha512,x->val[i]);
-                break;
-            }
+        case SHA256:
+            HASH256_process_array(&sha256,x->val,x->len);
+            break;
+        case SHA384:
+            HASH384_process_array(&sha512,x->val,x->len);
+            break;
+        case SHA512:
+            HASH512_process_array(&sha512,x->val,x->len);
+            break;
         }
 
     switch (sha)
@@ -116,6 +116,75 @@ static void HASH256_transform(hash256 *sh)
     sh->h[7]+=h;
 }
 
+/* SHA-256 with the x86 SHA extensions, selected at runtime */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HASH256_SHANI
+#include <cpuid.h>
+#include <immintrin.h>
+
+static int HASH256_has_shani(void)
+{
+    static int has=-1;
+    unsigned int a,b,c,d;
+    if (has<0)
+    {
+        has=0;
+        /* SSSE3 and SSE4.1 in leaf 1, SHA in leaf 7 */
+        if (__get_cpuid(1,&a,&b,&c,&d) && (c&(1<<9)) && (c&(1<<19)) &&
+            __get_cpuid_count(7,0,&a,&b,&c,&d) && (b&(1<<29)))
+            has=1;
+    }
+    return has;
+}
+
+/* process nblocks 64-byte blocks into state h[8] */
+__attribute__((target("sha,sse4.1")))
+static void HASH256_transform_shani(unsign32 *h,const char *b,int nblocks)
+{
+    const __m128i MASK=_mm_set_epi64x(0x0c0d0e0f08090a0bULL,0x0405060700010203ULL);
+    __m128i STATE0,STATE1,ABEF,CDGH,MSG,TMP,W[4];
+    int g;
+
+    TMP=_mm_loadu_si128((const __m128i*)&h[0]);
+    STATE1=_mm_loadu_si128((const __m128i*)&h[4]);
+    TMP=_mm_shuffle_epi32(TMP,0xB1);          /* CDAB */
+    STATE1=_mm_shuffle_epi32(STATE1,0x1B);    /* EFGH */
+    STATE0=_mm_alignr_epi8(TMP,STATE1,8);     /* ABEF */
+    STATE1=_mm_blend_epi16(STATE1,TMP,0xF0);  /* CDGH */
+
+    while (nblocks-->0)
+    {
+        ABEF=STATE0;
+        CDGH=STATE1;
+        for (g=0; g<16; g++)
+        {
+            /* 4 rounds each, message schedule from the 5th group */
+            if (g<4)
+                W[g]=_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(b+16*g)),MASK);
+            else
+                W[g&3]=_mm_sha256msg2_epu32(
+                           _mm_add_epi32(_mm_sha256msg1_epu32(W[g&3],W[(g+1)&3]),
+                                         _mm_alignr_epi8(W[(g+3)&3],W[(g+2)&3],4)),
+                           W[(g+3)&3]);
+            MSG=_mm_add_epi32(W[g&3],_mm_loadu_si128((const __m128i*)&K_256[4*g]));
+            STATE1=_mm_sha256rnds2_epu32(STATE1,STATE0,MSG);
+            MSG=_mm_shuffle_epi32(MSG,0x0E);
+            STATE0=_mm_sha256rnds2_epu32(STATE0,STATE1,MSG);
+        }
+        STATE0=_mm_add_epi32(STATE0,ABEF);
+        STATE1=_mm_add_epi32(STATE1,CDGH);
+        b+=64;
+    }
+
+    TMP=_mm_shuffle_epi32(STATE0,0x1B);       /* FEBA */
+    STATE1=_mm_shuffle_epi32(STATE1,0xB1);    /* DCHG */
+    STATE0=_mm_blend_epi16(TMP,STATE1,0xF0);  /* DCBA */
+    STATE1=_mm_alignr_epi8(STATE1,TMP,8);     /* ABEF */
+    _mm_storeu_si128((__m128i*)&h[0],STATE0);
+    _mm_storeu_si128((__m128i*)&h[4],STATE1);
+}
+#endif
+
 /* Initialise Hash function */
 void HASH256_init(hash256 *sh)
 {
@@ -154,6 +223,47 @@ void HASH256_process(hash256 *sh,int byt)
     if ((sh->length[0]%512)==0) HASH256_transform(sh);
 }
 
+/* process an array of bytes, whole 64-byte blocks go straight to the
+   transform (using the SHA extensions when the CPU has them) */
+void HASH256_process_array(hash256 *sh,const char *b,int len)
+{
+    unsign64 bits;
+    int i,nblocks;
+    /* complete a block already started */
+    while (len>0 && (sh->length[0]%512)!=0)
+    {
+        HASH256_process(sh,*b++);
+        len--;
+    }
+    nblocks=len/64;
+    if (nblocks>0)
+    {
+        bits=((unsign64)sh->length[1]<<32) | sh->length[0];
+        bits+=(unsign64)nblocks*512;
+        sh->length[0]=(unsign32)bits;
+        sh->length[1]=(unsign32)(bits>>32);
+#ifdef HASH256_SHANI
+        /* the last block goes through HASH256_transform to leave the
+           same message schedule in w as byte by byte processing */
+        if (nblocks>1 && HASH256_has_shani())
+        {
+            HASH256_transform_shani(sh->h,b,nblocks-1);
+            b+=(nblocks-1)*64;
+            nblocks=1;
+        }
+#endif
+        while (nblocks-->0)
+        {
+            for (i=0; i<16; i++,b+=4)
+                sh->w[i]=((unsign32)(unsigned char)b[0]<<24) | ((unsign32)(unsigned char)b[1]<<16) |
+                         ((unsign32)(unsigned char)b[2]<<8) | (unsign32)(unsigned char)b[3];
+            HASH256_transform(sh);
+        }
+        len%=64;
+    }
+    while (len-->0) HASH256_process(sh,*b++);
+}
+
 /* SU= 24 */
 /* Generate 32-byte Hash */
 void HASH256_hash(hash256 *sh,char *digest)
@@ -288,6 +398,11 @@ void HASH384_process(hash384 *sh,int byt)
     HASH512_process(sh,byt);
 }
 
+void HASH384_process_array(hash384 *sh,const char *b,int len)
+{
+    HASH512_process_array(sh,b,len);
+}
+
 void HASH384_hash(hash384 *sh,char *hash)
 {
     /* pad message and finish - supply digest */
@@ -332,6 +447,37 @@ void HASH512_process(hash512 *sh,int byt)
     if ((sh->length[0]%1024)==0) HASH512_transform(sh);
 }
 
+/* process an array of bytes, whole 128-byte blocks go straight to the
+   transform */
+void HASH512_process_array(hash512 *sh,const char *b,int len)
+{
+    unsign64 bits;
+    int i,j,nblocks;
+    while (len>0 && (sh->length[0]%1024)!=0)
+    {
+        HASH512_process(sh,*b++);
+        len--;
+    }
+    nblocks=len/128;
+    if (nblocks>0)
+    {
+        bits=(unsign64)nblocks*1024;
+        sh->length[0]+=bits;
+        if (sh->length[0]<bits) sh->length[1]++;
+        while (nblocks-->0)
+        {
+            for (i=0; i<16; i++,b+=8)
+            {
+                sh->w[i]=0;
+                for (j=0; j<8; j++) sh->w[i]=(sh->w[i]<<8) | (unsigned char)b[j];
+            }
+            HASH512_transform(sh);
+        }
+        len%=128;
+    }
+    while (len-->0) HASH512_process(sh,*b++);
+}
+
 void HASH512_hash(hash512 *sh,char *hash)
 {
     /* pad message and finish - supply digest */
@@ -465,6 +611,34 @@ void SHA3_process(sha3 *sh,int bytInt)
 }
 
 
+/* absorb an array of bytes, whole rate-sized chunks are xored in the
+   state one 64-bit lane at a time */
+void SHA3_process_array(sha3 *sh,const char *b,int len)
+{
+    int i,j,k;
+    unsign64 lane;
+    while (len>0 && (sh->length%sh->rate)!=0)
+    {
+        SHA3_process(sh,*b++);
+        len--;
+    }
+    while (len>=sh->rate)
+    {
+        for (k=0; k<sh->rate/8; k++,b+=8)
+        {
+            lane=0;
+            for (j=7; j>=0; j--) lane=(lane<<8) | (unsigned char)b[j];
+            i=k%5;
+            j=k/5;  /* by columns as in SHA3_process */
+            sh->S[i][j]^=lane;
+        }
+        sh->length+=sh->rate;
+        len-=sh->rate;
+        SHA3_transform(sh);
+    }
+    while (len-->0) SHA3_process(sh,*b++);
+}
+
 /* squeeze the sponge */
 void AMCL_(SHA3_squeeze)(sha3 *sh,char *buff,int len)
 {
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2025 Dyne.org foundation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef MLK_FIPS202_NATIVE_X86_64_META_H
+#define MLK_FIPS202_NATIVE_X86_64_META_H
+
+/* Identifier for this backend so that source and assembly files
+ * in the build can be appropriately guarded. */
+#define MLK_FIPS202_BACKEND_X86_64
+#define MLK_FIPS202_BACKEND_NAME AVX2
+
+#define MLK_USE_FIPS202_X4_NATIVE
+
+#define MLK_FIPS202_BACKEND_IMPL "native/x86_64/src/fips202_native_x86_64.h"
+
+#endif /* MLK_FIPS202_NATIVE_X86_64_META_H */
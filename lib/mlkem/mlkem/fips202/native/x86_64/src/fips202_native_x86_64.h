@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2025 Dyne.org foundation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef MLK_FIPS202_NATIVE_X86_64_SRC_FIPS202_NATIVE_X86_64_H
+#define MLK_FIPS202_NATIVE_X86_64_SRC_FIPS202_NATIVE_X86_64_H
+
+#include <stdint.h>
+#include "../../../../common.h"
+
+/* Permutes four consecutive 25 lanes states, on AVX2 when the cpu
+ * has it and the arithmetic backend is not capped to C, otherwise
+ * one after the other with mlk_keccakf1600_permute(). */
+#define mlk_keccak_f1600_x4_x86_64 MLK_NAMESPACE(keccak_f1600_x4_x86_64)
+void mlk_keccak_f1600_x4_x86_64(uint64_t *state);
+
+static MLK_INLINE void mlk_keccak_f1600_x4_native(uint64_t *state)
+{
+  mlk_keccak_f1600_x4_x86_64(state);
+}
+
+#endif /* MLK_FIPS202_NATIVE_X86_64_SRC_FIPS202_NATIVE_X86_64_H */
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2025 Dyne.org foundation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Four-way Keccak-f1600 on AVX2: the permutation of keccakf1600.c
+ * run on vectors holding the same lane of the four states.
+ */
+
+#include "../../../../common.h"
+
+#if defined(MLK_FIPS202_BACKEND_X86_64) &&  \
+    defined(MLK_ARITH_BACKEND_X86_64) && \
+    !defined(MLK_MULTILEVEL_BUILD_NO_SHARED)
+
+#include <stdint.h>
+#include "../../../../native/x86_64/src/arith_native_x86_64.h"
+#include "../../../keccakf1600.h"
+#include "fips202_native_x86_64.h"
+
+#define NROUNDS 24
+#define ROL(a, offset) ((a << offset) ^ (a >> (64 - offset)))
+
+typedef uint64_t v4u64 __attribute__((vector_size(32)));
+
+#define MLK_LOAD4(s, i)                                                  \
+  ((v4u64){(s)[i], (s)[MLK_KECCAK_LANES + (i)],                          \
+           (s)[2 * MLK_KECCAK_LANES + (i)], (s)[3 * MLK_KECCAK_LANES + (i)]})
+#define MLK_STORE4(s, i, v)                  \
+  do                                         \
+  {                                          \
+    (s)[i] = (v)[0];                         \
+    (s)[MLK_KECCAK_LANES + (i)] = (v)[1];     \
+    (s)[2 * MLK_KECCAK_LANES + (i)] = (v)[2]; \
+    (s)[3 * MLK_KECCAK_LANES + (i)] = (v)[3]; \
+  } while (0)
+
+static const uint64_t mlk_KeccakF_RoundConstants[NROUNDS] = {
+    (uint64_t)0x0000000000000001ULL, (uint64_t)0x0000000000008082ULL,
+    (uint64_t)0x800000000000808aULL, (uint64_t)0x8000000080008000ULL,
+    (uint64_t)0x000000000000808bULL, (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008081ULL, (uint64_t)0x8000000000008009ULL,
+    (uint64_t)0x000000000000008aULL, (uint64_t)0x0000000000000088ULL,
+    (uint64_t)0x0000000080008009ULL, (uint64_t)0x000000008000000aULL,
+    (uint64_t)0x000000008000808bULL, (uint64_t)0x800000000000008bULL,
+    (uint64_t)0x8000000000008089ULL, (uint64_t)0x8000000000008003ULL,
+    (uint64_t)0x8000000000008002ULL, (uint64_t)0x8000000000000080ULL,
+    (uint64_t)0x000000000000800aULL, (uint64_t)0x800000008000000aULL,
+    (uint64_t)0x8000000080008081ULL, (uint64_t)0x8000000000008080ULL,
+    (uint64_t)0x0000000080000001ULL, (uint64_t)0x8000000080008008ULL};
+
+__attribute__((target("avx2"))) static void mlk_keccak_f1600_x4_avx2(
+    uint64_t *state)
+{
+  unsigned round;
+
+  v4u64 Aba, Abe, Abi, Abo, Abu;
+  v4u64 Aga, Age, Agi, Ago, Agu;
+  v4u64 Aka, Ake, Aki, Ako, Aku;
+  v4u64 Ama, Ame, Ami, Amo, Amu;
+  v4u64 Asa, Ase, Asi, Aso, Asu;
+  v4u64 BCa, BCe, BCi, BCo, BCu;
+  v4u64 Da, De, Di, Do, Du;
+  v4u64 Eba, Ebe, Ebi, Ebo, Ebu;
+  v4u64 Ega, Ege, Egi, Ego, Egu;
+  v4u64 Eka, Eke, Eki, Eko, Eku;
+  v4u64 Ema, Eme, Emi, Emo, Emu;
+  v4u64 Esa, Ese, Esi, Eso, Esu;
+
+  /* copyFromState(A, state) */
+  Aba = MLK_LOAD4(state, 0);
+  Abe = MLK_LOAD4(state, 1);
+  Abi = MLK_LOAD4(state, 2);
+  Abo = MLK_LOAD4(state, 3);
+  Abu = MLK_LOAD4(state, 4);
+  Aga = MLK_LOAD4(state, 5);
+  Age = MLK_LOAD4(state, 6);
+  Agi = MLK_LOAD4(state, 7);
+  Ago = MLK_LOAD4(state, 8);
+  Agu = MLK_LOAD4(state, 9);
+  Aka = MLK_LOAD4(state, 10);
+  Ake = MLK_LOAD4(state, 11);
+  Aki = MLK_LOAD4(state, 12);
+  Ako = MLK_LOAD4(state, 13);
+  Aku = MLK_LOAD4(state, 14);
+  Ama = MLK_LOAD4(state, 15);
+  Ame = MLK_LOAD4(state, 16);
+  Ami = MLK_LOAD4(state, 17);
+  Amo = MLK_LOAD4(state, 18);
+  Amu = MLK_LOAD4(state, 19);
+  Asa = MLK_LOAD4(state, 20);
+  Ase = MLK_LOAD4(state, 21);
+  Asi = MLK_LOAD4(state, 22);
+  Aso = MLK_LOAD4(state, 23);
+  Asu = MLK_LOAD4(state, 24);
+
+  for (round = 0; round < NROUNDS; round += 2)
+  {
+    /*    prepareTheta */
+    BCa = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+    BCe = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+    BCi = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+    BCo = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+    BCu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+
+    /* thetaRhoPiChiIotaPrepareTheta(round  , A, E) */
+    Da = BCu ^ ROL(BCe, 1);
+    De = BCa ^ ROL(BCi, 1);
+    Di = BCe ^ ROL(BCo, 1);
+    Do = BCi ^ ROL(BCu, 1);
+    Du = BCo ^ ROL(BCa, 1);
+
+    Aba ^= Da;
+    BCa = Aba;
+    Age ^= De;
+    BCe = ROL(Age, 44);
+    Aki ^= Di;
+    BCi = ROL(Aki, 43);
+    Amo ^= Do;
+    BCo = ROL(Amo, 21);
+    Asu ^= Du;
+    BCu = ROL(Asu, 14);
+    Eba = BCa ^ ((~BCe) & BCi);
+    Eba ^= mlk_KeccakF_RoundConstants[round];
+    Ebe = BCe ^ ((~BCi) & BCo);
+    Ebi = BCi ^ ((~BCo) & BCu);
+    Ebo = BCo ^ ((~BCu) & BCa);
+    Ebu = BCu ^ ((~BCa) & BCe);
+
+    Abo ^= Do;
+    BCa = ROL(Abo, 28);
+    Agu ^= Du;
+    BCe = ROL(Agu, 20);
+    Aka ^= Da;
+    BCi = ROL(Aka, 3);
+    Ame ^= De;
+    BCo = ROL(Ame, 45);
+    Asi ^= Di;
+    BCu = ROL(Asi, 61);
+    Ega = BCa ^ ((~BCe) & BCi);
+    Ege = BCe ^ ((~BCi) & BCo);
+    Egi = BCi ^ ((~BCo) & BCu);
+    Ego = BCo ^ ((~BCu) & BCa);
+    Egu = BCu ^ ((~BCa) & BCe);
+
+    Abe ^= De;
+    BCa = ROL(Abe, 1);
+    Agi ^= Di;
+    BCe = ROL(Agi, 6);
+    Ako ^= Do;
+    BCi = ROL(Ako, 25);
+    Amu ^= Du;
+    BCo = ROL(Amu, 8);
+    Asa ^= Da;
+    BCu = ROL(Asa, 18);
+    Eka = BCa ^ ((~BCe) & BCi);
+    Eke = BCe ^ ((~BCi) & BCo);
+    Eki = BCi ^ ((~BCo) & BCu);
+    Eko = BCo ^ ((~BCu) & BCa);
+    Eku = BCu ^ ((~BCa) & BCe);
+
+    Abu ^= Du;
+    BCa = ROL(Abu, 27);
+    Aga ^= Da;
+    BCe = ROL(Aga, 36);
+    Ake ^= De;
+    BCi = ROL(Ake, 10);
+    Ami ^= Di;
+    BCo = ROL(Ami, 15);
+    Aso ^= Do;
+    BCu = ROL(Aso, 56);
+    Ema = BCa ^ ((~BCe) & BCi);
+    Eme = BCe ^ ((~BCi) & BCo);
+    Emi = BCi ^ ((~BCo) & BCu);
+    Emo = BCo ^ ((~BCu) & BCa);
+    Emu = BCu ^ ((~BCa) & BCe);
+
+    Abi ^= Di;
+    BCa = ROL(Abi, 62);
+    Ago ^= Do;
+    BCe = ROL(Ago, 55);
+    Aku ^= Du;
+    BCi = ROL(Aku, 39);
+    Ama ^= Da;
+    BCo = ROL(Ama, 41);
+    Ase ^= De;
+    BCu = ROL(Ase, 2);
+    Esa = BCa ^ ((~BCe) & BCi);
+    Ese = BCe ^ ((~BCi) & BCo);
+    Esi = BCi ^ ((~BCo) & BCu);
+    Eso = BCo ^ ((~BCu) & BCa);
+    Esu = BCu ^ ((~BCa) & BCe);
+
+    /*    prepareTheta */
+    BCa = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+    BCe = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+    BCi = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+    BCo = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+    BCu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+
+    /* thetaRhoPiChiIotaPrepareTheta(round+1, E, A) */
+    Da = BCu ^ ROL(BCe, 1);
+    De = BCa ^ ROL(BCi, 1);
+    Di = BCe ^ ROL(BCo, 1);
+    Do = BCi ^ ROL(BCu, 1);
+    Du = BCo ^ ROL(BCa, 1);
+
+    Eba ^= Da;
+    BCa = Eba;
+    Ege ^= De;
+    BCe = ROL(Ege, 44);
+    Eki ^= Di;
+    BCi = ROL(Eki, 43);
+    Emo ^= Do;
+    BCo = ROL(Emo, 21);
+    Esu ^= Du;
+    BCu = ROL(Esu, 14);
+    Aba = BCa ^ ((~BCe) & BCi);
+    Aba ^= mlk_KeccakF_RoundConstants[round + 1];
+    Abe = BCe ^ ((~BCi) & BCo);
+    Abi = BCi ^ ((~BCo) & BCu);
+    Abo = BCo ^ ((~BCu) & BCa);
+    Abu = BCu ^ ((~BCa) & BCe);
+
+    Ebo ^= Do;
+    BCa = ROL(Ebo, 28);
+    Egu ^= Du;
+    BCe = ROL(Egu, 20);
+    Eka ^= Da;
+    BCi = ROL(Eka, 3);
+    Eme ^= De;
+    BCo = ROL(Eme, 45);
+    Esi ^= Di;
+    BCu = ROL(Esi, 61);
+    Aga = BCa ^ ((~BCe) & BCi);
+    Age = BCe ^ ((~BCi) & BCo);
+    Agi = BCi ^ ((~BCo) & BCu);
+    Ago = BCo ^ ((~BCu) & BCa);
+    Agu = BCu ^ ((~BCa) & BCe);
+
+    Ebe ^= De;
+    BCa = ROL(Ebe, 1);
+    Egi ^= Di;
+    BCe = ROL(Egi, 6);
+    Eko ^= Do;
+    BCi = ROL(Eko, 25);
+    Emu ^= Du;
+    BCo = ROL(Emu, 8);
+    Esa ^= Da;
+    BCu = ROL(Esa, 18);
+    Aka = BCa ^ ((~BCe) & BCi);
+    Ake = BCe ^ ((~BCi) & BCo);
+    Aki = BCi ^ ((~BCo) & BCu);
+    Ako = BCo ^ ((~BCu) & BCa);
+    Aku = BCu ^ ((~BCa) & BCe);
+
+    Ebu ^= Du;
+    BCa = ROL(Ebu, 27);
+    Ega ^= Da;
+    BCe = ROL(Ega, 36);
+    Eke ^= De;
+    BCi = ROL(Eke, 10);
+    Emi ^= Di;
+    BCo = ROL(Emi, 15);
+    Eso ^= Do;
+    BCu = ROL(Eso, 56);
+    Ama = BCa ^ ((~BCe) & BCi);
+    Ame = BCe ^ ((~BCi) & BCo);
+    Ami = BCi ^ ((~BCo) & BCu);
+    Amo = BCo ^ ((~BCu) & BCa);
+    Amu = BCu ^ ((~BCa) & BCe);
+
+    Ebi ^= Di;
+    BCa = ROL(Ebi, 62);
+    Ego ^= Do;
+    BCe = ROL(Ego, 55);
+    Eku ^= Du;
+    BCi = ROL(Eku, 39);
+    Ema ^= Da;
+    BCo = ROL(Ema, 41);
+    Ese ^= De;
+    BCu = ROL(Ese, 2);
+    Asa = BCa ^ ((~BCe) & BCi);
+    Ase = BCe ^ ((~BCi) & BCo);
+    Asi = BCi ^ ((~BCo) & BCu);
+    Aso = BCo ^ ((~BCu) & BCa);
+    Asu = BCu ^ ((~BCa) & BCe);
+  }
+
+  /* copyToState(state, A) */
+  MLK_STORE4(state, 0, Aba);
+  MLK_STORE4(state, 1, Abe);
+  MLK_STORE4(state, 2, Abi);
+  MLK_STORE4(state, 3, Abo);
+  MLK_STORE4(state, 4, Abu);
+  MLK_STORE4(state, 5, Aga);
+  MLK_STORE4(state, 6, Age);
+  MLK_STORE4(state, 7, Agi);
+  MLK_STORE4(state, 8, Ago);
+  MLK_STORE4(state, 9, Agu);
+  MLK_STORE4(state, 10, Aka);
+  MLK_STORE4(state, 11, Ake);
+  MLK_STORE4(state, 12, Aki);
+  MLK_STORE4(state, 13, Ako);
+  MLK_STORE4(state, 14, Aku);
+  MLK_STORE4(state, 15, Ama);
+  MLK_STORE4(state, 16, Ame);
+  MLK_STORE4(state, 17, Ami);
+  MLK_STORE4(state, 18, Amo);
+  MLK_STORE4(state, 19, Amu);
+  MLK_STORE4(state, 20, Asa);
+  MLK_STORE4(state, 21, Ase);
+  MLK_STORE4(state, 22, Asi);
+  MLK_STORE4(state, 23, Aso);
+  MLK_STORE4(state, 24, Asu);
+
+}
+
+void mlk_keccak_f1600_x4_x86_64(uint64_t *state)
+{
+  if (MLK_X86_64_LEVEL == MLK_X86_64_AVX2)
+  {
+    mlk_keccak_f1600_x4_avx2(state);
+  }
+  else
+  {
+    mlk_keccakf1600_permute(state + MLK_KECCAK_LANES * 0);
+    mlk_keccakf1600_permute(state + MLK_KECCAK_LANES * 1);
+    mlk_keccakf1600_permute(state + MLK_KECCAK_LANES * 2);
+    mlk_keccakf1600_permute(state + MLK_KECCAK_LANES * 3);
+  }
+}
+
+#else /* MLK_FIPS202_BACKEND_X86_64 && MLK_ARITH_BACKEND_X86_64 && \
+         !MLK_MULTILEVEL_BUILD_NO_SHARED */
+
+MLK_EMPTY_CU(x86_64_keccak_f1600_x4_avx2)
+
+#endif /* MLK_FIPS202_BACKEND_X86_64 && MLK_ARITH_BACKEND_X86_64 && \
+          !MLK_MULTILEVEL_BUILD_NO_SHARED */
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2025 Dyne.org foundation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef MLK_NATIVE_META_H
+#define MLK_NATIVE_META_H
+
+/*
+ * Default arithmetic backend: AVX2 on x86_64, selected at runtime
+ * with the C code as fallback, and the C backend elsewhere.
+ */
+#if defined(MLK_SYS_X86_64) && (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(__EMSCRIPTEN__)
+#include "x86_64/meta.h"
+#endif
+
+#endif /* MLK_NATIVE_META_H */
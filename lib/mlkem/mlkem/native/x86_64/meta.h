@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2025 Dyne.org foundation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef MLK_NATIVE_X86_64_META_H
+#define MLK_NATIVE_X86_64_META_H
+
+/* Identifier for this backend so that source and assembly files
+ * in the build can be appropriately guarded. */
+#define MLK_ARITH_BACKEND_X86_64
+#define MLK_ARITH_BACKEND_NAME AVX2
+
+/* The NTT keeps the standard coefficient order, so the C code of
+ * the remaining polynomial operations is shared with this backend */
+#define MLK_USE_NATIVE_NTT
+#define MLK_USE_NATIVE_INTT
+#define MLK_USE_NATIVE_POLY_REDUCE
+#define MLK_USE_NATIVE_POLYVEC_BASEMUL_ACC_MONTGOMERY_CACHED
+
+#define MLK_ARITH_BACKEND_IMPL "native/x86_64/src/arith_native_x86_64.h"
+
+#endif /* MLK_NATIVE_X86_64_META_H */
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2025 Dyne.org foundation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Polynomial reduction and multiplication in the NTT domain on AVX2.
+ *
+ * The base multiplication accumulates both coefficients of each pair
+ * with madd_epi16 in 32 bits across the k polynomials and reduces
+ * them once at the end, as the C backend does.
+ */
+
+#include "../../../common.h"
+
+#if defined(MLK_ARITH_BACKEND_X86_64) && \
+    !defined(MLK_MULTILEVEL_BUILD_NO_SHARED)
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "../../../poly.h"
+#include "arith_native_x86_64.h"
+
+#define MLK_AVX2 __attribute__((target("avx2")))
+
+/* check-magic: 20159 == round(2^26 / MLKEM_Q) */
+#define MLK_BARRETT_MULTIPLIER 20159
+/* check-magic: 62209 == pow(MLKEM_Q, -1, 2^16) */
+#define MLK_QINV 62209
+
+static MLK_AVX2 void mlk_poly_reduce_avx2(int16_t *r)
+{
+  const __m256i q = _mm256_set1_epi16(MLKEM_Q);
+  const __m256i v = _mm256_set1_epi16(MLK_BARRETT_MULTIPLIER);
+  const __m256i shift = _mm256_set1_epi16(1 << 5);
+  unsigned i;
+  for (i = 0; i < MLKEM_N; i += 16)
+  {
+    __m256i a = _mm256_loadu_si256((const __m256i *)&r[i]);
+    __m256i t = _mm256_mulhrs_epi16(_mm256_mulhi_epi16(a, v), shift);
+    a = _mm256_sub_epi16(a, _mm256_mullo_epi16(t, q));
+    /* Conditional addition to get unsigned canonical representative */
+    a = _mm256_add_epi16(a, _mm256_and_si256(_mm256_srai_epi16(a, 15), q));
+    _mm256_storeu_si256((__m256i *)&r[i], a);
+  }
+}
+
+/* mlk_montgomery_reduce on 32 bit lanes, leaving a sign extended
+ * int16 in each */
+static MLK_INLINE MLK_AVX2 __m256i mlk_montgomery_avx2(__m256i t)
+{
+  __m256i m = _mm256_mullo_epi32(t, _mm256_set1_epi32(MLK_QINV));
+  m = _mm256_srai_epi32(_mm256_slli_epi32(m, 16), 16);
+  t = _mm256_sub_epi32(t, _mm256_mullo_epi32(m, _mm256_set1_epi32(MLKEM_Q)));
+  return _mm256_srai_epi32(t, 16);
+}
+
+static MLK_AVX2 void mlk_basemul_acc_avx2(int16_t *r, const int16_t *a,
+                                          const int16_t *b,
+                                          const int16_t *b_cache, unsigned k)
+{
+  unsigned i, j;
+  for (i = 0; i < MLKEM_N; i += 16)
+  {
+    __m256i t0 = _mm256_setzero_si256();
+    __m256i t1 = _mm256_setzero_si256();
+    for (j = 0; j < k; j++)
+    {
+      const __m256i x = _mm256_loadu_si256((const __m256i *)&a[j * MLKEM_N + i]);
+      const __m256i y = _mm256_loadu_si256((const __m256i *)&b[j * MLKEM_N + i]);
+      const __m256i c = _mm256_cvtepi16_epi32(
+          _mm_loadu_si128((const __m128i *)&b_cache[j * (MLKEM_N / 2) + i / 2]));
+      /* (b[2i], b_cache[i]) and (b[2i+1], b[2i]) in each 32 bit lane */
+      const __m256i y0 = _mm256_blend_epi16(y, _mm256_slli_epi32(c, 16), 0xAA);
+      const __m256i y1 =
+          _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(y, 0xB1), 0xB1);
+      t0 = _mm256_add_epi32(t0, _mm256_madd_epi16(x, y0));
+      t1 = _mm256_add_epi32(t1, _mm256_madd_epi16(x, y1));
+    }
+    t0 = mlk_montgomery_avx2(t0);
+    t1 = mlk_montgomery_avx2(t1);
+    _mm256_storeu_si256((__m256i *)&r[i],
+                        _mm256_blend_epi16(t0, _mm256_slli_epi32(t1, 16), 0xAA));
+  }
+}
+
+static void mlk_poly_reduce_c(int16_t *r)
+{
+  unsigned i;
+  for (i = 0; i < MLKEM_N; i++)
+  {
+    const int32_t t = (MLK_BARRETT_MULTIPLIER * r[i] + (1 << 25)) >> 26;
+    const int16_t x = (int16_t)(r[i] - t * MLKEM_Q);
+    r[i] = (int16_t)(x + ((x >> 15) & MLKEM_Q));
+  }
+}
+
+static void mlk_basemul_acc_c(int16_t *r, const int16_t *a, const int16_t *b,
+                              const int16_t *b_cache, unsigned k)
+{
+  unsigned i, j;
+  for (i = 0; i < MLKEM_N / 2; i++)
+  {
+    int32_t t0 = 0, t1 = 0;
+    for (j = 0; j < k; j++)
+    {
+      const int16_t *x = &a[j * MLKEM_N + 2 * i];
+      const int16_t *y = &b[j * MLKEM_N + 2 * i];
+      t0 += (int32_t)x[1] * b_cache[j * (MLKEM_N / 2) + i];
+      t0 += (int32_t)x[0] * y[0];
+      t1 += (int32_t)x[0] * y[1];
+      t1 += (int32_t)x[1] * y[0];
+    }
+    r[2 * i + 0] = mlk_montgomery_reduce(t0);
+    r[2 * i + 1] = mlk_montgomery_reduce(t1);
+  }
+}
+
+void mlk_poly_reduce_x86_64(int16_t *r)
+{
+  if (MLK_X86_64_LEVEL == MLK_X86_64_AVX2)
+  {
+    mlk_poly_reduce_avx2(r);
+  }
+  else
+  {
+    mlk_poly_reduce_c(r);
+  }
+}
+
+void mlk_basemul_acc_x86_64(int16_t *r, const int16_t *a, const int16_t *b,
+                            const int16_t *b_cache, unsigned k)
+{
+  if (MLK_X86_64_LEVEL == MLK_X86_64_AVX2)
+  {
+    mlk_basemul_acc_avx2(r, a, b, b_cache, k);
+  }
+  else
+  {
+    mlk_basemul_acc_c(r, a, b, b_cache, k);
+  }
+}
+
+#else /* MLK_ARITH_BACKEND_X86_64 && !MLK_MULTILEVEL_BUILD_NO_SHARED */
+
+MLK_EMPTY_CU(x86_64_arith_avx2)
+
+#endif /* MLK_ARITH_BACKEND_X86_64 && !MLK_MULTILEVEL_BUILD_NO_SHARED */
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Dyne.org foundation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef MLK_NATIVE_X86_64_SRC_ARITH_NATIVE_X86_64_H
+#define MLK_NATIVE_X86_64_SRC_ARITH_NATIVE_X86_64_H
+
+#include <stdint.h>
+#include "../../../common.h"
+
+/*
+ * Each function runs the AVX2 code when the cpu has it and the
+ * backend has not been capped to C with mlk_x86_64_backend(), the
+ * portable C code otherwise. Both compute the same Montgomery and
+ * Barrett reductions, so their outputs are identical.
+ */
+
+#define MLK_X86_64_C 0
+#define MLK_X86_64_AVX2 1
+
+#define mlk_x86_64_level MLK_NAMESPACE(x86_64_level)
+extern int mlk_x86_64_level;
+
+/* Caps the backend used to max and returns the one in use, a
+ * negative max just returns it. Also drives the FIPS202 backend. */
+#define mlk_x86_64_backend MLK_NAMESPACE(x86_64_backend)
+int mlk_x86_64_backend(int max);
+
+#define MLK_X86_64_LEVEL \
+  (mlk_x86_64_level >= 0 ? mlk_x86_64_level : mlk_x86_64_backend(-1))
+
+#define mlk_ntt_x86_64 MLK_NAMESPACE(ntt_x86_64)
+void mlk_ntt_x86_64(int16_t *r);
+
+#define mlk_intt_x86_64 MLK_NAMESPACE(intt_x86_64)
+void mlk_intt_x86_64(int16_t *r);
+
+#define mlk_poly_reduce_x86_64 MLK_NAMESPACE(poly_reduce_x86_64)
+void mlk_poly_reduce_x86_64(int16_t *r);
+
+#define mlk_basemul_acc_x86_64 MLK_NAMESPACE(basemul_acc_x86_64)
+void mlk_basemul_acc_x86_64(int16_t *r, const int16_t *a, const int16_t *b,
+                            const int16_t *b_cache, unsigned k);
+
+static MLK_INLINE void mlk_ntt_native(int16_t data[MLKEM_N])
+{
+  mlk_ntt_x86_64(data);
+}
+
+static MLK_INLINE void mlk_intt_native(int16_t data[MLKEM_N])
+{
+  mlk_intt_x86_64(data);
+}
+
+static MLK_INLINE void mlk_poly_reduce_native(int16_t data[MLKEM_N])
+{
+  mlk_poly_reduce_x86_64(data);
+}
+
+static MLK_INLINE void mlk_polyvec_basemul_acc_montgomery_cached_k2_native(
+    int16_t r[MLKEM_N], const int16_t a[2 * MLKEM_N],
+    const int16_t b[2 * MLKEM_N], const int16_t b_cache[2 * (MLKEM_N / 2)])
+{
+  mlk_basemul_acc_x86_64(r, a, b, b_cache, 2);
+}
+
+static MLK_INLINE void mlk_polyvec_basemul_acc_montgomery_cached_k3_native(
+    int16_t r[MLKEM_N], const int16_t a[3 * MLKEM_N],
+    const int16_t b[3 * MLKEM_N], const int16_t b_cache[3 * (MLKEM_N / 2)])
+{
+  mlk_basemul_acc_x86_64(r, a, b, b_cache, 3);
+}
+
+static MLK_INLINE void mlk_polyvec_basemul_acc_montgomery_cached_k4_native(
+    int16_t r[MLKEM_N], const int16_t a[4 * MLKEM_N],
+    const int16_t b[4 * MLKEM_N], const int16_t b_cache[4 * (MLKEM_N / 2)])
+{
+  mlk_basemul_acc_x86_64(r, a, b, b_cache, 4);
+}
+
+#endif /* MLK_NATIVE_X86_64_SRC_ARITH_NATIVE_X86_64_H */
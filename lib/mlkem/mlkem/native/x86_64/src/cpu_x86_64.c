@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2025 Dyne.org foundation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "../../../common.h"
+
+#if defined(MLK_ARITH_BACKEND_X86_64) && \
+    !defined(MLK_MULTILEVEL_BUILD_NO_SHARED)
+
+#include "arith_native_x86_64.h"
+
+int mlk_x86_64_level = -1;
+static int mlk_x86_64_cpu = -1;
+
+int mlk_x86_64_backend(int max)
+{
+  if (mlk_x86_64_cpu < 0)
+  {
+    mlk_x86_64_cpu = MLK_X86_64_C;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+      mlk_x86_64_cpu = MLK_X86_64_AVX2;
+    }
+  }
+  if (max >= 0)
+  {
+    mlk_x86_64_level = max < mlk_x86_64_cpu ? max : mlk_x86_64_cpu;
+  }
+  else if (mlk_x86_64_level < 0)
+  {
+    mlk_x86_64_level = mlk_x86_64_cpu;
+  }
+  return mlk_x86_64_level;
+}
+
+#else /* MLK_ARITH_BACKEND_X86_64 && !MLK_MULTILEVEL_BUILD_NO_SHARED */
+
+MLK_EMPTY_CU(x86_64_cpu)
+
+#endif /* MLK_ARITH_BACKEND_X86_64 && !MLK_MULTILEVEL_BUILD_NO_SHARED */
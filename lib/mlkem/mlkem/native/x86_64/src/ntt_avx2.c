@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2025 Dyne.org foundation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Forward and inverse NTT on AVX2, 16 coefficients per vector.
+ *
+ * The layers of length 128 down to 16 butterfly whole vectors. The
+ * last three layers work inside a pair of vectors, rearranged so
+ * that both inputs of a butterfly sit at the same position of two
+ * vectors, and the twiddles of each pair are shuffled out of eight
+ * consecutive zetas.
+ *
+ * Montgomery and Barrett reductions are computed exactly as the C
+ * backend does, which is kept here as the fallback when the cpu has
+ * no AVX2.
+ */
+
+#include "../../../common.h"
+
+#if defined(MLK_ARITH_BACKEND_X86_64) && \
+    !defined(MLK_MULTILEVEL_BUILD_NO_SHARED)
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "../../../poly.h"
+#include "arith_native_x86_64.h"
+
+#include "../../../zetas.inc"
+
+#define MLK_AVX2 __attribute__((target("avx2")))
+
+/* check-magic: -3327 == signed_mod(pow(MLKEM_Q, -1, 2^16), 2^16) */
+#define MLK_QINV_S16 -3327
+/* check-magic: 20159 == round(2^26 / MLKEM_Q) */
+#define MLK_BARRETT_MULTIPLIER 20159
+
+/* mlk_montgomery_reduce(a * b) on each lane */
+static MLK_INLINE MLK_AVX2 __m256i mlk_fqmul_avx2(__m256i a, __m256i b)
+{
+  const __m256i q = _mm256_set1_epi16(MLKEM_Q);
+  const __m256i qinv = _mm256_set1_epi16(MLK_QINV_S16);
+  __m256i lo = _mm256_mullo_epi16(a, b);
+  __m256i hi = _mm256_mulhi_epi16(a, b);
+  lo = _mm256_mullo_epi16(lo, qinv);
+  return _mm256_sub_epi16(hi, _mm256_mulhi_epi16(lo, q));
+}
+
+/* (2^26 / q * a + 2^25) >> 26 as mulhi followed by a rounding >> 10 */
+static MLK_INLINE MLK_AVX2 __m256i mlk_barrett_reduce_avx2(__m256i a)
+{
+  const __m256i q = _mm256_set1_epi16(MLKEM_Q);
+  __m256i t = _mm256_mulhi_epi16(a, _mm256_set1_epi16(MLK_BARRETT_MULTIPLIER));
+  t = _mm256_mulhrs_epi16(t, _mm256_set1_epi16(1 << 5));
+  return _mm256_sub_epi16(a, _mm256_mullo_epi16(t, q));
+}
+
+#define MLK_FWD(x, y, z)                  \
+  do                                      \
+  {                                       \
+    __m256i t_ = mlk_fqmul_avx2(y, z);    \
+    y = _mm256_sub_epi16(x, t_);          \
+    x = _mm256_add_epi16(x, t_);          \
+  } while (0)
+
+#define MLK_INV(x, y, z)                                  \
+  do                                                      \
+  {                                                       \
+    __m256i t_ = x;                                       \
+    x = mlk_barrett_reduce_avx2(_mm256_add_epi16(t_, y)); \
+    y = mlk_fqmul_avx2(_mm256_sub_epi16(y, t_), z);       \
+  } while (0)
+
+/* Rearrange a pair of vectors into the two inputs of butterflies of
+ * length 8, 4 and 2, each one is its own inverse */
+#define MLK_SPLIT8(a, b, x, y)                  \
+  do                                            \
+  {                                             \
+    x = _mm256_permute2x128_si256(a, b, 0x20);  \
+    y = _mm256_permute2x128_si256(a, b, 0x31);  \
+  } while (0)
+#define MLK_SPLIT4(a, b, x, y)       \
+  do                                 \
+  {                                  \
+    x = _mm256_unpacklo_epi64(a, b); \
+    y = _mm256_unpackhi_epi64(a, b); \
+  } while (0)
+#define MLK_SPLIT2(a, b, x, y)                                        \
+  do                                                                  \
+  {                                                                   \
+    x = _mm256_blend_epi32(a, _mm256_slli_epi64(b, 32), 0xAA);        \
+    y = _mm256_blend_epi32(_mm256_srli_epi64(a, 32), b, 0xAA);        \
+  } while (0)
+
+/* Shuffle of the int16 zetas[base .. base+7] in both lanes */
+static MLK_INLINE MLK_AVX2 __m256i mlk_zetas8(unsigned base, __m256i idx)
+{
+  __m256i z = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i *)&zetas[base]));
+  return _mm256_shuffle_epi8(z, idx);
+}
+
+/* Byte indices picking the int16 elements e0 .. e7 of each lane */
+#define MLK_E(e) (char)(2 * (e)), (char)(2 * (e) + 1)
+#define MLK_E2(e) MLK_E(e), MLK_E(e)
+#define MLK_E4(e) MLK_E2(e), MLK_E2(e)
+#define MLK_E8(e) MLK_E4(e), MLK_E4(e)
+
+static MLK_AVX2 void mlk_ntt_avx2(int16_t *r)
+{
+  __m256i v[16], x, y;
+  const __m256i idx8 = _mm256_setr_epi8(MLK_E8(0), MLK_E8(1));
+  const __m256i idx4 =
+      _mm256_setr_epi8(MLK_E4(0), MLK_E4(2), MLK_E4(1), MLK_E4(3));
+  const __m256i idx2 =
+      _mm256_setr_epi8(MLK_E2(0), MLK_E2(4), MLK_E2(1), MLK_E2(5), MLK_E2(2),
+                       MLK_E2(6), MLK_E2(3), MLK_E2(7));
+  unsigned i, j, s, k;
+
+  for (i = 0; i < 16; i++)
+  {
+    v[i] = _mm256_loadu_si256((const __m256i *)&r[16 * i]);
+  }
+
+  k = 1;
+  for (s = 8; s > 0; s >>= 1)
+  {
+    for (i = 0; i < 16; i += 2 * s)
+    {
+      __m256i z = _mm256_set1_epi16(zetas[k++]);
+      for (j = i; j < i + s; j++)
+      {
+        MLK_FWD(v[j], v[j + s], z);
+      }
+    }
+  }
+
+  for (i = 0; i < 8; i++)
+  {
+    MLK_SPLIT8(v[2 * i], v[2 * i + 1], x, y);
+    MLK_FWD(x, y, mlk_zetas8(16 + 2 * i, idx8));
+    MLK_SPLIT8(x, y, v[2 * i], v[2 * i + 1]);
+    MLK_SPLIT4(v[2 * i], v[2 * i + 1], x, y);
+    MLK_FWD(x, y, mlk_zetas8(32 + 4 * i, idx4));
+    MLK_SPLIT4(x, y, v[2 * i], v[2 * i + 1]);
+    MLK_SPLIT2(v[2 * i], v[2 * i + 1], x, y);
+    MLK_FWD(x, y, mlk_zetas8(64 + 8 * i, idx2));
+    MLK_SPLIT2(x, y, v[2 * i], v[2 * i + 1]);
+  }
+
+  for (i = 0; i < 16; i++)
+  {
+    _mm256_storeu_si256((__m256i *)&r[16 * i], v[i]);
+  }
+}
+
+static MLK_AVX2 void mlk_intt_avx2(int16_t *r)
+{
+  __m256i v[16], x, y;
+  /* check-magic: 1441 == pow(2,32 - 7,MLKEM_Q) */
+  const __m256i f = _mm256_set1_epi16(1441);
+  const __m256i idx2 =
+      _mm256_setr_epi8(MLK_E2(7), MLK_E2(3), MLK_E2(6), MLK_E2(2), MLK_E2(5),
+                       MLK_E2(1), MLK_E2(4), MLK_E2(0));
+  const __m256i idx4 =
+      _mm256_setr_epi8(MLK_E4(3), MLK_E4(1), MLK_E4(2), MLK_E4(0));
+  const __m256i idx8 = _mm256_setr_epi8(MLK_E8(1), MLK_E8(0));
+  unsigned i, j, s, k;
+
+  for (i = 0; i < 16; i++)
+  {
+    v[i] = mlk_fqmul_avx2(_mm256_loadu_si256((const __m256i *)&r[16 * i]), f);
+  }
+
+  for (i = 0; i < 8; i++)
+  {
+    MLK_SPLIT2(v[2 * i], v[2 * i + 1], x, y);
+    MLK_INV(x, y, mlk_zetas8(120 - 8 * i, idx2));
+    MLK_SPLIT2(x, y, v[2 * i], v[2 * i + 1]);
+    MLK_SPLIT4(v[2 * i], v[2 * i + 1], x, y);
+    MLK_INV(x, y, mlk_zetas8(60 - 4 * i, idx4));
+    MLK_SPLIT4(x, y, v[2 * i], v[2 * i + 1]);
+    MLK_SPLIT8(v[2 * i], v[2 * i + 1], x, y);
+    MLK_INV(x, y, mlk_zetas8(30 - 2 * i, idx8));
+    MLK_SPLIT8(x, y, v[2 * i], v[2 * i + 1]);
+  }
+
+  k = 16;
+  for (s = 1; s < 16; s <<= 1)
+  {
+    for (i = 0; i < 16; i += 2 * s)
+    {
+      __m256i z = _mm256_set1_epi16(zetas[--k]);
+      for (j = i; j < i + s; j++)
+      {
+        MLK_INV(v[j], v[j + s], z);
+      }
+    }
+  }
+
+  for (i = 0; i < 16; i++)
+  {
+    _mm256_storeu_si256((__m256i *)&r[16 * i], v[i]);
+  }
+}
+
+static int16_t mlk_fqmul_c(int16_t a, int16_t b)
+{
+  return mlk_montgomery_reduce((int32_t)a * (int32_t)b);
+}
+
+static int16_t mlk_barrett_reduce_c(int16_t a)
+{
+  const int32_t t = (MLK_BARRETT_MULTIPLIER * a + (1 << 25)) >> 26;
+  return (int16_t)(a - t * MLKEM_Q);
+}
+
+static void mlk_ntt_c(int16_t *r)
+{
+  unsigned len, start, j, k = 1;
+  for (len = 128; len >= 2; len >>= 1)
+  {
+    for (start = 0; start < MLKEM_N; start += 2 * len)
+    {
+      const int16_t zeta = zetas[k++];
+      for (j = start; j < start + len; j++)
+      {
+        const int16_t t = mlk_fqmul_c(r[j + len], zeta);
+        r[j + len] = r[j] - t;
+        r[j] = r[j] + t;
+      }
+    }
+  }
+}
+
+static void mlk_intt_c(int16_t *r)
+{
+  unsigned len, start, j, k = 127;
+  for (j = 0; j < MLKEM_N; j++)
+  {
+    r[j] = mlk_fqmul_c(r[j], 1441);
+  }
+  for (len = 2; len <= 128; len <<= 1)
+  {
+    for (start = 0; start < MLKEM_N; start += 2 * len)
+    {
+      const int16_t zeta = zetas[k--];
+      for (j = start; j < start + len; j++)
+      {
+        const int16_t t = r[j];
+        r[j] = mlk_barrett_reduce_c(t + r[j + len]);
+        r[j + len] = mlk_fqmul_c(r[j + len] - t, zeta);
+      }
+    }
+  }
+}
+
+void mlk_ntt_x86_64(int16_t *r)
+{
+  if (MLK_X86_64_LEVEL == MLK_X86_64_AVX2)
+  {
+    mlk_ntt_avx2(r);
+  }
+  else
+  {
+    mlk_ntt_c(r);
+  }
+}
+
+void mlk_intt_x86_64(int16_t *r)
+{
+  if (MLK_X86_64_LEVEL == MLK_X86_64_AVX2)
+  {
+    mlk_intt_avx2(r);
+  }
+  else
+  {
+    mlk_intt_c(r);
+  }
+}
+
+#else /* MLK_ARITH_BACKEND_X86_64 && !MLK_MULTILEVEL_BUILD_NO_SHARED */
+
+MLK_EMPTY_CU(x86_64_ntt_avx2)
+
+#endif /* MLK_ARITH_BACKEND_X86_64 && !MLK_MULTILEVEL_BUILD_NO_SHARED */
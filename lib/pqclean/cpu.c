@@ -0,0 +1,22 @@
+#include "cpu.h"
+
+int pqclean_level = -1;
+static int pqclean_cpu = -1;
+
+int pqclean_backend(int max) {
+    if (pqclean_cpu < 0) {
+        pqclean_cpu = PQCLEAN_C;
+#ifdef PQCLEAN_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            pqclean_cpu = PQCLEAN_AVX2;
+        }
+#endif
+    }
+    if (max >= 0) {
+        pqclean_level = max < pqclean_cpu ? max : pqclean_cpu;
+    } else if (pqclean_level < 0) {
+        pqclean_level = pqclean_cpu;
+    }
+    return pqclean_level;
+}
@@ -0,0 +1,22 @@
+#ifndef PQCLEAN_CPU_H
+#define PQCLEAN_CPU_H
+
+/* Runtime selection of the vectorized code paths: the portable C
+ * code is always built and used when the cpu lacks AVX2 */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+#define PQCLEAN_X86
+#endif
+
+#define PQCLEAN_C    0
+#define PQCLEAN_AVX2 1
+
+extern int pqclean_level;
+
+/* caps the backend used to max and returns the one in use, a
+ * negative max just returns it */
+int pqclean_backend(int max);
+
+#define PQCLEAN_LEVEL (pqclean_level >= 0 ? pqclean_level : pqclean_backend(-1))
+
+#endif
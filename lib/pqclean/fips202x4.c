@@ -0,0 +1,409 @@
+/* Four-way SHAKE128 and SHAKE256, used to sample the polynomials of
+ * a matrix or vector in parallel.
+ *
+ * The AVX2 permutation is the one of fips202.c run on vectors of the
+ * same lane of four states; without AVX2 the scalar permutation is
+ * applied to each state in turn. */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "fips202.h"
+#include "fips202x4.h"
+
+#define NROUNDS 24
+#define ROL(a, offset) (((a) << (offset)) ^ ((a) >> (64 - (offset))))
+
+#ifdef PQCLEAN_X86
+
+typedef uint64_t v4u64 __attribute__((vector_size(32)));
+
+#define LOAD4(s, i) ((v4u64){ (s)[i], (s)[25 + (i)], (s)[50 + (i)], (s)[75 + (i)] })
+#define STORE4(s, i, v) do { \
+        (s)[i] = (v)[0]; (s)[25 + (i)] = (v)[1]; \
+        (s)[50 + (i)] = (v)[2]; (s)[75 + (i)] = (v)[3]; } while (0)
+
+static const uint64_t KeccakF_RoundConstants[NROUNDS] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL,
+    0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL,
+    0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL,
+    0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL,
+    0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+__attribute__((target("avx2")))
+static void KeccakF1600x4_StatePermute_avx2(uint64_t *state) {
+    int round;
+
+    v4u64 Aba, Abe, Abi, Abo, Abu;
+    v4u64 Aga, Age, Agi, Ago, Agu;
+    v4u64 Aka, Ake, Aki, Ako, Aku;
+    v4u64 Ama, Ame, Ami, Amo, Amu;
+    v4u64 Asa, Ase, Asi, Aso, Asu;
+    v4u64 BCa, BCe, BCi, BCo, BCu;
+    v4u64 Da, De, Di, Do, Du;
+    v4u64 Eba, Ebe, Ebi, Ebo, Ebu;
+    v4u64 Ega, Ege, Egi, Ego, Egu;
+    v4u64 Eka, Eke, Eki, Eko, Eku;
+    v4u64 Ema, Eme, Emi, Emo, Emu;
+    v4u64 Esa, Ese, Esi, Eso, Esu;
+
+    // copyFromState(A, state)
+    Aba = LOAD4(state, 0);
+    Abe = LOAD4(state, 1);
+    Abi = LOAD4(state, 2);
+    Abo = LOAD4(state, 3);
+    Abu = LOAD4(state, 4);
+    Aga = LOAD4(state, 5);
+    Age = LOAD4(state, 6);
+    Agi = LOAD4(state, 7);
+    Ago = LOAD4(state, 8);
+    Agu = LOAD4(state, 9);
+    Aka = LOAD4(state, 10);
+    Ake = LOAD4(state, 11);
+    Aki = LOAD4(state, 12);
+    Ako = LOAD4(state, 13);
+    Aku = LOAD4(state, 14);
+    Ama = LOAD4(state, 15);
+    Ame = LOAD4(state, 16);
+    Ami = LOAD4(state, 17);
+    Amo = LOAD4(state, 18);
+    Amu = LOAD4(state, 19);
+    Asa = LOAD4(state, 20);
+    Ase = LOAD4(state, 21);
+    Asi = LOAD4(state, 22);
+    Aso = LOAD4(state, 23);
+    Asu = LOAD4(state, 24);
+
+    for (round = 0; round < NROUNDS; round += 2) {
+        //    prepareTheta
+        BCa = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+        BCe = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+        BCi = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+        BCo = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+        BCu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+
+        // thetaRhoPiChiIotaPrepareTheta(round  , A, E)
+        Da = BCu ^ ROL(BCe, 1);
+        De = BCa ^ ROL(BCi, 1);
+        Di = BCe ^ ROL(BCo, 1);
+        Do = BCi ^ ROL(BCu, 1);
+        Du = BCo ^ ROL(BCa, 1);
+
+        Aba ^= Da;
+        BCa = Aba;
+        Age ^= De;
+        BCe = ROL(Age, 44);
+        Aki ^= Di;
+        BCi = ROL(Aki, 43);
+        Amo ^= Do;
+        BCo = ROL(Amo, 21);
+        Asu ^= Du;
+        BCu = ROL(Asu, 14);
+        Eba = BCa ^ ((~BCe) & BCi);
+        Eba ^= KeccakF_RoundConstants[round];
+        Ebe = BCe ^ ((~BCi) & BCo);
+        Ebi = BCi ^ ((~BCo) & BCu);
+        Ebo = BCo ^ ((~BCu) & BCa);
+        Ebu = BCu ^ ((~BCa) & BCe);
+
+        Abo ^= Do;
+        BCa = ROL(Abo, 28);
+        Agu ^= Du;
+        BCe = ROL(Agu, 20);
+        Aka ^= Da;
+        BCi = ROL(Aka, 3);
+        Ame ^= De;
+        BCo = ROL(Ame, 45);
+        Asi ^= Di;
+        BCu = ROL(Asi, 61);
+        Ega = BCa ^ ((~BCe) & BCi);
+        Ege = BCe ^ ((~BCi) & BCo);
+        Egi = BCi ^ ((~BCo) & BCu);
+        Ego = BCo ^ ((~BCu) & BCa);
+        Egu = BCu ^ ((~BCa) & BCe);
+
+        Abe ^= De;
+        BCa = ROL(Abe, 1);
+        Agi ^= Di;
+        BCe = ROL(Agi, 6);
+        Ako ^= Do;
+        BCi = ROL(Ako, 25);
+        Amu ^= Du;
+        BCo = ROL(Amu, 8);
+        Asa ^= Da;
+        BCu = ROL(Asa, 18);
+        Eka = BCa ^ ((~BCe) & BCi);
+        Eke = BCe ^ ((~BCi) & BCo);
+        Eki = BCi ^ ((~BCo) & BCu);
+        Eko = BCo ^ ((~BCu) & BCa);
+        Eku = BCu ^ ((~BCa) & BCe);
+
+        Abu ^= Du;
+        BCa = ROL(Abu, 27);
+        Aga ^= Da;
+        BCe = ROL(Aga, 36);
+        Ake ^= De;
+        BCi = ROL(Ake, 10);
+        Ami ^= Di;
+        BCo = ROL(Ami, 15);
+        Aso ^= Do;
+        BCu = ROL(Aso, 56);
+        Ema = BCa ^ ((~BCe) & BCi);
+        Eme = BCe ^ ((~BCi) & BCo);
+        Emi = BCi ^ ((~BCo) & BCu);
+        Emo = BCo ^ ((~BCu) & BCa);
+        Emu = BCu ^ ((~BCa) & BCe);
+
+        Abi ^= Di;
+        BCa = ROL(Abi, 62);
+        Ago ^= Do;
+        BCe = ROL(Ago, 55);
+        Aku ^= Du;
+        BCi = ROL(Aku, 39);
+        Ama ^= Da;
+        BCo = ROL(Ama, 41);
+        Ase ^= De;
+        BCu = ROL(Ase, 2);
+        Esa = BCa ^ ((~BCe) & BCi);
+        Ese = BCe ^ ((~BCi) & BCo);
+        Esi = BCi ^ ((~BCo) & BCu);
+        Eso = BCo ^ ((~BCu) & BCa);
+        Esu = BCu ^ ((~BCa) & BCe);
+
+        //    prepareTheta
+        BCa = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+        BCe = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+        BCi = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+        BCo = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+        BCu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+
+        // thetaRhoPiChiIotaPrepareTheta(round+1, E, A)
+        Da = BCu ^ ROL(BCe, 1);
+        De = BCa ^ ROL(BCi, 1);
+        Di = BCe ^ ROL(BCo, 1);
+        Do = BCi ^ ROL(BCu, 1);
+        Du = BCo ^ ROL(BCa, 1);
+
+        Eba ^= Da;
+        BCa = Eba;
+        Ege ^= De;
+        BCe = ROL(Ege, 44);
+        Eki ^= Di;
+        BCi = ROL(Eki, 43);
+        Emo ^= Do;
+        BCo = ROL(Emo, 21);
+        Esu ^= Du;
+        BCu = ROL(Esu, 14);
+        Aba = BCa ^ ((~BCe) & BCi);
+        Aba ^= KeccakF_RoundConstants[round + 1];
+        Abe = BCe ^ ((~BCi) & BCo);
+        Abi = BCi ^ ((~BCo) & BCu);
+        Abo = BCo ^ ((~BCu) & BCa);
+        Abu = BCu ^ ((~BCa) & BCe);
+
+        Ebo ^= Do;
+        BCa = ROL(Ebo, 28);
+        Egu ^= Du;
+        BCe = ROL(Egu, 20);
+        Eka ^= Da;
+        BCi = ROL(Eka, 3);
+        Eme ^= De;
+        BCo = ROL(Eme, 45);
+        Esi ^= Di;
+        BCu = ROL(Esi, 61);
+        Aga = BCa ^ ((~BCe) & BCi);
+        Age = BCe ^ ((~BCi) & BCo);
+        Agi = BCi ^ ((~BCo) & BCu);
+        Ago = BCo ^ ((~BCu) & BCa);
+        Agu = BCu ^ ((~BCa) & BCe);
+
+        Ebe ^= De;
+        BCa = ROL(Ebe, 1);
+        Egi ^= Di;
+        BCe = ROL(Egi, 6);
+        Eko ^= Do;
+        BCi = ROL(Eko, 25);
+        Emu ^= Du;
+        BCo = ROL(Emu, 8);
+        Esa ^= Da;
+        BCu = ROL(Esa, 18);
+        Aka = BCa ^ ((~BCe) & BCi);
+        Ake = BCe ^ ((~BCi) & BCo);
+        Aki = BCi ^ ((~BCo) & BCu);
+        Ako = BCo ^ ((~BCu) & BCa);
+        Aku = BCu ^ ((~BCa) & BCe);
+
+        Ebu ^= Du;
+        BCa = ROL(Ebu, 27);
+        Ega ^= Da;
+        BCe = ROL(Ega, 36);
+        Eke ^= De;
+        BCi = ROL(Eke, 10);
+        Emi ^= Di;
+        BCo = ROL(Emi, 15);
+        Eso ^= Do;
+        BCu = ROL(Eso, 56);
+        Ama = BCa ^ ((~BCe) & BCi);
+        Ame = BCe ^ ((~BCi) & BCo);
+        Ami = BCi ^ ((~BCo) & BCu);
+        Amo = BCo ^ ((~BCu) & BCa);
+        Amu = BCu ^ ((~BCa) & BCe);
+
+        Ebi ^= Di;
+        BCa = ROL(Ebi, 62);
+        Ego ^= Do;
+        BCe = ROL(Ego, 55);
+        Eku ^= Du;
+        BCi = ROL(Eku, 39);
+        Ema ^= Da;
+        BCo = ROL(Ema, 41);
+        Ese ^= De;
+        BCu = ROL(Ese, 2);
+        Asa = BCa ^ ((~BCe) & BCi);
+        Ase = BCe ^ ((~BCi) & BCo);
+        Asi = BCi ^ ((~BCo) & BCu);
+        Aso = BCo ^ ((~BCu) & BCa);
+        Asu = BCu ^ ((~BCa) & BCe);
+    }
+
+    // copyToState(state, A)
+    STORE4(state, 0, Aba);
+    STORE4(state, 1, Abe);
+    STORE4(state, 2, Abi);
+    STORE4(state, 3, Abo);
+    STORE4(state, 4, Abu);
+    STORE4(state, 5, Aga);
+    STORE4(state, 6, Age);
+    STORE4(state, 7, Agi);
+    STORE4(state, 8, Ago);
+    STORE4(state, 9, Agu);
+    STORE4(state, 10, Aka);
+    STORE4(state, 11, Ake);
+    STORE4(state, 12, Aki);
+    STORE4(state, 13, Ako);
+    STORE4(state, 14, Aku);
+    STORE4(state, 15, Ama);
+    STORE4(state, 16, Ame);
+    STORE4(state, 17, Ami);
+    STORE4(state, 18, Amo);
+    STORE4(state, 19, Amu);
+    STORE4(state, 20, Asa);
+    STORE4(state, 21, Ase);
+    STORE4(state, 22, Asi);
+    STORE4(state, 23, Aso);
+    STORE4(state, 24, Asu);}
+
+#endif
+
+void KeccakF1600x4_StatePermute(uint64_t *s) {
+#ifdef PQCLEAN_X86
+    if (PQCLEAN_LEVEL == PQCLEAN_AVX2) {
+        KeccakF1600x4_StatePermute_avx2(s);
+        return;
+    }
+#endif
+    KeccakF1600_StatePermute(s);
+    KeccakF1600_StatePermute(s + 25);
+    KeccakF1600_StatePermute(s + 50);
+    KeccakF1600_StatePermute(s + 75);
+}
+
+static uint64_t load64(const uint8_t *x) {
+    uint64_t r = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        r |= (uint64_t)x[i] << 8 * i;
+    }
+
+    return r;
+}
+
+static void store64(uint8_t *x, uint64_t u) {
+    for (size_t i = 0; i < 8; ++i) {
+        x[i] = (uint8_t) (u >> 8 * i);
+    }
+}
+
+static void keccakx4_absorb_once(uint64_t *s, uint32_t r,
+                                 const uint8_t *in[4], size_t inlen,
+                                 uint8_t p) {
+    size_t i, j, pos = 0;
+    uint8_t t[200];
+
+    memset(s, 0, 100 * sizeof(uint64_t));
+    while (inlen >= r) {
+        for (j = 0; j < 4; ++j) {
+            for (i = 0; i < r / 8; ++i) {
+                s[25 * j + i] ^= load64(in[j] + pos + 8 * i);
+            }
+        }
+        KeccakF1600x4_StatePermute(s);
+        inlen -= r;
+        pos += r;
+    }
+
+    for (j = 0; j < 4; ++j) {
+        memset(t, 0, r);
+        memcpy(t, in[j] + pos, inlen);
+        t[inlen] = p;
+        t[r - 1] |= 128;
+        for (i = 0; i < r / 8; ++i) {
+            s[25 * j + i] ^= load64(t + 8 * i);
+        }
+    }
+}
+
+static void keccakx4_squeezeblocks(uint8_t *out[4], size_t nblocks,
+                                   uint64_t *s, uint32_t r) {
+    size_t i, j, pos = 0;
+
+    while (nblocks > 0) {
+        KeccakF1600x4_StatePermute(s);
+        for (j = 0; j < 4; ++j) {
+            for (i = 0; i < r / 8; ++i) {
+                store64(out[j] + pos + 8 * i, s[25 * j + i]);
+            }
+        }
+        pos += r;
+        nblocks--;
+    }
+}
+
+void shake128x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3,
+                            size_t inlen) {
+    const uint8_t *in[4] = { in0, in1, in2, in3 };
+    keccakx4_absorb_once(state->s, SHAKE128_RATE, in, inlen, 0x1F);
+}
+
+void shake128x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state) {
+    uint8_t *out[4] = { out0, out1, out2, out3 };
+    keccakx4_squeezeblocks(out, nblocks, state->s, SHAKE128_RATE);
+}
+
+void shake256x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3,
+                            size_t inlen) {
+    const uint8_t *in[4] = { in0, in1, in2, in3 };
+    keccakx4_absorb_once(state->s, SHAKE256_RATE, in, inlen, 0x1F);
+}
+
+void shake256x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state) {
+    uint8_t *out[4] = { out0, out1, out2, out3 };
+    keccakx4_squeezeblocks(out, nblocks, state->s, SHAKE256_RATE);
+}
@@ -0,0 +1,38 @@
+#ifndef FIPS202X4_H
+#define FIPS202X4_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fips202.h"
+
+// Four independent Keccak states, lanes of state i are s[25*i .. 25*i+24]
+typedef struct {
+    uint64_t s[100];
+} keccakx4_state;
+
+/* Applies the permutation to the four states, on AVX2 when the cpu
+ * has it and the PQCLEAN_AVX2 backend is selected (see cpu.h) */
+void KeccakF1600x4_StatePermute(uint64_t *s);
+
+/* Absorb four inputs of the same length into four SHAKE states,
+ * output is the same of four calls to shake*_absorb_once */
+void shake128x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3,
+                            size_t inlen);
+
+void shake128x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state);
+
+void shake256x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3,
+                            size_t inlen);
+
+void shake256x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state);
+
+#endif
@@ -2,6 +2,11 @@
 #include "params.h"
 #include "ntt.h"
 #include "reduce.h"
+#include "cpu.h"
+
+#ifdef PQCLEAN_X86
+#include <immintrin.h>
+#endif
 
 static const int32_t zetas[N] = {
          0,    25847, -2608894,  -518909,   237124,  -777960,  -876248,   466468,
@@ -38,6 +43,144 @@ static const int32_t zetas[N] = {
    -554416,  3919660,   -48306, -1362209,  3937738,  1400424,  -846154,  1976782
 };
 
+#ifdef PQCLEAN_X86
+/*************************************************
+* AVX2 transforms, on 8 coefficients per vector. They compute the
+* very same Montgomery reductions of the C code, so outputs are
+* identical. The last three layers butterfly coefficients inside a
+* pair of vectors, rearranged so that each butterfly has its two
+* inputs at the same position of two vectors.
+**************************************************/
+#define AVX2 __attribute__((target("avx2")))
+
+// montgomery_reduce(a*b) on each lane
+static inline AVX2 __m256i mont_mul(__m256i a, __m256i b) {
+  const __m256i q = _mm256_set1_epi32(Q);
+  const __m256i qinv = _mm256_set1_epi32(QINV);
+  __m256i pe, po, t, te, to;
+  pe = _mm256_mul_epi32(a, b);
+  po = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+  t = _mm256_mullo_epi32(_mm256_mullo_epi32(a, b), qinv);
+  te = _mm256_mul_epi32(t, q);
+  to = _mm256_mul_epi32(_mm256_srli_epi64(t, 32), q);
+  pe = _mm256_sub_epi64(pe, te);
+  po = _mm256_sub_epi64(po, to);
+  return _mm256_blend_epi32(_mm256_srli_epi64(pe, 32), po, 0xAA);
+}
+
+#define FWD(x, y, z) do { \
+    __m256i t_ = mont_mul(z, y); \
+    y = _mm256_sub_epi32(x, t_); \
+    x = _mm256_add_epi32(x, t_); } while(0)
+
+#define INV(x, y, z) do { \
+    __m256i t_ = x; \
+    x = _mm256_add_epi32(t_, y); \
+    y = mont_mul(z, _mm256_sub_epi32(t_, y)); } while(0)
+
+// split a pair of vectors in the inputs of butterflies of length
+// 4, 2 and 1, and merge them back
+#define SPLIT4(a, b, x, y) do { \
+    x = _mm256_permute2x128_si256(a, b, 0x20); \
+    y = _mm256_permute2x128_si256(a, b, 0x31); } while(0)
+#define SPLIT2(a, b, x, y) do { \
+    x = _mm256_unpacklo_epi64(a, b); \
+    y = _mm256_unpackhi_epi64(a, b); } while(0)
+#define SPLIT1(a, b, x, y) do { \
+    x = _mm256_blend_epi32(a, _mm256_slli_epi64(b, 32), 0xAA); \
+    y = _mm256_blend_epi32(_mm256_srli_epi64(a, 32), b, 0xAA); } while(0)
+
+// twiddles of the butterflies of a split pair, picked from 8 zetas
+static inline AVX2 __m256i zetas8(int base, __m256i idx) {
+  return _mm256_permutevar8x32_epi32(
+    _mm256_loadu_si256((const __m256i*)&zetas[base]), idx);
+}
+
+static AVX2 void ntt_avx2(int32_t a[N]) {
+  __m256i v[32], x, y;
+  const __m256i idx4 = _mm256_setr_epi32(0,0,0,0,1,1,1,1);
+  const __m256i idx2 = _mm256_setr_epi32(0,0,2,2,1,1,3,3);
+  const __m256i idx1 = _mm256_setr_epi32(0,4,1,5,2,6,3,7);
+  unsigned int i, j, s, k;
+
+  for(i = 0; i < 32; ++i)
+    v[i] = _mm256_loadu_si256((const __m256i*)&a[8*i]);
+
+  // layers of length 128 down to 8, across vectors
+  k = 0;
+  for(s = 16; s > 0; s >>= 1) {
+    for(i = 0; i < 32; i += 2*s) {
+      __m256i z = _mm256_set1_epi32(zetas[++k]);
+      for(j = i; j < i + s; ++j)
+        FWD(v[j], v[j + s], z);
+    }
+  }
+
+  // layers of length 4, 2 and 1 inside each pair of vectors
+  for(i = 0; i < 16; ++i) {
+    SPLIT4(v[2*i], v[2*i+1], x, y);
+    FWD(x, y, zetas8(32 + 2*i, idx4));
+    SPLIT4(x, y, v[2*i], v[2*i+1]);
+    SPLIT2(v[2*i], v[2*i+1], x, y);
+    FWD(x, y, zetas8(64 + 4*i, idx2));
+    SPLIT2(x, y, v[2*i], v[2*i+1]);
+    SPLIT1(v[2*i], v[2*i+1], x, y);
+    FWD(x, y, zetas8(128 + 8*i, idx1));
+    SPLIT1(x, y, v[2*i], v[2*i+1]);
+  }
+
+  for(i = 0; i < 32; ++i)
+    _mm256_storeu_si256((__m256i*)&a[8*i], v[i]);
+}
+
+static AVX2 void invntt_avx2(int32_t a[N]) {
+  __m256i v[32], x, y;
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i f = _mm256_set1_epi32(41978);
+  const __m256i idx1 = _mm256_setr_epi32(7,3,6,2,5,1,4,0);
+  const __m256i idx2 = _mm256_setr_epi32(3,3,1,1,2,2,0,0);
+  const __m256i idx4 = _mm256_setr_epi32(1,1,1,1,0,0,0,0);
+  unsigned int i, j, s, k;
+
+  for(i = 0; i < 32; ++i)
+    v[i] = _mm256_loadu_si256((const __m256i*)&a[8*i]);
+
+  // layers of length 1, 2 and 4 inside each pair of vectors
+  for(i = 0; i < 16; ++i) {
+    SPLIT1(v[2*i], v[2*i+1], x, y);
+    INV(x, y, _mm256_sub_epi32(zero, zetas8(248 - 8*i, idx1)));
+    SPLIT1(x, y, v[2*i], v[2*i+1]);
+    SPLIT2(v[2*i], v[2*i+1], x, y);
+    INV(x, y, _mm256_sub_epi32(zero, zetas8(124 - 4*i, idx2)));
+    SPLIT2(x, y, v[2*i], v[2*i+1]);
+    SPLIT4(v[2*i], v[2*i+1], x, y);
+    INV(x, y, _mm256_sub_epi32(zero, zetas8(62 - 2*i, idx4)));
+    SPLIT4(x, y, v[2*i], v[2*i+1]);
+  }
+
+  // layers of length 8 up to 128, across vectors
+  k = 32;
+  for(s = 1; s < 32; s <<= 1) {
+    for(i = 0; i < 32; i += 2*s) {
+      __m256i z = _mm256_set1_epi32(-zetas[--k]);
+      for(j = i; j < i + s; ++j)
+        INV(v[j], v[j + s], z);
+    }
+  }
+
+  for(i = 0; i < 32; ++i)
+    _mm256_storeu_si256((__m256i*)&a[8*i], mont_mul(f, v[i]));
+}
+
+AVX2 void pointwise_avx2(int32_t c[N], const int32_t a[N], const int32_t b[N]) {
+  unsigned int i;
+  for(i = 0; i < N; i += 8)
+    _mm256_storeu_si256((__m256i*)&c[i],
+      mont_mul(_mm256_loadu_si256((const __m256i*)&a[i]),
+               _mm256_loadu_si256((const __m256i*)&b[i])));
+}
+#endif
+
 /*************************************************
 * Name:        ntt
 *
@@ -50,6 +193,13 @@ void ntt(int32_t a[N]) {
   unsigned int len, start, j, k;
   int32_t zeta, t;
 
+#ifdef PQCLEAN_X86
+  if(PQCLEAN_LEVEL == PQCLEAN_AVX2) {
+    ntt_avx2(a);
+    return;
+  }
+#endif
+
   k = 0;
   for(len = 128; len > 0; len >>= 1) {
     for(start = 0; start < N; start = j + len) {
@@ -79,6 +229,13 @@ void invntt_tomont(int32_t a[N]) {
   int32_t t, zeta;
   const int32_t f = 41978; // mont^2/256
 
+#ifdef PQCLEAN_X86
+  if(PQCLEAN_LEVEL == PQCLEAN_AVX2) {
+    invntt_avx2(a);
+    return;
+  }
+#endif
+
   k = 256;
   for(len = 1; len < N; len <<= 1) {
     for(start = 0; start < N; start = j + len) {
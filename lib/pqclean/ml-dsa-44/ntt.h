@@ -10,4 +10,8 @@ void ntt(int32_t a[N]);
 #define invntt_tomont DILITHIUM_NAMESPACE(invntt_tomont)
 void invntt_tomont(int32_t a[N]);
 
+// montgomery_reduce(a*b) of each coefficient, AVX2 backend only
+#define pointwise_avx2 DILITHIUM_NAMESPACE(pointwise_avx2)
+void pointwise_avx2(int32_t c[N], const int32_t a[N], const int32_t b[N]);
+
 #endif
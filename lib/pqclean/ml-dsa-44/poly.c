@@ -5,6 +5,8 @@
 #include "reduce.h"
 #include "rounding.h"
 #include "symmetric.h"
+#include "fips202x4.h"
+#include "cpu.h"
 
 #ifdef DBENCH
 #include "test/cpucycles.h"
@@ -159,6 +161,13 @@ void poly_pointwise_montgomery(poly *c, const poly *a, const poly *b) {
   unsigned int i;
   DBENCH_START();
 
+#ifdef PQCLEAN_X86
+  if(PQCLEAN_LEVEL == PQCLEAN_AVX2) {
+    pointwise_avx2(c->coeffs, a->coeffs, b->coeffs);
+    DBENCH_STOP(*tmul);
+    return;
+  }
+#endif
   for(i = 0; i < N; ++i)
     c->coeffs[i] = montgomery_reduce((int64_t)a->coeffs[i] * b->coeffs[i]);
 
@@ -479,6 +488,135 @@ void poly_uniform_gamma1(poly *a,
   polyz_unpack(a, buf);
 }
 
+/*************************************************
+* Name:        poly_uniform_4x
+*
+* Description: Same as four calls to poly_uniform, sampling the
+*              polynomials from the four-way SHAKE128
+*
+* Arguments:   - poly *a0, *a1, *a2, *a3: pointers to output polynomials
+*              - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+*              - uint16_t nonce0..3: 2-byte nonces
+**************************************************/
+void poly_uniform_4x(poly *a0, poly *a1, poly *a2, poly *a3,
+                     const uint8_t seed[SEEDBYTES],
+                     uint16_t nonce0, uint16_t nonce1,
+                     uint16_t nonce2, uint16_t nonce3)
+{
+  unsigned int i, j, off, ctr[4];
+  unsigned int buflen = POLY_UNIFORM_NBLOCKS*STREAM128_BLOCKBYTES;
+  uint8_t buf[4][POLY_UNIFORM_NBLOCKS*STREAM128_BLOCKBYTES + 2];
+  uint8_t in[4][SEEDBYTES + 2];
+  poly *a[4] = { a0, a1, a2, a3 };
+  const uint16_t nonce[4] = { nonce0, nonce1, nonce2, nonce3 };
+  keccakx4_state state;
+
+  for(j = 0; j < 4; ++j) {
+    for(i = 0; i < SEEDBYTES; ++i)
+      in[j][i] = seed[i];
+    in[j][SEEDBYTES] = nonce[j];
+    in[j][SEEDBYTES + 1] = nonce[j] >> 8;
+  }
+  shake128x4_absorb_once(&state, in[0], in[1], in[2], in[3], SEEDBYTES + 2);
+  shake128x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3],
+                           POLY_UNIFORM_NBLOCKS, &state);
+
+  for(j = 0; j < 4; ++j)
+    ctr[j] = rej_uniform(a[j]->coeffs, N, buf[j], buflen);
+
+  while(ctr[0] < N || ctr[1] < N || ctr[2] < N || ctr[3] < N) {
+    off = buflen % 3;
+    for(j = 0; j < 4; ++j)
+      for(i = 0; i < off; ++i)
+        buf[j][i] = buf[j][buflen - off + i];
+
+    shake128x4_squeezeblocks(buf[0] + off, buf[1] + off, buf[2] + off,
+                             buf[3] + off, 1, &state);
+    buflen = STREAM128_BLOCKBYTES + off;
+    for(j = 0; j < 4; ++j)
+      ctr[j] += rej_uniform(a[j]->coeffs + ctr[j], N - ctr[j], buf[j], buflen);
+  }
+}
+
+/*************************************************
+* Name:        poly_uniform_eta_4x
+*
+* Description: Same as four calls to poly_uniform_eta, sampling the
+*              polynomials from the four-way SHAKE256
+*
+* Arguments:   - poly *a0, *a1, *a2, *a3: pointers to output polynomials
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce0..3: 2-byte nonces
+**************************************************/
+void poly_uniform_eta_4x(poly *a0, poly *a1, poly *a2, poly *a3,
+                         const uint8_t seed[CRHBYTES],
+                         uint16_t nonce0, uint16_t nonce1,
+                         uint16_t nonce2, uint16_t nonce3)
+{
+  unsigned int i, j, ctr[4];
+  uint8_t buf[4][POLY_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES];
+  uint8_t in[4][CRHBYTES + 2];
+  poly *a[4] = { a0, a1, a2, a3 };
+  const uint16_t nonce[4] = { nonce0, nonce1, nonce2, nonce3 };
+  keccakx4_state state;
+
+  for(j = 0; j < 4; ++j) {
+    for(i = 0; i < CRHBYTES; ++i)
+      in[j][i] = seed[i];
+    in[j][CRHBYTES] = nonce[j];
+    in[j][CRHBYTES + 1] = nonce[j] >> 8;
+  }
+  shake256x4_absorb_once(&state, in[0], in[1], in[2], in[3], CRHBYTES + 2);
+  shake256x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3],
+                           POLY_UNIFORM_ETA_NBLOCKS, &state);
+
+  for(j = 0; j < 4; ++j)
+    ctr[j] = rej_eta(a[j]->coeffs, N, buf[j],
+                     POLY_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES);
+
+  while(ctr[0] < N || ctr[1] < N || ctr[2] < N || ctr[3] < N) {
+    shake256x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], 1, &state);
+    for(j = 0; j < 4; ++j)
+      ctr[j] += rej_eta(a[j]->coeffs + ctr[j], N - ctr[j], buf[j],
+                        STREAM256_BLOCKBYTES);
+  }
+}
+
+/*************************************************
+* Name:        poly_uniform_gamma1_4x
+*
+* Description: Same as four calls to poly_uniform_gamma1, sampling the
+*              polynomials from the four-way SHAKE256
+*
+* Arguments:   - poly *a0, *a1, *a2, *a3: pointers to output polynomials
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce0..3: 16-bit nonces
+**************************************************/
+void poly_uniform_gamma1_4x(poly *a0, poly *a1, poly *a2, poly *a3,
+                            const uint8_t seed[CRHBYTES],
+                            uint16_t nonce0, uint16_t nonce1,
+                            uint16_t nonce2, uint16_t nonce3)
+{
+  unsigned int i, j;
+  uint8_t buf[4][POLY_UNIFORM_GAMMA1_NBLOCKS*STREAM256_BLOCKBYTES];
+  uint8_t in[4][CRHBYTES + 2];
+  poly *a[4] = { a0, a1, a2, a3 };
+  const uint16_t nonce[4] = { nonce0, nonce1, nonce2, nonce3 };
+  keccakx4_state state;
+
+  for(j = 0; j < 4; ++j) {
+    for(i = 0; i < CRHBYTES; ++i)
+      in[j][i] = seed[i];
+    in[j][CRHBYTES] = nonce[j];
+    in[j][CRHBYTES + 1] = nonce[j] >> 8;
+  }
+  shake256x4_absorb_once(&state, in[0], in[1], in[2], in[3], CRHBYTES + 2);
+  shake256x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3],
+                           POLY_UNIFORM_GAMMA1_NBLOCKS, &state);
+  for(j = 0; j < 4; ++j)
+    polyz_unpack(a[j], buf[j]);
+}
+
 /*************************************************
 * Name:        challenge
 *
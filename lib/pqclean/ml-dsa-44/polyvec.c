@@ -2,6 +2,7 @@
 #include "params.h"
 #include "polyvec.h"
 #include "poly.h"
+#include "cpu.h"
 
 /*************************************************
 * Name:        expand_mat
@@ -16,6 +17,15 @@
 void polyvec_matrix_expand(polyvecl mat[K], const uint8_t rho[SEEDBYTES]) {
   unsigned int i, j;
 
+#if defined(PQCLEAN_X86) && L == 4
+  if(PQCLEAN_LEVEL == PQCLEAN_AVX2) {
+    for(i = 0; i < K; ++i)
+      poly_uniform_4x(&mat[i].vec[0], &mat[i].vec[1], &mat[i].vec[2],
+                      &mat[i].vec[3], rho, (i << 8) + 0, (i << 8) + 1,
+                      (i << 8) + 2, (i << 8) + 3);
+    return;
+  }
+#endif
   for(i = 0; i < K; ++i)
     for(j = 0; j < L; ++j)
       poly_uniform(&mat[i].vec[j], rho, (i << 8) + j);
@@ -35,6 +45,13 @@ void polyvec_matrix_pointwise_montgomery(polyveck *t, const polyvecl mat[K], con
 void polyvecl_uniform_eta(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t nonce) {
   unsigned int i;
 
+#if defined(PQCLEAN_X86) && L == 4
+  if(PQCLEAN_LEVEL == PQCLEAN_AVX2) {
+    poly_uniform_eta_4x(&v->vec[0], &v->vec[1], &v->vec[2], &v->vec[3],
+                        seed, nonce, nonce + 1, nonce + 2, nonce + 3);
+    return;
+  }
+#endif
   for(i = 0; i < L; ++i)
     poly_uniform_eta(&v->vec[i], seed, nonce++);
 }
@@ -42,6 +59,13 @@ void polyvecl_uniform_eta(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t no
 void polyvecl_uniform_gamma1(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t nonce) {
   unsigned int i;
 
+#if defined(PQCLEAN_X86) && L == 4
+  if(PQCLEAN_LEVEL == PQCLEAN_AVX2) {
+    poly_uniform_gamma1_4x(&v->vec[0], &v->vec[1], &v->vec[2], &v->vec[3],
+                           seed, L*nonce, L*nonce + 1, L*nonce + 2, L*nonce + 3);
+    return;
+  }
+#endif
   for(i = 0; i < L; ++i)
     poly_uniform_gamma1(&v->vec[i], seed, L*nonce + i);
 }
@@ -153,6 +177,13 @@ int polyvecl_chknorm(const polyvecl *v, int32_t bound)  {
 void polyveck_uniform_eta(polyveck *v, const uint8_t seed[CRHBYTES], uint16_t nonce) {
   unsigned int i;
 
+#if defined(PQCLEAN_X86) && K == 4
+  if(PQCLEAN_LEVEL == PQCLEAN_AVX2) {
+    poly_uniform_eta_4x(&v->vec[0], &v->vec[1], &v->vec[2], &v->vec[3],
+                        seed, nonce, nonce + 1, nonce + 2, nonce + 3);
+    return;
+  }
+#endif
   for(i = 0; i < K; ++i)
     poly_uniform_eta(&v->vec[i], seed, nonce++);
 }
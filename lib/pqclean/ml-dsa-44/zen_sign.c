@@ -196,3 +196,106 @@ rej:
   *siglen = CRYPTO_BYTES;
   return 0;
 }
+
+/*************************************************
+* Name:        pqcrystals_ml_dsa_44_zen_verify_batch
+*
+* Description: Verifies n signatures by the same public key. The
+*              public key is unpacked and its matrix A, t1*2^d in the
+*              NTT domain and H(rho, t1) are computed once for all.
+*
+* Arguments:   - const uint8_t *pk: pointer to bit-packed public key
+*              - size_t n: number of signatures
+*              - const uint8_t **sigs: pointers to the signatures
+*              - const size_t *siglens: lengths of the signatures
+*              - const uint8_t **ms: pointers to the messages
+*              - const size_t *mlens: lengths of the messages
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - int *valid: set to 1 for each valid signature, 0 else
+*
+* Returns 0 if all signatures are valid and -1 otherwise
+**************************************************/
+int pqcrystals_ml_dsa_44_zen_verify_batch(const uint8_t *pk, size_t n,
+                                          const uint8_t **sigs, const size_t *siglens,
+                                          const uint8_t **ms, const size_t *mlens,
+                                          const uint8_t *ctx, size_t ctxlen,
+                                          int *valid)
+{
+  size_t i, j;
+  int res = 0;
+  uint8_t buf[K*POLYW1_PACKEDBYTES];
+  uint8_t rho[SEEDBYTES];
+  uint8_t tr[TRBYTES];
+  uint8_t mu[CRHBYTES];
+  uint8_t c[CTILDEBYTES];
+  uint8_t c2[CTILDEBYTES];
+  poly cp;
+  polyvecl mat[K], z;
+  polyveck t1, ct1, w1, h;
+  shake256incctx state;
+
+  for(i = 0; i < n; i++)
+    valid[i] = 0;
+  if(ctxlen > 255)
+    return -1;
+
+  unpack_pk(rho, &t1, pk);
+  shake256(tr, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+  polyvec_matrix_expand(mat, rho);
+  polyveck_shiftl(&t1);
+  polyveck_ntt(&t1);
+  shake256_inc_init(&state);
+
+  for(i = 0; i < n; i++) {
+    if(siglens[i] != CRYPTO_BYTES || unpack_sig(c, &z, &h, sigs[i])
+       || polyvecl_chknorm(&z, GAMMA1 - BETA)) {
+      res = -1;
+      continue;
+    }
+
+    /* Compute CRH(H(rho, t1), msg) */
+    shake256_inc_ctx_reset(&state);
+    shake256_inc_absorb(&state, tr, TRBYTES);
+    mu[0] = 0;
+    mu[1] = ctxlen;
+    shake256_inc_absorb(&state, mu, 2);
+    shake256_inc_absorb(&state, ctx, ctxlen);
+    shake256_inc_absorb(&state, ms[i], mlens[i]);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(mu, CRHBYTES, &state);
+
+    /* Matrix-vector multiplication; compute Az - c2^dt1 */
+    poly_challenge(&cp, c);
+    polyvecl_ntt(&z);
+    polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+
+    poly_ntt(&cp);
+    polyveck_pointwise_poly_montgomery(&ct1, &cp, &t1);
+
+    polyveck_sub(&w1, &w1, &ct1);
+    polyveck_reduce(&w1);
+    polyveck_invntt_tomont(&w1);
+
+    /* Reconstruct w1 */
+    polyveck_caddq(&w1);
+    polyveck_use_hint(&w1, &w1, &h);
+    polyveck_pack_w1(buf, &w1);
+
+    /* Call random oracle and verify challenge */
+    shake256_inc_ctx_reset(&state);
+    shake256_inc_absorb(&state, mu, CRHBYTES);
+    shake256_inc_absorb(&state, buf, K*POLYW1_PACKEDBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(c2, CTILDEBYTES, &state);
+    valid[i] = 1;
+    for(j = 0; j < CTILDEBYTES; ++j)
+      if(c[j] != c2[j])
+        valid[i] = 0;
+    if(!valid[i])
+      res = -1;
+  }
+
+  shake256_inc_ctx_release(&state);
+  return res;
+}
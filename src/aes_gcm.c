@@ -0,0 +1,491 @@
+/* This file is part of Zenroom (https://zenroom.dyne.org)
+ *
+ * Copyright (C) 2025 Dyne.org foundation
+ * designed, written and maintained by Denis Roio <jaromil@dyne.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <amcl.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+#define AES_X86 1
+#include <immintrin.h>
+#define AESNI __attribute__((target("aes,pclmul,sse4.1")))
+#endif
+
+#include "aes_gcm.h"
+
+// AES-GCM and AES-CTR on AES-NI and PCLMULQDQ when the cpu has them,
+// else on milagro's table based AES and bitwise GHASH. Both produce
+// the same bytes: the hardware path is constant time and runs the
+// counter mode 8 blocks at a time, hashing them with a single
+// reduction on the precomputed powers of H.
+
+static int aes_cpu = -1;
+static int aes_level = -1;
+
+int aes_backend(int max) {
+	if(aes_cpu < 0) {
+		aes_cpu = AES_MILAGRO;
+#ifdef AES_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("aes")
+		   && __builtin_cpu_supports("pclmul")
+		   && __builtin_cpu_supports("sse4.1"))
+			aes_cpu = AES_AESNI;
+#endif
+	}
+	if(max >= 0) aes_level = max < aes_cpu ? max : aes_cpu;
+	else if(aes_level < 0) aes_level = aes_cpu;
+	return aes_level;
+}
+
+#define AES_LEVEL (aes_level >= 0 ? aes_level : aes_backend(-1))
+
+// memset may be optimized away on memory not read anymore
+static void wipe(void *p, size_t len) {
+	volatile unsigned char *v = (volatile unsigned char*)p;
+	while(len--) *v++ = 0;
+}
+
+static inline uint32_t load32_be(const unsigned char *p) {
+	return ((uint32_t)p[0]<<24) | ((uint32_t)p[1]<<16)
+		| ((uint32_t)p[2]<<8) | (uint32_t)p[3];
+}
+
+static inline uint64_t load64_be(const unsigned char *p) {
+	return ((uint64_t)load32_be(p)<<32) | load32_be(p+4);
+}
+
+static inline void incr_be(unsigned char *c, int from) {
+	int i;
+	for(i=15; i>=from; i--) if(++c[i]) break;
+}
+
+#ifdef AES_X86
+
+#define X8(s) { s(0); s(1); s(2); s(3); s(4); s(5); s(6); s(7); }
+
+AESNI static inline __m128i bswap128(__m128i x) {
+	return _mm_shuffle_epi8(x, _mm_set_epi8(0,1,2,3,4,5,6,7,
+	                                        8,9,10,11,12,13,14,15));
+}
+
+AESNI static uint32_t aesni_subword(uint32_t w) {
+	// dword 0 of the result is SubWord of dword 1
+	__m128i x = _mm_aeskeygenassist_si128(_mm_set1_epi32((int)w), 0);
+	return (uint32_t)_mm_cvtsi128_si32(x);
+}
+
+// FIPS-197 key expansion, words are little endian so that the round
+// keys load straight into registers
+AESNI static int aesni_expand(unsigned char rk[15][16], const char *key, int nk) {
+	uint32_t w[60], t, rcon = 1;
+	int i, n = nk >> 2, nr = n + 6;
+	memcpy(w, key, nk);
+	for(i=n; i<4*(nr+1); i++) {
+		t = w[i-1];
+		if(i % n == 0) {
+			t = aesni_subword((t >> 8) | (t << 24)) ^ rcon;
+			rcon = (rcon << 1) ^ ((rcon >> 7) * 0x11b);
+		} else if(n > 6 && i % n == 4)
+			t = aesni_subword(t);
+		w[i] = w[i-n] ^ t;
+	}
+	memcpy(rk, w, 16*(nr+1));
+	wipe(w, sizeof(w));
+	return nr;
+}
+
+AESNI static inline void aesni_load(__m128i *k, unsigned char rk[15][16], int nr) {
+	int i;
+	for(i=0; i<=nr; i++) k[i] = _mm_loadu_si128((const __m128i*)rk[i]);
+}
+
+AESNI static inline __m128i aesni_block(__m128i b, const __m128i *k, int nr) {
+	int i;
+	b = _mm_xor_si128(b, k[0]);
+	for(i=1; i<nr; i++) b = _mm_aesenc_si128(b, k[i]);
+	return _mm_aesenclast_si128(b, k[nr]);
+}
+
+AESNI static inline void aesni_block8(__m128i *b, const __m128i *k, int nr) {
+	int i;
+	__m128i r = k[0];
+#define ROUND(j) b[j] = _mm_xor_si128(b[j], r)
+	X8(ROUND);
+#undef ROUND
+#define ROUND(j) b[j] = _mm_aesenc_si128(b[j], r)
+	for(i=1; i<nr; i++) {
+		r = k[i];
+		X8(ROUND);
+	}
+#undef ROUND
+	r = k[nr];
+#define ROUND(j) b[j] = _mm_aesenclast_si128(b[j], r)
+	X8(ROUND);
+#undef ROUND
+}
+
+// accumulates the unreduced 256 bit carry-less product of a and b
+AESNI static inline void clmul_acc(__m128i a, __m128i b,
+                                   __m128i *lo, __m128i *mid, __m128i *hi) {
+	*lo  = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+	*hi  = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+	*mid = _mm_xor_si128(*mid, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x01),
+	                                         _mm_clmulepi64_si128(a, b, 0x10)));
+}
+
+// reduces a product modulo x^128 + x^7 + x^2 + x + 1, operands are
+// bit reflected so the product is shifted left by one first (Gueron
+// and Kounavis, Intel carry-less multiplication white paper)
+AESNI static inline __m128i ghash_reduce(__m128i lo, __m128i mid, __m128i hi) {
+	__m128i t2, t3, t4, t5, t6, t7, t8, t9;
+	t3 = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+	t6 = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+	t7 = _mm_srli_epi32(t3, 31);
+	t8 = _mm_srli_epi32(t6, 31);
+	t3 = _mm_slli_epi32(t3, 1);
+	t6 = _mm_slli_epi32(t6, 1);
+	t9 = _mm_srli_si128(t7, 12);
+	t8 = _mm_slli_si128(t8, 4);
+	t7 = _mm_slli_si128(t7, 4);
+	t3 = _mm_or_si128(t3, t7);
+	t6 = _mm_or_si128(t6, t8);
+	t6 = _mm_or_si128(t6, t9);
+	t7 = _mm_slli_epi32(t3, 31);
+	t8 = _mm_slli_epi32(t3, 30);
+	t9 = _mm_slli_epi32(t3, 25);
+	t7 = _mm_xor_si128(t7, t8);
+	t7 = _mm_xor_si128(t7, t9);
+	t8 = _mm_srli_si128(t7, 4);
+	t7 = _mm_slli_si128(t7, 12);
+	t3 = _mm_xor_si128(t3, t7);
+	t2 = _mm_srli_epi32(t3, 1);
+	t4 = _mm_srli_epi32(t3, 2);
+	t5 = _mm_srli_epi32(t3, 7);
+	t2 = _mm_xor_si128(t2, t4);
+	t2 = _mm_xor_si128(t2, t5);
+	t2 = _mm_xor_si128(t2, t8);
+	t3 = _mm_xor_si128(t3, t2);
+	return _mm_xor_si128(t6, t3);
+}
+
+AESNI static inline __m128i gfmul(__m128i a, __m128i b) {
+	__m128i lo = _mm_setzero_si128(), mid = lo, hi = lo;
+	clmul_acc(a, b, &lo, &mid, &hi);
+	return ghash_reduce(lo, mid, hi);
+}
+
+// Y = (Y + X1) H^8 + X2 H^7 + ... + X8 H, x are byte reflected
+AESNI static inline __m128i ghash8(__m128i y, const __m128i *x, const __m128i *h) {
+	__m128i lo = _mm_setzero_si128(), mid = lo, hi = lo;
+	clmul_acc(_mm_xor_si128(y, x[0]), h[7], &lo, &mid, &hi);
+#define ACC(j) if(j) clmul_acc(x[j], h[7-j], &lo, &mid, &hi)
+	X8(ACC);
+#undef ACC
+	return ghash_reduce(lo, mid, hi);
+}
+
+// hashes len bytes, the last block padded with zeros
+AESNI static __m128i aesni_ghash(__m128i y, const __m128i *h,
+                                 const unsigned char *in, size_t len) {
+	__m128i x[8];
+	unsigned char last[16];
+	for(; len >= 128; len -= 128, in += 128) {
+#define LOAD(j) x[j] = bswap128(_mm_loadu_si128((const __m128i*)(in + 16*j)))
+		X8(LOAD);
+#undef LOAD
+		y = ghash8(y, x, h);
+	}
+	for(; len >= 16; len -= 16, in += 16)
+		y = gfmul(_mm_xor_si128(y, bswap128(_mm_loadu_si128((const __m128i*)in))), h[0]);
+	if(len) {
+		memset(last, 0, 16);
+		memcpy(last, in, len);
+		y = gfmul(_mm_xor_si128(y, bswap128(_mm_loadu_si128((const __m128i*)last))), h[0]);
+	}
+	return y;
+}
+
+AESNI static void aesni_gcm_init(aes_gcm *c, const char *key, int nk,
+                                 const char *iv, int niv,
+                                 const char *aad, int naad) {
+	__m128i k[15], h[8], y;
+	int i;
+	c->nr = aesni_expand(c->rk, key, nk);
+	aesni_load(k, c->rk, c->nr);
+	h[0] = bswap128(aesni_block(_mm_setzero_si128(), k, c->nr));
+	for(i=1; i<8; i++) h[i] = gfmul(h[i-1], h[0]);
+	for(i=0; i<8; i++) _mm_storeu_si128((__m128i*)c->hp[i], h[i]);
+	if(niv == 12) {
+		memcpy(c->j0, iv, 12);
+		c->j0[12] = c->j0[13] = c->j0[14] = 0;
+		c->j0[15] = 1;
+	} else {
+		y = aesni_ghash(_mm_setzero_si128(), h, (const unsigned char*)iv, niv);
+		y = gfmul(_mm_xor_si128(y, _mm_set_epi64x(0, (long long)niv << 3)), h[0]);
+		_mm_storeu_si128((__m128i*)c->j0, bswap128(y));
+	}
+	c->ctr = load32_be(c->j0 + 12) + 1;
+	y = aesni_ghash(_mm_setzero_si128(), h, (const unsigned char*)aad, naad);
+	_mm_storeu_si128((__m128i*)c->y, y);
+	c->alen = naad;
+}
+
+// keystream of the current counter block, then moves on
+AESNI static __m128i aesni_ctr_block(aes_gcm *c, const __m128i *k) {
+	__m128i b = _mm_loadu_si128((const __m128i*)c->j0);
+	b = _mm_insert_epi32(b, (int)__builtin_bswap32(c->ctr), 3);
+	c->ctr++;
+	return aesni_block(b, k, c->nr);
+}
+
+// hashes the ciphertext of a full or final partial block
+AESNI static __m128i aesni_gcm_flush(aes_gcm *c, __m128i y, const __m128i *h) {
+	unsigned char blk[16];
+	int i;
+	memset(blk, 0, 16);
+	for(i=0; i<c->used; i++)
+		blk[i] = c->decrypt ? c->pend[i] : c->pend[i] ^ c->ks[i];
+	y = gfmul(_mm_xor_si128(y, bswap128(_mm_loadu_si128((const __m128i*)blk))), h[0]);
+	c->used = 0;
+	return y;
+}
+
+AESNI static void aesni_gcm_update(aes_gcm *c, unsigned char *out,
+                                   const unsigned char *in, size_t len) {
+	__m128i k[15], h[8], y, b[8], x[8], base;
+	int i;
+	aesni_load(k, c->rk, c->nr);
+	for(i=0; i<8; i++) h[i] = _mm_loadu_si128((const __m128i*)c->hp[i]);
+	y = _mm_loadu_si128((const __m128i*)c->y);
+	c->clen += len;
+	// complete the block left by a previous update
+	if(c->used) {
+		for(; len && c->used < 16; len--) {
+			c->pend[c->used] = *in++;
+			*out++ = c->pend[c->used] ^ c->ks[c->used];
+			c->used++;
+		}
+		if(c->used == 16) y = aesni_gcm_flush(c, y, h);
+	}
+	base = _mm_loadu_si128((const __m128i*)c->j0);
+	for(; len >= 128; len -= 128, in += 128, out += 128) {
+#define CTR(j) b[j] = _mm_insert_epi32(base, (int)__builtin_bswap32(c->ctr + j), 3)
+		X8(CTR);
+#undef CTR
+		c->ctr += 8;
+		aesni_block8(b, k, c->nr);
+#define XOR(j) x[j] = _mm_loadu_si128((const __m128i*)(in + 16*j)); \
+		b[j] = _mm_xor_si128(b[j], x[j]); \
+		_mm_storeu_si128((__m128i*)(out + 16*j), b[j]); \
+		x[j] = bswap128(c->decrypt ? x[j] : b[j])
+		X8(XOR);
+#undef XOR
+		y = ghash8(y, x, h);
+	}
+	for(; len >= 16; len -= 16, in += 16, out += 16) {
+		x[0] = _mm_loadu_si128((const __m128i*)in);
+		b[0] = _mm_xor_si128(x[0], aesni_ctr_block(c, k));
+		_mm_storeu_si128((__m128i*)out, b[0]);
+		x[0] = bswap128(c->decrypt ? x[0] : b[0]);
+		y = gfmul(_mm_xor_si128(y, x[0]), h[0]);
+	}
+	if(len) {
+		_mm_storeu_si128((__m128i*)c->ks, aesni_ctr_block(c, k));
+		for(; c->used < (int)len; c->used++) {
+			c->pend[c->used] = in[c->used];
+			out[c->used] = c->pend[c->used] ^ c->ks[c->used];
+		}
+	}
+	_mm_storeu_si128((__m128i*)c->y, y);
+}
+
+AESNI static void aesni_gcm_final(aes_gcm *c, char *tag) {
+	__m128i k[15], h[1], y;
+	aesni_load(k, c->rk, c->nr);
+	h[0] = _mm_loadu_si128((const __m128i*)c->hp[0]);
+	y = _mm_loadu_si128((const __m128i*)c->y);
+	if(c->used) y = aesni_gcm_flush(c, y, h);
+	y = gfmul(_mm_xor_si128(y, _mm_set_epi64x((long long)(c->alen << 3),
+	                                          (long long)(c->clen << 3))), h[0]);
+	y = _mm_xor_si128(bswap128(y),
+	                  aesni_block(_mm_loadu_si128((const __m128i*)c->j0), k, c->nr));
+	_mm_storeu_si128((__m128i*)tag, y);
+}
+
+AESNI static void aesni_ctr(unsigned char *out, const unsigned char *in, size_t len,
+                            const char *key, int nk, const unsigned char *iv) {
+	unsigned char rk[15][16], ctr[16], ks[16];
+	__m128i k[15], b[8], one, sw, c;
+	int nr = aesni_expand(rk, key, nk);
+	size_t i;
+	aesni_load(k, rk, nr);
+	one = _mm_set_epi64x(0, 1);
+	sw = _mm_set_epi8(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15);
+	memcpy(ctr, iv, 16);
+	// counters are byte swapped to add 64 bit lanes, the rare carry
+	// into the upper half is left to the portable increment
+	while(len >= 128 && load64_be(ctr+8) <= UINT64_MAX - 8) {
+		c = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)ctr), sw);
+#define CTR(j) b[j] = _mm_shuffle_epi8(c, sw); c = _mm_add_epi64(c, one)
+		X8(CTR);
+#undef CTR
+		_mm_storeu_si128((__m128i*)ctr, _mm_shuffle_epi8(c, sw));
+		aesni_block8(b, k, nr);
+#define XOR(j) _mm_storeu_si128((__m128i*)(out + 16*j), \
+		_mm_xor_si128(b[j], _mm_loadu_si128((const __m128i*)(in + 16*j))))
+		X8(XOR);
+#undef XOR
+		len -= 128; in += 128; out += 128;
+	}
+	while(len) {
+		_mm_storeu_si128((__m128i*)ks,
+		                 aesni_block(_mm_loadu_si128((const __m128i*)ctr), k, nr));
+		incr_be(ctr, 0);
+		for(i=0; i<16 && len; i++, len--) *out++ = *in++ ^ ks[i];
+	}
+	wipe(rk, sizeof(rk));
+	wipe(ks, sizeof(ks));
+}
+
+#endif // AES_X86
+
+int aes_gcm_init(aes_gcm *c, int decrypt, const char *key, int nk,
+                 const char *iv, int niv, const char *aad, int naad) {
+	if(nk != 16 && nk != 24 && nk != 32) return 0;
+	c->decrypt = decrypt;
+	c->used = 0;
+	c->clen = 0;
+	c->hw = AES_LEVEL == AES_AESNI;
+#ifdef AES_X86
+	if(c->hw) {
+		aesni_gcm_init(c, key, nk, iv, niv, aad, naad);
+		return 1;
+	}
+#endif
+	GCM_init(&c->g, nk, (char*)key, niv, (char*)iv);
+	GCM_add_header(&c->g, (char*)aad, naad);
+	return 1;
+}
+
+// milagro only takes whole blocks until the last call, so a partial
+// block is output from its keystream and its input kept to be added
+// when complete
+static void milagro_gcm_add(aes_gcm *c, char *out, const char *in, int len) {
+	if(c->decrypt) GCM_add_cipher(&c->g, out, (char*)in, len);
+	else GCM_add_plain(&c->g, out, (char*)in, len);
+}
+
+void aes_gcm_update(aes_gcm *c, char *out, const char *in, int len) {
+	char blk[16];
+	int n;
+	if(len <= 0) return;
+#ifdef AES_X86
+	if(c->hw) {
+		aesni_gcm_update(c, (unsigned char*)out, (const unsigned char*)in, len);
+		return;
+	}
+#endif
+	if(c->used) {
+		for(; len && c->used < 16; len--) {
+			c->pend[c->used] = *in++;
+			*out++ = c->pend[c->used] ^ c->ks[c->used];
+			c->used++;
+		}
+		if(c->used < 16) return;
+		milagro_gcm_add(c, blk, (char*)c->pend, 16);
+		c->used = 0;
+	}
+	n = len & ~15;
+	if(n) milagro_gcm_add(c, out, in, n);
+	if(n == len) return;
+	// next counter block, as GCM_add_plain computes it
+	memcpy(c->ks, c->g.a.f, 16);
+	incr_be(c->ks, 12);
+	AES_ecb_encrypt(&c->g.a, c->ks);
+	for(; n < len; n++, c->used++) {
+		c->pend[c->used] = in[n];
+		out[n] = in[n] ^ c->ks[c->used];
+	}
+}
+
+void aes_gcm_final(aes_gcm *c, char *tag) {
+	char blk[16];
+#ifdef AES_X86
+	if(c->hw) aesni_gcm_final(c, tag);
+	else
+#endif
+	{
+		if(c->used) milagro_gcm_add(c, blk, (char*)c->pend, c->used);
+		GCM_finish(&c->g, tag);
+	}
+	c->used = 0;
+	wipe(c, sizeof(aes_gcm));
+}
+
+static int aes_gcm_oneshot(int decrypt, const octet *K, const octet *IV,
+                           const octet *H, const octet *in, octet *out,
+                           octet *T) {
+	aes_gcm c;
+	if(!aes_gcm_init(&c, decrypt, K->val, K->len, IV->val, IV->len,
+	                 H->val, H->len)) return 0;
+	aes_gcm_update(&c, out->val, in->val, in->len);
+	out->len = in->len;
+	aes_gcm_final(&c, T->val);
+	T->len = 16;
+	return 1;
+}
+
+int AES_GCM_encrypt(const octet *K, const octet *IV, const octet *H,
+                    const octet *P, octet *C, octet *T) {
+	return aes_gcm_oneshot(0, K, IV, H, P, C, T);
+}
+
+int AES_GCM_decrypt(const octet *K, const octet *IV, const octet *H,
+                    const octet *C, octet *P, octet *T) {
+	return aes_gcm_oneshot(1, K, IV, H, C, P, T);
+}
+
+int aes_ctr(char *out, const char *in, int len,
+            const char *key, int nk, const unsigned char *iv) {
+	amcl_aes a;
+	unsigned char ctr[16], ks[16];
+	int i;
+	if(nk != 16 && nk != 24 && nk != 32) return 0;
+	if(len <= 0) return 1;
+#ifdef AES_X86
+	if(AES_LEVEL == AES_AESNI) {
+		aesni_ctr((unsigned char*)out, (const unsigned char*)in, len, key, nk, iv);
+		return 1;
+	}
+#endif
+	memcpy(ctr, iv, 16);
+	AES_init(&a, ECB, nk, (char*)key, NULL);
+	while(len) {
+		memcpy(ks, ctr, 16);
+		AES_ecb_encrypt(&a, ks);
+		incr_be(ctr, 0);
+		for(i=0; i<16 && len; i++, len--) *out++ = *in++ ^ ks[i];
+	}
+	AES_end(&a);
+	wipe(ks, sizeof(ks));
+	return 1;
+}
@@ -0,0 +1,73 @@
+/* This file is part of Zenroom (https://zenroom.dyne.org)
+ *
+ * Copyright (C) 2025 Dyne.org foundation
+ * designed, written and maintained by Denis Roio <jaromil@dyne.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __AES_GCM_H__
+#define __AES_GCM_H__
+
+#include <stdint.h>
+#include <amcl.h>
+
+// AES backends, milagro is the portable one
+#define AES_MILAGRO 0
+#define AES_AESNI   1
+// caps the backend used to max and returns the one in use, a
+// negative max just returns it
+int aes_backend(int max);
+
+// AES-GCM state of an encryption or decryption, fed any number of
+// bytes at a time: keys are wiped by aes_gcm_final
+typedef struct {
+	int hw;       // AES-NI and PCLMULQDQ in use
+	int decrypt;
+	int used;     // bytes consumed of the current block keystream
+	unsigned char ks[16];   // keystream of the current block
+	unsigned char pend[16]; // input of the current block
+	// AES-NI state, GHASH values are byte reflected
+	int nr;
+	uint32_t ctr;
+	uint64_t alen, clen;
+	unsigned char rk[15][16];
+	unsigned char hp[8][16]; // H^1 .. H^8
+	unsigned char y[16];
+	unsigned char j0[16];
+	// milagro state
+	gcm g;
+} aes_gcm;
+
+// key must be 16, 24 or 32 bytes, returns 0 otherwise
+int aes_gcm_init(aes_gcm *c, int decrypt, const char *key, int nk,
+                 const char *iv, int niv, const char *aad, int naad);
+// out may be the same buffer as in
+void aes_gcm_update(aes_gcm *c, char *out, const char *in, int len);
+void aes_gcm_final(aes_gcm *c, char *tag);
+
+// one shot AES-GCM with the same arguments of milagro's
+// AES_GCM_ENCRYPT and AES_GCM_DECRYPT
+int AES_GCM_encrypt(const octet *K, const octet *IV, const octet *H,
+                    const octet *P, octet *C, octet *T);
+int AES_GCM_decrypt(const octet *K, const octet *IV, const octet *H,
+                    const octet *C, octet *P, octet *T);
+
+// AES-CTR over len bytes with a 128 bit big endian counter starting
+// from the 16 bytes block iv: key must be 16, 24 or 32 bytes
+int aes_ctr(char *out, const char *in, int len,
+            const char *key, int nk, const unsigned char *iv);
+
+#endif
@@ -81,18 +81,12 @@ int zenroom_hash_update(const char *hash_ctx,
     len = sizeof(hash512);
     sh = (char*)calloc(len, 1);
     hex2buf(sh, hash_ctx+1);
-    register int c;
-    for(c=0; c<buffer_size; c++) {
-      HASH512_process((hash512*)sh, buffer[c]);
-    }
+    HASH512_process_array((hash512*)sh, buffer, buffer_size);
   } else if(prefix==ZEN_SHA256) {
     len = sizeof(hash256);
     sh = (char*)calloc(len, 1);
     hex2buf(sh, hash_ctx+1);
-    register int c;
-    for(c=0; c<buffer_size; c++) {
-      HASH256_process((hash256*)sh, buffer[c]);
-    }
+    HASH256_process_array((hash256*)sh, buffer, buffer_size);
   } else {
     _err("%s :: invalid hash context prefix: %c", __func__, prefix);
 	return FAIL();
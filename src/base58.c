@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 #include <stdio.h>
@@ -25,135 +26,339 @@ const int8_t b58digits_map[] = {
 
 const char b58digits_ordered[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
-typedef uint64_t b58_maxint_t;
-typedef uint32_t b58_almostmaxint_t;
-#define b58_almostmaxint_bits (sizeof(b58_almostmaxint_t) * 8)
-static const b58_almostmaxint_t b58_almostmaxint_mask = ((((b58_maxint_t)1) << b58_almostmaxint_bits) - 1);
+/*
+ * Conversions run on 32 bit limbs: binary values in base 2^32 and
+ * base58 values in base 58^5, five digits per limb. Short values use
+ * the schoolbook Horner loop, which is quadratic but moves 4 bytes
+ * and 5 digits per step. Longer ones are split in two at a power of
+ * two limbs and recombined as hi * B^(2^k) + lo, with the powers of
+ * the source base precomputed in the target base by squaring and
+ * multiplied with Karatsuba, so large conversions are subquadratic.
+ */
+
+#define B58_LIMB 656356768u   // 58^5
+#define B58_HORNER 48         // max source limbs converted by Horner
+#define B58_KARATSUBA 32      // min limbs multiplied by Karatsuba
+#define B58_POWERS 32
+#define B58_HORNER_OUT (B58_HORNER + (B58_HORNER >> 3) + 2)
+
+typedef struct {
+	int to58;                 // target base is 58^5, else 2^32
+	uint64_t base;            // target base
+	uint32_t *pow[B58_POWERS]; // source base ^ 2^k in target base
+	size_t powlen[B58_POWERS];
+} b58_conv;
+
+// upper bound of target limbs for n source limbs, either direction
+static inline size_t conv_limbs(size_t n) { return n + (n >> 3) + 2; }
+
+static inline size_t trim(const uint32_t *x, size_t n)
+{
+	while (n && !x[n - 1])
+		--n;
+	return n;
+}
+
+static inline uint32_t split(uint64_t t, uint64_t *carry, int to58)
+{
+	if (to58) {
+		*carry = t / B58_LIMB;
+		return (uint32_t)(t - *carry * B58_LIMB);
+	}
+	*carry = t >> 32;
+	return (uint32_t)t;
+}
+
+// r[0..na+nb) = a * b
+static void mul_base(uint32_t *r, const uint32_t *a, size_t na,
+                     const uint32_t *b, size_t nb, int to58)
+{
+	size_t i, j;
+	uint64_t c;
+	memset(r, 0, (na + nb) * sizeof(*r));
+	for (i = 0; i < na; ++i) {
+		if (!a[i])
+			continue;
+		for (c = 0, j = 0; j < nb; ++j)
+			r[i + j] = split((uint64_t)a[i] * b[j] + r[i + j] + c, &c, to58);
+		r[i + nb] = (uint32_t)c;
+	}
+}
+
+// r[0..n) += a[0..na), returns the carry out of r[n-1]
+static uint32_t add_to(uint32_t *r, size_t n, const uint32_t *a, size_t na,
+                       uint64_t base)
+{
+	size_t i;
+	uint64_t s, c = 0;
+	for (i = 0; i < n && (i < na || c); ++i) {
+		s = (uint64_t)r[i] + (i < na ? a[i] : 0) + c;
+		c = s >= base;
+		r[i] = (uint32_t)(c ? s - base : s);
+	}
+	return (uint32_t)c;
+}
+
+// r[0..n) -= a[0..na), r must be the larger
+static void sub_from(uint32_t *r, size_t n, const uint32_t *a, size_t na,
+                     uint64_t base)
+{
+	size_t i;
+	int64_t d, b = 0;
+	for (i = 0; i < n && (i < na || b); ++i) {
+		d = (int64_t)r[i] - (i < na ? a[i] : 0) - b;
+		b = d < 0;
+		r[i] = (uint32_t)(b ? d + (int64_t)base : d);
+	}
+}
+
+static size_t karatsuba_scratch(size_t n)
+{
+	size_t h = n - (n >> 1) + 1;
+	return n < B58_KARATSUBA ? 0 : 4 * h + karatsuba_scratch(h);
+}
+
+// r[0..2n) = a[0..n) * b[0..n)
+static void karatsuba(uint32_t *r, const uint32_t *a, const uint32_t *b,
+                      size_t n, uint32_t *tmp, const b58_conv *cv)
+{
+	size_t m = n >> 1, h = n - m;
+	uint32_t *sa = tmp, *sb = tmp + h + 1, *z = tmp + 2 * (h + 1);
+	if (n < B58_KARATSUBA) {
+		mul_base(r, a, n, b, n, cv->to58);
+		return;
+	}
+	karatsuba(r, a, b, m, tmp, cv);
+	karatsuba(r + 2 * m, a + m, b + m, h, tmp, cv);
+	memcpy(sa, a + m, h * sizeof(*sa));
+	sa[h] = add_to(sa, h, a, m, cv->base);
+	memcpy(sb, b + m, h * sizeof(*sb));
+	sb[h] = add_to(sb, h, b, m, cv->base);
+	karatsuba(z, sa, sb, h + 1, tmp + 4 * (h + 1), cv);
+	sub_from(z, 2 * (h + 1), r, 2 * m, cv->base);
+	sub_from(z, 2 * (h + 1), r + 2 * m, 2 * h, cv->base);
+	add_to(r + m, 2 * n - m, z, trim(z, 2 * (h + 1)), cv->base);
+}
+
+// Horner's rule, x = x * source base + limb from the top
+static size_t convert_base(uint32_t *out, const uint32_t *in, size_t n, int to58)
+{
+	size_t i, j, len = 0;
+	uint64_t c;
+	for (i = n; i--; ) {
+		c = in[i];
+		for (j = 0; j < len; ++j)
+			out[j] = split(to58 ? ((uint64_t)out[j] << 32) + c
+			                    : (uint64_t)out[j] * B58_LIMB + c, &c, to58);
+		while (c)
+			out[len++] = split(c, &c, to58);
+	}
+	return len;
+}
 
+static const uint32_t *power(b58_conv *cv, int k, size_t *len)
+{
+	if (!cv->pow[k]) {
+		size_t n;
+		if (!k) {
+			cv->pow[0] = malloc(2 * sizeof(uint32_t));
+			if (!cv->pow[0])
+				return NULL;
+			if (cv->to58) { // 2^32 = 6 * 58^5 + 356826688
+				cv->pow[0][0] = 356826688;
+				cv->pow[0][1] = 6;
+				cv->powlen[0] = 2;
+			} else {
+				cv->pow[0][0] = B58_LIMB;
+				cv->powlen[0] = 1;
+			}
+		} else {
+			const uint32_t *p = power(cv, k - 1, &n);
+			uint32_t *tmp;
+			if (!p)
+				return NULL;
+			cv->pow[k] = malloc(2 * n * sizeof(uint32_t));
+			tmp = malloc((karatsuba_scratch(n) + 1) * sizeof(uint32_t));
+			if (!cv->pow[k] || !tmp) {
+				free(tmp);
+				return NULL;
+			}
+			karatsuba(cv->pow[k], p, p, n, tmp, cv);
+			cv->powlen[k] = trim(cv->pow[k], 2 * n);
+			free(tmp);
+		}
+	}
+	*len = cv->powlen[k];
+	return cv->pow[k];
+}
+
+// converts n source limbs into at most conv_limbs(n) target limbs,
+// returns their number or (size_t)-1 when out of memory
+static size_t convert(uint32_t *out, const uint32_t *in, size_t n, b58_conv *cv)
+{
+	size_t m = 1, pl, hl, ll, len = (size_t)-1;
+	uint32_t *hi = NULL, *lo = NULL, *prod = NULL, *tmp = NULL;
+	const uint32_t *p;
+	int k = 0;
+	n = trim(in, n);
+	if (n <= B58_HORNER)
+		return convert_base(out, in, n, cv->to58);
+	while ((m << 1) < n) {
+		m <<= 1;
+		++k;
+	}
+	// in = hi * B^m + lo, where hi < B^m so hi fits the power length
+	if (!(p = power(cv, k, &pl)))
+		return len;
+	hi = calloc(pl > conv_limbs(n - m) ? pl : conv_limbs(n - m), sizeof(uint32_t));
+	lo = malloc(conv_limbs(m) * sizeof(uint32_t));
+	prod = malloc(2 * pl * sizeof(uint32_t));
+	tmp = malloc((karatsuba_scratch(pl) + 1) * sizeof(uint32_t));
+	if (!hi || !lo || !prod || !tmp)
+		goto end;
+	if ((hl = convert(hi, in + m, n - m, cv)) == (size_t)-1
+	    || (ll = convert(lo, in, m, cv)) == (size_t)-1)
+		goto end;
+	(void)hl;
+	karatsuba(prod, hi, p, pl, tmp, cv);
+	add_to(prod, 2 * pl, lo, ll, cv->base);
+	len = trim(prod, 2 * pl);
+	memcpy(out, prod, len * sizeof(uint32_t));
+end:
+	free(hi);
+	free(lo);
+	free(prod);
+	free(tmp);
+	return len;
+}
 
-// const char err_highbit[] = "High bit set on invalid digit";
-// const char err_digit[] = "Invalid base58 digit";
-			// Output number too big (carry to the next int32)
-			// Output number too big (last int32 filled too far)
+static size_t b58_convert(uint32_t *out, const uint32_t *in, size_t n, int to58)
+{
+	b58_conv cv;
+	size_t len;
+	int k;
+	if (n <= B58_HORNER)
+		return convert_base(out, in, trim(in, n), to58);
+	memset(&cv, 0, sizeof(cv));
+	cv.to58 = to58;
+	cv.base = to58 ? B58_LIMB : ((uint64_t)1 << 32);
+	len = convert(out, in, n, &cv);
+	for (k = 0; k < B58_POWERS; ++k)
+		free(cv.pow[k]);
+	return len;
+}
 
 int b58tobin(void *bin, size_t *binszp, const char *b58, size_t b58sz)
 {
 	size_t binsz = *binszp;
 	const unsigned char *b58u = (void*)b58;
 	unsigned char *binu = bin;
-	size_t outisz = (binsz + sizeof(b58_almostmaxint_t) - 1) / sizeof(b58_almostmaxint_t);
-	b58_almostmaxint_t outi[outisz];
-	b58_maxint_t t;
-	b58_almostmaxint_t c;
-	size_t i, j;
-	uint8_t bytesleft = binsz % sizeof(b58_almostmaxint_t);
-	b58_almostmaxint_t zeromask = bytesleft ? (b58_almostmaxint_mask << (bytesleft * 8)) : 0;
+	uint32_t inbuf[B58_HORNER] = { 0 }, outbuf[B58_HORNER_OUT];
+	uint32_t *in = inbuf, *out = outbuf, v;
+	size_t i, j, n, len, nbytes;
 	unsigned zerocount = 0;
-	
+	int res = 0;
+
 	if (!b58sz)
 		b58sz = strlen(b58);
-	
-	for (i = 0; i < outisz; ++i) {
-		outi[i] = 0;
-	}
-	
+
 	// Leading zeros, just count
 	for (i = 0; i < b58sz && b58u[i] == '1'; ++i)
 		++zerocount;
-	
-	for ( ; i < b58sz; ++i)
-	{
-		if (b58u[i] & 0x80)
+	for (j = i; j < b58sz; ++j) {
+		if (b58u[j] & 0x80)
 			// High-bit set on invalid digit
 			return 0;
-		if (b58digits_map[b58u[i]] == -1)
+		if (b58digits_map[b58u[j]] == -1)
 			// Invalid base58 digit
 			return 0;
-		c = (unsigned)b58digits_map[b58u[i]];
-		for (j = outisz; j--; )
-		{
-			t = ((b58_maxint_t)outi[j]) * 58 + c;
-			c = t >> b58_almostmaxint_bits;
-			outi[j] = t & b58_almostmaxint_mask;
-		}
-		if (c)
-			// Output number too big (carry to the next int32)
-			return 0;
-		if (outi[0] & zeromask)
-			// Output number too big (last int32 filled too far)
-			return 0;
 	}
-	
-	j = 0;
-	if (bytesleft) {
-		for (i = bytesleft; i > 0; --i) {
-			*(binu++) = (outi[0] >> (8 * (i - 1))) & 0xff;
-		}
-		++j;
-	}
-	
-	for (; j < outisz; ++j)
-	{
-		for (i = sizeof(*outi); i > 0; --i) {
-			*(binu++) = (outi[j] >> (8 * (i - 1))) & 0xff;
-		}
+
+	// five digits per limb, least significant limb first
+	n = (b58sz - i + 4) / 5;
+	if (n > B58_HORNER) {
+		in = malloc(n * sizeof(uint32_t));
+		out = malloc(conv_limbs(n) * sizeof(uint32_t));
+		if (!in || !out)
+			goto end;
 	}
-	
-	// Count canonical base58 byte count
-	binu = bin;
-	for (i = 0; i < binsz; ++i)
-	{
-		if (binu[i])
-			break;
-		--*binszp;
+	for (j = n; j--; ) {
+		for (v = 0; i < b58sz - 5 * j; ++i)
+			v = v * 58 + (uint32_t)b58digits_map[b58u[i]];
+		in[j] = v;
 	}
-	*binszp += zerocount;
-	
-	return 1;
+	if ((len = b58_convert(out, in, n, 0)) == (size_t)-1)
+		goto end;
+
+	nbytes = len ? 4 * (len - 1) : 0;
+	for (v = len ? out[len - 1] : 0; v; v >>= 8)
+		++nbytes;
+	if (nbytes > binsz)
+		// Output number too big
+		goto end;
+	memset(binu, 0, binsz - nbytes);
+	for (i = 0; i < nbytes; ++i)
+		binu[binsz - 1 - i] = (out[i >> 2] >> (8 * (i & 3))) & 0xff;
+
+	// canonical base58 byte count
+	*binszp = nbytes + zerocount;
+	res = 1;
+end:
+	if (in != inbuf)
+		free(in);
+	if (out != outbuf)
+		free(out);
+	return res;
 }
 
 int b58enc(char *b58, size_t *b58sz, const void *data, size_t binsz)
 {
 	const uint8_t *bin = data;
-	int carry;
-	size_t i, j, high, zcount = 0;
-	size_t size;
-	
+	uint32_t inbuf[B58_HORNER], outbuf[B58_HORNER_OUT];
+	uint32_t *in = inbuf, *out = outbuf, v;
+	size_t i, j, n, len, ndigits, zcount = 0;
+	int res = 0;
+
 	while (zcount < binsz && !bin[zcount])
 		++zcount;
-	
-	size = (binsz - zcount) * 138 / 100 + 1;
-	uint8_t buf[size];
-	memset(buf, 0, size);
-	
-	for (i = zcount, high = size - 1; i < binsz; ++i, high = j)
-	{
-		for (carry = bin[i], j = size - 1; (j > high) || carry; --j)
-		{
-			carry += 256 * buf[j];
-			buf[j] = carry % 58;
-			carry /= 58;
-			if (!j) {
-				// Otherwise j wraps to maxint which is > high
-				break;
-			}
-		}
+
+	// big endian bytes into little endian 32 bit limbs
+	n = (binsz - zcount + 3) / 4;
+	if (n > B58_HORNER) {
+		in = malloc(n * sizeof(uint32_t));
+		out = malloc(conv_limbs(n) * sizeof(uint32_t));
+		if (!in || !out)
+			goto end;
+	}
+	for (i = binsz, j = 0; j < n; ++j) {
+		in[j] = 0;
+		for (v = 0; v < 32 && i > zcount; v += 8)
+			in[j] |= (uint32_t)bin[--i] << v;
 	}
-	
-	for (j = 0; j < size && !buf[j]; ++j);
-	
-	if (*b58sz <= zcount + size - j)
+	if ((len = b58_convert(out, in, n, 1)) == (size_t)-1)
+		goto end;
+
+	ndigits = len ? 5 * (len - 1) : 0;
+	for (v = len ? out[len - 1] : 0; v; v /= 58)
+		++ndigits;
+	if (*b58sz <= zcount + ndigits)
 	{
-		*b58sz = zcount + size - j + 1;
-		return 0;
+		*b58sz = zcount + ndigits + 1;
+		goto end;
 	}
-	
+
 	if (zcount)
 		memset(b58, '1', zcount);
-	for (i = zcount; j < size; ++i, ++j)
-		b58[i] = b58digits_ordered[buf[j]];
-	b58[i] = '\0';
-	*b58sz = i + 1;
-	
-	return 1;
+	for (i = zcount + ndigits, j = 0; j < len; ++j)
+		for (v = out[j], n = 0; n < 5 && i > zcount; ++n, v /= 58)
+			b58[--i] = b58digits_ordered[v % 58];
+	b58[zcount + ndigits] = '\0';
+	*b58sz = zcount + ndigits + 1;
+	res = 1;
+end:
+	if (in != inbuf)
+		free(in);
+	if (out != outbuf)
+		free(out);
+	return res;
 }
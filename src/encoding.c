@@ -27,47 +27,36 @@
 #include "bip39_english.h"
 #include <amcl.h>
 
-static const int32_t hextable[] = {
-	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1, 0,1,2,3,4,5,6,7,8,9,-1,-1,-1,-1,-1,-1,-1,10,11,12,13,14,15,-1,
-	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+#define ENCODING_X86 1
+#include <immintrin.h>
+#endif
+
+#include "encoding.h"
+
+// 0-15 for hex digits, -1 for anything else
+static const int8_t hextable[256] = {
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,-1,-1,-1,-1,-1,-1,
+	-1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
 };
 
-// takes zero terminated hex string, requires pre-allocation of dst,
-// returns len in bytes or -1 in case of error
-int hex2buf(char *dst, const char *hex) {
-	register int i, j;
-	for(i=0, j=0; hex[j]!=0; i++, j+=2) {
-		if(hex[j+1] == '\0') {
-			return -1;
-		}
-		dst[i] = (hextable[(short)hex[j]]<<4) + hextable[(short)hex[j+1]];
-	}
-	return(i);
-}
-
-// takes binary buffer and its bytes length, requires pre-allocation
-// of dst string
 static const char hexes[] = "0123456789abcdef";
-void buf2hex(char *dst, const char *buf, const size_t len) {
-	register size_t i;
-	register unsigned char ch;
-	for (i=0; i<len; i++) {
-		ch=buf[i];
-		dst[i<<1]     = hexes[ch>>4];
-		dst[(i<<1)+1] = hexes[ch & 0xf];
-	}
-	dst[len<<1] = 0x0; // null termination
-}
 
+// url64 decoding, also accepts '/' in place of '_'
 static const unsigned char asciitable[256] = {
 	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
 	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
@@ -87,13 +76,447 @@ static const unsigned char asciitable[256] = {
 	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64
 };
 
-static const char alpha_U64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
-// static const char alpha_B64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+// standard base64 decoding (RFC4648 section 4)
+static const unsigned char b64table[256] = {
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 62, 64, 64, 64, 63,
+	52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 64, 64, 64, 64, 64, 64,
+	64,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+	15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 64, 64, 64, 64, 64,
+	64, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+	41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 64, 64, 64, 64, 64,
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
+	64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64
+};
+
+// everything the base64 and url64 codecs need to know about an
+// alphabet: scalar tables plus the nibble lookups of the SIMD
+// kernels, generated so that for every byte c
+//   valid(c) = (lo[c & 0xf] & hi[c >> 4]) != 0
+//   value(c) = c + roll[c >> 4] + (c == special ? delta : 0)
+// the hi nibble classes are the same for both alphabets.
+typedef struct {
+	const char *alpha;
+	const unsigned char *table;
+	char pad;
+	int8_t lo[16];
+	int8_t roll[16];
+	int8_t special, delta;
+	int8_t enc62, enc63; // offsets from index to char for 62 and 63
+} b64_alphabet;
+
+static const int8_t b64_hi[16] = {
+	0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+static const b64_alphabet B64 = {
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+	b64table, '=',
+	{ 0x2a, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e,
+	  0x3e, 0x3e, 0x3c, 0x15, 0x14, 0x14, 0x14, 0x15 },
+	{ 0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 },
+	'/', -3, '+' - 62, '/' - 63 };
+
+static const b64_alphabet U64 = {
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+	asciitable, 0,
+	{ 0x2a, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e, 0x3e,
+	  0x3e, 0x3e, 0x3c, 0x14, 0x14, 0x15, 0x14, 0x1c },
+	{ 0, 0, 17, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 },
+	'_', 33, '-' - 62, '_' - 63 };
+
+/////////////////////////
+// SIMD kernels
+//
+// each kernel converts as many whole blocks as it can without
+// reading or writing out of bounds and returns the number of input
+// bytes consumed, the scalar loops finish the tail. Decoders stop at
+// the first block holding an invalid character and leave the error
+// report to the scalar code.
+
+#ifdef ENCODING_X86
+
+__attribute__((target("avx2")))
+static size_t hex_encode_avx2(char *dst, const unsigned char *src, size_t len) {
+	const __m256i lut = _mm256_setr_epi8(
+		'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f',
+		'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f');
+	const __m256i m = _mm256_set1_epi8(0x0f);
+	size_t i;
+	for(i=0; i+32 <= len; i+=32) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src+i));
+		__m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v,4), m));
+		__m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, m));
+		__m256i a = _mm256_unpacklo_epi8(hi, lo);
+		__m256i b = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256((__m256i*)(dst+(i<<1)),    _mm256_permute2x128_si256(a, b, 0x20));
+		_mm256_storeu_si256((__m256i*)(dst+(i<<1)+32), _mm256_permute2x128_si256(a, b, 0x31));
+	}
+	return i;
+}
+
+__attribute__((target("sse4.1")))
+static size_t hex_encode_sse(char *dst, const unsigned char *src, size_t len) {
+	const __m128i lut = _mm_setr_epi8(
+		'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f');
+	const __m128i m = _mm_set1_epi8(0x0f);
+	size_t i;
+	for(i=0; i+16 <= len; i+=16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src+i));
+		__m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v,4), m));
+		__m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, m));
+		_mm_storeu_si128((__m128i*)(dst+(i<<1)),    _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i*)(dst+(i<<1)+16), _mm_unpackhi_epi8(hi, lo));
+	}
+	return i;
+}
+
+// nibble values of 32 hex chars, all bits of *bad set on invalid chars
+__attribute__((target("avx2")))
+static inline __m256i hex_nibbles_avx2(__m256i v, __m256i *bad) {
+	__m256i d = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+	__m256i l = _mm256_sub_epi8(_mm256_or_si256(v, _mm256_set1_epi8(0x20)),
+	                            _mm256_set1_epi8('a'));
+	__m256i dok = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+	__m256i lok = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+	*bad = _mm256_or_si256(*bad, _mm256_xor_si256(_mm256_or_si256(dok, lok),
+	                                              _mm256_set1_epi8(-1)));
+	return _mm256_or_si256(_mm256_and_si256(d, dok),
+	                       _mm256_and_si256(_mm256_add_epi8(l, _mm256_set1_epi8(10)), lok));
+}
+
+__attribute__((target("avx2")))
+static size_t hex_decode_avx2(unsigned char *dst, const char *src, size_t len) {
+	const __m256i pair = _mm256_set1_epi16(0x0110);
+	size_t i;
+	for(i=0; i+64 <= len; i+=64) {
+		__m256i bad = _mm256_setzero_si256();
+		__m256i a = hex_nibbles_avx2(_mm256_loadu_si256((const __m256i*)(src+i)), &bad);
+		__m256i b = hex_nibbles_avx2(_mm256_loadu_si256((const __m256i*)(src+i+32)), &bad);
+		if(!_mm256_testz_si256(bad, bad)) break;
+		__m256i r = _mm256_packus_epi16(_mm256_maddubs_epi16(a, pair),
+		                                _mm256_maddubs_epi16(b, pair));
+		_mm256_storeu_si256((__m256i*)(dst+(i>>1)), _mm256_permute4x64_epi64(r, 0xd8));
+	}
+	return i;
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i hex_nibbles_sse(__m128i v, __m128i *bad) {
+	__m128i d = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+	__m128i l = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	__m128i dok = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+	__m128i lok = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+	*bad = _mm_or_si128(*bad, _mm_xor_si128(_mm_or_si128(dok, lok), _mm_set1_epi8(-1)));
+	return _mm_or_si128(_mm_and_si128(d, dok),
+	                    _mm_and_si128(_mm_add_epi8(l, _mm_set1_epi8(10)), lok));
+}
+
+__attribute__((target("sse4.1")))
+static size_t hex_decode_sse(unsigned char *dst, const char *src, size_t len) {
+	const __m128i pair = _mm_set1_epi16(0x0110);
+	size_t i;
+	for(i=0; i+32 <= len; i+=32) {
+		__m128i bad = _mm_setzero_si128();
+		__m128i a = hex_nibbles_sse(_mm_loadu_si128((const __m128i*)(src+i)), &bad);
+		__m128i b = hex_nibbles_sse(_mm_loadu_si128((const __m128i*)(src+i+16)), &bad);
+		if(!_mm_testz_si128(bad, bad)) break;
+		_mm_storeu_si128((__m128i*)(dst+(i>>1)),
+		                 _mm_packus_epi16(_mm_maddubs_epi16(a, pair),
+		                                  _mm_maddubs_epi16(b, pair)));
+	}
+	return i;
+}
+
+// base64 after W. Muła and D. Lemire, "Faster Base64 Encoding and
+// Decoding Using AVX2 Instructions", ACM TOW 2018: 12 input bytes
+// per 128 bit lane are spread into 16 sextets, which are turned into
+// ascii by adding an offset looked up by range.
+#define B64_SPLIT 10,11,9,10, 7,8,6,7, 4,5,3,4, 1,2,0,1
+#define B64_SHIFT(a) 0, 0, 'A', (a)->enc63, (a)->enc62, '0'-52, '0'-52, '0'-52, \
+		'0'-52, '0'-52, '0'-52, '0'-52, '0'-52, '0'-52, '0'-52, 'a'-26
+
+__attribute__((target("avx2")))
+static size_t b64_encode_avx2(char *dst, const unsigned char *src, size_t len,
+                              const b64_alphabet *a) {
+	const __m256i split = _mm256_set_epi8(B64_SPLIT, B64_SPLIT);
+	const __m256i shift = _mm256_set_epi8(B64_SHIFT(a), B64_SHIFT(a));
+	size_t i, o;
+	for(i=0, o=0; i+28 <= len; i+=24, o+=32) {
+		__m256i v = _mm256_inserti128_si256(
+			_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(src+i))),
+			_mm_loadu_si128((const __m128i*)(src+i+12)), 1);
+		v = _mm256_shuffle_epi8(v, split);
+		__m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)),
+		                                _mm256_set1_epi32(0x04000040));
+		__m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)),
+		                                _mm256_set1_epi32(0x01000010));
+		__m256i idx = _mm256_or_si256(t0, t1);
+		__m256i r = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+		r = _mm256_or_si256(r, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx),
+		                                        _mm256_set1_epi8(13)));
+		r = _mm256_add_epi8(idx, _mm256_shuffle_epi8(shift, r));
+		_mm256_storeu_si256((__m256i*)(dst+o), r);
+	}
+	return i;
+}
+
+__attribute__((target("sse4.1")))
+static size_t b64_encode_sse(char *dst, const unsigned char *src, size_t len,
+                             const b64_alphabet *a) {
+	const __m128i split = _mm_set_epi8(B64_SPLIT);
+	const __m128i shift = _mm_set_epi8(B64_SHIFT(a));
+	size_t i, o;
+	for(i=0, o=0; i+16 <= len; i+=12, o+=16) {
+		__m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src+i)), split);
+		__m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+		                             _mm_set1_epi32(0x04000040));
+		__m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+		                             _mm_set1_epi32(0x01000010));
+		__m128i idx = _mm_or_si128(t0, t1);
+		__m128i r = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+		r = _mm_or_si128(r, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx),
+		                                  _mm_set1_epi8(13)));
+		r = _mm_add_epi8(idx, _mm_shuffle_epi8(shift, r));
+		_mm_storeu_si128((__m128i*)(dst+o), r);
+	}
+	return i;
+}
+
+// stores 16 bytes per 12 decoded: callers leave enough input behind
+// the last block for the output to cover the overhang
+__attribute__((target("avx2")))
+static size_t b64_decode_avx2(unsigned char *dst, const char *src, size_t len,
+                              const b64_alphabet *a) {
+	const __m256i lo_lut = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)a->lo));
+	const __m256i hi_lut = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)b64_hi));
+	const __m256i roll_lut = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)a->roll));
+	const __m256i m = _mm256_set1_epi8(0x0f);
+	const __m256i pack = _mm256_setr_epi8(
+		2,1,0,6,5,4,10,9,8,14,13,12,-1,-1,-1,-1,
+		2,1,0,6,5,4,10,9,8,14,13,12,-1,-1,-1,-1);
+	size_t i, o;
+	for(i=0, o=0; i+44 <= len; i+=32, o+=24) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src+i));
+		__m256i hi = _mm256_and_si256(_mm256_srli_epi32(v, 4), m);
+		__m256i ok = _mm256_and_si256(_mm256_shuffle_epi8(lo_lut, _mm256_and_si256(v, m)),
+		                              _mm256_shuffle_epi8(hi_lut, hi));
+		if(_mm256_movemask_epi8(_mm256_cmpeq_epi8(ok, _mm256_setzero_si256()))) break;
+		__m256i roll = _mm256_add_epi8(_mm256_shuffle_epi8(roll_lut, hi),
+			_mm256_and_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(a->special)),
+			                 _mm256_set1_epi8(a->delta)));
+		v = _mm256_add_epi8(v, roll);
+		v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+		v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+		v = _mm256_shuffle_epi8(v, pack);
+		v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0,1,2,4,5,6,7,7));
+		_mm256_storeu_si256((__m256i*)(dst+o), v);
+	}
+	return i;
+}
+
+__attribute__((target("sse4.1")))
+static size_t b64_decode_sse(unsigned char *dst, const char *src, size_t len,
+                             const b64_alphabet *a) {
+	const __m128i lo_lut = _mm_loadu_si128((const __m128i*)a->lo);
+	const __m128i hi_lut = _mm_loadu_si128((const __m128i*)b64_hi);
+	const __m128i roll_lut = _mm_loadu_si128((const __m128i*)a->roll);
+	const __m128i m = _mm_set1_epi8(0x0f);
+	const __m128i pack = _mm_setr_epi8(2,1,0,6,5,4,10,9,8,14,13,12,-1,-1,-1,-1);
+	size_t i, o;
+	for(i=0, o=0; i+24 <= len; i+=16, o+=12) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src+i));
+		__m128i hi = _mm_and_si128(_mm_srli_epi32(v, 4), m);
+		__m128i ok = _mm_and_si128(_mm_shuffle_epi8(lo_lut, _mm_and_si128(v, m)),
+		                           _mm_shuffle_epi8(hi_lut, hi));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi8(ok, _mm_setzero_si128()))) break;
+		__m128i roll = _mm_add_epi8(_mm_shuffle_epi8(roll_lut, hi),
+			_mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(a->special)),
+			              _mm_set1_epi8(a->delta)));
+		v = _mm_add_epi8(v, roll);
+		v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+		v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+		_mm_storeu_si128((__m128i*)(dst+o), _mm_shuffle_epi8(v, pack));
+	}
+	return i;
+}
+
+#endif // ENCODING_X86
+
+static int simd_cpu = -1;
+static int simd_level = -1;
+
+int encoding_simd(int max) {
+	if(simd_cpu < 0) {
+		simd_cpu = ENCODING_SCALAR;
+#ifdef ENCODING_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("sse4.1")) simd_cpu = ENCODING_SSE41;
+		if(__builtin_cpu_supports("avx2"))   simd_cpu = ENCODING_AVX2;
+#endif
+	}
+	if(max >= 0) simd_level = max < simd_cpu ? max : simd_cpu;
+	else if(simd_level < 0) simd_level = simd_cpu;
+	return simd_level;
+}
+
+#define SIMD_LEVEL (simd_level >= 0 ? simd_level : encoding_simd(-1))
+
+/////////////////////////
+// hex
+
+void hex_encode(char *dst, const char *buf, size_t len) {
+	const unsigned char *src = (const unsigned char*)buf;
+	register size_t i = 0;
+#ifdef ENCODING_X86
+	switch(SIMD_LEVEL) {
+	case ENCODING_AVX2:  i = hex_encode_avx2(dst, src, len); break;
+	case ENCODING_SSE41: i = hex_encode_sse(dst, src, len); break;
+	}
+#endif
+	for(; i<len; i++) {
+		dst[i<<1]     = hexes[src[i]>>4];
+		dst[(i<<1)+1] = hexes[src[i] & 0xf];
+	}
+}
+
+int hex_decode(char *dst, const char *hex, size_t len) {
+	const unsigned char *src = (const unsigned char*)hex;
+	register size_t i = 0;
+	register int8_t h, l;
+	if(len & 1) return -1;
+#ifdef ENCODING_X86
+	switch(SIMD_LEVEL) {
+	case ENCODING_AVX2:  i = hex_decode_avx2((unsigned char*)dst, hex, len); break;
+	case ENCODING_SSE41: i = hex_decode_sse((unsigned char*)dst, hex, len); break;
+	}
+#endif
+	for(; i<len; i+=2) {
+		h = hextable[src[i]];
+		l = hextable[src[i+1]];
+		if((h | l) < 0) return -1;
+		dst[i>>1] = (char)((h<<4) | l);
+	}
+	return (int)(len>>1);
+}
+
+// takes zero terminated hex string, requires pre-allocation of dst,
+// returns len in bytes or -1 in case of error
+int hex2buf(char *dst, const char *hex) {
+	return hex_decode(dst, hex, strlen(hex));
+}
+
+// takes binary buffer and its bytes length, requires pre-allocation
+// of dst string
+void buf2hex(char *dst, const char *buf, const size_t len) {
+	hex_encode(dst, buf, len);
+	dst[len<<1] = 0x0; // null termination
+}
+
+/////////////////////////
+// base64 and url64
 
 int B64encoded_len(int len) { return ((((len + 2) / 3) <<2) + 1); }
 
 int B64decoded_len(int len) { return ((len + 3) >> 2) * 3; }
 
+size_t base64_len(size_t len) { return ((len + 2) / 3) << 2; }
+
+size_t url64_len(size_t len) { return (len << 2) / 3 + ((len % 3) ? 1 : 0); }
+
+static size_t _b64encode(char *dst, const unsigned char *src, size_t len,
+                         const b64_alphabet *a) {
+	const char *alpha = a->alpha;
+	register size_t i = 0;
+	register char *p = dst;
+#ifdef ENCODING_X86
+	switch(SIMD_LEVEL) {
+	case ENCODING_AVX2:  i = b64_encode_avx2(dst, src, len, a); break;
+	case ENCODING_SSE41: i = b64_encode_sse(dst, src, len, a); break;
+	}
+	p += i / 3 * 4;
+#endif
+	for(; i+2 < len; i+=3) {
+		*p++ = alpha[src[i] >> 2];
+		*p++ = alpha[((src[i] & 0x3) << 4) | (src[i+1] >> 4)];
+		*p++ = alpha[((src[i+1] & 0xf) << 2) | (src[i+2] >> 6)];
+		*p++ = alpha[src[i+2] & 0x3f];
+	}
+	if(i < len) {
+		*p++ = alpha[src[i] >> 2];
+		if(i == len-1) {
+			*p++ = alpha[(src[i] & 0x3) << 4];
+			if(a->pad) { *p++ = a->pad; *p++ = a->pad; }
+		} else {
+			*p++ = alpha[((src[i] & 0x3) << 4) | (src[i+1] >> 4)];
+			*p++ = alpha[(src[i+1] & 0xf) << 2];
+			if(a->pad) *p++ = a->pad;
+		}
+	}
+	return p - dst;
+}
+
+static int _b64decode(char *dest, const char *in, size_t len,
+                      const b64_alphabet *a) {
+	const unsigned char *src = (const unsigned char*)in;
+	const unsigned char *t = a->table;
+	unsigned char *dst = (unsigned char*)dest;
+	register size_t i = 0;
+	register unsigned int v, c0, c1, c2, c3;
+	if(a->pad) {
+		if(len && src[len-1] == a->pad) len--;
+		if(len && src[len-1] == a->pad) len--;
+	}
+	if((len & 3) == 1) return -1;
+#ifdef ENCODING_X86
+	switch(SIMD_LEVEL) {
+	case ENCODING_AVX2:  i = b64_decode_avx2(dst, in, len, a); break;
+	case ENCODING_SSE41: i = b64_decode_sse(dst, in, len, a); break;
+	}
+	dst += i / 4 * 3;
+#endif
+	for(; i+3 < len; i+=4) {
+		c0 = t[src[i]]; c1 = t[src[i+1]]; c2 = t[src[i+2]]; c3 = t[src[i+3]];
+		if((c0 | c1 | c2 | c3) & 64) return -1;
+		v = (c0 << 18) | (c1 << 12) | (c2 << 6) | c3;
+		*dst++ = v >> 16;
+		*dst++ = v >> 8;
+		*dst++ = v;
+	}
+	if(i < len) { // 2 or 3 chars left
+		c0 = t[src[i]]; c1 = t[src[i+1]];
+		c2 = i+2 < len ? t[src[i+2]] : 0;
+		if((c0 | c1 | c2) & 64) return -1;
+		v = (c0 << 18) | (c1 << 12) | (c2 << 6);
+		*dst++ = v >> 16;
+		if(i+2 < len) *dst++ = v >> 8;
+	}
+	return (int)(dst - (unsigned char*)dest);
+}
+
+size_t base64_encode(char *dst, const char *src, size_t len) {
+	return _b64encode(dst, (const unsigned char*)src, len, &B64);
+}
+
+int base64_decode(char *dst, const char *src, size_t len) {
+	return _b64decode(dst, src, len, &B64);
+}
+
+size_t url64_encode(char *dst, const char *src, size_t len) {
+	return _b64encode(dst, (const unsigned char*)src, len, &U64);
+}
+
+int url64_decode(char *dst, const char *src, size_t len) {
+	return _b64decode(dst, src, len, &U64);
+}
+
 // assumes null terminated string
 // no padding equals check (no modulo 4)
 // returns 0 if not base else length of base encoded string
@@ -109,60 +532,18 @@ int is_url64(const char *in) {
 	return(c);
 }
 
+// decodes up to the first invalid char, null terminates dest
 int U64decode(char *dest, const char *src) {
-	register const unsigned char *bufin;
-	register unsigned char *bufout;
-	register int nprbytes;
-	const unsigned char *_buf = (const unsigned char *) src;
-	bufin = _buf;
-	while (asciitable[*(bufin++)] <= 63);
-	nprbytes = bufin - _buf - 1;
-
-	bufout = (unsigned char *) dest;
-	bufin = _buf;
-
-	while (nprbytes > 4) {
-		*(bufout++) = (unsigned char) (asciitable[*bufin] << 2 | asciitable[bufin[1]] >> 4);
-		*(bufout++) = (unsigned char) (asciitable[bufin[1]] << 4 | asciitable[bufin[2]] >> 2);
-		*(bufout++) = (unsigned char) (asciitable[bufin[2]] << 6 | asciitable[bufin[3]]);
-		bufin += 4;
-		nprbytes -= 4;
-	}
-
-	if (nprbytes > 1)
-		*(bufout++) = (unsigned char) (asciitable[*bufin] << 2 | asciitable[bufin[1]] >> 4);
-	if (nprbytes > 2)
-		*(bufout++) = (unsigned char) (asciitable[bufin[1]] << 4 | asciitable[bufin[2]] >> 2);
-	if (nprbytes > 3)
-		*(bufout++) = (unsigned char) (asciitable[bufin[2]] << 6 | asciitable[bufin[3]]);
-
-	*(bufout++) = '\0';
-	// return the length of decoded
-	return(bufout-(unsigned char*)dest-1);
+	register size_t len = 0;
+	while(asciitable[(unsigned char)src[len]] <= 63) len++;
+	if((len & 3) == 1) len--; // a lone trailing sextet carries no byte
+	int res = url64_decode(dest, src, len);
+	dest[res] = '\0';
+	return res;
 }
 
 void U64encode(char *dest, const char *src, int len) {
-	int i;
-	char *p = dest;
-
-	for (i = 0; i < len - 2; i += 3) {
-		*p++ = alpha_U64[(src[i] >> 2) & 0x3F];
-		*p++ = alpha_U64[((src[i] & 0x3) << 4) | ((int) (src[i + 1] & 0xF0) >> 4)];
-		*p++ = alpha_U64[((src[i + 1] & 0xF) << 2) | ((int) (src[i + 2] & 0xC0) >> 6)];
-		*p++ = alpha_U64[src[i + 2] & 0x3F];
-	}
-
-	if (i < len) {
-		*p++ = alpha_U64[(src[i] >> 2) & 0x3F];
-		if (i == (len - 1)) {
-			*p++ = alpha_U64[((src[i] & 0x3) << 4)];
-		} else {
-			*p++ = alpha_U64[((src[i] & 0x3) << 4) | ((int) (src[i + 1] & 0xF0) >> 4)];
-			*p++ = alpha_U64[((src[i + 1] & 0xF) << 2)];
-		}
-	}
-
-	*p++ = '\0';
+	dest[url64_encode(dest, src, len)] = '\0';
 }
 
 
@@ -300,8 +681,7 @@ int is_base45(const char* src) {
 void sha256_raw(const char *data, int len, char *result) {
   hash256 hash;
   HASH256_init(&hash);
-  register int i;
-  for(i=0;i<len;i++) HASH256_process(&hash,data[i]);
+  HASH256_process_array(&hash, data, len);
   HASH256_hash(&hash, (char*)result);
 }
 
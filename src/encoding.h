@@ -23,6 +23,26 @@
 
 #include <stddef.h>
 
+// SIMD levels of the hex, base64 and url64 codecs
+#define ENCODING_SCALAR 0
+#define ENCODING_SSE41  1
+#define ENCODING_AVX2   2
+// caps the level used to max and returns the one in use, a negative
+// max only returns the best level supported by the CPU
+int encoding_simd(int max);
+
+// length explicit codecs: encoders write exactly the encoded length
+// without null termination, decoders return the number of bytes
+// written or -1 on invalid input
+void hex_encode(char *dst, const char *src, size_t len);
+int hex_decode(char *dst, const char *hex, size_t len);
+size_t base64_len(size_t len);
+size_t base64_encode(char *dst, const char *src, size_t len);
+int base64_decode(char *dst, const char *src, size_t len);
+size_t url64_len(size_t len);
+size_t url64_encode(char *dst, const char *src, size_t len);
+int url64_decode(char *dst, const char *src, size_t len);
+
 int hex2buf(char *dst, const char *hex);
 void buf2hex(char *dst, const char *buf, const size_t len);
 
@@ -291,26 +291,22 @@ DESCRIPTION: The following function takes in input an array of elements that can
     OUTPUT: octet_result as "zenroom.octet"
 ]]
 local function serialization(input_array)
-    local octet_result = O.empty()
-    local el_octs = O.empty()
+    local octet_result = O.builder()
     for i=1, table_size(input_array) do
         local elt = input_array[i]
         local elt_type = type(elt)
         if (elt_type == "zenroom.ecp") or (elt_type == "zenroom.ecp2") then
-            el_octs = elt:to_zcash()
+            octet_result:append(elt:to_zcash())
         elseif (elt_type == "zenroom.big") then
-            el_octs = i2osp(elt, OCTET_SCALAR_LENGTH)
+            octet_result:append(i2osp(elt, OCTET_SCALAR_LENGTH))
         elseif (elt_type == "number") then
-            el_octs = i2osp(elt, 8)
+            octet_result:append_uint(elt, 8)
         else
             error("Invalid type passed inside serialize", 4)
         end
-
-        octet_result = octet_result .. el_octs
-
     end
 
-    return octet_result
+    return octet_result:finish()
 end
 
 --[[
@@ -335,6 +331,16 @@ local function calculate_domain(ciphersuite, pk_octet, Q1, H_points, header)
     return domain
 end
 
+-- B = P1 + Q_1 * domain + H_points[1] * messages[1] + ... + H_points[len] * messages[len]
+local function calculate_B(ciphersuite, Q_1, domain, H_points, messages, len)
+    local points, scalars = { Q_1 }, { domain }
+    for i = 1, len do
+        points[i+1] = H_points[i]
+        scalars[i+1] = messages[i]
+    end
+    return ciphersuite.P1 + ECP.msm(points, scalars)
+end
+
 --[[
 DESCRIPTION:  This operation computes a deterministic signature from a secret key(SK), a set of generators (points of G1) and
 optionally a header and a vector of messages.
@@ -359,12 +365,7 @@ local function core_sign(ciphersuite, sk, pk, header, messages, generators)
     table.insert(serialize_array, domain)
     local e = hash_to_scalar(ciphersuite, serialization(serialize_array))
 
-    local BB = ciphersuite.P1 + Q_1* domain
-    if (LEN > 0) then
-        for i = 1,LEN do
-            BB = BB + (H_array[i]* messages[i])
-        end
-    end
+    local BB = calculate_B(ciphersuite, Q_1, domain, H_array, messages, LEN)
     if (BIG.mod(sk + e, PRIME_R) == BIG.new(0))  then
         error("Invalid value for e",3)   
     end
@@ -458,15 +459,9 @@ local function core_verify(ciphersuite, pk, signature, generators, messages, hea
     local H_points = { table.unpack(generators, 2, LEN + 1) }
     -- Procedure
     local domain = calculate_domain(ciphersuite, pk, Q_1, H_points, header)
-    local BB = ciphersuite.P1 + (Q_1 * domain)
-    if (LEN > 0) then
-        for i = 1, LEN do
-            BB = BB + (H_points[i] * messages[i])
-        end
-    end
-    local LHS = ECP2.ate(W + (ECP2.generator() * s), AA)
-    local RHS = ECP2.ate(ECP2.generator(), BB)
-    return LHS == RHS
+    local BB = calculate_B(ciphersuite, Q_1, domain, H_points, messages, LEN)
+    return ECP2.pairing_check({ { W + (ECP2.generator() * s), AA },
+                                { ECP2.generator(), BB:negative() } })
 end
 
 
@@ -583,19 +578,13 @@ local function proof_init(ciphersuite, pk, signature_result, generators, random_
     
     local domain = calculate_domain(ciphersuite, pk, Q_1, MsgGenerators, header)
     
-    local BB = ciphersuite.P1 + (Q_1 * domain)
-    for i = 1, L do
-        BB = BB + (MsgGenerators[i] * messages[i])
-    end
+    local BB = calculate_B(ciphersuite, Q_1, domain, MsgGenerators, messages, L)
     
     local D = BB * r2
     local Abar = AA * (r1 * r2)
     local Bbar = (D * r1) - (Abar * e)
-    local T1 = (Abar * et) + (D * r1t)
-    local T2 = (D * r3t)
-    for i = 1, U do
-        T2 = T2 + (H_j[i] * mjt[i])
-    end
+    local T1 = ECP.msm({Abar, D}, {et, r1t})
+    local T2 = ECP.msm({D, table.unpack(H_j, 1, U)}, {r3t, table.unpack(mjt, 1, U)})
     local init_res = {Abar, Bbar, D, T1, T2, domain}
     return init_res
 
@@ -784,17 +773,12 @@ local function proof_verify_init(ciphersuite, pk, Abar, Bbar, D , ehat, r1hat, r
 
     local domain = calculate_domain(ciphersuite, pk, Q_1, MsgGenerators, header)
 
-    local T_1 = Bbar* c + Abar* ehat + D* r1hat
- 
-    local Bv = ciphersuite.P1 + Q_1*domain
-    for i = 1, len_R do
-        Bv = Bv + disclosed_H[i]*disclosed_messages[i]
-    end
+    local T_1 = ECP.msm({Bbar, Abar, D}, {c, ehat, r1hat})
 
-    local T_2 = Bv*c + D* r3hat
-    for i = 1, len_U do
-        T_2 = T_2 + secret_H[i]*commitments[i]
-    end
+    local Bv = calculate_B(ciphersuite, Q_1, domain, disclosed_H, disclosed_messages, len_R)
+
+    local T_2 = ECP.msm({Bv, D, table.unpack(secret_H, 1, len_U)},
+                        {c, r3hat, table.unpack(commitments, 1, len_U)})
     return {Abar, Bbar, D, T_1, T_2, domain}
 
 
@@ -818,9 +802,8 @@ local function core_proof_verify(ciphersuite, pk , proof, generators, header, ph
         return false
     end
 
-    local LHS = ECP2.ate(W, Abar)
-    local RHS = ECP2.ate(ECP2.generator(), Bbar)
-    return  LHS == RHS
+    return ECP2.pairing_check({ { W, Abar },
+                                { ECP2.generator(), Bbar:negative() } })
 
 end
 
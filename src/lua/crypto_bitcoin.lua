@@ -125,7 +125,7 @@ local function decode_compact_size_at_index(raw, i)
    else
       s, e = 2, 9
    end
-   return INT.new(raw:sub(i+s-1, i+e-1)), i+e
+   return INT.new(raw:sub(i+s-1, i+e-1):reverse()), i+e
 end
 
 -- fixed size encoding for integer
@@ -153,7 +153,7 @@ function btc.decode_raw_transaction(raw, sender_address, amounts_spent)
    tx = {}
    -- version (little endian)
    tx.version, i = read_uint(raw, i, 4)
-   assert(tx.version == 1 or tx.version == 2)
+   assert(tx.version == INT.new(1) or tx.version == INT.new(2))
 
    -- check if this is segwit, BIP 141
 
@@ -250,44 +250,44 @@ end
 -- @return octet raw transaction
 function btc.build_raw_transaction(tx)
    local raw, script
-   raw = O.new()
+   raw = O.builder()
 
    sigwit = (tx["witness"] and #tx["witness"]>0)
 
    -- version
-   raw = raw .. O.from_hex('02000000')
+   raw:append(O.from_hex('02000000'))
 
 
    if sigwit then
       -- marker + flags
-      raw = raw .. O.from_hex('0001')
+      raw:append(O.from_hex('0001'))
    end
    
-   raw = raw .. btc.encode_compact_size(INT.new(#tx.txIn))
+   raw:append(btc.encode_compact_size(INT.new(#tx.txIn)))
 
    -- txIn
    for _, v in pairs(tx.txIn) do
       -- outpoint (hash and index of the transaction)
-      raw = raw .. v.txid:reverse() .. btc.to_uint(v.vout, 4)
+      raw:append(v.txid:reverse(), btc.to_uint(v.vout, 4))
       -- the script depends on the signature
       script = O.new()
 
-      raw = raw .. btc.encode_compact_size(#script) .. script
+      raw:append(btc.encode_compact_size(#script), script)
       
       -- Sequence number disabled
-      raw = raw .. O.from_hex('ffffffff')
+      raw:append(O.from_hex('ffffffff'))
    end
 
-   raw = raw .. btc.encode_compact_size(INT.new(#tx.txOut))
+   raw:append(btc.encode_compact_size(INT.new(#tx.txOut)))
 
    -- txOut
    for k, v in pairs(tx.txOut) do
       --raw = raw .. btc.to_uint(v.amount, 8)
       assert(v.address, "Address not found in txout["..k.."]")
       local amount = O.new(v.amount)
-      raw = raw .. amount:reverse()
+      raw:append(amount:reverse())
       if #v.amount < 8 then
-	 raw = raw .. O.zero(8 - #amount)
+	 raw:append(O.zero(8 - #amount))
       end
       -- fixed script to send bitcoins
       -- OP_DUP OP_HASH160 20byte
@@ -302,7 +302,7 @@ function btc.build_raw_transaction(tx)
       -- readBech32Address(v.address)
       script = script .. fif(v.address.raw, v.address.raw, v.address)
       
-      raw = raw .. btc.encode_compact_size(#script) .. script
+      raw:append(btc.encode_compact_size(#script), script)
    end
 
    if sigwit then
@@ -317,17 +317,16 @@ function btc.build_raw_transaction(tx)
 
       for _, v in pairs(tx["witness"]) do
 	 -- encode all the stack items for the witness
-	 raw = raw .. btc.encode_compact_size(#v)
+	 raw:append(btc.encode_compact_size(#v))
 	 for _, s in pairs(v) do
-	    raw = raw .. btc.encode_compact_size(#s)
-	    raw = raw .. s
+	    raw:append(btc.encode_compact_size(#s), s)
 	 end
       end
    end
 
-   raw = raw .. O.from_hex('00000000')
+   raw:append(O.from_hex('00000000'))
    
-   return raw
+   return raw:finish()
 end
 
 local function encode_with_prepend(bytes)
@@ -411,10 +410,10 @@ local function _hash_prevouts(tx)
    local H
    H = HASH.new('sha256')
 
-   raw = O.new()
+   raw = O.builder()
 
    for _, v in pairs(tx.txIn) do
-      raw = raw .. v.txid:reverse() .. btc.to_uint(v.vout, 4)
+      raw:append(v.txid:reverse(), btc.to_uint(v.vout, 4))
    end
 
    return H:process(H:process(raw))
@@ -428,7 +427,7 @@ local function _hash_sequence(tx)
    local seq
    H = HASH.new('sha256')
 
-   raw = O.new()
+   raw = O.builder()
 
    for _, v in pairs(tx.txIn) do
       seq = v['sequence']
@@ -436,7 +435,7 @@ local function _hash_sequence(tx)
 	 -- default value, not enabled
 	 seq = O.from_hex('ffffffff')
       end
-      raw = raw .. btc.to_uint(seq, 4)
+      raw:append(btc.to_uint(seq, 4))
    end
    
    return H:process(H:process(raw))
@@ -449,16 +448,16 @@ local function _hash_outputs(tx)
    local H
    H = HASH.new('sha256')
 
-   raw = O.new()
+   raw = O.builder()
 
    for _, v in pairs(tx.txOut) do
       amount = O.new(v.amount)
-      raw = raw .. amount:reverse()
+      raw:append(amount:reverse())
       if #v.amount < 8 then
-	 raw = raw .. O.zero(8 - #amount)
+	 raw:append(O.zero(8 - #amount))
       end
       -- This is specific to Bech32 addresses, we should be able to verify the kind of address
-      raw = raw .. O.from_hex('160014') .. fif( v.address.raw, v.address.raw, v.address)
+      raw:append(O.from_hex('160014'), fif( v.address.raw, v.address.raw, v.address))
 
    end
 
@@ -484,31 +483,31 @@ local function build_transaction_to_sign(tx, i)
    local address = fif(tx.txIn[i].address.raw, 
 		       tx.txIn[i].address.raw, tx.txIn[i].address)
    assert(address, "Cannot sign or verify transaction: no address provided")
-   raw = O.new()
+   raw = O.builder()
    --      1. nVersion of the transaction (4-byte little endian)
-   raw = raw .. btc.to_uint(tx.version, 4)
+   raw:append(btc.to_uint(tx.version, 4))
    --      2. hash_prevouts (32-byte hash)
-   raw = raw .. _hash_prevouts(tx)
+   raw:append(_hash_prevouts(tx))
    --      3. hash_sequence (32-byte hash)
-   raw = raw .. _hash_sequence(tx)
+   raw:append(_hash_sequence(tx))
    --      4. outpoint (32-byte hash + 4-byte little endian)
-   raw = raw .. tx.txIn[i].txid:reverse() .. btc.to_uint(tx.txIn[i].vout, 4)
+   raw:append(tx.txIn[i].txid:reverse(), btc.to_uint(tx.txIn[i].vout, 4))
    --      5. scriptCode of the input (serialized as scripts inside CTxOuts)
-   raw = raw .. O.from_hex('1976a914') .. address  .. O.from_hex('88ac')
+   raw:append(O.from_hex('1976a914'), address, O.from_hex('88ac'))
    --      6. value of the output spent by this input (8-byte little endian)
    amount = O.new(tx.txIn[i].amountSpent)
-   raw = raw .. amount:reverse()
+   raw:append(amount:reverse())
    if #amount < 8 then
-      raw = raw .. O.zero(8 - #amount)
+      raw:append(O.zero(8 - #amount))
    end
    --      7. nSequence of the input (4-byte little endian)
-   raw = raw .. tx.txIn[i].sequence:reverse()
+   raw:append(tx.txIn[i].sequence:reverse())
    --      8. hash_outputs (32-byte hash)
-   raw = raw .. _hash_outputs(tx)
+   raw:append(_hash_outputs(tx))
    --      9. nLocktime of the transaction (4-byte little endian)
-   raw = raw .. btc.to_uint(tx.nLockTime, 4)
+   raw:append(btc.to_uint(tx.nLockTime, 4))
    --     10. sighash type of the signature (4-byte little endian)
-   raw = raw .. btc.to_uint(tx.nHashType, 4)
+   raw:append(btc.to_uint(tx.nHashType, 4))
 
    return raw
 end
@@ -37,8 +37,8 @@ local function make_pi_s(gamma, commit, k, r, m)
    local wm = INT.random()
    local wr = INT.random()
    local Aw = G1 * wk
-   local Bw = gamma * wk + commit * wm
-   local Cw = G1 * wr + SALT * wm
+   local Bw = ECP.msm({gamma, commit}, {wk, wm})
+   local Cw = ECP.msm({G1, SALT}, {wr, wm})
    local c = ZKP_challenge({commit, Aw, Bw, Cw})
    -- return pi_s
    return {
@@ -50,12 +50,11 @@ local function make_pi_s(gamma, commit, k, r, m)
 end
 
 function credential.verify_pi_s(l)
-   local Aw = l.sign.a * l.pi_s.commit + G1 * l.pi_s.rk
-   local Bw =
-      l.sign.b * l.pi_s.commit + l.public * l.pi_s.rk +
-      l.commit * l.pi_s.rm
-   local Cw =
-      l.commit * l.pi_s.commit + G1 * l.pi_s.rr + SALT * l.pi_s.rm
+   local Aw = ECP.msm({l.sign.a, G1}, {l.pi_s.commit, l.pi_s.rk})
+   local Bw = ECP.msm({l.sign.b, l.public, l.commit},
+                      {l.pi_s.commit, l.pi_s.rk, l.pi_s.rm})
+   local Cw = ECP.msm({l.commit, G1, SALT},
+                      {l.pi_s.commit, l.pi_s.rr, l.pi_s.rm})
    -- return a bool for assert
    return l.pi_s.commit == ZKP_challenge({l.commit, Aw, Bw, Cw})
 end
@@ -89,11 +88,11 @@ function credential.prepare_blind_sign(secret)
    local m = INT.new(sha256(secret)) % ECP.order()
    -- ElGamal commitment
    local r = INT.random()
-   local commit = G1 * r + SALT * m
+   local commit = ECP.msm({G1, SALT}, {r, m})
    local k = INT.random()
    local sign = {
       a = G1 * k,
-      b = gamma * k + commit * m
+      b = ECP.msm({gamma, commit}, {k, m})
    }
    -- calculate zero knowledge proofs
    local pi_s = make_pi_s(gamma, commit, k, r, m)
@@ -114,7 +113,7 @@ function credential.blind_sign(sk, Lambda)
    )
    local h = Lambda.commit
    local a_tilde = Lambda.sign.a * sk.y
-   local b_tilde = h * sk.x + Lambda.sign.b * sk.y
+   local b_tilde = ECP.msm({h, Lambda.sign.b}, {sk.x, sk.y})
    -- sigma tilde
    return {
       h = h,
@@ -150,7 +149,7 @@ function credential.prove_cred(verify, sigma, secret)
       h_prime = sigma.h * r_prime,
       s_prime = sigma.s * r_prime
    }
-   local kappa = verify.alpha + verify.beta * m + G2 * r
+   local kappa = verify.alpha + ECP2.msm({verify.beta, G2}, {m, r})
    local nu = sigma_prime.h_prime * r
    local wm = INT.random()
    local wr = INT.random()
@@ -159,7 +158,7 @@ function credential.prove_cred(verify, sigma, secret)
       {
          verify.alpha,
          verify.beta,
-         verify.alpha + G2 * wr + verify.beta * wm, -- Aw
+         verify.alpha + ECP2.msm({G2, verify.beta}, {wr, wm}), -- Aw
          sigma_prime.h_prime * wr
       }
    ) -- Bw
@@ -181,13 +180,11 @@ function credential.verify_cred(verify, Theta)
       verify = verify[1]
    end -- single element in array
    -- verify pi_v
-   local Aw =
-      Theta.kappa * Theta.pi_v.c + G2 * Theta.pi_v.rr +
-      verify.alpha * (BIG.new(1) - Theta.pi_v.c) +
-      verify.beta * Theta.pi_v.rm
-   local Bw =
-      Theta.nu * Theta.pi_v.c +
-      Theta.sigma_prime.h_prime * Theta.pi_v.rr
+   local Aw = ECP2.msm(
+      {Theta.kappa, G2, verify.alpha, verify.beta},
+      {Theta.pi_v.c, Theta.pi_v.rr, BIG.new(1) - Theta.pi_v.c, Theta.pi_v.rm})
+   local Bw = ECP.msm({Theta.nu, Theta.sigma_prime.h_prime},
+                      {Theta.pi_v.c, Theta.pi_v.rr})
    -- check zero knowledge proof
    assert(
       Theta.pi_v.c == ZKP_challenge({verify.alpha, verify.beta, Aw, Bw}),
@@ -200,8 +197,9 @@ function credential.verify_cred(verify, Theta)
       2
    )
    assert(
-      ECP2.miller(Theta.kappa, Theta.sigma_prime.h_prime) ==
-         ECP2.miller(G2, Theta.sigma_prime.s_prime + Theta.nu),
+      ECP2.pairing_check({
+            { Theta.kappa, Theta.sigma_prime.h_prime },
+            { G2, (Theta.sigma_prime.s_prime + Theta.nu):negative() } }),
       'credential verification: invalid signature (miller loop)',
       2
    )
@@ -217,7 +215,7 @@ function credential.prove_cred_uid(vk, sigma, secret, uid)
       h_prime = sigma.h * r_prime,
       s_prime = sigma.s * r_prime
    }
-   local kappa = vk.alpha + vk.beta * m + G2 * r
+   local kappa = vk.alpha + ECP2.msm({vk.beta, G2}, {m, r})
    local nu = sigma_prime.h_prime * r
    local zeta = m * ECP.hashtopoint(uid)
    -- proof --
@@ -225,7 +223,7 @@ function credential.prove_cred_uid(vk, sigma, secret, uid)
    local wm = INT.random()
    local wr = INT.random()
    -- compute the witnessess commitments
-   local Aw = vk.alpha + vk.beta * wm + G2 * wr
+   local Aw = vk.alpha + ECP2.msm({vk.beta, G2}, {wm, wr})
    local Bw = sigma_prime.h_prime * wr
    local Cw = wm * ECP.hashtopoint(uid)
    -- create the challenge
@@ -247,14 +245,12 @@ end
 
 function credential.verify_cred_uid(vk, theta, zeta, uid)
    -- recompute witnessess commitments
-   local Aw =
-      theta.kappa * theta.pi_v.c + G2 * theta.pi_v.rr +
-      vk.alpha * (BIG.new(1) - theta.pi_v.c) +
-      vk.beta * theta.pi_v.rm
-   local Bw =
-      theta.pi_v.rr * theta.sigma_prime.h_prime +
-      theta.nu * theta.pi_v.c
-   local Cw = theta.pi_v.rm * ECP.hashtopoint(uid) + zeta * theta.pi_v.c
+   local Aw = ECP2.msm(
+      {theta.kappa, G2, vk.alpha, vk.beta},
+      {theta.pi_v.c, theta.pi_v.rr, BIG.new(1) - theta.pi_v.c, theta.pi_v.rm})
+   local Bw = ECP.msm({theta.sigma_prime.h_prime, theta.nu},
+                      {theta.pi_v.rr, theta.pi_v.c})
+   local Cw = ECP.msm({ECP.hashtopoint(uid), zeta}, {theta.pi_v.rm, theta.pi_v.c})
    -- compute the challenge prime
    assert(
       theta.pi_v.c == ZKP_challenge({vk.alpha, vk.beta, Aw, Bw, Cw}),
@@ -268,8 +264,9 @@ function credential.verify_cred_uid(vk, theta, zeta, uid)
       2
    )
    assert(
-      ECP2.miller(theta.kappa, theta.sigma_prime.h_prime) ==
-         ECP2.miller(G2, theta.sigma_prime.s_prime + theta.nu),
+      ECP2.pairing_check({
+            { theta.kappa, theta.sigma_prime.h_prime },
+            { G2, (theta.sigma_prime.s_prime + theta.nu):negative() } }),
       'credential verification: invalid signature (miller loop) for UID',
       2
    )
@@ -52,13 +52,13 @@ function ETH.encodeRLP(data)
    end
 
    if type(data) == 'table' then
-      -- empty octet
-      res = O.empty()
+      -- the header is prepended to the whole list at the end
+      res = O.builder()
       for _, v in pairs(data) do
-	 res = res .. ETH.encodeRLP(v)
+	 res:append(ETH.encodeRLP(v))
       end
       if #res < 56 then
-	 res = INT.new(192+#res):octet() .. res
+	 header = INT.new(192+#res):octet()
       else
 	 -- Length of the result to be saved before the bytes themselves
 	 byt = INT.new(#res):octet()
@@ -25,6 +25,9 @@ local CURVE_ORDER = ECP.order()
 local GENERATORS = {["g"] = ECP.new(BIG.new(O.from_hex("07ef3f7f6123b2f5e1ce7c249e0a44c8b18b3671e11d5e233d15742cf538d068f94dfae3ac9966e626a3d6670d78b6ee")), BIG.new(O.from_hex("12d5c20e3ce7143c03491820a7b08c067f25bd9b724985cd95ec862f8cbb31c944f420e59f8f820bccf6e94b72236ca7"))),
     ["G"] = ECP.new(BIG.new(O.from_hex("0a17f5c7ea3abe3654c4b56d709efd293e17e79327e15b2a7eababd02b20edf33bba0a6ff2c801923399c3c9fd6a1718")), BIG.new(O.from_hex("12f6579b77dbc6485107e68fe181e0aeb680f665880c7ded1db5f84c0a3fdc152f299511e4e5f64f1422d21c276f848a")))}
 
+ECP.precompute(GENERATORS.g)
+ECP.precompute(GENERATORS.G)
+
 --------------------------------------- NIZKP ------------------------------------------------------
 
 -- NOTE: the inputs of the following 2 functions are points on the curve.
@@ -54,7 +57,7 @@ function PVSS.create_proof_DLEQ(points_tables, alpha_array, hash, concat_f, det_
     local concat_function = concat_f or PVSS.concatenation
     local w_array = {}
     local r_array = {}
-    local concat = O.empty()
+    local concat = O.builder()
     for k,v in pairs(points_tables) do
         local g1, h1, g2, h2 = table.unpack(v)
         local w
@@ -66,7 +69,7 @@ function PVSS.create_proof_DLEQ(points_tables, alpha_array, hash, concat_f, det_
         w_array[k] = w
         local a1 = g1 * w
         local a2 = g2 * w
-        concat = concat .. concat_function(h1, h2, a1, a2)
+        concat:append(concat_function(h1, h2, a1, a2))
     end
     local c = hash_function(concat)
     c = BIG.mod( BIG.new(c) , CURVE_ORDER)
@@ -89,14 +92,14 @@ end
 function PVSS.verify_proof_DLEQ(points_tables, proof, hash, concat_f)
     local hash_function = hash or sha256
     local concat_function = concat_f or PVSS.concatenation
-    local concat = O.empty()
+    local concat = O.builder()
     local c = table.remove(proof, 1)
     for k,v in pairs(points_tables) do
         local g1, h1, g2, h2 = table.unpack(v)
         local r = proof[k]
-        local a1 = (g1 * r) + (h1 * c)
-        local a2 = (g2 * r) + (h2 * c)
-        concat = concat..concat_function(h1, h2, a1, a2)
+        local a1 = ECP.msm({g1, h1}, {r, c})
+        local a2 = ECP.msm({g2, h2}, {r, c})
+        concat:append(concat_function(h1, h2, a1, a2))
     end
     table.insert(proof,1,c)
     local digest = hash_function(concat)
@@ -219,12 +222,11 @@ function PVSS.verify_shares(generators, t, n, issuer_shares, concat_f)
     local Xs = {}
     local proof_points = {}
     for i=1,n do
-        local value = ECP.infinity()
+        local pows = {}
         for j = 0, (t-1) do
-            local pow = BIG.new(i):modpower(BIG.new(j), CURVE_ORDER)
-            value = value + (issuer_shares.commitments[j+1] * pow)
+            pows[j+1] = BIG.new(i):modpower(BIG.new(j), CURVE_ORDER)
         end
-        Xs[i] = value
+        Xs[i] = ECP.msm({table.unpack(issuer_shares.commitments, 1, t)}, pows)
         proof_points[i] = {generators.g, Xs[i], issuer_shares.public_keys[i], issuer_shares.encrypted_shares[i]}
     end
 
@@ -275,7 +277,7 @@ end
 -- Here we are assuming that the shares have been already verified.
 function PVSS.pooling_shares(shares, indexes, threshold)
     if #shares >= threshold then
-        local secret = ECP.infinity()
+        local coeffs = {}
         for k = 1, threshold do
             local i = indexes[k]
             local lagrange_coeff = BIG.new(1)
@@ -288,9 +290,9 @@ function PVSS.pooling_shares(shares, indexes, threshold)
                     lagrange_coeff = BIG.modmul(lagrange_coeff,factor, CURVE_ORDER)
                 end
             end
-            secret = secret + (shares[k]*lagrange_coeff)
+            coeffs[k] = lagrange_coeff
         end
-        return secret
+        return ECP.msm({table.unpack(shares, 1, threshold)}, coeffs)
     else
         error("The number of shares "..#shares.." is less then the threshold "..threshold, 2)
     end
@@ -90,7 +90,10 @@ end
 ]]
 local JWT_RESERVED_CLAIMS = {"iss", "sub", "aud", "exp", "nbf", "iat", "jti", "typ", "type", "cty", "cnf"}
 
-local NON_SELECTIVELY_DISCLOSABLE_CLAIMS = {"iss", "iat", "exp", "cnf", "type", "_sd", "_sd_alg"}
+local NON_SELECTIVELY_DISCLOSABLE_CLAIMS = {
+    iss = true, iat = true, exp = true, cnf = true, type = true,
+    _sd = true, _sd_alg = true
+}
 
 -- Given as input a selective disclosure request
 -- Return a table containing two keys:
@@ -192,17 +195,6 @@ function sd_jwt.verify_sd_alg(jwt)
     return jwt.payload._sd_alg == O.from_string("sha-256")
 end
 
-local function is_in(list, elem)
-    local found = false
-    for i = 1, #list do
-        if list[i] == elem then
-            found = true
-            break
-        end
-    end
-    return found
-end
-
 -- TODO: In the final version we should check that the sd-jwt payload contains all the mandatory claims below
 -- "iss", "iat", "cnf", "type", if "_sd" => "_sd_alg"
 function sd_jwt.check_mandatory_claim_names(jwt)
@@ -228,7 +220,7 @@ local function disclosure_array_is_valid(arr)
     if type(arr[1]) ~= 'string' or type(arr[2]) ~= 'string' then
         return false
     end
-    if is_in(NON_SELECTIVELY_DISCLOSABLE_CLAIMS, arr[2]) then
+    if NON_SELECTIVELY_DISCLOSABLE_CLAIMS[arr[2]] then
         return false
     end
     return true
@@ -236,20 +228,20 @@ end
 
 function sd_jwt.verify_sd_fields(jwt, disclosures)
     local match = true
-    local digest_arr = jwt._sd
+    local digests = O.set(jwt._sd)
     local disclosures_arr = export_str_dict(disclosures)
     local claim_names = {}
     for i = 1, #disclosures_arr do
         if not disclosure_array_is_valid(disclosures_arr[i]) then
             return false
         end
-        if is_in(claim_names, disclosures_arr[i][2]) then
+        if claim_names[disclosures_arr[i][2]] then
             return false
         else
-            table.insert(claim_names, disclosures_arr[i][2])
+            claim_names[disclosures_arr[i][2]] = true
         end
         local _, hashed = sd_jwt.create_disclosure(disclosures_arr[i])
-        if not is_in(digest_arr, hashed) then
+        if not digests:has(hashed) then
             match = false
             break
         end
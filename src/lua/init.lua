@@ -198,6 +198,7 @@ _G['COPYRIGHT'] =
 Forked by Jaromil on 18 January 2020 from Coconut Petition
 ]]
 SALT = ECP.hashtopoint(OCTET.from_string(COPYRIGHT .. LICENSE))
+ECP.precompute(SALT)
 -- Calculate a system-wide crypto challenge for ZKP operations
 -- returns a BIG INT
 -- this is a sort of salted hash for advanced ZKP operations and
@@ -70,7 +70,9 @@ ZEN = {
 	traceback = {}, -- transferred into HEAP by zencode_begin
 	linenum = 0,
 	last_valid_statement = false,
-	phase = "g"
+	phase = "g",
+	prelude = {}, -- scenarios and rules in order, see ZEN:compile
+	ignored = {} -- lines skipped by the parser, see ZEN:compile
 }
 
 
@@ -91,19 +93,155 @@ function ZEN:add_schema(arr)
 	end
 end
 
+-- register of the steps matched in each state of the parser
+local section_steps <const> = {
+   whenif = 'when',
+   thenif = 'then',
+   whenforeach = 'when',
+   whenforeachif = 'when',
+   whenifforeach = 'when',
+   foreachif = 'foreach',
+   ifforeach = 'if'
+}
+
+-- append a statement x to the AST, tracking loops and branches in Z
+local function ast_append(Z, x)
+   local index <const> = section_steps[x.section] or x.section
+   Z.id = Z.id + 1
+   x.id = Z.id -- ordered number
+   x.f = index == 'foreach' or nil
+   x.ef = index == 'endforeach' or nil
+   x.i = index == 'if' or nil
+   x.ei = index == 'endif' or nil
+   table.insert(AST, x)
+   if index == 'foreach' then
+	  Z.ITER_present = true
+	  Z.ITER[Z.id] = { jump = Z.id, pos = 1 }
+	  table.insert(Z.ITER_parse, Z.id)
+   elseif index == 'endforeach' then
+	  local id = table.remove(Z.ITER_parse)
+	  Z.ITER[id].end_id = Z.id
+   end
+   Z.BRANCH_present = Z.BRANCH_present or index == 'if'
+end
+
+local function set_rule(text)
+   local tr = text.msg:gsub(' +', ' ') -- eliminate multiple internal spaces
+   local rule = strtok(trim(tr):lower())
+   local rules <const> = {
+	  -- TODO: rule debug [ format | encoding ]
+	  -- ['load'] = function(extension)
+	  --	if not extension then return false end
+	  --  act("zencode extension: "..extension)
+	  --  require("zencode_"..extension)
+	  -- 	return true
+	  -- end,
+	  ['check version'] = function (version)
+		 -- TODO: check version of running VM
+		 if not version then return false end
+		 local ver = SEMVER(version)
+		 if ver == ZENROOM_VERSION then
+			act('Zencode version match: ' .. ZENROOM_VERSION.original)
+		 elseif ver < ZENROOM_VERSION then
+			warn('Zencode written for an older version: ' .. ver.original)
+		 elseif ver > ZENROOM_VERSION then
+			warn('Zencode written for a newer version: ' .. ver.original)
+		 else
+			error('Version check error: ' .. version)
+		 end
+		 text.Z.checks.version = true
+		 return true
+	  end,
+	  ['input encoding'] = function (encoding)
+		 if not encoding then return false end
+		 CONF.input.encoding = input_encoding(encoding)
+		 return true and CONF.input.encoding
+	  end,
+	  ['input format'] = function (format)
+		 if not format then return false end
+		 CONF.input.format = get_format(format)
+		 return true and CONF.input.format
+	  end,
+	  ['input untagged'] = function ()
+		 CONF.input.tagged = false
+		 return true
+	  end,
+	  ['input number'] = function (what)
+		if not what or what ~= 'strict' then return false end
+		CONF.input.number_strict = true
+		return true
+	  end,
+	  ['output encoding'] = function (encoding)
+		 if not encoding then return false end
+		 CONF.output.encoding = { fun = get_encoding_function(encoding),
+								  name = encoding }
+		 return true and CONF.output.encoding
+	  end,
+	  ['output format'] = function (format)
+		 if not format then return false end
+		 CONF.output.format = get_format(format)
+		 return true and CONF.output.format
+	  end,
+	  ['output sorting'] = function(what)
+		 if what == 'true' then
+			CONF.output.sorting = true
+		 else
+			CONF.output.sorting = false
+		 end
+		 return true
+	  end,
+	  ['output versioning'] = function ()
+		 CONF.output.versioning = true
+		 return true
+	  end,
+	  ['unknown ignore'] = function ()
+		 CONF.parser.strict_match = false
+		 return true
+	  end,
+	  ['path separator'] = function (separator)
+		if not separator or separator:len() ~= 1 then return false end
+		CONF.path.separator = separator
+		return true
+	 end,
+	  ['set'] = function (conf, value)
+		 if not conf or not value then return false end
+		 CONF[conf] = fif( tonumber(value), tonumber(value),
+						   fif( value=='true', true,
+								fif( value=='false', false,
+									 value)))
+		 return true
+	  end,
+   }
+   local res
+   if rule[2] == 'set' then
+	  res = rules[rule[2]](rule[3], rule[4])
+   else
+	  res = rules[rule[2]..' '..rule[3]] and rules[rule[2]..' '..rule[3]](rule[4])
+   end
+   if res then act(text.msg) else error('Rule invalid: ' .. text.msg, 3) end
+   return res
+end
+-- END local function set_rule
+
+local function heap_init()
+   IN  = {} -- Given processing, import global DATA from json
+   ACK = {} -- When processing,  destination for push*
+   OUT = {} -- print out
+   CODEC = {} -- metadata
+   CACHE = {} -- contract-wide computation cache
+   WHO = nil
+   traceback = {}
+end
+
 function ZEN:begin(new_heap)
    self:crumb()
    if new_heap then
 	  -- TODO: setup with an existing HEAP
    else
-	  IN  = {} -- Given processing, import global DATA from json
-	  ACK = {} -- When processing,  destination for push*
-	  OUT = {} -- print out
-	  CODEC = {} -- metadata
-	  CACHE = {} -- contract-wide computation cache
-	  WHO = nil
-	  traceback = {}
+	  heap_init()
    end
+   self.prelude = {}
+   self.ignored = {}
 
 	-- stateDiagram
     -- [*] --> Given
@@ -120,100 +258,32 @@ function ZEN:begin(new_heap)
     -- Then --> [*]
 
 	local function set_sentence(self, event, from, to, ctx)
-	   local translate <const> = {
-		  whenif = 'when',
-		  thenif = 'then',
-		  whenforeach = 'when',
-		  whenforeachif = 'when',
-		  whenifforeach = 'when',
-		  foreachif = 'foreach',
-		  ifforeach = 'if'
-	   }
 	   local current <const> = self.current
-	   local index <const> = translate[current] or current
+	   local index <const> = section_steps[current] or current
 	   -- save in reg a pointer to array of statements
 	   local reg <const> = ctx.Z[index .. '_steps']
 	   local sentence <const> = ctx.msg
 	   local linenum <const> = ctx.Z.linenum
 	   ctx.Z.OK = false
-	   xxx('Zencode parser from: ' .. from .. " to: "..to, 3)
+	   xxx('Zencode parser from: %s to: %s', 3, from, to)
 	   assert(reg,'Callback register not found: ' .. current)
 	   -- assert(#reg,'Callback register empty: '..current)
-	   local gsub <const> = string.gsub -- optimization
-	   -- TODO: optimize in C
 	   -- remove '' contents, lower everything, expunge prefixes
-	   -- ignore 'the' only in Then statements
-	   local tt = gsub(sentence, "'(.-)'", "''") -- msg trimmed on parse
-	   tt = gsub(tt, ' I ', ' ', 1) -- eliminate first person pronoun
-	   tt = tt:lower() -- lowercase all statement
-	   if to == 'then' or to == 'thenif' then
-		  tt = gsub(tt, ' the ', ' ', 1)
-	   end
-	   if to == 'given' then
-		  tt = gsub(tt, ' the ', ' ', 1)
-		  tt = gsub(tt, ' a ', ' ', 1)
-		  tt = gsub(tt, ' an ', ' ', 1)
-		  tt = gsub(tt, ' have ', ' ', 1)
-		  tt = gsub(tt, ' known as ', ' ', 1)
-		  tt = gsub(tt, ' valid ', ' ', 1)
-	   end
-	   -- prefixes found at beginning of statement
-	   tt = gsub(tt, '^when ', '', 1)
-	   tt = gsub(tt, '^then ', '', 1)
-	   tt = gsub(tt, '^given ', '', 1)
-	   tt = gsub(tt, '^if ', '', 1)
-	   tt = gsub(tt, '^foreach ', '', 1)
-	   tt = gsub(tt, '^and ', '', 1) -- TODO: expunge only first 'and'
-	   -- generic particles
-	   tt = gsub(tt, '^that ', ' ', 1)
-	   tt = gsub(tt, ' the ', ' ')
-	   tt = gsub(tt, '^an ', 'a ', 1) -- equivalence
-	   tt = gsub(tt, ' valid ', ' ', 1) -- backward compat (v1)
-	   tt = gsub(tt, ' all ', ' ', 1)
-	   tt = gsub(tt, ' inside ', ' in ', 1) -- equivalence
-	   -- TODO: expire deprecation then activate equivalence
-	   -- tt = gsub(tt, ' size ', ' length ', 1)
-	   -- trimming
-	   tt = gsub(tt, ' +', ' ') -- eliminate multiple internal spaces
-	   tt = gsub(tt, '^ +', '') -- remove initial spaces
-	   tt = gsub(tt, ' +$', '') -- remove final spaces
-	   --
+	   -- and particles, see zencode_statement in zen_parse.c
+	   local tt <const>, args <const> = zencode_statement(sentence, to)
 	   local func <const> = reg[tt] -- lookup the statement
 	   if func and luatype(func) == 'function' then
-		  local args = {} -- handle multiple arguments in same string
-		  for arg in string.gmatch(sentence, "'(.-)'") do
-			 -- convert all spaces to underscore in argument strings
-			 arg = uscore(arg, ' ', '_')
-			 table.insert(args, arg)
-		  end
-		  ctx.Z.id = ctx.Z.id + 1
 		  -- AST data prototype
-		  table.insert(
-			 AST,
-			 {
-				id = ctx.Z.id, -- ordered number
+		  ast_append(ctx.Z, {
 				args = args, -- array of vars
 				source = sentence, -- source text
+				statement = tt, -- key of hook in reg
 				section = current,
 				from = from,
 				to = to,
 				hook = func,
-				linenum = linenum,
-				f = index == 'foreach' or nil,
-				ef = index == 'endforeach' or nil,
-				i = index == 'if' or nil,
-				ei = index == 'endif' or nil
-			 }
-		  ) -- function
-		  if index == 'foreach' then
-			ctx.Z.ITER_present = true
-			ctx.Z.ITER[ctx.Z.id] = { jump = ctx.Z.id, pos = 1 }
-			table.insert(ctx.Z.ITER_parse, ctx.Z.id)
-		  elseif index == 'endforeach' then
-			local id = table.remove(ctx.Z.ITER_parse)
-			ctx.Z.ITER[id].end_id = ctx.Z.id
-		  end
-		  ctx.Z.BRANCH_present = ctx.Z.BRANCH_present or index == 'if'
+				linenum = linenum
+		  })
 		  ctx.Z.OK = true
 	   end
 	   if not ctx.Z.OK and CONF.parser.strict_match then
@@ -234,6 +304,7 @@ function ZEN:begin(new_heap)
 		   end
 		   if not ctx.Z.OK then
 			   table.insert(traceback, '-'..linenum..'	'..sentence)
+			   table.insert(ctx.Z.ignored, {linenum, sentence})
 			   fif(CONF.parser.strict_parse, warn, error)('Zencode line '..linenum..' pattern ignored: ' .. sentence, 1)
 		   end
 	   end
@@ -242,103 +313,6 @@ function ZEN:begin(new_heap)
 	end
 	-- END local function set_sentence
 
-	local function set_rule(text)
-	   local tr = text.msg:gsub(' +', ' ') -- eliminate multiple internal spaces
-	   local rule = strtok(trim(tr):lower())
-	   local rules <const> = {
-		  -- TODO: rule debug [ format | encoding ]
-		  -- ['load'] = function(extension)
-		  --	if not extension then return false end
-		  --  act("zencode extension: "..extension)
-		  --  require("zencode_"..extension)
-		  -- 	return true
-		  -- end,
-		  ['check version'] = function (version)
-			 -- TODO: check version of running VM
-			 if not version then return false end
-			 local ver = SEMVER(version)
-			 if ver == ZENROOM_VERSION then
-				act('Zencode version match: ' .. ZENROOM_VERSION.original)
-			 elseif ver < ZENROOM_VERSION then
-				warn('Zencode written for an older version: ' .. ver.original)
-			 elseif ver > ZENROOM_VERSION then
-				warn('Zencode written for a newer version: ' .. ver.original)
-			 else
-				error('Version check error: ' .. version)
-			 end
-			 text.Z.checks.version = true
-			 return true
-		  end,
-		  ['input encoding'] = function (encoding)
-			 if not encoding then return false end
-			 CONF.input.encoding = input_encoding(encoding)
-			 return true and CONF.input.encoding
-		  end,
-		  ['input format'] = function (format)
-			 if not format then return false end
-			 CONF.input.format = get_format(format)
-			 return true and CONF.input.format
-		  end,
-		  ['input untagged'] = function ()
-			 CONF.input.tagged = false
-			 return true
-		  end,
-		  ['input number'] = function (what)
-			if not what or what ~= 'strict' then return false end
-			CONF.input.number_strict = true
-			return true
-		  end,
-		  ['output encoding'] = function (encoding)
-			 if not encoding then return false end
-			 CONF.output.encoding = { fun = get_encoding_function(encoding),
-									  name = encoding }
-			 return true and CONF.output.encoding
-		  end,
-		  ['output format'] = function (format)
-			 if not format then return false end
-			 CONF.output.format = get_format(format)
-			 return true and CONF.output.format
-		  end,
-		  ['output sorting'] = function(what)
-			 if what == 'true' then
-				CONF.output.sorting = true
-			 else
-				CONF.output.sorting = false
-			 end
-			 return true
-		  end,
-		  ['output versioning'] = function ()
-			 CONF.output.versioning = true
-			 return true
-		  end,
-		  ['unknown ignore'] = function ()
-			 CONF.parser.strict_match = false
-			 return true
-		  end,
-		  ['path separator'] = function (separator)
-			if not separator or separator:len() ~= 1 then return false end
-			CONF.path.separator = separator
-			return true
-		 end,
-		  ['set'] = function (conf, value)
-			 if not conf or not value then return false end
-			 CONF[conf] = fif( tonumber(value), tonumber(value),
-							   fif( value=='true', true,
-									fif( value=='false', false,
-										 value)))
-			 return true
-		  end,
-	   }
-	   local res
-	   if rule[2] == 'set' then
-		  res = rules[rule[2]](rule[3], rule[4])
-	   else
-		  res = rules[rule[2]..' '..rule[3]] and rules[rule[2]..' '..rule[3]](rule[4])
-	   end
-	   if res then act(text.msg) else error('Rule invalid: ' .. text.msg, 3) end
-	   return res
-	end
-	-- END local function set_rule
 
 	-- state machine callback events
 	-- graph TD
@@ -365,6 +339,7 @@ function ZEN:begin(new_heap)
 			 strtok(string.match(trim(msg.msg):lower(), '[^:]+'))
 		  for k, scen in ipairs(scenarios) do
 			 if k ~= 1 then -- skip first (prefix)
+				table.insert(msg.Z.prelude, {'scenario', trimq(scen)})
 				load_scenario('zencode_' .. trimq(scen))
 				-- self:trace('Scenario ' .. scen)
 				return
@@ -373,7 +348,10 @@ function ZEN:begin(new_heap)
 	   end,
 	   onrule = function(self, event, from, to, msg)
 		  -- process rules immediately
-		  if msg then	set_rule(msg) end
+		  if msg then
+			 table.insert(msg.Z.prelude, {'rule', msg.msg})
+			 set_rule(msg)
+		  end
 	   end,
 	   ongiven = set_sentence,
 	   onthen = set_sentence,
@@ -434,7 +412,7 @@ function ZEN:begin(new_heap)
 		events = events,
 		callbacks = callbacks
 	})
-	collectgarbage 'collect'
+	gc_release()
 	-- Zencode init traceback
 	return true
 end
@@ -559,6 +537,7 @@ function ZEN:parse(text)
 			if ZEN.phase == 'g' and not ZEN.last_valid_statement then
 				if CONF.parser.strict_parse then
 					table.insert(traceback, '-'..self.linenum..'  '..line)
+					table.insert(self.ignored, {self.linenum, line})
 					warn('Zencode line '..self.linenum..' pattern ignored: ' .. line, 1)
 				else
 					table.insert(res.ignored, {line, self.linenum})
@@ -567,6 +546,7 @@ function ZEN:parse(text)
 				ZEN.last_valid_statement = false
 				if CONF.parser.strict_parse then
 					table.insert(traceback, '-'..self.linenum..'  '..line)
+					table.insert(self.ignored, {self.linenum, line})
 					warn('Zencode line '..self.linenum..' pattern ignored: ' .. line, 1)
 				 else
 					table.insert(res.ignored, {line, self.linenum})
@@ -596,7 +576,7 @@ function ZEN:parse(text)
    end
 	check_open_branching_or_looping('branching', branching)
 	check_open_branching_or_looping('looping', looping)
-   collectgarbage'collect'
+   gc_release()
    if res == true then
 	  return true
    else
@@ -605,6 +585,84 @@ function ZEN:parse(text)
 end
 
 
+--- Compiled form of the contract parsed by ZEN:parse, a table that
+-- can be encoded to JSON and executed many times by ZEN:load and
+-- ZEN:run without parsing it again. Statements refer to their hook
+-- by its key in the steps register, looked up again on load.
+function ZEN:compile()
+   self:crumb()
+   local ast <const> = {}
+   for _, x in ipairs(AST) do
+	  table.insert(ast, {
+		 args = x.args,
+		 source = x.source,
+		 statement = x.statement,
+		 section = x.section,
+		 from = x.from,
+		 to = x.to,
+		 linenum = x.linenum
+	  })
+   end
+   return {
+	  zenroom = ZENROOM_BUILD, -- version and scenarios it runs on
+	  digest = DIGEST, -- sha256 of the script
+	  scope = CONF.exec.scope,
+	  prelude = self.prelude,
+	  ignored = self.ignored, -- lines skipped by the parser
+	  ast = ast
+   }
+end
+
+--- Load a contract compiled by ZEN:compile in place of ZEN:begin
+-- and ZEN:parse: loads its scenarios, applies its rules and fills
+-- the AST. Fails if compiled by another build of Zenroom, for another
+-- scope, or if a statement is not found in the scenarios.
+function ZEN:load(compiled)
+   self:crumb()
+   if compiled.zenroom ~= ZENROOM_BUILD then
+	  error('Compiled contract built for another Zenroom: '
+			..tostring(compiled.zenroom), 2)
+   end
+   if compiled.scope ~= CONF.exec.scope then
+	  error('Compiled contract built for scope: '..tostring(compiled.scope), 2)
+   end
+   heap_init()
+   for _, p in ipairs(compiled.prelude) do
+	  if p[1] == 'scenario' then
+		 load_scenario('zencode_' .. p[2])
+	  else
+		 set_rule({ msg = p[2], Z = self })
+	  end
+   end
+   self.ignored = compiled.ignored
+   for _, t in ipairs(compiled.ignored) do
+	  local linenum <const>, line <const> = t[1], t[2]
+	  table.insert(traceback, '-'..linenum..'  '..line)
+	  warn('Zencode line '..linenum..' pattern ignored: ' .. line, 1)
+   end
+   for _, x in ipairs(compiled.ast) do
+	  local index <const> = section_steps[x.section] or x.section
+	  local reg <const> = self[index .. '_steps']
+	  local hook <const> = reg and reg[x.statement]
+	  if not hook then
+		 error('Compiled statement not found at line '..x.linenum
+			   ..': '..x.source, 2)
+	  end
+	  ast_append(self, {
+		 args = x.args,
+		 source = x.source,
+		 statement = x.statement,
+		 section = x.section,
+		 from = x.from,
+		 to = x.to,
+		 hook = hook,
+		 linenum = x.linenum
+	  })
+   end
+   gc_release()
+   return true
+end
+
 local function IN_uscore(i)
 	-- convert all element keys of IN to underscore
 	local res = {}
@@ -716,10 +774,26 @@ local function AST_iterator()
 end
 
 
+-- statements kept in the traceback of a run: the entries before it
+-- are kept, the older ones in between are dropped once they double
+local TRACE_TAIL <const> = 512
+
 function ZEN:run()
    self:crumb()
+   local trace_head <const> = #traceback
+   local trace_dropped = 0
    local runtime_trace = function(x)
-	  table.insert(traceback, '+'..x.linenum..'  '..x.source)
+	  local n <const> = #traceback
+	  local first <const> = trace_head + (trace_dropped > 0 and 2 or 1)
+	  local drop <const> = n - first + 1 - TRACE_TAIL
+	  if drop > TRACE_TAIL then
+		 table.move(traceback, first + drop, n, trace_head + 2)
+		 for i = trace_head + 2 + TRACE_TAIL, n do traceback[i] = nil end
+		 trace_dropped = trace_dropped + drop
+		 traceback[trace_head + 1] =
+			' .  ('..trace_dropped..' trace lines dropped)'
+	  end
+	  traceback[#traceback + 1] = '+'..x.linenum..'  '..x.source
    end
    local runtime_error = function(x, err)
 	  table.insert(traceback, '[!] Error at Zencode line '..x.linenum)
@@ -733,11 +807,14 @@ function ZEN:run()
    end
    -- HEAP setup
    local tmp
+   -- bytes of input strings dropped once decoded
+   local released = 0
    if EXTRA then
 	  tmp  = CONF.input.format.fun(EXTRA) or {}
 	  for k, v in pairs(tmp) do
 		 IN[k] = v
 	  end
+	  released = released + #EXTRA
 	  EXTRA = nil
    end
    if DATA then
@@ -748,6 +825,7 @@ function ZEN:run()
 		 end
 		 IN[k] = v
 	  end
+	  released = released + #DATA
 	  DATA = nil
    end
    if KEYS then
@@ -758,10 +836,11 @@ function ZEN:run()
 		 end
 		 IN[k] = v
 	  end
+	  released = released + #KEYS
 	  KEYS = nil
    end
    tmp = nil
-   collectgarbage 'collect'
+   gc_release(released // 1024)
 
    -- convert all spaces in keys to underscore
    IN = IN_uscore(IN)
@@ -772,7 +851,7 @@ function ZEN:run()
 		if x.from == 'given' and x.to ~= 'given' then
 			-- delete IN memory
 			IN = {}
-			collectgarbage 'collect'
+			gc_release()
 		end
 		-- HEAP integrity guard
 		if CONF.heapguard then -- watchdog
@@ -793,8 +872,12 @@ function ZEN:run()
 		-- give a notice about the CACHE being used
 		-- TODO: print it in debug
 		if #CACHE > 0 then xxx('Contract CACHE is in use') end
-		if collectgarbage('count') > MAXMEM then
-			collectgarbage('collect')
+		-- collector step within the budget, or a full collection
+		-- when memory is over the limit
+		if memory_count() > MAXMEM then
+			gc_collect()
+		else
+			gc_step()
 		end
 	end
    -- PRINT output
@@ -856,8 +939,10 @@ end
 
 ------------------------------------------
 -- ZENCODE STATEMENT DECLARATION FUNCTIONS
+-- statements are indexed in the same normal form set_sentence looks
+-- them up with, see zencode_statement in zen_parse.c
 function Given(text, fn)
-   text = text:lower()
+   text = zencode_statement(text, 'given')
    if ZEN.given_steps[text] then
 	  error('Conflicting GIVEN statement loaded by scenario: ' .. text, 2)
    end
@@ -868,7 +953,7 @@ function When(text, fn)
 	  text = nil
 	  fn = nil
    else
-	  text = text:lower()
+	  text = zencode_statement(text, 'when')
 	  if ZEN.when_steps[text] then
 		 error('Conflicting WHEN statement loaded by scenario: ' .. text, 2)
 	  end
@@ -880,7 +965,7 @@ function IfWhen(text, fn)
 	  text = nil
 	  fn = nil
    else
-	  text = text:lower()
+	  text = zencode_statement(text, 'if')
 	  if ZEN.if_steps[text] then
 		 error('Conflicting IF-WHEN statement loaded by scenario: '..text, 2)
 	  end
@@ -896,7 +981,7 @@ function Foreach(text, fn)
 	  text = nil
 	  fn = nil
    else
-	  text = text:lower()
+	  text = zencode_statement(text, 'foreach')
 	  if ZEN.foreach_steps[text] then
 			error('Conflicting FOREACH statement loaded by scenario: ' .. text, 2)
 	  end
@@ -908,7 +993,7 @@ function Then(text, fn)
 	  text = nil
 	  fn = nil
    else
-	  text = text:lower()
+	  text = zencode_statement(text, 'then')
 	  if ZEN.then_steps[text] then
 			error('Conflicting THEN statement loaded by scenario : ' .. text, 2)
 	  end
@@ -445,7 +445,7 @@ end
 function new_cache(key, val)
    if not key then error("new_cache called with empty key", 2) end
    if not val then error("new_cache called with empty value", 2) end
-   xxx("zencode_cache set value: "..key)
+   xxx("zencode_cache set value: %s", nil, key)
    CACHE[uscore(key)] = val
 end
 
@@ -18,10 +18,12 @@
 --]]
 
 
--- quick internal debugging facility
-function xxx(s, n)
+-- quick internal debugging facility, the optional arguments after
+-- the level are formatted in s only when the message is printed
+function xxx(s, n, ...)
    local n <const> = n or 3
    if DEBUG >= n then
+	  if select('#', ...) > 0 then s = string.format(s, ...) end
 	  if LOGFMT == 'JSON' then
 		 printerr("\"LUA "..s.."\",")
 	  else
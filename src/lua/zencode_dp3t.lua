@@ -66,15 +66,15 @@ When("create proximity tracing of infected ids", function()
 		zencode_assert(ACK.broadcast_key, "Broadcast key not found")
 		ACK.proximity_tracing = { }
 		local epd = (24*60)/epoch -- num epochs per day
-		local zero = OCTET.zero(epd*16) -- 0 byte buffer
+		-- the first 16 bytes of the keystream only need one block
+		local zero = OCTET.zero(16)
+		local ephs = OCTET.set(ACK.ephemeral_ids)
 		for n,sk in ipairs(ACK.list_of_infected) do
 		   local PRF = SHA256:hmac(sk, ACK.broadcast_key)
 		   for i = 0,epd,1 do
-			  local PRG = OCTET.chop( AES.ctr_encrypt(PRF, zero, O.from_number(i)), 16)
-			  for nn,eph in next, ACK.ephemeral_ids, nil do
-				 if eph == PRG then
-					table.insert(ACK.proximity_tracing, sk)
-				 end
+			  local PRG = AES.ctr_encrypt(PRF, zero, O.from_number(i))
+			  if ephs:has(PRG) then
+				 table.insert(ACK.proximity_tracing, sk)
 			  end
 		   end
 		end
@@ -88,3 +88,23 @@ IfWhen("verify '' has a eddsa signature in '' by ''",function(msg, sig, by)
 	     'The eddsa signature by '..by..' is not authentic'
 	  )
 end)
+
+-- verify all the signatures in an array, each one of the message at
+-- the same position in the messages array and by the public key at
+-- the same position in the public keys array
+IfWhen("verify array '' has eddsa signatures in '' by ''",function(msgs, sigs, by)
+	  local m, m_codec = have(msgs)
+	  local s, s_codec = have(sigs)
+	  local pk, pk_codec = have(by)
+	  zencode_assert(m_codec.zentype == 'a' and s_codec.zentype == 'a'
+			 and pk_codec.zentype == 'a',
+			 'The eddsa messages, signatures and public keys must be arrays')
+	  zencode_assert(#m == #s and #m == #pk,
+			 'The eddsa messages, signatures and public keys differ in length')
+	  local serialized = { }
+	  for i, v in ipairs(m) do serialized[i] = zencode_serialize(v) end
+	  local valid, failed = ED.verify_batch(pk, s, serialized)
+	  zencode_assert(valid,
+			 'The eddsa signatures in '..sigs..' are not authentic at position: '
+			 ..table.concat(failed, ', '))
+end)
@@ -307,6 +307,39 @@ When("create mlkem512 secret from ''",function(secret)
 	new_codec('mlkem512 secret')
 end)
 
+-- create a kem for each public key in an array or dictionary, the
+-- result has the same keys
+When("create mlkem512 kems for ''",function(pubs)
+	local pks, pks_codec = have(pubs)
+	zencode_assert(pks_codec.zentype == 'a' or pks_codec.zentype == 'd',
+				   'The mlkem512 public keys must be an array or a dictionary')
+	empty'mlkem512 kems'
+	local keys, arr = { }, { }
+	for k, v in pairs(pks) do
+		table.insert(keys, k)
+		table.insert(arr, v)
+	end
+	local enc = QP.mlkem_enc_batch(arr)
+	ACK.mlkem512_kems = { }
+	for i, k in ipairs(keys) do
+		ACK.mlkem512_kems[k] = {
+			mlkem512_ciphertext = enc[i].cipher,
+			mlkem512_secret = enc[i].secret
+		}
+	end
+	new_codec('mlkem512 kems', { zentype = pks_codec.zentype })
+end)
+-- create the secrets starting from an array of ciphertexts
+When("create mlkem512 secrets from ''",function(ciphertexts)
+	local sk = havekey'mlkem512'
+	local cts, cts_codec = have(ciphertexts)
+	zencode_assert(cts_codec.zentype == 'a',
+				   'The mlkem512 ciphertexts must be an array')
+	empty'mlkem512 secrets'
+	ACK.mlkem512_secrets = QP.mlkem_dec_batch(sk, cts)
+	new_codec('mlkem512 secrets', { zentype = 'a' })
+end)
+
 --# NTRUP #--
 
 -- generate the private key
@@ -392,3 +425,22 @@ IfWhen("verify '' has a mldsa44 signature in '' by ''",function(msg, sig, by)
 	     'The mldsa44 signature by '..by..' is not authentic'
 	  )
 end)
+
+-- verify all the signatures in an array, each one of the message at
+-- the same position in the messages array, by the same public key
+IfWhen("verify array '' has mldsa44 signatures in '' by ''",function(msgs, sigs, by)
+	  local pk = load_pubkey_compat(by, 'mldsa44')
+	  local m, m_codec = have(msgs)
+	  local s, s_codec = have(sigs)
+	  local ctx = mayhave'ctx' or nil
+	  zencode_assert(m_codec.zentype == 'a' and s_codec.zentype == 'a',
+			 'The mldsa44 messages and signatures must be arrays')
+	  zencode_assert(#m == #s,
+			 'The mldsa44 messages and signatures differ in length')
+	  local serialized = { }
+	  for i, v in ipairs(m) do serialized[i] = zencode_serialize(v) end
+	  local valid, failed = QP.mldsa44_verify_batch(pk, s, serialized, ctx)
+	  zencode_assert(valid,
+			 'The mldsa44 signatures in '..sigs..' are not authentic at position: '
+			 ..table.concat(failed, ', '))
+end)
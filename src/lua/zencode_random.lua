@@ -66,7 +66,9 @@ When("seed random with ''",
          zencode_assert(iszen(type(s)), "New random seed is not a valid zenroom type: "..seed)
          local fingerprint = random_seed(s:octet()) -- pass the seed for srand init
          act("New random seed of "..#s.." bytes")
-         xxx("New random fingerprint: "..fingerprint:hex())
+         if DEBUG >= 3 then -- do not encode the fingerprint otherwise
+             xxx("New random fingerprint: %s", 3, fingerprint:hex())
+         end
      end
 )
 
@@ -274,7 +274,7 @@ IfWhen("verify reflow signature fingerprint is new", function()
         return
     end
     zencode_assert(
-        not ACK.reflow_seal.fingerprints[ACK.reflow_signature.zeta],
+        not O.set(ACK.reflow_seal.fingerprints):has(ACK.reflow_signature.zeta),
         'Signature fingerprint is not new'
     )
 end)
@@ -304,9 +304,9 @@ end)
 IfWhen("verify reflow seal is valid",function()
         have 'reflow_seal'
         zencode_assert(
-            ECP2.miller(ACK.reflow_seal.verifier, ACK.reflow_seal.identity)
-            ==
-            ECP2.miller(G2, ACK.reflow_seal.SM),
+            ECP2.pairing_check({
+                { ACK.reflow_seal.verifier, ACK.reflow_seal.identity },
+                { G2, ACK.reflow_seal.SM:negative() } }),
             "reflow seal doesn't validates"
         )
 end)
@@ -400,9 +400,9 @@ IfWhen("verify material passport of ''",function(obj)
 				 "Object does not match material passport identity (needs track and trace?): "..obj)
 	  local SID = UID + _aggregate_array(mp.seal.fingerprints)
 	  zencode_assert(
-		 ECP2.miller(mp.seal.verifier, SID)
-		 ==
-		 ECP2.miller(G2, mp.seal.SM),
+		 ECP2.pairing_check({
+			   { mp.seal.verifier, SID },
+			   { G2, mp.seal.SM:negative() } }),
 		 "Object matches, but seal is invalid: "..obj)
 	  zencode_assert(
 		 ABC.verify_cred_uid(pub, mp.proof, mp.zeta, SID),
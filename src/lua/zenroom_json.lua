@@ -27,24 +27,10 @@ J.decode = function(data)
    if not data then error("JSON.decode called without argument", 2) end
    if #data < 2 then error("JSON.decode argument is empty string", 2) end
    if luatype(data) ~= "string" then error("JSON.decode argument of unsopported type: "..luatype(data), 2) end
-   local res = {}
-   local right = tostring(data)
-   local left
-   local tmp
-   while right and right ~= "" do
-      left, right = jsontok(right) -- function in zen_parser.c
-      if not left then
-         error("JSON decode input is not a encoded table", 2)
-         break
-      end
-      tmp = JSON.raw_decode(left)
-      if luatype(tmp) == 'table' then
-            for k,v in pairs(tmp) do
-               res[k] = v
-            end
-      else
-         error("JSON decode has not returned a table", 2)
-      end
+   -- single pass decoder in zen_parse.c, merges concatenated tables
+   local res <const> = jsondecode(data)
+   if not res then
+      error("JSON decode input is not a encoded table", 2)
    end
    return res
 end
@@ -54,13 +40,10 @@ J.encode = function(tab,enc,whitespace)
    if luatype(tab) ~= 'table' then
     error("JSON encode input is not a table", 2)
    end
-   return
-      JSON.raw_encode(
-	 -- process encodes zencode types
-	 -- it is part of inspect.lua
-	 INSPECT.process(tab, enc or CONF.output.encoding.name),
-	 whitespace
-      )
+   -- single walk encoder in zen_parse.c, exports zencode types
+   -- as INSPECT.process and formats as JSON.raw_encode
+   return jsonencode(tab, enc or CONF.output.encoding.name,
+                     CONF.output.sorting, whitespace)
 end
 
 J.auto = function(obj)
@@ -0,0 +1,110 @@
+--[[
+--This file is part of zenroom
+--
+--Copyright (C) 2024 Dyne.org foundation
+--designed, written and maintained by Denis Roio <jaromil@dyne.org>
+--
+--This program is free software: you can redistribute it and/or modify
+--it under the terms of the GNU Affero General Public License v3.0
+--
+--This program is distributed in the hope that it will be useful,
+--but WITHOUT ANY WARRANTY; without even the implied warranty of
+--MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+--GNU Affero General Public License for more details.
+--
+--Along with this program you should have received a copy of the
+--GNU Affero General Public License v3.0
+--If not, see http://www.gnu.org/licenses/agpl.txt
+--]]
+
+-- Warm VM snapshot and restore, used by zen_pool_* in zenroom.c
+--
+-- A snapshot is taken once right after init.lua has bootstrapped the
+-- VM, then restore() brings the Lua state back to it before each new
+-- execution: globals, library tables, REQUIRED modules and SCENARIOS,
+-- ZEN parser state and CONF are all rolled back, while the per-run
+-- HEAP (IN, ACK, OUT, CODEC, CACHE, AST...) is recreated empty.
+
+local pool = { }
+
+-- HEAP globals recreated empty at every run
+local heap <const> = { 'AST', 'IN', 'TMP', 'ACK', 'CACHE', 'OUT', 'CODEC' }
+-- tables restored recursively (their sub-tables are state as well)
+local deep <const> = { ZEN = true, CONF = true }
+
+local snap = nil
+
+local function deepcopy(t, seen)
+   if type(t) ~= 'table' then return t end
+   seen = seen or { }
+   if seen[t] then return seen[t] end
+   local res <const> = { }
+   seen[t] = res
+   for k, v in next, t do
+	  rawset(res, k, deepcopy(v, seen))
+   end
+   return setmetatable(res, getmetatable(t))
+end
+
+local function shallowcopy(t)
+   local res <const> = { }
+   for k, v in next, t do rawset(res, k, v) end
+   return res
+end
+
+-- bring table t back to the contents of s, in place to preserve
+-- references held by closures and upvalues
+local function restore_table(t, s)
+   for k in next, t do
+	  if rawget(s, k) == nil then rawset(t, k, nil) end
+   end
+   for k, v in next, s do
+	  if rawget(t, k) ~= v then rawset(t, k, v) end
+   end
+end
+
+function pool.snapshot()
+   local G <const> = _G
+   snap = { globals = shallowcopy(G), tables = { }, deep = { } }
+   for _, k in ipairs(heap) do snap.globals[k] = nil end
+   for k, v in next, snap.globals do
+	  if deep[k] then
+		 snap.deep[k] = deepcopy(v)
+	  elseif type(v) == 'table' and v ~= G then
+		 snap.tables[v] = shallowcopy(v)
+	  end
+   end
+   return true
+end
+
+function pool.restore()
+   assert(snap, 'VM pool restore called without a snapshot')
+   local G <const> = _G
+   -- first the contents of tables created at init
+   for t, s in next, snap.tables do restore_table(t, s) end
+   -- then globals, which may have been replaced or added
+   restore_table(G, snap.globals)
+   for k, s in next, snap.deep do
+	  -- a fresh copy keeps the snapshot untouched by this run
+	  restore_table(G[k], deepcopy(s))
+   end
+   for _, k in ipairs(heap) do G[k] = { } end
+   G.WHO = nil
+   G.traceback = { }
+   return true
+end
+
+-- apply the per-run configuration globals set by zen_pool_exec
+function pool.configure()
+   local G <const> = _G
+   G.MAXITER = tonumber(STR_MAXITER)
+   G.MAXMEM = tonumber(STR_MAXMEM) * 1024
+   if DEBUG > 1 or MAKETARGET == "linux-debug" then
+	  CONF.heapguard = true
+   else
+	  CONF.heapguard = false
+   end
+   return true
+end
+
+return pool
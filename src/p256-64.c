@@ -0,0 +1,903 @@
+/*
+ * Implementation of curve P-256 (ECDH and ECDSA) on 64-bit limbs
+ *
+ * Same interface as p256-m.c, selected at build time with -DP256_64 on
+ * hosts with 64x64->128 bit multiplication.
+ *
+ * - field and scalar arithmetic in the Montgomery domain on 4 limbs
+ * - points in homogeneous projective coordinates, added and doubled
+ *   with the complete formulas of [RCB15] (algorithms 4 and 6, a = -3)
+ * - k * G on a table of d * 16^i * G for each 4 bit window of the
+ *   scalar, selected in constant time: 64 additions and no doublings
+ * - k * P for ECDH on a 4 bit fixed window, in constant time
+ * - u1 * G + u2 * Q for verify as one joint wNAF multiplication,
+ *   on the odd multiples of G (width 7) and Q (width 5)
+ *
+ * The G tables are built at first use and shared by all threads.
+ *
+ * References:
+ * - [RCB15]: Complete addition formulas for prime order elliptic curves;
+ *   Renes, Costello, Batina; IACR e-print 2015-1060.
+ * - [SEC1] SEC 1: Elliptic Curve Cryptography, Certicom research, 2009.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zen_error.h>
+#include <zen_octet.h>
+
+#include <p256-m.h> // includes zenroom.h
+#include <zen_once.h>
+
+#if defined(P256_64)
+
+#include <stdlib.h>
+
+__extension__ typedef unsigned __int128 u128;
+
+static void zeroize(void *d, size_t n)
+{
+	volatile char *p = d;
+	while (n--)
+		*p++ = 0;
+}
+
+/**********************************************************************
+ *
+ * Modular arithmetic, least significant limb first
+ *
+ **********************************************************************/
+
+typedef struct {
+	uint64_t m[4];
+	uint64_t R2[4]; /* 2^512 mod m */
+	uint64_t one[4]; /* 2^256 mod m */
+	uint64_t ni; /* -m^-1 mod 2^64 */
+} m64_mod;
+
+static const m64_mod p256_p = {
+	{ 0xffffffffffffffff, 0x00000000ffffffff, 0x0000000000000000, 0xffffffff00000001 },
+	{ 0x0000000000000003, 0xfffffffbffffffff, 0xfffffffffffffffe, 0x00000004fffffffd },
+	{ 0x0000000000000001, 0xffffffff00000000, 0xffffffffffffffff, 0x00000000fffffffe },
+	0x0000000000000001
+};
+
+static const m64_mod p256_n = {
+	{ 0xf3b9cac2fc632551, 0xbce6faada7179e84, 0xffffffffffffffff, 0xffffffff00000000 },
+	{ 0x83244c95be79eea2, 0x4699799c49bd6fa6, 0x2845b2392b6bec59, 0x66e12d94f3d95620 },
+	{ 0x0c46353d039cdaaf, 0x4319055258e8617b, 0x0000000000000000, 0x00000000ffffffff },
+	0xccd1c8aaee00bc4f
+};
+
+/* curve b and generator, Montgomery domain */
+static const uint64_t p256_b[4] = {
+	0xd89cdf6229c4bddf, 0xacf005cd78843090, 0xe5a220abf7212ed6, 0xdc30061d04874834
+};
+static const uint64_t p256_gx[4] = {
+	0x79e730d418a9143c, 0x75ba95fc5fedb601, 0x79fb732b77622510, 0x18905f76a53755c6
+};
+static const uint64_t p256_gy[4] = {
+	0xddf25357ce95560a, 0x8b4ab8e4ba19e45c, 0xd2e88688dd21f325, 0x8571ff1825885d85
+};
+
+static void u256_copy(uint64_t z[4], const uint64_t x[4])
+{
+	z[0] = x[0]; z[1] = x[1]; z[2] = x[2]; z[3] = x[3];
+}
+
+/* z = x if c else z, c in {0, 1}, in constant time */
+static void u256_cmov(uint64_t z[4], const uint64_t x[4], uint64_t c)
+{
+	const uint64_t mask = -c;
+	for (int i = 0; i < 4; i++)
+		z[i] ^= (z[i] ^ x[i]) & mask;
+}
+
+/* z = x + y, returns the carry */
+static uint64_t u256_add(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	u128 c = 0;
+	for (int i = 0; i < 4; i++) {
+		c += (u128)x[i] + y[i];
+		z[i] = (uint64_t)c;
+		c >>= 64;
+	}
+	return (uint64_t)c;
+}
+
+/* z = x - y, returns the borrow */
+static uint64_t u256_sub(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	uint64_t b = 0;
+	for (int i = 0; i < 4; i++) {
+		u128 d = (u128)x[i] - y[i] - b;
+		z[i] = (uint64_t)d;
+		b = (uint64_t)(d >> 64) & 1;
+	}
+	return b;
+}
+
+/* 0 if x == y, non-zero otherwise, in constant time */
+static uint64_t u256_diff(const uint64_t x[4], const uint64_t y[4])
+{
+	return (x[0] ^ y[0]) | (x[1] ^ y[1]) | (x[2] ^ y[2]) | (x[3] ^ y[3]);
+}
+
+/* 1 if x == 0, 0 otherwise, in constant time */
+static uint64_t u64_iszero(uint64_t x)
+{
+	return 1 ^ ((x | -x) >> 63);
+}
+
+static uint64_t u256_iszero(const uint64_t x[4])
+{
+	return u64_iszero(x[0] | x[1] | x[2] | x[3]);
+}
+
+static void u256_from_bytes(uint64_t z[4], const uint8_t p[32])
+{
+	for (int i = 0; i < 4; i++) {
+		const uint8_t *b = p + 8 * (3 - i);
+		z[i] = (uint64_t)b[0] << 56 | (uint64_t)b[1] << 48 |
+			(uint64_t)b[2] << 40 | (uint64_t)b[3] << 32 |
+			(uint64_t)b[4] << 24 | (uint64_t)b[5] << 16 |
+			(uint64_t)b[6] << 8 | (uint64_t)b[7];
+	}
+}
+
+static void u256_to_bytes(uint8_t p[32], const uint64_t z[4])
+{
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 8; j++)
+			p[8 * (3 - i) + j] = (uint8_t)(z[i] >> (56 - 8 * j));
+}
+
+/* z = x + y mod m, x and y in [0, m) */
+static void m64_add(uint64_t z[4], const uint64_t x[4], const uint64_t y[4],
+		    const m64_mod *mod)
+{
+	uint64_t t[4];
+	const uint64_t c = u256_add(z, x, y);
+	const uint64_t b = u256_sub(t, z, mod->m);
+	u256_cmov(z, t, c | (1 ^ b));
+}
+
+/* z = x - y mod m, x and y in [0, m) */
+static void m64_sub(uint64_t z[4], const uint64_t x[4], const uint64_t y[4],
+		    const m64_mod *mod)
+{
+	uint64_t t[4];
+	const uint64_t b = u256_sub(z, x, y);
+	u256_add(t, z, mod->m);
+	u256_cmov(z, t, b);
+}
+
+/*
+ * Montgomery multiplication
+ *
+ * in: x, y in [0, m)
+ * out: z = x * y / 2^256 mod m, in [0, m)
+ */
+static void m64_mul(uint64_t z[4], const uint64_t x[4], const uint64_t y[4],
+		    const m64_mod *mod)
+{
+	uint64_t t[6] = { 0, 0, 0, 0, 0, 0 };
+	const uint64_t *m = mod->m;
+	for (int i = 0; i < 4; i++) {
+		u128 uv;
+		uint64_t c = 0;
+		for (int j = 0; j < 4; j++) {
+			uv = (u128)x[j] * y[i] + t[j] + c;
+			t[j] = (uint64_t)uv;
+			c = (uint64_t)(uv >> 64);
+		}
+		uv = (u128)t[4] + c;
+		t[4] = (uint64_t)uv;
+		t[5] = (uint64_t)(uv >> 64);
+
+		const uint64_t q = t[0] * mod->ni;
+		uv = (u128)q * m[0] + t[0];
+		c = (uint64_t)(uv >> 64);
+		for (int j = 1; j < 4; j++) {
+			uv = (u128)q * m[j] + t[j] + c;
+			t[j - 1] = (uint64_t)uv;
+			c = (uint64_t)(uv >> 64);
+		}
+		uv = (u128)t[4] + c;
+		t[3] = (uint64_t)uv;
+		t[4] = t[5] + (uint64_t)(uv >> 64);
+	}
+	/* t < 2m, subtract m once if needed */
+	uint64_t r[4];
+	const uint64_t b = u256_sub(r, t, m);
+	u256_copy(z, t);
+	u256_cmov(z, r, t[4] | (1 ^ b));
+}
+
+#define fp_add(z, x, y) m64_add(z, x, y, &p256_p)
+#define fp_sub(z, x, y) m64_sub(z, x, y, &p256_p)
+#define fp_mul(z, x, y) m64_mul(z, x, y, &p256_p)
+
+/*
+ * z = x ^ e mod m in the Montgomery domain, e is public
+ *
+ * Note: as a memory area, z may overlap with x.
+ */
+static void m64_pow(uint64_t z[4], const uint64_t x[4], const uint64_t e[4],
+		    const m64_mod *mod)
+{
+	uint64_t b[4];
+	u256_copy(b, x);
+	u256_copy(z, mod->one);
+	for (int i = 255; i >= 0; i--) {
+		m64_mul(z, z, z, mod);
+		if ((e[i / 64] >> (i % 64)) & 1)
+			m64_mul(z, z, b, mod);
+	}
+}
+
+/* z = x^-1 mod m (Montgomery domain), 0 when x is 0 */
+static void m64_inv(uint64_t z[4], const uint64_t x[4], const m64_mod *mod)
+{
+	/* m - 2, the least significant limb of both p and n is above 2 */
+	uint64_t e[4];
+	u256_copy(e, mod->m);
+	e[0] -= 2;
+	m64_pow(z, x, e, mod);
+}
+
+static void m64_prep(uint64_t z[4], const m64_mod *mod)
+{
+	m64_mul(z, z, mod->R2, mod);
+}
+
+static void m64_done(uint64_t z[4], const m64_mod *mod)
+{
+	static const uint64_t one[4] = { 1, 0, 0, 0 };
+	m64_mul(z, z, one, mod);
+}
+
+/* import from bytes to the Montgomery domain, -1 if not in [0, m) */
+static int m64_from_bytes(uint64_t z[4], const uint8_t p[32], const m64_mod *mod)
+{
+	uint64_t t[4];
+	u256_from_bytes(z, p);
+	if (u256_sub(t, z, mod->m) != 1)
+		return -1;
+	m64_prep(z, mod);
+	return 0;
+}
+
+static void m64_to_bytes(uint8_t p[32], const uint64_t z[4], const m64_mod *mod)
+{
+	uint64_t t[4];
+	u256_copy(t, z);
+	m64_done(t, mod);
+	u256_to_bytes(p, t);
+}
+
+/**********************************************************************
+ *
+ * Points in homogeneous projective coordinates (X:Y:Z), Montgomery
+ * domain, x = X/Z and y = Y/Z. The point at infinity is (0:1:0).
+ *
+ **********************************************************************/
+
+typedef struct {
+	uint64_t x[4], y[4], z[4];
+} p64_point;
+
+typedef struct {
+	uint64_t x[4], y[4];
+} p64_affine;
+
+static void point_zero(p64_point *r)
+{
+	static const uint64_t zero[4] = { 0, 0, 0, 0 };
+	u256_copy(r->x, zero);
+	u256_copy(r->y, p256_p.one);
+	u256_copy(r->z, zero);
+}
+
+static void point_from_affine(p64_point *r, const p64_affine *a)
+{
+	u256_copy(r->x, a->x);
+	u256_copy(r->y, a->y);
+	u256_copy(r->z, p256_p.one);
+}
+
+/* r = p + q for any p and q, [RCB15] algorithm 4 */
+static void point_add(p64_point *r, const p64_point *p, const p64_point *q)
+{
+	uint64_t t0[4], t1[4], t2[4], t3[4], t4[4], x3[4], y3[4], z3[4];
+	fp_mul(t0, p->x, q->x);
+	fp_mul(t1, p->y, q->y);
+	fp_mul(t2, p->z, q->z);
+	fp_add(t3, p->x, p->y);
+	fp_add(t4, q->x, q->y);
+	fp_mul(t3, t3, t4);
+	fp_add(t4, t0, t1);
+	fp_sub(t3, t3, t4);
+	fp_add(t4, p->y, p->z);
+	fp_add(x3, q->y, q->z);
+	fp_mul(t4, t4, x3);
+	fp_add(x3, t1, t2);
+	fp_sub(t4, t4, x3);
+	fp_add(x3, p->x, p->z);
+	fp_add(y3, q->x, q->z);
+	fp_mul(x3, x3, y3);
+	fp_add(y3, t0, t2);
+	fp_sub(y3, x3, y3);
+	fp_mul(z3, p256_b, t2);
+	fp_sub(x3, y3, z3);
+	fp_add(z3, x3, x3);
+	fp_add(x3, x3, z3);
+	fp_sub(z3, t1, x3);
+	fp_add(x3, t1, x3);
+	fp_mul(y3, p256_b, y3);
+	fp_add(t1, t2, t2);
+	fp_add(t2, t1, t2);
+	fp_sub(y3, y3, t2);
+	fp_sub(y3, y3, t0);
+	fp_add(t1, y3, y3);
+	fp_add(y3, t1, y3);
+	fp_add(t1, t0, t0);
+	fp_add(t0, t1, t0);
+	fp_sub(t0, t0, t2);
+	fp_mul(t1, t4, y3);
+	fp_mul(t2, t0, y3);
+	fp_mul(y3, x3, z3);
+	fp_add(y3, y3, t2);
+	fp_mul(x3, t3, x3);
+	fp_sub(x3, x3, t1);
+	fp_mul(z3, t4, z3);
+	fp_mul(t1, t3, t0);
+	fp_add(z3, z3, t1);
+	u256_copy(r->x, x3);
+	u256_copy(r->y, y3);
+	u256_copy(r->z, z3);
+}
+
+/* r = 2 * p for any p, [RCB15] algorithm 6 */
+static void point_double(p64_point *r, const p64_point *p)
+{
+	uint64_t t0[4], t1[4], t2[4], t3[4], x3[4], y3[4], z3[4];
+	fp_mul(t0, p->x, p->x);
+	fp_mul(t1, p->y, p->y);
+	fp_mul(t2, p->z, p->z);
+	fp_mul(t3, p->x, p->y);
+	fp_add(t3, t3, t3);
+	fp_mul(z3, p->x, p->z);
+	fp_add(z3, z3, z3);
+	fp_mul(y3, p256_b, t2);
+	fp_sub(y3, y3, z3);
+	fp_add(x3, y3, y3);
+	fp_add(y3, x3, y3);
+	fp_sub(x3, t1, y3);
+	fp_add(y3, t1, y3);
+	fp_mul(y3, x3, y3);
+	fp_mul(x3, x3, t3);
+	fp_add(t3, t2, t2);
+	fp_add(t2, t2, t3);
+	fp_mul(z3, p256_b, z3);
+	fp_sub(z3, z3, t2);
+	fp_sub(z3, z3, t0);
+	fp_add(t3, z3, z3);
+	fp_add(z3, z3, t3);
+	fp_add(t3, t0, t0);
+	fp_add(t0, t3, t0);
+	fp_sub(t0, t0, t2);
+	fp_mul(t0, t0, z3);
+	fp_add(y3, y3, t0);
+	fp_mul(t0, p->y, p->z);
+	fp_add(t0, t0, t0);
+	fp_mul(z3, t0, z3);
+	fp_sub(x3, x3, z3);
+	fp_mul(z3, t0, t1);
+	fp_add(z3, z3, z3);
+	fp_add(z3, z3, z3);
+	u256_copy(r->x, x3);
+	u256_copy(r->y, y3);
+	u256_copy(r->z, z3);
+}
+
+/* r = -p, negated in constant time when c is 1 */
+static void point_cneg(p64_point *r, uint64_t c)
+{
+	static const uint64_t zero[4] = { 0, 0, 0, 0 };
+	uint64_t ny[4];
+	fp_sub(ny, zero, r->y);
+	u256_cmov(r->y, ny, c);
+}
+
+/* affine coordinates of p (Montgomery domain), (0, 0) for infinity */
+static void point_to_affine(uint64_t x[4], uint64_t y[4], const p64_point *p)
+{
+	uint64_t zi[4];
+	m64_inv(zi, p->z, &p256_p);
+	fp_mul(x, p->x, zi);
+	fp_mul(y, p->y, zi);
+}
+
+/* affine coordinates of n points with one inversion, none at infinity */
+static void point_normalize(p64_affine *a, const p64_point *p, size_t n,
+			    uint64_t (*acc)[4])
+{
+	uint64_t inv[4], t[4];
+	u256_copy(acc[0], p[0].z);
+	for (size_t i = 1; i < n; i++)
+		fp_mul(acc[i], acc[i - 1], p[i].z);
+	m64_inv(inv, acc[n - 1], &p256_p);
+	for (size_t i = n - 1; i > 0; i--) {
+		fp_mul(t, inv, acc[i - 1]); /* 1 / z_i */
+		fp_mul(inv, inv, p[i].z);
+		fp_mul(a[i].x, p[i].x, t);
+		fp_mul(a[i].y, p[i].y, t);
+	}
+	fp_mul(a[0].x, p[0].x, inv);
+	fp_mul(a[0].y, p[0].y, inv);
+}
+
+/*
+ * Curve equation check y^2 = x^3 - 3x + b
+ * in: x, y in [0, p) (Montgomery domain)
+ * out: 0 if the point lies on the curve, non-zero otherwise
+ */
+static uint64_t point_check(const uint64_t x[4], const uint64_t y[4])
+{
+	uint64_t lhs[4], rhs[4];
+	fp_mul(lhs, y, y);
+	fp_mul(rhs, x, x);
+	fp_mul(rhs, rhs, x);
+	for (int i = 0; i < 3; i++)
+		fp_sub(rhs, rhs, x);
+	fp_add(rhs, rhs, p256_b);
+	return u256_diff(lhs, rhs);
+}
+
+static int point_from_bytes(uint64_t x[4], uint64_t y[4], const uint8_t p[64])
+{
+	if (m64_from_bytes(x, p, &p256_p) != 0)
+		return -1;
+	if (m64_from_bytes(y, p + 32, &p256_p) != 0)
+		return -1;
+	return point_check(x, y) == 0 ? 0 : -1;
+}
+
+static void point_to_bytes(uint8_t p[64], const uint64_t x[4], const uint64_t y[4])
+{
+	m64_to_bytes(p, x, &p256_p);
+	m64_to_bytes(p + 32, y, &p256_p);
+}
+
+/**********************************************************************
+ *
+ * Tables of multiples of G, built once
+ *
+ **********************************************************************/
+
+#define COMB_WINDOWS 64 /* 4 bit windows of a 256 bit scalar */
+#define COMB_ENTRIES 15 /* 1..15 * 16^i * G for each window i */
+#define WNAF_G 7 /* width of the wNAF of u1 in verify */
+#define WNAF_Q 5 /* width of the wNAF of u2 in verify */
+
+static p64_affine g_comb[COMB_WINDOWS][COMB_ENTRIES];
+static p64_affine g_odd[1 << (WNAF_G - 2)]; /* G, 3G, 5G ... */
+static volatile int g_state = ZEN_ONCE_MISSING;
+/* scratch space of the build, in jacobian coordinates */
+static p64_point g_pts[COMB_WINDOWS * COMB_ENTRIES + (1 << (WNAF_G - 2))];
+static uint64_t g_acc[COMB_WINDOWS * COMB_ENTRIES + (1 << (WNAF_G - 2))][4];
+
+static void g_tables_build(void)
+{
+	const size_t ncomb = COMB_WINDOWS * COMB_ENTRIES;
+	const size_t nodd = 1 << (WNAF_G - 2);
+	p64_point *pts = g_pts;
+	uint64_t (*acc)[4] = g_acc;
+	p64_point base, g2;
+	p64_affine g = { { 0 }, { 0 } };
+	u256_copy(g.x, p256_gx);
+	u256_copy(g.y, p256_gy);
+	point_from_affine(&base, &g);
+	for (int i = 0; i < COMB_WINDOWS; i++) {
+		p64_point *row = pts + i * COMB_ENTRIES;
+		row[0] = base;
+		for (int j = 1; j < COMB_ENTRIES; j++)
+			point_add(&row[j], &row[j - 1], &base);
+		point_double(&base, &row[7]); /* 16 * base */
+	}
+	p64_point *odd = pts + ncomb;
+	point_from_affine(&odd[0], &g);
+	point_double(&g2, &odd[0]);
+	for (size_t i = 1; i < nodd; i++)
+		point_add(&odd[i], &odd[i - 1], &g2);
+	point_normalize(&g_comb[0][0], pts, ncomb, acc);
+	point_normalize(g_odd, odd, nodd, acc);
+}
+
+static void g_tables(void)
+{
+	zen_once(&g_state, g_tables_build);
+}
+
+/**********************************************************************
+ *
+ * Scalar multiplication
+ *
+ **********************************************************************/
+
+/* r = s * G, s in [0, n), in constant time */
+static void scalar_mult_base(p64_point *r, const uint64_t s[4])
+{
+	p64_point t;
+	g_tables();
+	point_zero(r);
+	for (int i = 0; i < COMB_WINDOWS; i++) {
+		const uint64_t d = (s[i / 16] >> (4 * (i % 16))) & 0xf;
+		point_zero(&t);
+		for (uint64_t j = 0; j < COMB_ENTRIES; j++) {
+			const uint64_t eq = u64_iszero(d ^ (j + 1));
+			u256_cmov(t.x, g_comb[i][j].x, eq);
+			u256_cmov(t.y, g_comb[i][j].y, eq);
+			u256_cmov(t.z, p256_p.one, eq);
+		}
+		point_add(r, r, &t);
+	}
+	zeroize(&t, sizeof t);
+}
+
+/* r = s * P, s in [0, n), P on the curve, in constant time */
+static void scalar_mult(p64_point *r, const p64_affine *p, const uint64_t s[4])
+{
+	p64_point tab[16], t;
+	point_zero(&tab[0]);
+	point_from_affine(&tab[1], p);
+	for (int j = 2; j < 16; j++)
+		point_add(&tab[j], &tab[j - 1], &tab[1]);
+	point_zero(r);
+	for (int i = 63; i >= 0; i--) {
+		const uint64_t d = (s[i / 16] >> (4 * (i % 16))) & 0xf;
+		for (int k = 0; k < 4; k++)
+			point_double(r, r);
+		t = tab[0];
+		for (uint64_t j = 1; j < 16; j++) {
+			const uint64_t eq = u64_iszero(d ^ j);
+			u256_cmov(t.x, tab[j].x, eq);
+			u256_cmov(t.y, tab[j].y, eq);
+			u256_cmov(t.z, tab[j].z, eq);
+		}
+		point_add(r, r, &t);
+	}
+	zeroize(&t, sizeof t);
+}
+
+/*
+ * Width w non-adjacent form of a public scalar s < 2^256
+ * out: naf[i] odd in (-2^(w-1), 2^(w-1)) or 0, returns the length
+ */
+static int wnaf(int8_t naf[257], const uint64_t s[4], int w)
+{
+	uint64_t d[5] = { s[0], s[1], s[2], s[3], 0 };
+	const int64_t half = 1 << (w - 1);
+	int len = 0;
+	while (d[0] | d[1] | d[2] | d[3] | d[4]) {
+		int64_t digit = 0;
+		if (d[0] & 1) {
+			digit = (int64_t)(d[0] & ((1 << w) - 1));
+			if (digit >= half)
+				digit -= 2 * half;
+			/* d -= digit */
+			if (digit > 0) {
+				uint64_t b = (uint64_t)digit;
+				for (int i = 0; i < 5 && b; i++) {
+					const uint64_t o = d[i];
+					d[i] -= b;
+					b = d[i] > o;
+				}
+			} else {
+				uint64_t c = (uint64_t)-digit;
+				for (int i = 0; i < 5 && c; i++) {
+					d[i] += c;
+					c = d[i] < c;
+				}
+			}
+		}
+		naf[len++] = (int8_t)digit;
+		for (int i = 0; i < 4; i++)
+			d[i] = (d[i] >> 1) | (d[i + 1] << 63);
+		d[4] >>= 1;
+	}
+	return len;
+}
+
+/* r = u1 * G + u2 * Q for public scalars, joint wNAF */
+static void scalar_mult_joint(p64_point *r, const uint64_t u1[4],
+			      const p64_affine *q, const uint64_t u2[4])
+{
+	int8_t n1[257] = { 0 }, n2[257] = { 0 };
+	p64_point qodd[1 << (WNAF_Q - 2)], q2, t;
+	g_tables();
+	point_from_affine(&qodd[0], q);
+	point_double(&q2, &qodd[0]);
+	for (int i = 1; i < (1 << (WNAF_Q - 2)); i++)
+		point_add(&qodd[i], &qodd[i - 1], &q2);
+	const int l1 = wnaf(n1, u1, WNAF_G);
+	const int l2 = wnaf(n2, u2, WNAF_Q);
+	point_zero(r);
+	for (int i = (l1 > l2 ? l1 : l2) - 1; i >= 0; i--) {
+		point_double(r, r);
+		if (n1[i]) {
+			point_from_affine(&t, &g_odd[(n1[i] < 0 ? -n1[i] : n1[i]) / 2]);
+			point_cneg(&t, n1[i] < 0);
+			point_add(r, r, &t);
+		}
+		if (n2[i]) {
+			t = qodd[(n2[i] < 0 ? -n2[i] : n2[i]) / 2];
+			point_cneg(&t, n2[i] < 0);
+			point_add(r, r, &t);
+		}
+	}
+}
+
+/* s from big-endian bytes, 0 if s in [1, n-1] or -1 */
+static int scalar_from_bytes(uint64_t s[4], const uint8_t p[32])
+{
+	uint64_t t[4];
+	u256_from_bytes(s, p);
+	const uint64_t lt_n = u256_sub(t, s, p256_n.m);
+	return (lt_n && !u256_iszero(s)) ? 0 : -1;
+}
+
+static int scalar_gen_with_pub(zenroom_t *Z, const octet *k, uint8_t sbytes[32],
+			       uint64_t s[4], uint64_t x[4], uint64_t y[4])
+{
+	int ret;
+	unsigned nb_tried = 0;
+	do {
+		if (nb_tried++ >= 4)
+			return -1;
+		if (k) {
+			if (k->len < 32)
+				return -1;
+			for (int i = 0; i < 32; i++)
+				sbytes[i] = k->val[i];
+		} else {
+			octet o;
+			o.val = (char *)sbytes;
+			o.len = o.max = 32;
+			OCT_rand(&o, Z->random_generator, 32);
+		}
+		ret = scalar_from_bytes(s, sbytes);
+	} while (ret != 0);
+
+	p64_point r;
+	scalar_mult_base(&r, s);
+	point_to_affine(x, y, &r);
+	return 0;
+}
+
+/**********************************************************************
+ *
+ * Public interface, see p256-m.h
+ *
+ **********************************************************************/
+
+int p256_gen_keypair(zenroom_t *Z, const octet *k, uint8_t priv[32], uint8_t pub[64])
+{
+	uint64_t s[4], x[4], y[4];
+	int ret = scalar_gen_with_pub(Z, k, priv, s, x, y);
+	zeroize(s, sizeof s);
+	if (ret != 0)
+		return P256_RANDOM_FAILED;
+	point_to_bytes(pub, x, y);
+	return P256_SUCCESS;
+}
+
+int p256_publickey(uint8_t priv[32], uint8_t pub[64])
+{
+	uint64_t s[4], x[4], y[4];
+	p64_point r;
+	if (scalar_from_bytes(s, priv) != 0)
+		return P256_INVALID_PRIVKEY;
+	scalar_mult_base(&r, s);
+	zeroize(s, sizeof s);
+	point_to_affine(x, y, &r);
+	point_to_bytes(pub, x, y);
+	return P256_SUCCESS;
+}
+
+int p256_ecdh_shared_secret(uint8_t secret[32],
+			    const uint8_t priv[32], const uint8_t peer[64])
+{
+	uint64_t s[4], x[4], y[4];
+	p64_affine p;
+	p64_point r;
+	int ret = P256_SUCCESS;
+	if (scalar_from_bytes(s, priv) != 0) {
+		ret = P256_INVALID_PRIVKEY;
+		goto cleanup;
+	}
+	if (point_from_bytes(p.x, p.y, peer) != 0) {
+		ret = P256_INVALID_PUBKEY;
+		goto cleanup;
+	}
+	scalar_mult(&r, &p, s);
+	point_to_affine(x, y, &r);
+	m64_to_bytes(secret, x, &p256_p);
+cleanup:
+	zeroize(s, sizeof s);
+	return ret;
+}
+
+/* e = leftmost bits of the hash mod n, Montgomery domain */
+static void ecdsa_from_hash(uint64_t e[4], const uint8_t *h, size_t hlen)
+{
+	uint8_t p[32] = { 0 };
+	uint64_t t[4];
+	if (hlen < 32) {
+		for (size_t i = 0; i < hlen; i++)
+			p[32 - hlen + i] = h[i];
+	} else {
+		for (size_t i = 0; i < 32; i++)
+			p[i] = h[i];
+	}
+	u256_from_bytes(e, p);
+	const uint64_t b = u256_sub(t, e, p256_n.m);
+	u256_cmov(e, t, 1 ^ b);
+	m64_prep(e, &p256_n);
+}
+
+int p256_ecdsa_sign(zenroom_t *Z, const octet *kk, uint8_t sig[64], const uint8_t priv[32],
+		    const uint8_t *hash, size_t hlen)
+{
+	uint64_t k[4], r[4], y[4], e[4], d[4], t[4];
+	uint8_t kb[32];
+
+	/* 1. ephemeral keypair, r = x(k * G) mod n */
+	if (scalar_gen_with_pub(Z, kk, kb, k, r, y) != 0)
+		return P256_RANDOM_FAILED;
+	zeroize(kb, sizeof kb);
+	m64_done(r, &p256_p);
+	const uint64_t b = u256_sub(t, r, p256_n.m);
+	u256_cmov(r, t, 1 ^ b);
+	if (u256_iszero(r)) {
+		zeroize(k, sizeof k);
+		return P256_RANDOM_FAILED;
+	}
+
+	/* 2. s = k^-1 * (e + r * d) */
+	ecdsa_from_hash(e, hash, hlen);
+	if (scalar_from_bytes(d, priv) != 0) {
+		zeroize(k, sizeof k);
+		return P256_INVALID_PRIVKEY;
+	}
+	m64_prep(d, &p256_n);
+	m64_prep(k, &p256_n);
+	u256_to_bytes(sig, r);
+	m64_prep(r, &p256_n);
+	m64_inv(k, k, &p256_n);
+	m64_mul(d, r, d, &p256_n);
+	m64_add(d, e, d, &p256_n);
+	m64_mul(d, k, d, &p256_n);
+	zeroize(k, sizeof k);
+	if (u256_iszero(d)) {
+		for (int i = 0; i < 32; i++)
+			sig[i] = 0;
+		return P256_RANDOM_FAILED;
+	}
+	m64_to_bytes(sig + 32, d, &p256_n);
+	zeroize(d, sizeof d);
+	return P256_SUCCESS;
+}
+
+int p256_ecdsa_verify(const uint8_t sig[64], const uint8_t pub[64],
+		      const uint8_t *hash, size_t hlen)
+{
+	/* public data only, branches are fine */
+	uint64_t r[4], s[4], e[4], u1[4], u2[4], t[4];
+	p64_affine q;
+	p64_point R;
+
+	if (scalar_from_bytes(r, sig) != 0 || scalar_from_bytes(s, sig + 32) != 0)
+		return P256_INVALID_SIGNATURE;
+	if (point_from_bytes(q.x, q.y, pub) != 0)
+		return P256_INVALID_PUBKEY;
+
+	/* u1 = e / s and u2 = r / s mod n */
+	ecdsa_from_hash(e, hash, hlen);
+	m64_prep(s, &p256_n);
+	m64_inv(s, s, &p256_n);
+	m64_mul(u1, e, s, &p256_n);
+	m64_done(u1, &p256_n);
+	u256_copy(u2, r);
+	m64_prep(u2, &p256_n);
+	m64_mul(u2, u2, s, &p256_n);
+	m64_done(u2, &p256_n);
+
+	scalar_mult_joint(&R, u1, &q, u2);
+	if (u256_iszero(R.z))
+		return P256_INVALID_SIGNATURE;
+
+	/* x(R) mod n == r, checked as X == r * Z or X == (r + n) * Z
+	 * without leaving the projective coordinates */
+	u256_copy(t, r);
+	m64_prep(t, &p256_p);
+	fp_mul(t, t, R.z);
+	if (u256_diff(t, R.x) == 0)
+		return P256_SUCCESS;
+	if (u256_add(t, r, p256_n.m) == 0 && u256_sub(u1, t, p256_p.m) == 1) {
+		m64_prep(t, &p256_p);
+		fp_mul(t, t, R.z);
+		if (u256_diff(t, R.x) == 0)
+			return P256_SUCCESS;
+	}
+	return P256_INVALID_SIGNATURE;
+}
+
+/**********************************************************************
+ *
+ * Key management utilities
+ *
+ **********************************************************************/
+
+int p256_uncompress_publickey(uint8_t unc_pub[64], const uint8_t pub[33])
+{
+	uint64_t x[4], y[4], rhs[4], e[4], t[4];
+	if (m64_from_bytes(x, pub + 1, &p256_p) != 0)
+		return P256_INVALID_PUBKEY;
+
+	/* rhs = x^3 - 3x + b */
+	fp_mul(rhs, x, x);
+	fp_mul(rhs, rhs, x);
+	for (int i = 0; i < 3; i++)
+		fp_sub(rhs, rhs, x);
+	fp_add(rhs, rhs, p256_b);
+
+	/* y = rhs^((p + 1) / 4), p + 1 does not overflow */
+	static const uint64_t one[4] = { 1, 0, 0, 0 };
+	u256_add(e, p256_p.m, one);
+	for (int i = 0; i < 3; i++)
+		e[i] = (e[i] >> 2) | (e[i + 1] << 62);
+	e[3] >>= 2;
+	m64_pow(y, rhs, e, &p256_p);
+	if (point_check(x, y) != 0)
+		return P256_INVALID_PUBKEY; /* x^3 - 3x + b is not a square */
+
+	/* y parity from the prefix */
+	u256_copy(t, y);
+	m64_done(t, &p256_p);
+	if ((t[0] & 1) != (pub[0] & 1)) {
+		static const uint64_t zero[4] = { 0, 0, 0, 0 };
+		fp_sub(y, zero, y);
+	}
+	point_to_bytes(unc_pub, x, y);
+	return P256_SUCCESS;
+}
+
+int p256_compress_publickey(uint8_t comp_pub[33], const uint8_t unc_pub[64])
+{
+	uint64_t x[4], y[4];
+	if (point_from_bytes(x, y, unc_pub) != 0)
+		return P256_INVALID_PUBKEY;
+	m64_done(y, &p256_p);
+	comp_pub[0] = (y[0] & 1) ? 0x03 : 0x02;
+	for (int i = 0; i < 32; i++)
+		comp_pub[i + 1] = unc_pub[i];
+	return P256_SUCCESS;
+}
+
+int p256_validate_pubkey(const uint8_t pub[64])
+{
+	uint64_t x[4], y[4];
+	return point_from_bytes(x, y, pub) == 0 ? P256_SUCCESS : P256_INVALID_PUBKEY;
+}
+
+int p256_validate_privkey(const uint8_t priv[32])
+{
+	uint64_t s[4];
+	int ret = scalar_from_bytes(s, priv);
+	zeroize(s, sizeof s);
+	return ret == 0 ? P256_SUCCESS : P256_INVALID_PRIVKEY;
+}
+
+#endif /* P256_64 */
@@ -10,6 +10,8 @@
 
 #include <p256-m.h> // includes zenroom.h
 
+#if !defined(P256_64) // else built from p256-64.c
+
 /*
  * Zeroize memory - this should not be optimized away
  */
@@ -1630,9 +1632,14 @@ int p256_uncompress_publickey(uint8_t unc_pub[64], const uint8_t pub[33])
 
 	/* y = (y^2)^e mod p = rhs^e mod p */
 	m256_pow_p(y, rhs, e);
-
-	/* y parity from first byte	*/
-	if ((y[0] & 1) != (pub[0] & 1)) {
+	if (point_check(x, y) != 0)
+		return P256_INVALID_PUBKEY; /* rhs is not a square */
+
+	/* y parity from first byte, out of the Montgomery domain */
+	uint32_t yi[8];
+	u256_cmov(yi, y, 1);
+	m256_done(yi, &p256_p);
+	if ((yi[0] & 1) != (pub[0] & 1)) {
 		m256_sub_p(y, p256_p.m, y); /* y = p - y (invert) */
 	}
 
@@ -1672,3 +1679,5 @@ int p256_validate_privkey(const uint8_t priv[32])
 
     return ret == 0 ? P256_SUCCESS : P256_INVALID_PRIVKEY;
 }
+
+#endif /* !P256_64 */
@@ -13,6 +13,13 @@
 #include <zenroom.h>
 #include <zen_octet.h>
 
+/* Implemented by p256-m.c on 32-bit limbs for small and embedded
+ * targets, or by p256-64.c on 64-bit limbs when building with
+ * -DP256_64, see build/posix.mk */
+#if defined(P256_64) && !defined(__SIZEOF_INT128__)
+#error "P256_64 needs a compiler with 128 bit integers"
+#endif
+
 /* Status codes */
 #define P256_SUCCESS            0
 #define P256_RANDOM_FAILED      -1
@@ -0,0 +1,1066 @@
+/* This file is part of Zenroom (https://zenroom.dyne.org)
+ *
+ * Copyright (C) 2025 Dyne.org foundation
+ * designed, written and maintained by Denis Roio <jaromil@dyne.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * ECDSA verification and public key recovery on secp256k1, see
+ * secp256k1-glv.h for the interface.
+ *
+ * - field elements mod p = 2^256 - 2^32 - 977 on 4 limbs of 64 bits,
+ *   products reduced by folding their high half times 2^256 mod p
+ * - scalars mod n in the Montgomery domain
+ * - points in Jacobian coordinates, doubled and added with the a = 0
+ *   formulas of [EFD]
+ * - lambda * (x, y) = (beta * x, y) splits each scalar in two halves
+ *   of 128 bits [GLV01], so that u1 * G + u2 * Q is one joint wNAF
+ *   over four scalars and takes half the doublings
+ * - the odd multiples of G and lambda * G (width 8) are built once,
+ *   those of Q (width 5) at each call, all in affine coordinates
+ * - verify compares x(R) with r in Jacobian coordinates
+ * - the batch calls share among all their inputs the inversion of s
+ *   (or r) mod n, the one bringing the tables of Q to affine
+ *   coordinates and the one of the recovered keys [Mont87]
+ *
+ * Only public data goes through here: none of this is constant time.
+ *
+ * References:
+ * - [GLV01] Faster point multiplication on elliptic curves with
+ *   efficient endomorphisms; Gallant, Lambert, Vanstone; CRYPTO 2001.
+ * - [EFD] Explicit-Formulas Database, shortw-jacobian-0,
+ *   https://hyperelliptic.org/EFD/g1p/auto-shortw-jacobian-0.html
+ * - [Mont87] Speeding the Pollard and elliptic curve methods of
+ *   factorization; Montgomery; Mathematics of Computation, 1987.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <ecdh_support.h>
+#include <ecdh_SECP256K1.h>
+#include <secp256k1-glv.h>
+#include <zen_once.h>
+
+#if defined(SECP256K1_GLV)
+
+__extension__ typedef unsigned __int128 u128;
+
+/**********************************************************************
+ *
+ * Constants, least significant limb first
+ *
+ **********************************************************************/
+
+/* 2^256 mod p */
+#define FE_C 0x00000001000003d1ULL
+
+static const uint64_t fe_p[4] = {
+	0xfffffffefffffc2f, 0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff
+};
+/* cube root of unity mod p, lambda * (x, y) = (beta * x, y) */
+static const uint64_t fe_beta[4] = {
+	0xc1396c28719501ee, 0x9cf0497512f58995, 0x6e64479eac3434e9, 0x7ae96a2b657c0710
+};
+static const uint64_t k1_gx[4] = {
+	0x59f2815b16f81798, 0x029bfcdb2dce28d9, 0x55a06295ce870b07, 0x79be667ef9dcbbac
+};
+static const uint64_t k1_gy[4] = {
+	0x9c47d08ffb10d4b8, 0xfd17b448a6855419, 0x5da4fbfc0e1108a8, 0x483ada7726a3c465
+};
+
+static const uint64_t sc_n[4] = {
+	0xbfd25e8cd0364141, 0xbaaedce6af48a03b, 0xfffffffffffffffe, 0xffffffffffffffff
+};
+static const uint64_t sc_half_n[4] = {
+	0xdfe92f46681b20a0, 0x5d576e7357a4501d, 0xffffffffffffffff, 0x7fffffffffffffff
+};
+/* 2^512 mod n, 2^256 mod n and -n^-1 mod 2^64 */
+static const uint64_t sc_R2[4] = {
+	0x896cf21467d7d140, 0x741496c20e7cf878, 0xe697f5e45bcd07c6, 0x9d671cd581c69bc5
+};
+static const uint64_t sc_one[4] = {
+	0x402da1732fc9bebf, 0x4551231950b75fc4, 0x0000000000000001, 0x0000000000000000
+};
+#define SC_NI 0x4b0dff665588b13fULL
+/* p - n, x(R) mod n is r also when x(R) = r + n < p */
+static const uint64_t p_minus_n[4] = {
+	0x402da1722fc9baee, 0x4551231950b75fc4, 0x0000000000000001, 0x0000000000000000
+};
+
+/* GLV: lambda and the basis of the lattice used to split k, with
+ * g1 = round(2^384 * b2 / n) and g2 = round(2^384 * -b1 / n) */
+static const uint64_t glv_lambda[4] = {
+	0xdf02967c1b23bd72, 0x122e22ea20816678, 0xa5261c028812645a, 0x5363ad4cc05c30e0
+};
+static const uint64_t glv_minus_b1[4] = {
+	0x6f547fa90abfe4c3, 0xe4437ed6010e8828, 0x0000000000000000, 0x0000000000000000
+};
+static const uint64_t glv_minus_b2[4] = {
+	0xd765cda83db1562c, 0x8a280ac50774346d, 0xfffffffffffffffe, 0xffffffffffffffff
+};
+static const uint64_t glv_g1[4] = {
+	0xe893209a45dbb031, 0x3daa8a1471e8ca7f, 0xe86c90e49284eb15, 0x3086d221a7d46bcd
+};
+static const uint64_t glv_g2[4] = {
+	0x1571b4ae8ac47f71, 0x221208ac9df506c6, 0x6f547fa90abfe4c4, 0xe4437ed6010e8828
+};
+
+/**********************************************************************
+ *
+ * 256 bit integers
+ *
+ **********************************************************************/
+
+static void u256_copy(uint64_t z[4], const uint64_t x[4])
+{
+	z[0] = x[0]; z[1] = x[1]; z[2] = x[2]; z[3] = x[3];
+}
+
+/* z = x + y, returns the carry */
+static uint64_t u256_add(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	u128 c = 0;
+	for (int i = 0; i < 4; i++) {
+		c += (u128)x[i] + y[i];
+		z[i] = (uint64_t)c;
+		c >>= 64;
+	}
+	return (uint64_t)c;
+}
+
+/* z = x - y, returns the borrow */
+static uint64_t u256_sub(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	uint64_t b = 0;
+	for (int i = 0; i < 4; i++) {
+		u128 d = (u128)x[i] - y[i] - b;
+		z[i] = (uint64_t)d;
+		b = (uint64_t)(d >> 64) & 1;
+	}
+	return b;
+}
+
+static int u256_iszero(const uint64_t x[4])
+{
+	return (x[0] | x[1] | x[2] | x[3]) == 0;
+}
+
+static int u256_eq(const uint64_t x[4], const uint64_t y[4])
+{
+	return ((x[0] ^ y[0]) | (x[1] ^ y[1]) | (x[2] ^ y[2]) | (x[3] ^ y[3])) == 0;
+}
+
+/* x < y */
+static int u256_lt(const uint64_t x[4], const uint64_t y[4])
+{
+	uint64_t t[4];
+	return (int)u256_sub(t, x, y);
+}
+
+/* z = x mod m for x < 2m */
+static void u256_reduce(uint64_t z[4], const uint64_t x[4], const uint64_t m[4])
+{
+	uint64_t t[4];
+	if (u256_sub(t, x, m))
+		u256_copy(z, x);
+	else
+		u256_copy(z, t);
+}
+
+/* big-endian bytes, len up to 32 */
+static void u256_from_be(uint64_t z[4], const char *p, int len)
+{
+	z[0] = z[1] = z[2] = z[3] = 0;
+	for (int i = 0; i < len; i++) {
+		const int b = len - 1 - i; /* byte position from the right */
+		z[b / 8] |= (uint64_t)(uint8_t)p[i] << (8 * (b % 8));
+	}
+}
+
+static void u256_to_be(char *p, const uint64_t z[4])
+{
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 8; j++)
+			p[8 * (3 - i) + j] = (char)(z[i] >> (56 - 8 * j));
+}
+
+/* integers as Milagro reads them from octets: the last 32 bytes of
+ * longer encodings of r, s and x, the first 32 bytes of hashes */
+static void u256_from_octet(uint64_t z[4], const octet *o)
+{
+	if (o->len > 32)
+		u256_from_be(z, o->val + o->len - 32, 32);
+	else
+		u256_from_be(z, o->val, o->len);
+}
+
+static void u256_from_hash(uint64_t z[4], const octet *o)
+{
+	u256_from_be(z, o->val, o->len > 32 ? 32 : o->len);
+}
+
+/**********************************************************************
+ *
+ * Field elements mod p, fully reduced
+ *
+ **********************************************************************/
+
+/* z = x + c, returns the carry */
+static uint64_t u256_add_word(uint64_t z[4], const uint64_t x[4], uint64_t c)
+{
+	for (int i = 0; i < 4; i++) {
+		z[i] = x[i] + c;
+		c = z[i] < c;
+	}
+	return c;
+}
+
+static void fe_add(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	uint64_t t[4];
+	const uint64_t c = u256_add(z, x, y);
+	/* z - p = z + 2^256 - p, which carries if and only if z >= p */
+	if (u256_add_word(t, z, FE_C) | c)
+		u256_copy(z, t);
+}
+
+static void fe_sub(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	if (u256_sub(z, x, y)) {
+		/* z + p = z - (2^256 - p) mod 2^256 */
+		uint64_t b = FE_C;
+		for (int i = 0; i < 4; i++) {
+			const uint64_t o = z[i];
+			z[i] -= b;
+			b = z[i] > o;
+		}
+	}
+}
+
+static void fe_neg(uint64_t z[4], const uint64_t x[4])
+{
+	if (u256_iszero(x))
+		u256_copy(z, x);
+	else
+		u256_sub(z, fe_p, x);
+}
+
+static void fe_mul(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	uint64_t t[8] = { 0 }, r[4], c;
+	u128 uv;
+	for (int i = 0; i < 4; i++) {
+		c = 0;
+		for (int j = 0; j < 4; j++) {
+			uv = (u128)x[i] * y[j] + t[i + j] + c;
+			t[i + j] = (uint64_t)uv;
+			c = (uint64_t)(uv >> 64);
+		}
+		t[i + 4] = c;
+	}
+	/* t = lo + hi * 2^256 = lo + hi * FE_C mod p, twice */
+	uv = (u128)t[4] * FE_C + t[0]; r[0] = (uint64_t)uv; uv >>= 64;
+	uv += (u128)t[5] * FE_C + t[1]; r[1] = (uint64_t)uv; uv >>= 64;
+	uv += (u128)t[6] * FE_C + t[2]; r[2] = (uint64_t)uv; uv >>= 64;
+	uv += (u128)t[7] * FE_C + t[3]; r[3] = (uint64_t)uv;
+	c = (uint64_t)(uv >> 64); /* below 2^34 */
+	uv = (u128)c * FE_C + r[0]; r[0] = (uint64_t)uv; uv >>= 64;
+	uv += r[1]; r[1] = (uint64_t)uv; uv >>= 64;
+	uv += r[2]; r[2] = (uint64_t)uv; uv >>= 64;
+	uv += r[3]; r[3] = (uint64_t)uv;
+	c = (uint64_t)(uv >> 64);
+	/* subtract p once if the carry is set (r is then small) or r >= p */
+	if (u256_add_word(z, r, FE_C) == 0 && c == 0)
+		u256_copy(z, r);
+}
+
+static void fe_sqr(uint64_t z[4], const uint64_t x[4])
+{
+	fe_mul(z, x, x);
+}
+
+static void fe_sqr_n(uint64_t z[4], const uint64_t x[4], int n)
+{
+	fe_sqr(z, x);
+	while (--n > 0)
+		fe_sqr(z, z);
+}
+
+/* a^(2^223 - 1), a^(2^22 - 1) and a^3, shared by the exponents of
+ * the inversion and of the square root */
+static void fe_pow_chain(uint64_t x223[4], uint64_t x22[4], uint64_t x2[4],
+			 const uint64_t a[4])
+{
+	uint64_t x3[4], x6[4], x9[4], x11[4], x44[4], x88[4], x176[4], x220[4];
+	fe_sqr(x2, a);
+	fe_mul(x2, x2, a);
+	fe_sqr(x3, x2);
+	fe_mul(x3, x3, a);
+	fe_sqr_n(x6, x3, 3);
+	fe_mul(x6, x6, x3);
+	fe_sqr_n(x9, x6, 3);
+	fe_mul(x9, x9, x3);
+	fe_sqr_n(x11, x9, 2);
+	fe_mul(x11, x11, x2);
+	fe_sqr_n(x22, x11, 11);
+	fe_mul(x22, x22, x11);
+	fe_sqr_n(x44, x22, 22);
+	fe_mul(x44, x44, x22);
+	fe_sqr_n(x88, x44, 44);
+	fe_mul(x88, x88, x44);
+	fe_sqr_n(x176, x88, 88);
+	fe_mul(x176, x176, x88);
+	fe_sqr_n(x220, x176, 44);
+	fe_mul(x220, x220, x44);
+	fe_sqr_n(x223, x220, 3);
+	fe_mul(x223, x223, x3);
+}
+
+/* z = a^(p - 2) = 1 / a, 0 when a is 0 */
+static void fe_inv(uint64_t z[4], const uint64_t a[4])
+{
+	uint64_t x223[4], x22[4], x2[4], t[4];
+	fe_pow_chain(x223, x22, x2, a);
+	fe_sqr_n(t, x223, 23);
+	fe_mul(t, t, x22);
+	fe_sqr_n(t, t, 5);
+	fe_mul(t, t, a);
+	fe_sqr_n(t, t, 3);
+	fe_mul(t, t, x2);
+	fe_sqr_n(t, t, 2);
+	fe_mul(z, t, a);
+}
+
+/* z = a^((p + 1) / 4), the square root of a when it has one */
+static void fe_sqrt(uint64_t z[4], const uint64_t a[4])
+{
+	uint64_t x223[4], x22[4], x2[4], t[4];
+	fe_pow_chain(x223, x22, x2, a);
+	fe_sqr_n(t, x223, 23);
+	fe_mul(t, t, x22);
+	fe_sqr_n(t, t, 6);
+	fe_mul(t, t, x2);
+	fe_sqr_n(z, t, 2);
+}
+
+/**********************************************************************
+ *
+ * Scalars mod n, in the Montgomery domain unless noted
+ *
+ **********************************************************************/
+
+static void sc_add(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	uint64_t t[4];
+	const uint64_t c = u256_add(z, x, y);
+	if (c | (1 ^ u256_sub(t, z, sc_n)))
+		u256_copy(z, t);
+}
+
+static void sc_sub(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	if (u256_sub(z, x, y))
+		u256_add(z, z, sc_n);
+}
+
+/* z = x * y / 2^256 mod n, x and y in [0, n) */
+static void sc_mul(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	uint64_t t[6] = { 0, 0, 0, 0, 0, 0 };
+	for (int i = 0; i < 4; i++) {
+		u128 uv;
+		uint64_t c = 0;
+		for (int j = 0; j < 4; j++) {
+			uv = (u128)x[j] * y[i] + t[j] + c;
+			t[j] = (uint64_t)uv;
+			c = (uint64_t)(uv >> 64);
+		}
+		uv = (u128)t[4] + c;
+		t[4] = (uint64_t)uv;
+		t[5] = (uint64_t)(uv >> 64);
+
+		const uint64_t q = t[0] * SC_NI;
+		uv = (u128)q * sc_n[0] + t[0];
+		c = (uint64_t)(uv >> 64);
+		for (int j = 1; j < 4; j++) {
+			uv = (u128)q * sc_n[j] + t[j] + c;
+			t[j - 1] = (uint64_t)uv;
+			c = (uint64_t)(uv >> 64);
+		}
+		uv = (u128)t[4] + c;
+		t[3] = (uint64_t)uv;
+		t[4] = t[5] + (uint64_t)(uv >> 64);
+	}
+	uint64_t r[4];
+	if (t[4] | (1 ^ u256_sub(r, t, sc_n)))
+		u256_copy(z, r);
+	else
+		u256_copy(z, t);
+}
+
+/* to the Montgomery domain */
+static void sc_prep(uint64_t z[4], const uint64_t x[4])
+{
+	sc_mul(z, x, sc_R2);
+}
+
+/* z = x * y mod n, out of the Montgomery domain */
+static void sc_mul_plain(uint64_t z[4], const uint64_t x[4], const uint64_t y[4])
+{
+	sc_mul(z, x, y);
+	sc_mul(z, z, sc_R2);
+}
+
+/* z = x^(n - 2) = 1 / x, on a fixed window of 4 bits */
+static void sc_inv(uint64_t z[4], const uint64_t x[4])
+{
+	uint64_t tab[16][4], e[4], r[4];
+	u256_copy(e, sc_n);
+	e[0] -= 2;
+	u256_copy(tab[0], sc_one);
+	for (int i = 1; i < 16; i++)
+		sc_mul(tab[i], tab[i - 1], x);
+	u256_copy(r, sc_one);
+	for (int i = 63; i >= 0; i--) {
+		for (int k = 0; k < 4 && i < 63; k++)
+			sc_mul(r, r, r);
+		const int d = (int)(e[i / 16] >> (4 * (i % 16))) & 0xf;
+		if (d)
+			sc_mul(r, r, tab[d]);
+	}
+	u256_copy(z, r);
+}
+
+/*
+ * GLV split: k = k1 + k2 * lambda mod n, with k1 and k2 returned as
+ * magnitudes below 2^128 and their signs, k is not in the Montgomery
+ * domain
+ */
+static void sc_split(uint64_t k1[4], int *neg1, uint64_t k2[4], int *neg2,
+		     const uint64_t k[4])
+{
+	uint64_t c1[4], c2[4], t[4];
+	const uint64_t *g[2] = { glv_g1, glv_g2 };
+	uint64_t *c[2] = { c1, c2 };
+	/* c = round(k * g / 2^384) */
+	for (int m = 0; m < 2; m++) {
+		uint64_t w[8] = { 0 };
+		for (int i = 0; i < 4; i++) {
+			uint64_t carry = 0;
+			for (int j = 0; j < 4; j++) {
+				u128 uv = (u128)k[i] * g[m][j] + w[i + j] + carry;
+				w[i + j] = (uint64_t)uv;
+				carry = (uint64_t)(uv >> 64);
+			}
+			w[i + 4] = carry;
+		}
+		const uint64_t r[4] = { w[6], w[7], 0, 0 };
+		u256_add_word(c[m], r, w[5] >> 63);
+	}
+	sc_mul_plain(c1, c1, glv_minus_b1);
+	sc_mul_plain(c2, c2, glv_minus_b2);
+	sc_add(k2, c1, c2);
+	sc_mul_plain(t, k2, glv_lambda);
+	sc_sub(k1, k, t);
+	*neg1 = u256_lt(sc_half_n, k1);
+	if (*neg1)
+		u256_sub(k1, sc_n, k1);
+	*neg2 = u256_lt(sc_half_n, k2);
+	if (*neg2)
+		u256_sub(k2, sc_n, k2);
+}
+
+/*
+ * z[i] = 1 / x[i] for n values, none of them 0, with one inversion
+ * [Mont87]; acc holds n temporaries, z may be x
+ */
+typedef void (*mul_f)(uint64_t z[4], const uint64_t x[4], const uint64_t y[4]);
+typedef void (*inv_f)(uint64_t z[4], const uint64_t x[4]);
+
+static void batch_inv(uint64_t (*z)[4], uint64_t (*x)[4], size_t n,
+		      uint64_t (*acc)[4], mul_f mul, inv_f inv)
+{
+	uint64_t t[4], xi[4];
+	if (n == 0)
+		return;
+	u256_copy(acc[0], x[0]);
+	for (size_t i = 1; i < n; i++)
+		mul(acc[i], acc[i - 1], x[i]);
+	inv(t, acc[n - 1]);
+	for (size_t i = n - 1; i > 0; i--) {
+		u256_copy(xi, x[i]);
+		mul(z[i], t, acc[i - 1]);
+		mul(t, t, xi);
+	}
+	u256_copy(z[0], t);
+}
+
+/**********************************************************************
+ *
+ * Points in Jacobian coordinates (X:Y:Z), x = X/Z^2 and y = Y/Z^3
+ *
+ **********************************************************************/
+
+typedef struct {
+	uint64_t x[4], y[4], z[4];
+	int inf;
+} k1_point;
+
+typedef struct {
+	uint64_t x[4], y[4];
+} k1_affine;
+
+static void point_from_affine(k1_point *r, const k1_affine *a)
+{
+	u256_copy(r->x, a->x);
+	u256_copy(r->y, a->y);
+	r->z[0] = 1; r->z[1] = r->z[2] = r->z[3] = 0;
+	r->inf = 0;
+}
+
+/* r = 2 * p, dbl-2009-l */
+static void point_double(k1_point *r, const k1_point *p)
+{
+	uint64_t a[4], b[4], c[4], d[4], e[4], f[4], t[4];
+	if (p->inf || u256_iszero(p->y)) {
+		r->inf = 1;
+		return;
+	}
+	fe_mul(t, p->y, p->z); /* Z3 / 2 */
+	fe_sqr(a, p->x);
+	fe_sqr(b, p->y);
+	fe_sqr(c, b);
+	fe_add(d, p->x, b);
+	fe_sqr(d, d);
+	fe_sub(d, d, a);
+	fe_sub(d, d, c);
+	fe_add(d, d, d);
+	fe_add(e, a, a);
+	fe_add(e, e, a);
+	fe_sqr(f, e);
+	fe_add(r->z, t, t);
+	fe_sub(r->x, f, d);
+	fe_sub(r->x, r->x, d);
+	fe_sub(d, d, r->x);
+	fe_mul(r->y, e, d);
+	fe_add(c, c, c);
+	fe_add(c, c, c);
+	fe_add(c, c, c);
+	fe_sub(r->y, r->y, c);
+	r->inf = 0;
+}
+
+/* r = p + q, madd-2007-bl */
+static void point_add_affine(k1_point *r, const k1_point *p, const k1_affine *q)
+{
+	uint64_t z1z1[4], u2[4], s2[4], h[4], hh[4], i[4], j[4], rr[4], v[4], t[4];
+	if (p->inf) {
+		point_from_affine(r, q);
+		return;
+	}
+	fe_sqr(z1z1, p->z);
+	fe_mul(u2, q->x, z1z1);
+	fe_mul(s2, q->y, p->z);
+	fe_mul(s2, s2, z1z1);
+	fe_sub(h, u2, p->x);
+	fe_sub(rr, s2, p->y);
+	if (u256_iszero(h)) {
+		if (u256_iszero(rr))
+			point_double(r, p);
+		else
+			r->inf = 1;
+		return;
+	}
+	fe_sqr(hh, h);
+	fe_add(i, hh, hh);
+	fe_add(i, i, i);
+	fe_mul(j, h, i);
+	fe_add(rr, rr, rr);
+	fe_mul(v, p->x, i);
+	fe_mul(t, p->y, j);
+	fe_mul(r->z, p->z, h);
+	fe_add(r->z, r->z, r->z);
+	fe_sqr(r->x, rr);
+	fe_sub(r->x, r->x, j);
+	fe_sub(r->x, r->x, v);
+	fe_sub(r->x, r->x, v);
+	fe_sub(v, v, r->x);
+	fe_mul(r->y, rr, v);
+	fe_sub(r->y, r->y, t);
+	fe_sub(r->y, r->y, t);
+	r->inf = 0;
+}
+
+/* r = p + q, add-2007-bl */
+static void point_add(k1_point *r, const k1_point *p, const k1_point *q)
+{
+	uint64_t z1z1[4], z2z2[4], u1[4], u2[4], s1[4], s2[4], h[4], i[4], j[4],
+		rr[4], v[4], t[4];
+	if (p->inf) {
+		*r = *q;
+		return;
+	}
+	if (q->inf) {
+		*r = *p;
+		return;
+	}
+	fe_sqr(z1z1, p->z);
+	fe_sqr(z2z2, q->z);
+	fe_mul(u1, p->x, z2z2);
+	fe_mul(u2, q->x, z1z1);
+	fe_mul(s1, p->y, q->z);
+	fe_mul(s1, s1, z2z2);
+	fe_mul(s2, q->y, p->z);
+	fe_mul(s2, s2, z1z1);
+	fe_sub(h, u2, u1);
+	fe_sub(rr, s2, s1);
+	if (u256_iszero(h)) {
+		if (u256_iszero(rr))
+			point_double(r, p);
+		else
+			r->inf = 1;
+		return;
+	}
+	fe_add(i, h, h);
+	fe_sqr(i, i);
+	fe_mul(j, h, i);
+	fe_add(rr, rr, rr);
+	fe_mul(v, u1, i);
+	fe_mul(t, s1, j);
+	fe_mul(r->z, p->z, q->z);
+	fe_mul(r->z, r->z, h);
+	fe_add(r->z, r->z, r->z);
+	fe_sqr(r->x, rr);
+	fe_sub(r->x, r->x, j);
+	fe_sub(r->x, r->x, v);
+	fe_sub(r->x, r->x, v);
+	fe_sub(v, v, r->x);
+	fe_mul(r->y, rr, v);
+	fe_sub(r->y, r->y, t);
+	fe_sub(r->y, r->y, t);
+	r->inf = 0;
+}
+
+/* affine coordinates of n points, none at infinity, with one
+ * inversion; zi holds n temporaries */
+static void point_normalize(k1_affine *a, const k1_point *p, size_t n,
+			    uint64_t (*zi)[4], uint64_t (*acc)[4])
+{
+	uint64_t t[4];
+	for (size_t i = 0; i < n; i++)
+		u256_copy(zi[i], p[i].z);
+	batch_inv(zi, zi, n, acc, fe_mul, fe_inv);
+	for (size_t i = 0; i < n; i++) {
+		fe_sqr(t, zi[i]);
+		fe_mul(a[i].x, p[i].x, t);
+		fe_mul(t, t, zi[i]);
+		fe_mul(a[i].y, p[i].y, t);
+	}
+}
+
+/* y^2 = x^3 + 7 */
+static void curve_rhs(uint64_t r[4], const uint64_t x[4])
+{
+	static const uint64_t b[4] = { 7, 0, 0, 0 };
+	fe_sqr(r, x);
+	fe_mul(r, r, x);
+	fe_add(r, r, b);
+}
+
+/* y from x and the parity of y as ECP_setx(), 0 on success */
+static int point_setx(k1_affine *a, const uint64_t x[4], int parity)
+{
+	uint64_t rhs[4], t[4];
+	u256_reduce(a->x, x, fe_p);
+	curve_rhs(rhs, a->x);
+	fe_sqrt(a->y, rhs);
+	fe_sqr(t, a->y);
+	if (u256_iszero(rhs) || !u256_eq(t, rhs))
+		return -1;
+	if ((int)(a->y[0] & 1) != parity)
+		fe_neg(a->y, a->y);
+	return 0;
+}
+
+/* point from its uncompressed or compressed encoding as
+ * ECP_fromOctet(), 0 on success */
+static int point_from_octet(k1_affine *a, const octet *o)
+{
+	uint64_t x[4], rhs[4], t[4];
+	if (o->len < 33)
+		return -1;
+	u256_from_be(x, o->val + 1, 32);
+	if (o->val[0] == 0x04 && o->len >= 65) {
+		u256_reduce(a->x, x, fe_p);
+		u256_from_be(t, o->val + 33, 32);
+		u256_reduce(a->y, t, fe_p);
+		curve_rhs(rhs, a->x);
+		fe_sqr(t, a->y);
+		return u256_eq(t, rhs) ? 0 : -1;
+	}
+	if (o->val[0] == 0x02 || o->val[0] == 0x03)
+		return point_setx(a, x, o->val[0] & 1);
+	return -1;
+}
+
+/**********************************************************************
+ *
+ * Scalar multiplication
+ *
+ **********************************************************************/
+
+#define WNAF_G 8 /* width of the wNAF on the tables of G, built once */
+#define WNAF_Q 5 /* width of the wNAF on the tables of Q */
+#define G_ODD (1 << (WNAF_G - 2))
+#define Q_ODD (1 << (WNAF_Q - 2))
+
+static k1_affine g_odd[G_ODD]; /* G, 3G, 5G ... */
+static k1_affine g_odd_lam[G_ODD]; /* lambda * the above */
+static volatile int g_state = ZEN_ONCE_MISSING;
+
+/* Q, 3Q ... (2 Q_ODD - 1) Q in t[0 .. Q_ODD) */
+static void odd_multiples(k1_point *t, const k1_affine *q, int n)
+{
+	k1_point q2;
+	point_from_affine(&t[0], q);
+	point_double(&q2, &t[0]);
+	for (int i = 1; i < n; i++)
+		point_add(&t[i], &t[i - 1], &q2);
+}
+
+static void g_tables_build(void)
+{
+	k1_point pts[G_ODD];
+	uint64_t zi[G_ODD][4], acc[G_ODD][4];
+	k1_affine g;
+	u256_copy(g.x, k1_gx);
+	u256_copy(g.y, k1_gy);
+	odd_multiples(pts, &g, G_ODD);
+	point_normalize(g_odd, pts, G_ODD, zi, acc);
+	for (int i = 0; i < G_ODD; i++) {
+		fe_mul(g_odd_lam[i].x, g_odd[i].x, fe_beta);
+		u256_copy(g_odd_lam[i].y, g_odd[i].y);
+	}
+}
+
+static void g_tables(void)
+{
+	zen_once(&g_state, g_tables_build);
+}
+
+/*
+ * Width w non-adjacent form of s < 2^256
+ * out: naf[i] odd in (-2^(w-1), 2^(w-1)) or 0, returns the length
+ */
+static int wnaf(int8_t naf[257], const uint64_t s[4], int w)
+{
+	uint64_t d[5] = { s[0], s[1], s[2], s[3], 0 };
+	const int64_t half = 1 << (w - 1);
+	int len = 0;
+	while (d[0] | d[1] | d[2] | d[3] | d[4]) {
+		int64_t digit = 0;
+		if (d[0] & 1) {
+			digit = (int64_t)(d[0] & ((1 << w) - 1));
+			if (digit >= half)
+				digit -= 2 * half;
+			/* d -= digit */
+			if (digit > 0) {
+				uint64_t b = (uint64_t)digit;
+				for (int i = 0; i < 5 && b; i++) {
+					const uint64_t o = d[i];
+					d[i] -= b;
+					b = d[i] > o;
+				}
+			} else {
+				uint64_t c = (uint64_t)-digit;
+				for (int i = 0; i < 5 && c; i++) {
+					d[i] += c;
+					c = d[i] < c;
+				}
+			}
+		}
+		naf[len++] = (int8_t)digit;
+		for (int i = 0; i < 4; i++)
+			d[i] = (d[i] >> 1) | (d[i + 1] << 63);
+		d[4] >>= 1;
+	}
+	return len;
+}
+
+/*
+ * r = u1 * G + u2 * Q, u1 and u2 out of the Montgomery domain, q holds
+ * the Q_ODD odd multiples of Q: u1 and u2 are split in halves for the
+ * tables of G and lambda * G and those of Q and lambda * Q, then all
+ * four are added in a single pass of doublings
+ */
+static void scalar_mult_joint(k1_point *r, const uint64_t u1[4],
+			      const k1_affine *q, const uint64_t u2[4])
+{
+	int8_t naf[4][257];
+	uint64_t k[4][4];
+	int neg[4], len[4], max = 0;
+	k1_affine qlam[Q_ODD], t;
+	const k1_affine *tab[4] = { g_odd, g_odd_lam, q, qlam };
+	for (int i = 0; i < Q_ODD; i++) {
+		fe_mul(qlam[i].x, q[i].x, fe_beta);
+		u256_copy(qlam[i].y, q[i].y);
+	}
+	sc_split(k[0], &neg[0], k[1], &neg[1], u1);
+	sc_split(k[2], &neg[2], k[3], &neg[3], u2);
+	for (int i = 0; i < 4; i++) {
+		memset(naf[i], 0, sizeof naf[i]);
+		len[i] = wnaf(naf[i], k[i], i < 2 ? WNAF_G : WNAF_Q);
+		if (len[i] > max)
+			max = len[i];
+	}
+	r->inf = 1;
+	for (int i = max - 1; i >= 0; i--) {
+		point_double(r, r);
+		for (int m = 0; m < 4; m++) {
+			const int d = naf[m][i];
+			if (!d)
+				continue;
+			t = tab[m][(d < 0 ? -d : d) / 2];
+			if ((d < 0) ^ neg[m])
+				fe_neg(t.y, t.y);
+			point_add_affine(r, r, &t);
+		}
+	}
+}
+
+/**********************************************************************
+ *
+ * Batches
+ *
+ **********************************************************************/
+
+typedef struct {
+	uint64_t u1[4], u2[4]; /* scalars of G and of q */
+	uint64_t c[4]; /* r */
+	k1_affine q; /* public key, or the point R in recovery */
+	k1_point r;
+	int i; /* index in the batch */
+} k1_job;
+
+typedef struct {
+	k1_job *job;
+	k1_point *jac;
+	k1_affine *tab;
+	uint64_t (*v)[4], (*acc)[4];
+} k1_batch;
+
+static void batch_free(k1_batch *b)
+{
+	free(b->job);
+	free(b->jac);
+	free(b->tab);
+	free(b->v);
+	free(b->acc);
+}
+
+static int batch_alloc(k1_batch *b, int n)
+{
+	const size_t m = (size_t)n * Q_ODD;
+	b->job = malloc((size_t)n * sizeof(k1_job));
+	b->jac = malloc(m * sizeof(k1_point));
+	b->tab = malloc(m * sizeof(k1_affine));
+	b->v = malloc(m * sizeof(*b->v));
+	b->acc = malloc(m * sizeof(*b->acc));
+	if (b->job && b->jac && b->tab && b->v && b->acc)
+		return 0;
+	batch_free(b);
+	return -1;
+}
+
+/* u1 * G + u2 * q for the first n jobs, tables of q brought to
+ * affine coordinates all together */
+static void batch_mult(k1_batch *b, int n)
+{
+	g_tables();
+	for (int k = 0; k < n; k++)
+		odd_multiples(b->jac + k * Q_ODD, &b->job[k].q, Q_ODD);
+	point_normalize(b->tab, b->jac, (size_t)n * Q_ODD, b->v, b->acc);
+	for (int k = 0; k < n; k++)
+		scalar_mult_joint(&b->job[k].r, b->job[k].u1,
+				  b->tab + k * Q_ODD, b->job[k].u2);
+}
+
+void SECP256K1_GLV_VP_DSA_NOHASH_BATCH(int n, octet **W, octet **H,
+				       octet **C, octet **D, int *res)
+{
+	k1_batch b;
+	uint64_t d[4], e[4], t[4];
+	int m = 0;
+	if (n <= 0)
+		return;
+	if (batch_alloc(&b, n)) {
+		for (int i = 0; i < n; i++)
+			res[i] = ECDH_ERROR;
+		return;
+	}
+	for (int i = 0; i < n; i++) {
+		k1_job *j = &b.job[m];
+		u256_from_octet(j->c, C[i]);
+		u256_from_octet(d, D[i]);
+		if (u256_iszero(j->c) || !u256_lt(j->c, sc_n) ||
+		    u256_iszero(d) || !u256_lt(d, sc_n)) {
+			res[i] = ECDH_INVALID;
+			continue;
+		}
+		if (point_from_octet(&j->q, W[i])) {
+			res[i] = ECDH_ERROR;
+			continue;
+		}
+		sc_prep(b.v[m], d);
+		j->i = i;
+		m++;
+	}
+	/* u1 = e / s and u2 = r / s */
+	batch_inv(b.v, b.v, (size_t)m, b.acc, sc_mul, sc_inv);
+	for (int k = 0; k < m; k++) {
+		k1_job *j = &b.job[k];
+		u256_from_hash(t, H[j->i]);
+		u256_reduce(e, t, sc_n);
+		sc_mul(j->u1, e, b.v[k]);
+		sc_mul(j->u2, j->c, b.v[k]);
+	}
+	batch_mult(&b, m);
+	/* x(R) mod n = r, as X = r * Z^2 or X = (r + n) * Z^2 */
+	for (int k = 0; k < m; k++) {
+		k1_job *j = &b.job[k];
+		int ok = 0;
+		if (!j->r.inf) {
+			uint64_t z2[4];
+			fe_sqr(z2, j->r.z);
+			fe_mul(t, j->c, z2);
+			ok = u256_eq(t, j->r.x);
+			if (!ok && u256_lt(j->c, p_minus_n)) {
+				u256_add(t, j->c, sc_n);
+				fe_mul(t, t, z2);
+				ok = u256_eq(t, j->r.x);
+			}
+		}
+		res[j->i] = ok ? 0 : ECDH_INVALID;
+	}
+	batch_free(&b);
+}
+
+void SECP256K1_GLV_PUBLIC_KEY_RECOVERY_BATCH(int n, octet **X,
+					     const int *y_parity, octet **H,
+					     octet **C, octet **D,
+					     octet **PK, int *res)
+{
+	k1_batch b;
+	uint64_t x[4], d[4], h[4], t[4];
+	int m = 0, f = 0;
+	if (n <= 0)
+		return;
+	if (batch_alloc(&b, n)) {
+		for (int i = 0; i < n; i++)
+			res[i] = ECDH_ERROR;
+		return;
+	}
+	for (int i = 0; i < n; i++) {
+		k1_job *j = &b.job[m];
+		u256_from_octet(x, X[i]);
+		if (point_setx(&j->q, x, y_parity[i])) {
+			res[i] = -1;
+			continue;
+		}
+		u256_from_octet(t, C[i]);
+		u256_reduce(j->c, t, sc_n);
+		if (u256_iszero(j->c)) {
+			/* 1 / r is taken as 0, which gives the point at infinity */
+			memset(PK[i]->val, 0, 65);
+			PK[i]->val[0] = 0x04;
+			PK[i]->len = 65;
+			res[i] = ECDH_INVALID_PUBLIC_KEY;
+			continue;
+		}
+		sc_prep(b.v[m], j->c);
+		j->i = i;
+		m++;
+	}
+	/* Q = (s * R - e * G) / r, u1 = -e / r and u2 = s / r */
+	batch_inv(b.v, b.v, (size_t)m, b.acc, sc_mul, sc_inv);
+	for (int k = 0; k < m; k++) {
+		k1_job *j = &b.job[k];
+		static const uint64_t zero[4] = { 0, 0, 0, 0 };
+		u256_from_hash(t, H[j->i]);
+		u256_reduce(h, t, sc_n);
+		sc_sub(h, zero, h);
+		u256_from_octet(t, D[j->i]);
+		u256_reduce(d, t, sc_n);
+		sc_mul(j->u1, h, b.v[k]);
+		sc_mul(j->u2, d, b.v[k]);
+	}
+	batch_mult(&b, m);
+	/* the public keys at infinity are invalid, the others brought
+	 * to affine coordinates together */
+	for (int k = 0; k < m; k++) {
+		k1_job *j = &b.job[k];
+		if (j->r.inf) {
+			octet *o = PK[j->i];
+			memset(o->val, 0, 65);
+			o->val[0] = 0x04;
+			o->len = 65;
+			res[j->i] = ECDH_INVALID_PUBLIC_KEY;
+			continue;
+		}
+		b.jac[f] = j->r;
+		b.job[f].i = j->i;
+		f++;
+	}
+	point_normalize(b.tab, b.jac, (size_t)f, b.v, b.acc);
+	for (int k = 0; k < f; k++) {
+		octet *o = PK[b.job[k].i];
+		o->val[0] = 0x04;
+		u256_to_be(o->val + 1, b.tab[k].x);
+		u256_to_be(o->val + 33, b.tab[k].y);
+		o->len = 65;
+		res[b.job[k].i] = 0;
+	}
+	batch_free(&b);
+}
+
+int SECP256K1_GLV_VP_DSA_NOHASH(int sha, octet *W, octet *H, octet *C, octet *D)
+{
+	int res;
+	(void)sha;
+	SECP256K1_GLV_VP_DSA_NOHASH_BATCH(1, &W, &H, &C, &D, &res);
+	return res;
+}
+
+int SECP256K1_GLV_VP_DSA(int sha, octet *W, octet *F, octet *C, octet *D)
+{
+	char h[128];
+	octet H = { 0, sizeof(h), h, 1 };
+	ehashit(sha, F, -1, NULL, &H, sha);
+	return SECP256K1_GLV_VP_DSA_NOHASH(sha, W, &H, C, D);
+}
+
+int SECP256K1_GLV_PUBLIC_KEY_RECOVERY(octet *X, int y_parity, octet *H,
+				      octet *C, octet *D, octet *PK)
+{
+	int res;
+	SECP256K1_GLV_PUBLIC_KEY_RECOVERY_BATCH(1, &X, &y_parity, &H, &C, &D,
+						&PK, &res);
+	return res;
+}
+
+#endif /* SECP256K1_GLV */
@@ -0,0 +1,83 @@
+/* This file is part of Zenroom (https://zenroom.dyne.org)
+ *
+ * Copyright (C) 2025 Dyne.org foundation
+ * designed, written and maintained by Denis Roio <jaromil@dyne.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * ECDSA verification and public key recovery on curve secp256k1
+ *
+ * Drop-in replacements of Milagro's ECP_SECP256K1_VP_DSA,
+ * ECP_SECP256K1_VP_DSA_NOHASH and ECP_SECP256K1_PUBLIC_KEY_RECOVERY,
+ * taking the same arguments and giving the same results, plus batch
+ * versions of the last two. Built with -DSECP256K1_GLV on hosts with
+ * 64x64->128 bit multiplication, see build/posix.mk, and installed in
+ * the ECDH class by build/codegen_ecdh_factory.sh.
+ */
+#ifndef SECP256K1_GLV_H
+#define SECP256K1_GLV_H
+
+#include <zen_octet.h>
+
+#if defined(SECP256K1_GLV) && !defined(__SIZEOF_INT128__)
+#error "SECP256K1_GLV needs a compiler with 128 bit integers"
+#endif
+
+/*
+ * ECDSA verify
+ *
+ * [in] sha: size in bytes of the hash applied to F, see ehashit()
+ * [in] W: public key, uncompressed (0x04) or compressed (0x02, 0x03)
+ * [in] F, H: message, or its hash truncated to 32 bytes
+ * [in] C, D: signature (r, s) as big-endian integers
+ *
+ * return:  0 if the signature is valid
+ *          ECDH_ERROR if W is not a point of the curve
+ *          ECDH_INVALID otherwise
+ */
+int SECP256K1_GLV_VP_DSA(int sha, octet *W, octet *F, octet *C, octet *D);
+int SECP256K1_GLV_VP_DSA_NOHASH(int sha, octet *W, octet *H, octet *C, octet *D);
+
+/*
+ * ECDSA public key recovery
+ *
+ * [in] X, y_parity: x coordinate and parity of y of the point R
+ *      of the signature
+ * [in] H: hash of the message, truncated to 32 bytes
+ * [in] C, D: signature (r, s) as big-endian integers
+ * [out] PK: on success, holds the uncompressed public key
+ *
+ * return:  0 on success
+ *          -1 if X is not the x coordinate of a point of the curve
+ *          ECDH_INVALID_PUBLIC_KEY if the result is the point at infinity
+ */
+int SECP256K1_GLV_PUBLIC_KEY_RECOVERY(octet *X, int y_parity, octet *H,
+				      octet *C, octet *D, octet *PK);
+
+/*
+ * Batch versions: the n inputs are independent and each res[i] is the
+ * return value of the single call on the i-th of them. Inversions are
+ * shared between all the inputs.
+ */
+void SECP256K1_GLV_VP_DSA_NOHASH_BATCH(int n, octet **W, octet **H,
+				       octet **C, octet **D, int *res);
+void SECP256K1_GLV_PUBLIC_KEY_RECOVERY_BATCH(int n, octet **X,
+					     const int *y_parity, octet **H,
+					     octet **C, octet **D,
+					     octet **PK, int *res);
+
+#endif
@@ -27,6 +27,7 @@
 
 #include <zenroom.h>
 #include <zen_memory.h>
+#include <aes_gcm.h>
 
 /// <h1>Advanced Encryption Standard (AES)</h1>
 //
@@ -40,9 +41,9 @@
 //  @license AGPLv3
 //  @copyright Dyne.org foundation 2017-2020
 
-// from milagro's pbc_support.h
-extern void AES_GCM_ENCRYPT(octet *K, octet *IV, octet *H, octet *P, octet *C, octet *T);
-extern void AES_GCM_DECRYPT(octet *K, octet *IV, octet *H, octet *C, octet *P, octet *T);
+//  AES-GCM and AES-CTR run on AES-NI and PCLMULQDQ when the cpu
+//  supports them, else on milagro's portable implementation: both
+//  give the same output, see @{backend}.
 
 /*
    AES-GCM encrypt with Additional Data (AEAD) encrypts and
@@ -67,14 +68,14 @@ extern void AES_GCM_DECRYPT(octet *K, octet *IV, octet *H, octet *C, octet *P, o
 static int gcm_encrypt(lua_State *L) {
 	BEGIN();
 	char *failed_msg = NULL;
-	octet *k = NULL, *in = NULL, *iv = NULL, *h = NULL;
+	const octet *k = NULL, *in = NULL, *iv = NULL, *h = NULL;
 	k =  o_arg(L, 1);
 	if(k == NULL) {
 		failed_msg = "failed to allocate space for the aes key";
 		goto end;
 	}
         // AES key size nk can be 16, 24 or 32 bytes
-	if(k->len > 32 || k->len < 16) {
+	if(k->len != 16 && k->len != 24 && k->len != 32) {
 		zerror(L, "ECDH.aead_encrypt accepts only keys of 16, 24, 32, this is %u", k->len);
 		failed_msg = "ECDH encryption aborted";
 		goto end;
@@ -110,7 +111,7 @@ static int gcm_encrypt(lua_State *L) {
 		failed_msg = "failed to allocate space for the checksum";
 		goto end;
 	}
-	AES_GCM_ENCRYPT(k, iv, h, in, out, t);
+	AES_GCM_encrypt(k, iv, h, in, out, t);
 end:
 	o_free(L, h);
 	o_free(L, iv);
@@ -140,13 +141,13 @@ end:
 static int gcm_decrypt(lua_State *L) {
 	BEGIN();
 	char *failed_msg = NULL;
-	octet *k = NULL, *in = NULL, *iv = NULL, *h = NULL;
+	const octet *k = NULL, *in = NULL, *iv = NULL, *h = NULL;
 	k = o_arg(L, 1);
 	if(k == NULL) {
 		failed_msg = "failed to allocate space for the aes key";
 		goto end;
 	}
-	if(k->len > 32 || k->len < 16) {
+	if(k->len != 16 && k->len != 24 && k->len != 32) {
 		zerror(L, "ECDH.aead_decrypt accepts only keys of 16, 24, 32, this is %u", k->len);
 		failed_msg = "ECDH decryption aborted";
 		goto end;
@@ -182,7 +183,7 @@ static int gcm_decrypt(lua_State *L) {
 		failed_msg = "failed to allocate space for the checksum";
 		goto end;
 	}
-	AES_GCM_DECRYPT(k, iv, h, in, out, t2);
+	AES_GCM_decrypt(k, iv, h, in, out, t2);
 end:
 	o_free(L, h);
 	o_free(L, iv);
@@ -195,18 +196,29 @@ end:
 	END(2);
 }
 
-static int ctr_encrypt(lua_State *L) {
+/*
+   AES-CTR encrypts or decrypts a message of any length, the same
+   function does both. The counter is the 128 bit big endian number
+   in the first 16 bytes of the iv, shorter ivs are padded with zeros.
+
+   @param key AES key octet (must be 16, 24 or 32 bytes long)
+   @param message input text in an octet
+   @param iv initial counter block, 12 bytes minimum
+   @function ctr_encrypt(key, message, iv)
+   @treturn[1] octet containing the output text
+*/
+static int ctr_process(lua_State *L) {
 	BEGIN();
 	char *failed_msg = NULL;
-	octet *k = NULL, *in = NULL, *iv = NULL;
-	amcl_aes a;
+	const octet *k = NULL, *in = NULL, *iv = NULL;
+	unsigned char ctr[16];
 	k = o_arg(L, 1);
 	if(k == NULL) {
 		failed_msg = "failed to allocate space for the aes key";
 		goto end;
 	}
-	if(k->len != 16 && k->len != 32) {
-		zerror(L, "AES.ctr_process accepts only keys of 16 or 32 bytes, this is %u", k->len);
+	if(k->len != 16 && k->len != 24 && k->len != 32) {
+		zerror(L, "AES.ctr_process accepts only keys of 16, 24 or 32 bytes, this is %u", k->len);
 		failed_msg = "AES-CTR process aborted";
 		goto end;
 	}
@@ -225,14 +237,15 @@ static int ctr_encrypt(lua_State *L) {
 		failed_msg = "AES-CTR process aborted";
 		goto end;
 	}
-	AES_init(&a, CTR16, k->len, k->val, iv->val);
-	octet *out = o_dup(L, in);
+	memset(ctr, 0, 16);
+	memcpy(ctr, iv->val, iv->len < 16 ? iv->len : 16);
+	octet *out = o_new(L, in->len);
 	if(out == NULL) {
 		failed_msg = "failed to allocate space for the output";
 		goto end;
 	}
-	AMCL_(AES_encrypt)(&a, out->val);
-	AES_end(&a);
+	aes_ctr(out->val, in->val, in->len, k->val, k->len, ctr);
+	out->len = in->len;
 end:
 	o_free(L, iv);
 	o_free(L, in);
@@ -243,66 +256,215 @@ end:
 	END(1);
 }
 
-static int ctr_decrypt(lua_State *L) {
+// state of a streaming AES-GCM, see @{gcm_encrypt_init}
+typedef struct {
+	int open;
+	aes_gcm c;
+} gcm_stream;
+
+static int gcm_init(lua_State *L, int decrypt) {
 	BEGIN();
 	char *failed_msg = NULL;
-	octet *k = NULL, *in = NULL, *iv = NULL;
-	amcl_aes a;
+	const octet *k = NULL, *iv = NULL, *h = NULL;
 	k = o_arg(L, 1);
 	if(k == NULL) {
 		failed_msg = "failed to allocate space for the aes key";
 		goto end;
 	}
-	if(k->len != 16 && k->len != 32) {
-		zerror(L, "AES.ctr_process accepts only keys of 16 or 32 bytes, this is %u", k->len);
-		failed_msg = "AES-CTR process aborted";
-		goto end;
-	}
-	in = o_arg(L, 2);
-	if(in == NULL) {
-		failed_msg = "failed to allocate space for the message text";
+	if(k->len != 16 && k->len != 24 && k->len != 32) {
+		zerror(L, "AES.gcm_init accepts only keys of 16, 24, 32, this is %u", k->len);
+		failed_msg = "AES-GCM stream aborted";
 		goto end;
 	}
-	iv = o_arg(L, 3);
+	iv = o_arg(L, 2);
 	if(iv == NULL) {
 		failed_msg = "failed to allocate space for the iv";
 		goto end;
 	}
 	if (iv->len < 12) {
-		zerror(L, "AES.ctr_process accepts an iv of 12 bytes minimum, this is %u", iv->len);
-		failed_msg = "AES-CTR process aborted";
+		zerror(L, "AES.gcm_init accepts an iv of 12 bytes minimum, this is %u", iv->len);
+		failed_msg = "AES-GCM stream aborted";
+		goto end;
+	}
+	if(lua_isnoneornil(L, 3)) {
+		h = o_alloc(L, 0);
+	} else {
+		h = o_arg(L, 3);
+	}
+	if(h == NULL) {
+		failed_msg = "failed to allocate space for the header";
+		goto end;
+	}
+	gcm_stream *s = (gcm_stream *)lua_newuserdatauv(L, sizeof(gcm_stream), 0);
+	if(HEDLEY_UNLIKELY(s==NULL)) {
+		failed_msg = "Cannot create AES-GCM stream, lua_newuserdata failure";
+		goto end;
+	}
+	s->open = aes_gcm_init(&s->c, decrypt, k->val, k->len,
+	                       iv->val, iv->len, h->val, h->len);
+	luaL_getmetatable(L, "zenroom.aes_gcm");
+	lua_setmetatable(L, -2);
+end:
+	o_free(L, h);
+	o_free(L, iv);
+	o_free(L, k);
+	if(failed_msg != NULL) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
+/*
+   Starts an AES-GCM encryption fed with @{gcm:update} one piece at a
+   time, so that large messages are never held in memory at once.
+   The concatenation of all the pieces output and the tag returned by
+   @{gcm:final} are the same returned by @{gcm_encrypt}.
+
+   @param key AES key octet (must be 16, 24 or 32 bytes long)
+   @param iv initialization vector, 12 bytes minimum
+   @param[opt] header clear text, authenticated for integrity
+   @function gcm_encrypt_init(key, iv, h)
+   @return a new AES-GCM stream
+*/
+static int gcm_encrypt_init(lua_State *L) {
+	return gcm_init(L, 0);
+}
+
+/*
+   Starts an AES-GCM decryption fed with @{gcm:update} one piece at a
+   time, the tag returned by @{gcm:final} is to be compared with the
+   one obtained by the encryption.
+
+   @param key AES key octet
+   @param iv initialization vector
+   @param[opt] header the additional data
+   @function gcm_decrypt_init(key, iv, h)
+   @return a new AES-GCM stream
+*/
+static int gcm_decrypt_init(lua_State *L) {
+	return gcm_init(L, 1);
+}
+
+/*
+   Encrypts or decrypts the next piece of the message, of any length.
+
+   @param message piece of the input text in an octet
+   @function gcm:update(message)
+   @return octet containing the piece of output text
+*/
+static int gcm_update(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	const octet *in = NULL;
+	gcm_stream *s = (gcm_stream*)luaL_checkudata(L, 1, "zenroom.aes_gcm");
+	if(!s->open) {
+		failed_msg = "AES-GCM stream is already finished";
+		goto end;
+	}
+	in = o_arg(L, 2);
+	if(in == NULL) {
+		failed_msg = "failed to allocate space for the message text";
 		goto end;
 	}
-	AES_init(&a, CTR16, k->len, k->val, iv->val);
-	octet *out = o_dup(L, in);
+	octet *out = o_new(L, in->len);
 	if(out == NULL) {
 		failed_msg = "failed to allocate space for the output";
 		goto end;
 	}
-	AMCL_(AES_decrypt)(&a, out->val);
-	AES_end(&a);
+	aes_gcm_update(&s->c, out->val, in->val, in->len);
+	out->len = in->len;
 end:
-	o_free(L, iv);
 	o_free(L, in);
-	o_free(L, k);
 	if(failed_msg != NULL) {
 		THROW(failed_msg);
 	}
 	END(1);
 }
 
+/*
+   Ends the stream and wipes its keys.
+
+   @function gcm:final()
+   @return octet containing the authentication tag (checksum)
+*/
+static int gcm_final(lua_State *L) {
+	BEGIN();
+	gcm_stream *s = (gcm_stream*)luaL_checkudata(L, 1, "zenroom.aes_gcm");
+	if(!s->open) {
+		THROW("AES-GCM stream is already finished");
+	}
+	octet *t = o_new(L, 16);
+	if(t == NULL) {
+		THROW("failed to allocate space for the checksum");
+	}
+	aes_gcm_final(&s->c, t->val);
+	t->len = 16;
+	s->open = 0;
+	END(1);
+}
+
+static int gcm_destroy(lua_State *L) {
+	gcm_stream *s = (gcm_stream*)luaL_testudata(L, 1, "zenroom.aes_gcm");
+	if(!s) return 0;
+	if(s->open) {
+		char tag[16];
+		aes_gcm_final(&s->c, tag);
+		s->open = 0;
+	}
+	return 0;
+}
+
+/*
+   Tells which implementation of AES is in use, 'aes-ni' or
+   'milagro', and if a name is given switches to it when the cpu
+   supports it.
+
+   @param[opt] name of the implementation to use
+   @function backend(name)
+   @return name of the implementation in use
+*/
+static int aes_set_backend(lua_State *L) {
+	BEGIN();
+	static const char *names[] = { "milagro", "aes-ni" };
+	const char *name = luaL_optstring(L, 1, NULL);
+	int level = -1;
+	if(name) {
+		if(strcmp(name, "aes-ni") == 0) level = AES_AESNI;
+		else if(strcmp(name, "milagro") == 0) level = AES_MILAGRO;
+		else {
+			THROW("AES.backend accepts 'aes-ni' or 'milagro'");
+		}
+	}
+	lua_pushstring(L, names[aes_backend(level)]);
+	END(1);
+}
 
 int luaopen_aes(lua_State *L) {
 	(void)L;
 	const struct luaL_Reg aes_class[] = {
 		{"gcm_encrypt", gcm_encrypt},
 		{"gcm_decrypt", gcm_decrypt},
-		{"ctr_encrypt", ctr_encrypt},
-		{"ctr_decrypt", ctr_decrypt},
+		{"ctr_encrypt", ctr_process},
+		{"ctr_decrypt", ctr_process},
+		{"gcm_encrypt_init", gcm_encrypt_init},
+		{"gcm_decrypt_init", gcm_decrypt_init},
+		{"backend", aes_set_backend},
 		{NULL, NULL}};
 	const struct luaL_Reg aes_methods[] = {
 		{NULL, NULL}
 	};
+	const struct luaL_Reg gcm_methods[] = {
+		{"update", gcm_update},
+		{"final", gcm_final},
+		{"__gc", gcm_destroy},
+		{NULL, NULL}
+	};
+	// streams have methods but no class table, see AES.gcm_encrypt_init
+	luaL_newmetatable(L, "zenroom.aes_gcm");
+	lua_pushvalue(L, -1);
+	lua_setfield(L, -2, "__index");
+	luaL_setfuncs(L, gcm_methods, 0);
+	lua_pop(L, 1);
 
 	zen_add_class(L, "aes", aes_class, aes_methods);
 	return 1;
@@ -253,7 +253,7 @@ int big_init(lua_State *L,big *n) {
 		return 0; }
 	if(!n->val && !n->dval) {
 		size_t size = sizeof(BIG);
-		n->val = (int*)malloc(size);
+		n->val = (chunk*)malloc(size);
 		n->doublesize = 0;
 		n->len = MODBYTES;
 		return(size);
@@ -269,7 +269,7 @@ int dbig_init(lua_State *L,big *n) {
 	size_t size = sizeof(DBIG); //sizeof(DBIG); // modbytes * 2, aka n->len<<1
 	if(n->val && !n->doublesize) {
 		n->doublesize = 1;
-		n->dval = (int*)malloc(size);
+		n->dval = (chunk*)malloc(size);
 		// extend from big to double big
 		BIG_dscopy(n->dval,n->val);
 		free(n->val);
@@ -278,7 +278,7 @@ int dbig_init(lua_State *L,big *n) {
 	}
 	if(!n->val || !n->dval) {
 		n->doublesize = 1;
-		n->dval = (int*)malloc(size);
+		n->dval = (chunk*)malloc(size);
 		n->len = MODBYTES<<1;
 		return(size);
 	}
@@ -24,6 +24,9 @@
 // debug=1..3
 // rngseed=hex:[256 bits in hex notation]
 // print=sys|stb|mutt
+// gc=full|inc|gen
+// gcstep=[KiB of collector work between statements]
+// gctime=[microseconds budget of the collector between statements]
 ///////////////////////
 
 #include <strings.h>
@@ -113,6 +116,10 @@ int zen_conf_parse(zenroom_t *ZZ, const char *configuration) {
 			if(strcasecmp(lex.string,"logfmt") ==0) { curconf = LOGFMT;  break; } // str
 			if(strcasecmp(lex.string,"maxiter")==0) { curconf = MAXITER; break; } // str
 			if(strcasecmp(lex.string,"maxmem")==0)  { curconf = MAXMEM;  break; } // str
+			if(strcasecmp(lex.string,"memmanager")==0) { curconf = MEMMANAGER; break; } // str
+			if(strcasecmp(lex.string,"gc")==0)      { curconf = GCPOLICY; break; } // str
+			if(strcasecmp(lex.string,"gcstep")==0)  { curconf = GCSTEP;  break; } // int
+			if(strcasecmp(lex.string,"gctime")==0)  { curconf = GCTIME;  break; } // int
 			if(curconf==RNGSEED) {
 				if(strncasecmp(lex.string, "hex:", 4) != 0) { // hex: prefix needed
 					_err( "Invalid rngseed data prefix (must be hex:)\n");
@@ -220,6 +227,25 @@ int zen_conf_parse(zenroom_t *ZZ, const char *configuration) {
 				ZZ->str_maxmem[len-4] = 0x0;
 				break;
 			}
+			if(curconf==MEMMANAGER) {
+			  if(strcasecmp(lex.string, "slab") == 0) ZZ->memmanager = MEM_SLAB;
+			  else if(strcasecmp(lex.string, "libc") == 0) ZZ->memmanager = MEM_LIBC;
+			  else {
+				_err( "Invalid memory manager: %s\n",lex.string);
+				return 0;
+			  }
+			  break;
+			}
+			if(curconf==GCPOLICY) {
+			  if(strcasecmp(lex.string, "full") == 0) ZZ->gcpolicy = GC_FULL;
+			  else if(strcasecmp(lex.string, "inc") == 0) ZZ->gcpolicy = GC_INC;
+			  else if(strcasecmp(lex.string, "gen") == 0) ZZ->gcpolicy = GC_GEN;
+			  else {
+				_err( "Invalid garbage collection policy: %s\n",lex.string);
+				return 0;
+			  }
+			  break;
+			}
 			// free(lexbuf);
 			_err( "Invalid configuration: %s\n", lex.string);
 			curconf = NIL;
@@ -227,6 +253,16 @@ int zen_conf_parse(zenroom_t *ZZ, const char *configuration) {
 
 		case CLEX_intlit:
 			if(curconf==VERBOSE) { ZZ->debuglevel = lex.int_number; break; }
+			if(curconf==GCSTEP || curconf==GCTIME) {
+				if(lex.int_number < 0 || lex.int_number > 1000000) {
+					_err( "Invalid %s value: %ld\n",
+						  curconf==GCSTEP ? "gcstep" : "gctime", lex.int_number);
+					return 0;
+				}
+				if(curconf==GCSTEP) ZZ->gcstep = (int)lex.int_number;
+				else ZZ->gctime = (int)lex.int_number;
+				break;
+			}
 			// free(lexbuf);
 			_err( "Invalid integer configuration\n");
 			curconf = NIL;
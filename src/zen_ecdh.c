@@ -55,6 +55,7 @@
 #include <zen_memory.h>
 #include <zen_hash.h>
 #include <zen_ecdh.h>
+#include <aes_gcm.h>
 #include <zen_big_factory.h>
 
 // #include <ecp_SECP256K1.h>
@@ -866,7 +867,7 @@ static int ecdh_aead_encrypt(lua_State *L) {
 		goto end;
 	}
 	// AES key size nk can be 16, 24 or 32 bytes
-	if(k->len > 32 || k->len < 16) {
+	if(k->len != 16 && k->len != 24 && k->len != 32) {
 		zerror(L, "ECDH.aead_encrypt accepts only keys of 16, 24, 32, this is %u", k->len);
 		failed_msg = "ECDH encryption aborted";
 		goto end;
@@ -902,7 +903,7 @@ static int ecdh_aead_encrypt(lua_State *L) {
 		failed_msg = "Could not create authentication tag";
 		goto end;
 	}
-	AES_GCM_ENCRYPT(k, iv, h, in, out, t);
+	AES_GCM_encrypt(k, iv, h, in, out, t);
 end:
 	o_free(L, h);
 	o_free(L, iv);
@@ -937,7 +938,7 @@ static int ecdh_aead_decrypt(lua_State *L) {
 		failed_msg = "Could not allocate aes key";
 		goto end;
 	}
-	if(k->len > 32 || k->len < 16) {
+	if(k->len != 16 && k->len != 24 && k->len != 32) {
 		zerror(L, "ECDH.aead_decrypt accepts only keys of 16, 24, 32, this is %u", k->len);
 		failed_msg = "ECDH decryption aborted";
 		goto end;
@@ -973,7 +974,7 @@ static int ecdh_aead_decrypt(lua_State *L) {
 		failed_msg = "Could not create authentication tag";
 		goto end;
 	}
-	AES_GCM_DECRYPT(k, iv, h, in, out, t2);
+	AES_GCM_decrypt(k, iv, h, in, out, t2);
 end:
 	o_free(L, h);
 	o_free(L, iv);
@@ -1111,6 +1112,186 @@ end:
 	END(2);
 }
 
+/*
+  Octets of the n elements of the table at index t, or of their field f
+  when the elements are tables themselves, into o[0 .. n)
+*/
+static char *ecdh_batch_args(lua_State *L, int t, const char *f, int n,
+			     octet **o) {
+	int i;
+	for(i = 0; i < n; i++) {
+		lua_rawgeti(L, t, i+1);
+		if(f) {
+			if(!lua_istable(L, -1)) {
+				lua_pop(L, 1);
+				return "signature argument invalid: not a table";
+			}
+			lua_getfield(L, -1, f);
+			lua_remove(L, -2);
+		}
+		o[i] = (octet*)o_arg(L, -1);
+		lua_pop(L, 1);
+		if(!o[i]) return "Could not allocate ECDSA batch argument";
+	}
+	return NULL;
+}
+
+/**
+   Verify a batch of ECDSA signatures on hashed messages, each as
+   @{verify_hashed} would, sharing the modular inversions among all of
+   them when the curve implementation supports it.
+
+   @param pks table of public keys
+   @param hashes table of hashed messages, same length
+   @param sigs table of signatures {r,s}, same length
+   @function ECDH.verify_batch(pks, hashes, sigs)
+   @return true if all signatures are valid, false otherwise
+   @return table with the indexes of the invalid signatures
+*/
+static int ecdh_dsa_verify_batch(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	octet **o = NULL; // n keys, hashes, r and s
+	int *res = NULL;
+	int i, j, n = 0;
+	if(!lua_istable(L, 1) || !lua_istable(L, 2) || !lua_istable(L, 3)) {
+		failed_msg = "ECDSA batch verification needs three tables";
+		goto end;
+	}
+	n = lua_rawlen(L, 1);
+	if(n != (int)lua_rawlen(L, 2) || n != (int)lua_rawlen(L, 3)) {
+		failed_msg = "ECDSA batch verification tables differ in length";
+		goto end;
+	}
+	o = calloc(4 * n + 1, sizeof(octet*));
+	res = malloc(sizeof(int) * (n + 1));
+	if(!o || !res) {
+		failed_msg = "Could not allocate ECDSA batch";
+		goto end;
+	}
+	if((failed_msg = ecdh_batch_args(L, 1, NULL, n, o)) ||
+	   (failed_msg = ecdh_batch_args(L, 2, NULL, n, o + n)) ||
+	   (failed_msg = ecdh_batch_args(L, 3, "r", n, o + 2 * n)) ||
+	   (failed_msg = ecdh_batch_args(L, 3, "s", n, o + 3 * n)))
+		goto end;
+	if(ECDH.ECP__VP_DSA_NOHASH_BATCH) {
+		(*ECDH.ECP__VP_DSA_NOHASH_BATCH)(n, o, o + n, o + 2 * n,
+						 o + 3 * n, res);
+	} else {
+		for(i = 0; i < n; i++)
+			res[i] = (*ECDH.ECP__VP_DSA_NOHASH)(o[n+i]->len, o[i], o[n+i],
+							    o[2*n+i], o[3*n+i]);
+	}
+	lua_newtable(L);
+	for(i = 0, j = 1; i < n; i++) {
+		if(res[i] >= 0) continue;
+		lua_pushinteger(L, i+1);
+		lua_rawseti(L, -2, j++);
+	}
+	lua_pushboolean(L, j == 1);
+	lua_insert(L, -2);
+end:
+	if(o) {
+		for(i = 0; i < 4 * n; i++) o_free(L, o[i]);
+	}
+	free(o);
+	free(res);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(2);
+}
+
+/**
+   Recover the public keys of a batch of ECDSA signatures, each as
+   @{recovery} would, sharing the modular inversions among all of them
+   when the curve implementation supports it.
+
+   @param xs table of x coordinates of the ephemeral public keys
+   @param parities table of parities of their y coordinates
+   @param hashes table of hashed messages
+   @param sigs table of signatures {r,s}, all tables of the same length
+   @function ECDH.recover_batch(xs, parities, hashes, sigs)
+   @return table of the recovered public keys
+   @return table with the indexes of those which are not valid
+*/
+static int ecdh_dsa_recover_batch(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	octet **o = NULL; // n x, hashes, r, s and public keys
+	int *res = NULL, *y = NULL;
+	int i, j, n = 0;
+	if(!lua_istable(L, 1) || !lua_istable(L, 2) ||
+	   !lua_istable(L, 3) || !lua_istable(L, 4)) {
+		failed_msg = "ECDSA batch recovery needs four tables";
+		goto end;
+	}
+	n = lua_rawlen(L, 1);
+	if(n != (int)lua_rawlen(L, 2) || n != (int)lua_rawlen(L, 3) ||
+	   n != (int)lua_rawlen(L, 4)) {
+		failed_msg = "ECDSA batch recovery tables differ in length";
+		goto end;
+	}
+	o = calloc(5 * n + 1, sizeof(octet*));
+	res = malloc(sizeof(int) * (n + 1));
+	y = malloc(sizeof(int) * (n + 1));
+	if(!o || !res || !y) {
+		failed_msg = "Could not allocate ECDSA batch";
+		goto end;
+	}
+	for(i = 0; i < n; i++) {
+		int isnum;
+		lua_rawgeti(L, 2, i+1);
+		y[i] = (int)lua_tointegerx(L, -1, &isnum);
+		lua_pop(L, 1);
+		if(!isnum) {
+			failed_msg = "parity of y coordinate has to be a integer";
+			goto end;
+		}
+	}
+	if((failed_msg = ecdh_batch_args(L, 1, NULL, n, o)) ||
+	   (failed_msg = ecdh_batch_args(L, 3, NULL, n, o + n)) ||
+	   (failed_msg = ecdh_batch_args(L, 4, "r", n, o + 2 * n)) ||
+	   (failed_msg = ecdh_batch_args(L, 4, "s", n, o + 3 * n)))
+		goto end;
+	lua_createtable(L, n, 0);
+	for(i = 0; i < n; i++) {
+		octet *pk = o_new(L, ECDH.fieldsize*2 +1);
+		if(pk == NULL) {
+			failed_msg = "Could not create public key";
+			goto end;
+		}
+		lua_rawseti(L, -2, i+1); // the table holds the octet
+		o[4*n+i] = pk;
+	}
+	if(ECDH.ECP__PUBLIC_KEY_RECOVERY_BATCH) {
+		(*ECDH.ECP__PUBLIC_KEY_RECOVERY_BATCH)(n, o, y, o + n, o + 2 * n,
+						       o + 3 * n, o + 4 * n, res);
+	} else {
+		for(i = 0; i < n; i++)
+			res[i] = (*ECDH.ECP__PUBLIC_KEY_RECOVERY)(o[i], y[i], o[n+i],
+								  o[2*n+i], o[3*n+i],
+								  o[4*n+i]);
+	}
+	lua_newtable(L);
+	for(i = 0, j = 1; i < n; i++) {
+		if(!res[i]) continue;
+		lua_pushinteger(L, i+1);
+		lua_rawseti(L, -2, j++);
+	}
+end:
+	if(o) {
+		for(i = 0; i < 4 * n; i++) o_free(L, o[i]);
+	}
+	free(o);
+	free(res);
+	free(y);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(2);
+}
+
 extern int ecdh_add(lua_State *L);
 
 int luaopen_ecdh(lua_State *L) {
@@ -1139,6 +1320,8 @@ int luaopen_ecdh(lua_State *L) {
 		{"sign_hashed", ecdh_dsa_sign_hashed},
 		{"verify_hashed", ecdh_dsa_verify_hashed},
 		{"recovery", ecdh_dsa_recovery},
+		{"verify_batch", ecdh_dsa_verify_batch},
+		{"recover_batch", ecdh_dsa_recover_batch},
 		{"public_xy", ecdh_pub_xy},
 		{"pubxy", ecdh_pub_xy},
 		{"add", ecdh_add},
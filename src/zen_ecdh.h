@@ -48,6 +48,13 @@ typedef struct {
 				  octet *c, octet *d);
 	int (*ECP__PUBLIC_KEY_RECOVERY)(octet *X, int y_parity, octet *H,
 					octet *C, octet *D, octet *PK);
+	// optional, else the batch is a loop of single calls
+	void (*ECP__VP_DSA_NOHASH_BATCH)(int n, octet **W, octet **M,
+					 octet **c, octet **d, int *res);
+	void (*ECP__PUBLIC_KEY_RECOVERY_BATCH)(int n, octet **X,
+					       const int *y_parity, octet **H,
+					       octet **C, octet **D,
+					       octet **PK, int *res);
 	int fieldsize;
 	int hash; // hash type is also bytes length of hash
 	char curve[16]; // just short names
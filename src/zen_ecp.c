@@ -302,7 +302,7 @@ static int ecp_order(lua_State *L) {
 	big *res = big_new(L);
 	if(res) {
 		big_init(L,res);
-		// BIG is an array of int32_t on chunk 32 (see rom_curve)
+		// BIG is an array of chunk sized limbs (see rom_curve)
 
 		// curve order is ready-only so we need a copy for norm() to work
 		BIG_copy(res->val, (chunk*)CURVE_Order);
@@ -529,6 +529,130 @@ end:
 	END(1);
 }
 
+// find the table of a registered fixed base, building it at its first
+// use, returns NULL when P is not registered
+static ECP *_ecp_precomp_table(lua_State *L, ECP *P) {
+	ECP *tab = NULL, *base, B;
+	int i, j, k, n;
+	const int w = PRECOMP_WINDOW, half = 1 << (w-1);
+	const int windows = scalar_windows(w);
+	if(lua_getfield(L, LUA_REGISTRYINDEX, "zenroom.ecp_precomp") != LUA_TTABLE) {
+		lua_pop(L, 1);
+		return NULL;
+	}
+	n = lua_rawlen(L, -1);
+	for(i = 1; i <= n && tab == NULL; i++) {
+		lua_rawgeti(L, -1, i);
+		base = (ECP*)lua_touserdata(L, -1);
+		if(ECP_equals(base, P)) {
+			if(lua_getiuservalue(L, -1, 1) == LUA_TUSERDATA) {
+				tab = (ECP*)lua_touserdata(L, -1);
+				lua_pop(L, 1);
+			} else {
+				lua_pop(L, 1);
+				tab = (ECP*)lua_newuserdatauv(L, sizeof(ECP) * windows * half, 0);
+				ECP_copy(&B, base);
+				for(j = 0; j < windows; j++) {
+					ECP_copy(&tab[j*half], &B);
+					for(k = 1; k < half; k++) {
+						ECP_copy(&tab[j*half+k], &tab[j*half+k-1]);
+						ECP_add(&tab[j*half+k], &B);
+					}
+					for(k = 0; k < w; k++) ECP_dbl(&B);
+				}
+				lua_setiuservalue(L, -2, 1);
+			}
+		}
+		lua_pop(L, 1);
+	}
+	lua_pop(L, 1);
+	return tab;
+}
+
+// one addition per window, selecting table entries in constant time
+static void _ecp_precomp_mul(ECP *res, ECP *tab, BIG b) {
+	short digits[MODBYTES*8/PRECOMP_WINDOW + 2];
+	ECP T, N;
+	int j, k, d, m, a;
+	const int w = PRECOMP_WINDOW, half = 1 << (w-1);
+	const int windows = scalar_windows(w);
+	scalar_recode(digits, b, w, windows);
+	ECP_inf(res);
+	for(j = 0; j < windows; j++) {
+		d = digits[j];
+		m = -(d < 0);
+		a = (d ^ m) - m;
+		ECP_inf(&T);
+		for(k = 0; k < half; k++)
+			zen_cmove(&T, &tab[j*half+k], sizeof(ECP), k+1 == a);
+		ECP_copy(&N, &T);
+		ECP_neg(&N);
+		zen_cmove(&T, &N, sizeof(ECP), d < 0);
+		ECP_add(res, &T);
+	}
+}
+
+// register P as a fixed base, returns 0 when there is no more room
+static int _ecp_precomp_add(lua_State *L, ECP *P) {
+	ECP *base;
+	int i, n, found = 0;
+	if(lua_getfield(L, LUA_REGISTRYINDEX, "zenroom.ecp_precomp") != LUA_TTABLE) {
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushvalue(L, -1);
+		lua_setfield(L, LUA_REGISTRYINDEX, "zenroom.ecp_precomp");
+	}
+	n = lua_rawlen(L, -1);
+	for(i = 1; i <= n && !found; i++) {
+		lua_rawgeti(L, -1, i);
+		found = ECP_equals((ECP*)lua_touserdata(L, -1), P);
+		lua_pop(L, 1);
+	}
+	if(!found && n < PRECOMP_MAX) {
+		base = (ECP*)lua_newuserdatauv(L, sizeof(ECP), 1);
+		ECP_copy(base, P);
+		lua_rawseti(L, -2, n+1);
+	}
+	lua_pop(L, 1);
+	return found || n < PRECOMP_MAX;
+}
+
+/***
+    Register an ECP point as a fixed base: its multiplications will
+    use a table of precomputed multiples, built at the first one. The
+    generator is always registered. The point must be in the subgroup
+    of prime order, because the table works with scalars modulo it.
+
+    @function ECP.precompute(ecp)
+    @param ecp point on the elliptic curve used as base
+    @return true if registered, false if there are too many bases
+*/
+static int ecp_precompute(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	BIG order;
+	ECP T;
+	const ecp *e = ecp_arg(L, 1);
+	if(!e) {
+		failed_msg = "Could not instantiate input";
+		goto end;
+	}
+	BIG_rcopy(order, CURVE_Order);
+	ECP_copy(&T, (ECP*)&e->val);
+	ECP_mul(&T, order);
+	if(!ECP_isinf(&T)) {
+		failed_msg = "Cannot precompute a point out of the prime order subgroup";
+		goto end;
+	}
+	lua_pushboolean(L, _ecp_precomp_add(L, (ECP*)&e->val));
+end:
+	ecp_free(L, e);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
 /***
     Multiply an ECP point by a @{BIG} number. Can be made using the overloaded operator `*`
 
@@ -543,6 +667,7 @@ static int ecp_mul(lua_State *L) {
 	const ecp *e = NULL;
 	const big *b = NULL;
 	ecp *out = NULL;
+	ECP *tab;
 	uint8_t ecpos, bigpos = 0;
 	ecpos = luaL_testudata(L, 1, "zenroom.ecp") ? 1 : 0;
 	if(!ecpos) ecpos = luaL_testudata(L, 2, "zenroom.ecp") ? 2 : 0;
@@ -571,7 +696,9 @@ static int ecp_mul(lua_State *L) {
 		failed_msg = "Could not create ECP";
 		goto end;
 	}
-	PAIR_G1mul(&out->val, b->val);
+	tab = _ecp_precomp_table(L, &out->val);
+	if(tab) _ecp_precomp_mul(&out->val, tab, b->val);
+	else PAIR_G1mul(&out->val, b->val);
 end:
 	ecp_free(L,e);
 	big_free(L,b);
@@ -581,6 +708,157 @@ end:
 	END(1);
 }
 
+int msm_window(int n) {
+	int w = 0;
+	if(n < MSM_STRAUS_MAX) return MSM_STRAUS_WINDOW;
+	while(n >>= 1) w++;
+	w--; // about log2(n) - 1 minimizes additions to buckets
+	return w > 16 ? 16 : w;
+}
+
+int scalar_windows(int w) {
+	BIG order;
+	BIG_rcopy(order, CURVE_Order);
+	// one more window to hold the last carry
+	return (BIG_nbits(order) / w) + 1;
+}
+
+void scalar_recode(short *digits, BIG b, int w, int windows) {
+	BIG order, s;
+	int j, k, bit = 0, v, carry = 0;
+	const int half = 1 << (w-1);
+	BIG_rcopy(order, CURVE_Order);
+	BIG_copy(s, b);
+	BIG_mod(s, order);
+	for(j = 0; j < windows; j++) {
+		v = carry;
+		for(k = 0; k < w; k++, bit++)
+			v += BIG_bit(s, bit) << k;
+		carry = v >= half;
+		digits[j] = carry ? v - (1 << w) : v;
+	}
+}
+
+char *msm_scalars(lua_State *L, int idx, int n, int w,
+                  short **digits, int *windows) {
+	big *b = NULL;
+	int i;
+	*windows = scalar_windows(w);
+	*digits = malloc(sizeof(short) * n * (*windows));
+	if(*digits == NULL)
+		return "Could not allocate scalar digits";
+	for(i = 0; i < n; i++) {
+		lua_rawgeti(L, idx, i+1);
+		b = big_arg(L, -1);
+		lua_pop(L, 1);
+		if(b == NULL || b->doublesize) {
+			big_free(L, b);
+			free(*digits);
+			*digits = NULL;
+			return b == NULL ? "Could not instantiate scalar" :
+				"cannot multiply ECP point with double BIG numbers, need modulo";
+		}
+		scalar_recode(&(*digits)[i * (*windows)], b->val, w, *windows);
+		big_free(L, b);
+	}
+	return NULL;
+}
+
+/***
+    Multi-scalar multiplication: sum of the products of a list of ECP
+    points by a list of @{BIG} numbers, computed all at once using
+    Straus for few points and Pippenger buckets for many.
+
+    @function ECP.msm(points, scalars)
+    @param points table of ECP points
+    @param scalars table of BIG numbers, same length as points
+    @return new ecp point resulting from the sum of all products
+*/
+static int ecp_msm(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	short *digits = NULL;
+	ECP *pts = NULL, *b;
+	ECP run, sum;
+	const ecp *e;
+	ecp *out = NULL;
+	int n, w, half, stride, windows, i, j, k, d;
+	if(!lua_istable(L, 1) || !lua_istable(L, 2)) {
+		failed_msg = "ECP multi-scalar multiplication needs two tables";
+		goto end;
+	}
+	n = lua_rawlen(L, 1);
+	if(n != (int)lua_rawlen(L, 2)) {
+		failed_msg = "ECP multi-scalar multiplication needs as many scalars as points";
+		goto end;
+	}
+	w = msm_window(n);
+	half = 1 << (w-1);
+	failed_msg = msm_scalars(L, 2, n, w, &digits, &windows);
+	if(failed_msg) goto end;
+	// Straus keeps a table of the multiples 1..half of each point
+	stride = n < MSM_STRAUS_MAX ? half : 1;
+	pts = malloc(sizeof(ECP) * (n * stride + half));
+	if(pts == NULL) {
+		failed_msg = "Could not allocate ECP points";
+		goto end;
+	}
+	for(i = 0; i < n; i++) {
+		lua_rawgeti(L, 1, i+1);
+		e = ecp_arg(L, -1);
+		lua_pop(L, 1);
+		if(e == NULL) {
+			failed_msg = "Could not instantiate ECP point";
+			goto end;
+		}
+		ECP_copy(&pts[i*stride], (ECP*)&e->val);
+		ecp_free(L, e);
+		for(k = 1; k < stride; k++) {
+			ECP_copy(&pts[i*stride+k], &pts[i*stride+k-1]);
+			ECP_add(&pts[i*stride+k], &pts[i*stride]);
+		}
+	}
+	out = ecp_new(L);
+	if(out == NULL) {
+		failed_msg = "Could not create ECP";
+		goto end;
+	}
+	ECP_inf(&out->val);
+	b = &pts[n * stride]; // buckets
+	for(j = windows - 1; j >= 0; j--) {
+		for(k = 0; k < w; k++) ECP_dbl(&out->val);
+		if(stride > 1) {
+			for(i = 0; i < n; i++) {
+				d = digits[i*windows + j];
+				if(d > 0) ECP_add(&out->val, &pts[i*stride + d-1]);
+				else if(d < 0) ECP_sub(&out->val, &pts[i*stride - d-1]);
+			}
+			continue;
+		}
+		for(k = 0; k < half; k++) ECP_inf(&b[k]);
+		for(i = 0; i < n; i++) {
+			d = digits[i*windows + j];
+			if(d > 0) ECP_add(&b[d-1], &pts[i]);
+			else if(d < 0) ECP_sub(&b[-d-1], &pts[i]);
+		}
+		// sum of k * b[k-1] as a running sum of buckets
+		ECP_inf(&run);
+		ECP_inf(&sum);
+		for(k = half - 1; k >= 0; k--) {
+			ECP_add(&run, &b[k]);
+			ECP_add(&sum, &run);
+		}
+		ECP_add(&out->val, &sum);
+	}
+end:
+	free(digits);
+	free(pts);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
 /***
     Compares two ECP objects and returns true if they indicate the same point on the curve (they are equal) or false otherwise. It can also be executed by using the `==` overloaded operator.
 
@@ -926,6 +1204,8 @@ int luaopen_ecp(lua_State *L) {
 		{"add", ecp_add},
 		{"sub", ecp_sub},
 		{"mul", ecp_mul},
+		{"msm", ecp_msm},
+		{"precompute", ecp_precompute},
 		{"validate", ecp_validate},
 		{"prime", ecp_prime},
 		{"rhs", ecp_rhs},
@@ -955,6 +1235,9 @@ int luaopen_ecp(lua_State *L) {
 		{NULL, NULL}
 	};
 	zen_add_class(L, "ecp", ecp_class, ecp_methods);
+	ECP G;
+	ECP_generator(&G);
+	_ecp_precomp_add(L, &G);
 	
 	act(L, "ECP curve is %s", ECP_CURVE_NAME);
 
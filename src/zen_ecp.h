@@ -21,6 +21,7 @@
 #ifndef __ZEN_ECP_H__
 #define __ZEN_ECP_H__
 
+#include <string.h>
 #include <zen_octet.h>
 #include <zen_ecp_factory.h>
 #include <hedley.h>
@@ -70,6 +71,42 @@ HEDLEY_NON_NULL(1)
 HEDLEY_WARN_UNUSED_RESULT
 const ecp2* ecp2_arg(lua_State *L,int n);
 
+// multi-scalar multiplication shared by ECP.msm and ECP2.msm: below
+// MSM_STRAUS_MAX points Straus with MSM_STRAUS_WINDOW bits windows,
+// Pippenger buckets otherwise
+#define MSM_STRAUS_MAX 64
+#define MSM_STRAUS_WINDOW 5
+int msm_window(int n);
+// recode the n scalars in the table at index idx in signed windows of
+// w bits, digits[i*windows + j] is window j of scalar i
+char *msm_scalars(lua_State *L, int idx, int n, int w,
+                  short **digits, int *windows);
+
+// number of signed windows of w bits in a scalar modulo the curve
+// order and recoding of a scalar in those, digits are in [-2^(w-1), 2^(w-1))
+int scalar_windows(int w);
+void scalar_recode(short *digits, BIG b, int w, int windows);
+
+// fixed-base precomputation for ECP.precompute and ECP2.precompute: a
+// registered base keeps a table of d * 2^(w*j) * P for each window j
+// and digit d, built at its first multiplication
+#define PRECOMP_WINDOW 5
+#define PRECOMP_MAX 16
+
+// constant time copy of len bytes from src to dst when flag is 1
+static inline void zen_cmove(void *dst, const void *src, size_t len, int flag) {
+	const size_t mask = (size_t)0 - (size_t)flag;
+	size_t i, w, v;
+	for(i = 0; i + sizeof(size_t) <= len; i += sizeof(size_t)) {
+		memcpy(&w, (char*)dst + i, sizeof(size_t));
+		memcpy(&v, (const char*)src + i, sizeof(size_t));
+		w ^= mask & (w ^ v);
+		memcpy((char*)dst + i, &w, sizeof(size_t));
+	}
+	for(; i < len; i++)
+		((char*)dst)[i] ^= (char)mask & (((char*)dst)[i] ^ ((const char*)src)[i]);
+}
+
 char gf_sign(BIG y);
 char gf2_sign(BIG y0, BIG y1);
 
@@ -275,6 +275,203 @@ end:
 	END(1);
 }
 
+/***
+    Multi-scalar multiplication: sum of the products of a list of ECP2
+    points by a list of @{BIG} numbers, computed all at once using
+    Straus for few points and Pippenger buckets for many.
+
+    @function ECP2.msm(points, scalars)
+    @param points table of ECP2 points
+    @param scalars table of BIG numbers, same length as points
+    @return new ecp2 point resulting from the sum of all products
+*/
+static int ecp2_msm(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	short *digits = NULL;
+	ECP2 *pts = NULL, *b;
+	ECP2 run, sum;
+	const ecp2 *e;
+	ecp2 *out = NULL;
+	int n, w, half, stride, windows, i, j, k, d;
+	if(!lua_istable(L, 1) || !lua_istable(L, 2)) {
+		failed_msg = "ECP2 multi-scalar multiplication needs two tables";
+		goto end;
+	}
+	n = lua_rawlen(L, 1);
+	if(n != (int)lua_rawlen(L, 2)) {
+		failed_msg = "ECP2 multi-scalar multiplication needs as many scalars as points";
+		goto end;
+	}
+	w = msm_window(n);
+	half = 1 << (w-1);
+	failed_msg = msm_scalars(L, 2, n, w, &digits, &windows);
+	if(failed_msg) goto end;
+	// Straus keeps a table of the multiples 1..half of each point
+	stride = n < MSM_STRAUS_MAX ? half : 1;
+	pts = malloc(sizeof(ECP2) * (n * stride + half));
+	if(pts == NULL) {
+		failed_msg = "Could not allocate ECP2 points";
+		goto end;
+	}
+	for(i = 0; i < n; i++) {
+		lua_rawgeti(L, 1, i+1);
+		e = ecp2_arg(L, -1);
+		lua_pop(L, 1);
+		if(e == NULL) {
+			failed_msg = "Could not instantiate ECP2 point";
+			goto end;
+		}
+		ECP2_copy(&pts[i*stride], (ECP2*)&e->val);
+		ecp2_free(L, e);
+		for(k = 1; k < stride; k++) {
+			ECP2_copy(&pts[i*stride+k], &pts[i*stride+k-1]);
+			ECP2_add(&pts[i*stride+k], &pts[i*stride]);
+		}
+	}
+	out = ecp2_new(L);
+	if(out == NULL) {
+		failed_msg = "Could not create ECP2";
+		goto end;
+	}
+	ECP2_inf(&out->val);
+	b = &pts[n * stride]; // buckets
+	for(j = windows - 1; j >= 0; j--) {
+		for(k = 0; k < w; k++) ECP2_dbl(&out->val);
+		if(stride > 1) {
+			for(i = 0; i < n; i++) {
+				d = digits[i*windows + j];
+				if(d > 0) ECP2_add(&out->val, &pts[i*stride + d-1]);
+				else if(d < 0) ECP2_sub(&out->val, &pts[i*stride - d-1]);
+			}
+			continue;
+		}
+		for(k = 0; k < half; k++) ECP2_inf(&b[k]);
+		for(i = 0; i < n; i++) {
+			d = digits[i*windows + j];
+			if(d > 0) ECP2_add(&b[d-1], &pts[i]);
+			else if(d < 0) ECP2_sub(&b[-d-1], &pts[i]);
+		}
+		// sum of k * b[k-1] as a running sum of buckets
+		ECP2_inf(&run);
+		ECP2_inf(&sum);
+		for(k = half - 1; k >= 0; k--) {
+			ECP2_add(&run, &b[k]);
+			ECP2_add(&sum, &run);
+		}
+		ECP2_add(&out->val, &sum);
+	}
+end:
+	free(digits);
+	free(pts);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
+// get the {ECP2, ECP} pair at position i of the table at index 1
+static char *_pair_arg(lua_State *L, int i, const ecp2 **q, const ecp **p) {
+	if(lua_rawgeti(L, 1, i) != LUA_TTABLE) {
+		lua_pop(L, 1);
+		return "Pairing product element is not a pair";
+	}
+	lua_rawgeti(L, -1, 1);
+	lua_rawgeti(L, -2, 2);
+	*q = ecp2_arg(L, -2);
+	*p = ecp_arg(L, -1);
+	lua_pop(L, 3);
+	if(*q == NULL || *p == NULL)
+		return "Pairing product element is not an {ECP2, ECP} pair";
+	return NULL;
+}
+
+// multiply the Miller loops of all {ECP2, ECP} pairs in the table at
+// index 1, two at a time sharing their squarings, then apply a single
+// final exponentiation to the product
+static char *_pairing_product(lua_State *L, FP12 *res) {
+	char *failed_msg = NULL;
+	const ecp2 *q1 = NULL, *q2 = NULL;
+	const ecp *p1 = NULL, *p2 = NULL;
+	FP12 t;
+	int i, n;
+	if(!lua_istable(L, 1))
+		return "Pairing product argument is not a table of pairs";
+	n = lua_rawlen(L, 1);
+	if(n < 1)
+		return "Pairing product called on an empty table";
+	for(i = 1; i <= n; i += 2) {
+		failed_msg = _pair_arg(L, i, &q1, &p1);
+		if(failed_msg) goto end;
+		if(i < n) {
+			failed_msg = _pair_arg(L, i+1, &q2, &p2);
+			if(failed_msg) goto end;
+			PAIR_double_ate(&t, (ECP2*)&q1->val, (ECP*)&p1->val,
+							(ECP2*)&q2->val, (ECP*)&p2->val);
+		} else {
+			PAIR_ate(&t, (ECP2*)&q1->val, (ECP*)&p1->val);
+		}
+		if(i == 1) FP12_copy(res, &t);
+		else FP12_mul(res, &t);
+		ecp_free(L, p1); p1 = NULL;
+		ecp2_free(L, q1); q1 = NULL;
+		ecp_free(L, p2); p2 = NULL;
+		ecp2_free(L, q2); q2 = NULL;
+	}
+	PAIR_fexp(res);
+end:
+	ecp_free(L, p1);
+	ecp2_free(L, q1);
+	ecp_free(L, p2);
+	ecp2_free(L, q2);
+	return failed_msg;
+}
+
+/***
+    Compute the product of the pairings of a list of points, running
+    their Miller loops together and a single final exponentiation.
+
+    @function ECP2.pairing_product(pairs)
+    @param pairs table of { ECP2, ECP } pairs
+    @return FP12 product of all pairings
+*/
+static int ecp2_pairing_product(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	fp12 *f = fp12_new(L);
+	if(f == NULL) {
+		failed_msg = "Could not create FP12";
+		goto end;
+	}
+	failed_msg = _pairing_product(L, &f->val);
+end:
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
+/***
+    Check that the product of the pairings of a list of points is the
+    identity, so that e(Q1,P1) == e(Q2,P2) can be verified in one go as
+    ECP2.pairing_check({ {Q1, P1}, {Q2, P2:negative()} })
+
+    @function ECP2.pairing_check(pairs)
+    @param pairs table of { ECP2, ECP } pairs
+    @return true if the product of all pairings is one, false otherwise
+*/
+static int ecp2_pairing_check(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	FP12 res;
+	failed_msg = _pairing_product(L, &res);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	lua_pushboolean(L, FP12_isunity(&res));
+	END(1);
+}
+
 /// Class methods
 // @type ecp2
 
@@ -501,10 +698,135 @@ end:
 	END(1);
 }
 
+// find the table of a registered fixed base, building it at its first
+// use, returns NULL when P is not registered
+static ECP2 *_ecp2_precomp_table(lua_State *L, ECP2 *P) {
+	ECP2 *tab = NULL, *base, B;
+	int i, j, k, n;
+	const int w = PRECOMP_WINDOW, half = 1 << (w-1);
+	const int windows = scalar_windows(w);
+	if(lua_getfield(L, LUA_REGISTRYINDEX, "zenroom.ecp2_precomp") != LUA_TTABLE) {
+		lua_pop(L, 1);
+		return NULL;
+	}
+	n = lua_rawlen(L, -1);
+	for(i = 1; i <= n && tab == NULL; i++) {
+		lua_rawgeti(L, -1, i);
+		base = (ECP2*)lua_touserdata(L, -1);
+		if(ECP2_equals(base, P)) {
+			if(lua_getiuservalue(L, -1, 1) == LUA_TUSERDATA) {
+				tab = (ECP2*)lua_touserdata(L, -1);
+				lua_pop(L, 1);
+			} else {
+				lua_pop(L, 1);
+				tab = (ECP2*)lua_newuserdatauv(L, sizeof(ECP2) * windows * half, 0);
+				ECP2_copy(&B, base);
+				for(j = 0; j < windows; j++) {
+					ECP2_copy(&tab[j*half], &B);
+					for(k = 1; k < half; k++) {
+						ECP2_copy(&tab[j*half+k], &tab[j*half+k-1]);
+						ECP2_add(&tab[j*half+k], &B);
+					}
+					for(k = 0; k < w; k++) ECP2_dbl(&B);
+				}
+				lua_setiuservalue(L, -2, 1);
+			}
+		}
+		lua_pop(L, 1);
+	}
+	lua_pop(L, 1);
+	return tab;
+}
+
+// one addition per window, selecting table entries in constant time
+static void _ecp2_precomp_mul(ECP2 *res, ECP2 *tab, BIG b) {
+	short digits[MODBYTES*8/PRECOMP_WINDOW + 2];
+	ECP2 T, N;
+	int j, k, d, m, a;
+	const int w = PRECOMP_WINDOW, half = 1 << (w-1);
+	const int windows = scalar_windows(w);
+	scalar_recode(digits, b, w, windows);
+	ECP2_inf(res);
+	for(j = 0; j < windows; j++) {
+		d = digits[j];
+		m = -(d < 0);
+		a = (d ^ m) - m;
+		ECP2_inf(&T);
+		for(k = 0; k < half; k++)
+			zen_cmove(&T, &tab[j*half+k], sizeof(ECP2), k+1 == a);
+		ECP2_copy(&N, &T);
+		ECP2_neg(&N);
+		zen_cmove(&T, &N, sizeof(ECP2), d < 0);
+		ECP2_add(res, &T);
+	}
+}
+
+// register P as a fixed base, returns 0 when there is no more room
+static int _ecp2_precomp_add(lua_State *L, ECP2 *P) {
+	ECP2 *base;
+	int i, n, found = 0;
+	if(lua_getfield(L, LUA_REGISTRYINDEX, "zenroom.ecp2_precomp") != LUA_TTABLE) {
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushvalue(L, -1);
+		lua_setfield(L, LUA_REGISTRYINDEX, "zenroom.ecp2_precomp");
+	}
+	n = lua_rawlen(L, -1);
+	for(i = 1; i <= n && !found; i++) {
+		lua_rawgeti(L, -1, i);
+		found = ECP2_equals((ECP2*)lua_touserdata(L, -1), P);
+		lua_pop(L, 1);
+	}
+	if(!found && n < PRECOMP_MAX) {
+		base = (ECP2*)lua_newuserdatauv(L, sizeof(ECP2), 1);
+		ECP2_copy(base, P);
+		lua_rawseti(L, -2, n+1);
+	}
+	lua_pop(L, 1);
+	return found || n < PRECOMP_MAX;
+}
+
+/***
+    Register an ECP2 point as a fixed base: its multiplications will
+    use a table of precomputed multiples, built at the first one. The
+    generator is always registered. The point must be in the subgroup
+    of prime order, because the table works with scalars modulo it.
+
+    @function ECP2.precompute(ecp2)
+    @param ecp2 point on the twisted curve used as base
+    @return true if registered, false if there are too many bases
+*/
+static int ecp2_precompute(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	BIG order;
+	ECP2 T;
+	const ecp2 *e = ecp2_arg(L, 1);
+	if(!e) {
+		failed_msg = "Could not instantiate input";
+		goto end;
+	}
+	BIG_rcopy(order, CURVE_Order);
+	ECP2_copy(&T, (ECP2*)&e->val);
+	ECP2_mul(&T, order);
+	if(!ECP2_isinf(&T)) {
+		failed_msg = "Cannot precompute a point out of the prime order subgroup";
+		goto end;
+	}
+	lua_pushboolean(L, _ecp2_precomp_add(L, (ECP2*)&e->val));
+end:
+	ecp2_free(L, e);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
 static int ecp2_mul(lua_State *L) {
 	BEGIN();
 	char *failed_msg = NULL;
 	big *b = NULL;
+	ECP2 *tab;
 	const ecp2 *p = ecp2_arg(L, 1);
 	if(p == NULL) {
 		failed_msg = "Could not allocate ECP2 point";
@@ -520,7 +842,9 @@ static int ecp2_mul(lua_State *L) {
 		failed_msg = "Could not duplicate ECP2 point";
 		goto end;
 	}
-	PAIR_G2mul(&r->val, b->val);
+	tab = _ecp2_precomp_table(L, &r->val);
+	if(tab) _ecp2_precomp_mul(&r->val, tab, b->val);
+	else PAIR_G2mul(&r->val, b->val);
 end:
 	big_free(L, b);
 	ecp2_free(L, p);
@@ -935,6 +1259,10 @@ int luaopen_ecp2(lua_State *L) {
 		{"loop", ecp2_millerloop},
 		{"miller", ecp2_millerloop},
 		{"ate", ecp2_millerloop},
+		{"msm", ecp2_msm},
+		{"precompute", ecp2_precompute},
+		{"pairing_product", ecp2_pairing_product},
+		{"pairing_check", ecp2_pairing_check},
 		{NULL, NULL}};
 	const struct luaL_Reg ecp2_methods[] = {
 		{"affine", ecp2_affine},
@@ -962,5 +1290,8 @@ int luaopen_ecp2(lua_State *L) {
 		{NULL, NULL}
 	};
 	zen_add_class(L, "ecp2", ecp2_class, ecp2_methods);
+	ECP2 G;
+	ECP2_generator(&G);
+	_ecp2_precomp_add(L, &G);
 	return 1;
 }
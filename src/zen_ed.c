@@ -155,6 +155,84 @@ end:
 	END(1);
 }
 
+/*
+  Verify a batch of signatures, given three tables of public keys,
+  signatures and messages of the same length. Returns true when all
+  signatures are valid, false otherwise and a table with the indexes
+  of the invalid ones. Groups of up to 64 signatures are checked at
+  once with random linear combinations, falling back to single
+  verifications on the groups that fail.
+*/
+static int ed_verify_batch(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	const octet **o = NULL; // n public keys, n signatures, n messages
+	const unsigned char **ptr = NULL;
+	size_t *mlen = NULL;
+	int *valid = NULL;
+	int i, j, n = 0;
+	if(!lua_istable(L, 1) || !lua_istable(L, 2) || !lua_istable(L, 3)) {
+		failed_msg = "EdDSA batch verification needs three tables";
+		goto end;
+	}
+	n = lua_rawlen(L, 1);
+	if(n != (int)lua_rawlen(L, 2) || n != (int)lua_rawlen(L, 3)) {
+		failed_msg = "EdDSA batch verification tables differ in length";
+		goto end;
+	}
+	o = calloc(3 * n + 1, sizeof(octet*));
+	ptr = malloc(sizeof(unsigned char*) * (3 * n + 1));
+	mlen = malloc(sizeof(size_t) * (n + 1));
+	valid = malloc(sizeof(int) * (n + 1));
+	if(!o || !ptr || !mlen || !valid) {
+		failed_msg = "Could not allocate EdDSA batch";
+		goto end;
+	}
+	for(j = 0; j < 3; j++) {
+		for(i = 0; i < n; i++) {
+			lua_rawgeti(L, j+1, i+1);
+			o[j*n+i] = o_arg(L, -1);
+			lua_pop(L, 1);
+			if(!o[j*n+i]) {
+				failed_msg = "Could not allocate EdDSA batch argument";
+				goto end;
+			}
+			ptr[j*n+i] = (const unsigned char*)o[j*n+i]->val;
+		}
+	}
+	for(i = 0; i < n; i++) {
+		if(o[i]->len != sizeof(ed25519_public_key)) {
+			failed_msg = "Invalid size for EdDSA public key";
+			goto end;
+		}
+		if(o[n+i]->len != sizeof(ed25519_signature)) {
+			failed_msg = "Invalid size for EdDSA signature";
+			goto end;
+		}
+		mlen[i] = o[2*n+i]->len;
+	}
+	lua_pushboolean(L, ed25519_sign_open_batch(&ptr[2*n], mlen, &ptr[0],
+	                                           &ptr[n], n, valid) == 0);
+	lua_newtable(L);
+	for(i = 0, j = 1; i < n; i++) {
+		if(valid[i]) continue;
+		lua_pushinteger(L, i+1);
+		lua_rawseti(L, -2, j++);
+	}
+end:
+	if(o) {
+		for(i = 0; i < 3 * n; i++) o_free(L, o[i]);
+	}
+	free(o);
+	free(ptr);
+	free(mlen);
+	free(valid);
+	if(failed_msg != NULL) {
+		THROW(failed_msg);
+	}
+	END(2);
+}
+
 int luaopen_ed(lua_State *L) {
 	(void)L;
 	const struct luaL_Reg ed_class[] = {
@@ -163,6 +241,7 @@ int luaopen_ed(lua_State *L) {
 		{"pubgen", ed_pubgen},
 		{"sign", ed_sign},
 		{"verify", ed_verify},
+		{"verify_batch", ed_verify_batch},
 		{NULL,NULL}
 	};
 	const struct luaL_Reg ed_methods[] = {
@@ -57,9 +57,8 @@ static inline void _zen_error_write(int fd, const void *buf, size_t count) {
 extern int zen_log(lua_State *L, log_priority prio, octet *oct);
 extern int printerr(lua_State *L, octet *in);
 
-#define Z_FORMAT_ARG(l) zenroom_t *Z=NULL; (void)Z; if (l) { void *_zv; lua_getallocf(l, &_zv); Z = _zv; } else { _err(format, arg); return(0); }
-
-#define MAX_ERRMSG 256 // maximum length of an error message line
+// everything passes the logging macros until a VM is entered
+ZEN_THREAD int zen_log_level = 4;
 
 #define LOG_DEFAULT " .   "
 // aligned to log_priority in error.h header
@@ -121,14 +120,10 @@ void _out(const char *fmt, ...) {
 #endif
 }
 
-// error message free from context
-void _err(const char *fmt, ...) {
+static void _verr(const char *fmt, va_list args) {
   char msg[MAX_ERRMSG+4];
   int len;
-  va_list args;
-  va_start(args, fmt);
   len = mutt_vsnprintf(msg, MAX_ERRMSG, fmt, args);
-  va_end(args);
   msg[len] = '\n';
   msg[len+1] = 0x0;
 #if defined(__EMSCRIPTEN__)
@@ -142,6 +137,14 @@ void _err(const char *fmt, ...) {
 #endif
 }
 
+// error message free from context
+void _err(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  _verr(fmt, args);
+  va_end(args);
+}
+
 // context free results
 #if defined(__EMSCRIPTEN__)
 int OK() {
@@ -178,81 +181,66 @@ void json_end(void *L) {
   free(o.val);
 }
 
-int notice(void *L, const char *format, ...) {
+// formats in the next line of the VM log ring, so that a message
+// logged while another is printed does not overwrite it
+static void _log(void *L, int level, log_priority prio,
+                 const char *format, va_list arg) {
+  if(!L) { _verr(format, arg); return; }
+  Z(L);
+  if(Z->debuglevel<level) return;
+  octet o;
+  o.val = Z->logring[Z->logpos++ % LOG_RING];
+  o.max = MAX_ERRMSG;
+  mutt_vsnprintf(o.val, MAX_ERRMSG, format, arg);
+  o.len = strlen(o.val);
+  zen_log(L, prio, &o);
+}
+
+int log_notice(void *L, const char *format, ...) {
   va_list arg;
   va_start(arg, format);
-  Z_FORMAT_ARG(L);
-  if(Z && Z->debuglevel<1) return 0;
-  octet *o = o_alloc(L, MAX_ERRMSG);
-  mutt_vsnprintf(o->val, o->max-5, format, arg);
-  o->len = strlen(o->val);
-  zen_log(L, LOG_INFO, o);
-  o_free((lua_State*)L,o);
+  _log(L, 1, LOG_INFO, format, arg);
+  va_end(arg);
   return 0;
 }
 
-int func(void *L, const char *format, ...) {
+int log_func(void *L, const char *format, ...) {
   va_list arg;
   va_start(arg, format);
-  Z_FORMAT_ARG(L);
-  if(Z && Z->debuglevel<3) return 0;
-  octet *o = o_alloc(L, MAX_ERRMSG);
-  mutt_vsnprintf(o->val, o->max-5, format, arg);
-  o->len = strlen(o->val);
-  zen_log(L, LOG_VERBOSE, o);
-  o_free((lua_State*)L,o);
+  _log(L, 3, LOG_VERBOSE, format, arg);
+  va_end(arg);
   return 0;
 }
 
-int trace(void *L, const char *format, ...) {
+int log_trace(void *L, const char *format, ...) {
   va_list arg;
   va_start(arg, format);
-  Z_FORMAT_ARG(L);
-  if(Z && Z->debuglevel<4) return 0;
-  octet *o = o_alloc(L, MAX_ERRMSG);
-  mutt_vsnprintf(o->val, o->max-5, format, arg);
-  o->len = strlen(o->val);
-  zen_log(L, LOG_VERBOSE, o);
-  o_free((lua_State*)L,o);
+  _log(L, 4, LOG_VERBOSE, format, arg);
+  va_end(arg);
   return 0;
 }
 
 int zerror(void *L, const char *format, ...) {
   va_list arg;
   va_start(arg, format);
-  Z_FORMAT_ARG(L);
-  octet *o = o_alloc(L, MAX_ERRMSG);
-  mutt_vsnprintf(o->val, o->max-5, format, arg);
-  o->len = strlen(o->val);
-  zen_log(L, LOG_ERROR, o);
-  o_free((lua_State*)L,o);
+  _log(L, 0, LOG_ERROR, format, arg);
+  va_end(arg);
   return 0;
 }
 
-int act(void *L, const char *format, ...) {
+int log_act(void *L, const char *format, ...) {
   va_list arg;
   va_start(arg, format);
-  Z_FORMAT_ARG(L);
-  if(Z && Z->debuglevel<2) return 0;
-  octet *o = o_alloc(L, MAX_ERRMSG);
-  // new octet is pushed to stack
-  mutt_vsnprintf(o->val, o->max-5, format, arg);
-  o->len = strlen(o->val);
-  zen_log(L, LOG_DEBUG, o);
-  o_free((lua_State*)L,o);
+  _log(L, 2, LOG_DEBUG, format, arg);
+  va_end(arg);
   return 0;
 }
 
-int warning(void *L, const char *format, ...) {
+int log_warning(void *L, const char *format, ...) {
   va_list arg;
   va_start(arg, format);
-  Z_FORMAT_ARG(L);
-  if(Z && Z->debuglevel<1) return 0;
-  octet *o = o_alloc(L, MAX_ERRMSG);
-  mutt_vsnprintf(o->val, o->max-5, format, arg);
-  o->len = strlen(o->val);
-  zen_log(L, LOG_WARN, o);
-  o_free((lua_State*)L,o);
+  _log(L, 1, LOG_WARN, format, arg);
+  va_end(arg);
   return 0;
 }
 
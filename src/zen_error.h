@@ -69,18 +69,35 @@ HEDLEY_PRINTF_FORMAT(2,3)
 HEDLEY_NO_RETURN
 void lerror(void *L, const char *fmt, ...);
 
+// debug level of the VM last entered on this thread, checked by the
+// logging macros below before evaluating any of their arguments
+#if defined(ARCH_CORTEX) || defined(__EMSCRIPTEN__)
+#define ZEN_THREAD
+#else
+#define ZEN_THREAD __thread
+#endif
+extern ZEN_THREAD int zen_log_level;
+
 HEDLEY_PRINTF_FORMAT(2,3)
-int notice(void *L, const char *format, ...); // INFO
+int log_notice(void *L, const char *format, ...); // INFO
 HEDLEY_PRINTF_FORMAT(2,3)
-int func(void *L, const char *format, ...); // VERBOSE
+int log_func(void *L, const char *format, ...); // VERBOSE
 HEDLEY_PRINTF_FORMAT(2,3)
-int trace(void *L, const char *format, ...); // TRACE (VERY VERBOSE)
+int log_trace(void *L, const char *format, ...); // TRACE (VERY VERBOSE)
 HEDLEY_PRINTF_FORMAT(2,3)
 int zerror(void *L, const char *format, ...); // ERROR
 HEDLEY_PRINTF_FORMAT(2,3)
-int act(void *L, const char *format, ...); // DEBUG
+int log_act(void *L, const char *format, ...); // DEBUG
 HEDLEY_PRINTF_FORMAT(2,3)
-int warning(void *L, const char *format, ...); // WARN
+int log_warning(void *L, const char *format, ...); // WARN
+
+#define ZEN_LOG(L, lvl, fn, ...) \
+	(zen_log_level < (lvl) ? 0 : fn((L), __VA_ARGS__))
+#define notice(L, ...)  ZEN_LOG(L, 1, log_notice, __VA_ARGS__)
+#define func(L, ...)    ZEN_LOG(L, 3, log_func, __VA_ARGS__)
+#define trace(L, ...)   ZEN_LOG(L, 4, log_trace, __VA_ARGS__)
+#define act(L, ...)     ZEN_LOG(L, 2, log_act, __VA_ARGS__)
+#define warning(L, ...) ZEN_LOG(L, 1, log_warning, __VA_ARGS__)
 int hexdump(void *L, const char *src, size_t len); // DEBUG hex sequence
 
 void json_start(void *L);
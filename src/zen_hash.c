@@ -204,15 +204,14 @@ static int lua_new_hash(lua_State *L) {
 
 // internal use to feed bytes into the hash structure
 static void _feed(const hash *h, const octet *o) {
-	register int i;
 	switch(h->algo) {
-	case _SHA256: for(i=0;i<o->len;i++) HASH256_process(h->sha256,o->val[i]); break;
-	case _SHA384: for(i=0;i<o->len;i++) HASH384_process(h->sha384,o->val[i]); break;
-	case _SHA512: for(i=0;i<o->len;i++) HASH512_process(h->sha512,o->val[i]); break;
-	case _SHA3_256: for(i=0;i<o->len;i++) SHA3_process(h->sha3_256,o->val[i]); break;
-	case _SHA3_512: for(i=0;i<o->len;i++) SHA3_process(h->sha3_512,o->val[i]); break;
-	case _SHAKE256: for(i=0;i<o->len;i++) SHA3_process(h->shake256,o->val[i]); break;
-	case _KECCAK256: for(i=0;i<o->len;i++) SHA3_process(h->keccak256,o->val[i]); break;
+	case _SHA256: HASH256_process_array(h->sha256,o->val,o->len); break;
+	case _SHA384: HASH384_process_array(h->sha384,o->val,o->len); break;
+	case _SHA512: HASH512_process_array(h->sha512,o->val,o->len); break;
+	case _SHA3_256: SHA3_process_array(h->sha3_256,o->val,o->len); break;
+	case _SHA3_512: SHA3_process_array(h->sha3_512,o->val,o->len); break;
+	case _SHAKE256: SHA3_process_array(h->shake256,o->val,o->len); break;
+	case _KECCAK256: SHA3_process_array(h->keccak256,o->val,o->len); break;
 	case _RMD160: RMD160_process(h->rmd160, (unsigned char*)o->val, o->len); break;
 	}
 }
@@ -60,7 +60,7 @@ static int zen_print (lua_State *L) {
   BEGIN();
   Z(L);
   char *failed_msg = NULL;
-  const octet *o = o_arg(L, 1);
+  octet *o = o_writable(L, o_arg(L, 1));
   if(o == NULL) {
 	  failed_msg = "Could not allocate message to show";
 	  goto end;
@@ -68,8 +68,11 @@ static int zen_print (lua_State *L) {
   if (Z->stdout_buf) {
 	char *p = Z->stdout_buf+Z->stdout_pos;
 	if(!o) { *p='\n'; Z->stdout_pos++; return 0; }
-	if (Z->stdout_pos+o->len+1 > Z->stdout_len)
-	  zerror(L, "No space left in output buffer");
+	if (Z->stdout_pos+o->len+2 > Z->stdout_len) {
+	  Z->stdout_full = 1;
+	  failed_msg = "No space left in output buffer";
+	  goto end;
+	}
 	memcpy(p, o->val, o->len);
 	*(p + o->len) = '\n';
 	*(p + o->len+1) = '\0';
@@ -101,10 +104,13 @@ int printerr(lua_State *L, const octet *o) {
   if (Z->stderr_buf) {
 	char *p = Z->stderr_buf+Z->stderr_pos;
 	if(!o) { *p='\n'; Z->stderr_pos++; return 0; }
-	if (Z->stderr_pos+o->len+1 > Z->stderr_len)
-	  zerror(L, "No space left in output buffer");
+	if (Z->stderr_pos+o->len+2 > Z->stderr_len) {
+	  Z->stderr_full = 1;
+	  return 1;
+	}
 	memcpy(p, o->val, o->len);
 	*(p + o->len) = '\n';
+	*(p + o->len+1) = '\0';
 	Z->stderr_pos += o->len + 1;
   } else if(o) {
 	  char *t = calloc(o->len +8, sizeof(char));
@@ -139,9 +145,13 @@ static int zen_write (lua_State *L) {
   }
   if (Z->stdout_buf) {
 	char *p = Z->stdout_buf+Z->stdout_pos;
-	if (Z->stdout_pos+o->len > Z->stdout_len)
-	  zerror(L, "No space left in output buffer");
+	if (Z->stdout_pos+o->len+1 > Z->stdout_len) {
+	  Z->stdout_full = 1;
+	  failed_msg = "No space left in output buffer";
+	  goto end;
+	}
 	memcpy(p, o->val, o->len);
+	*(p + o->len) = '\0';
 	Z->stdout_pos += o->len;
   } else if(o) {
 #ifdef __EMSCRIPTEN_
@@ -172,9 +182,10 @@ int zen_log(lua_State *L, log_priority prio, const octet *o) {
   free(t);
   return 0;
 #endif
+  // prefix, json termination, newline and string termination
   if (Z->stderr_buf
-	  && Z->stderr_pos+o->len+5 > Z->stderr_len) {
-	  zerror(L, "No space left in error buffer");
+	  && Z->stderr_pos+o->len+9 > Z->stderr_len) {
+	  Z->stderr_full = 1; // logging here again would recurse
 	  return 1;
   }
   char *p = o->val + o->len;
@@ -209,7 +220,7 @@ int zen_log(lua_State *L, log_priority prio, const octet *o) {
 #define ZEN_PRINT(FUN_NAME, PRINT_FUN) \
 	static int (FUN_NAME)(lua_State *L) { \
 		BEGIN(); \
-		const octet *o = o_arg(L, 1); \
+		const octet *o = o_writable(L, o_arg(L, 1)); \
 		if(o != NULL) { \
 			PRINT_FUN; \
 			o_free(L,o); \
@@ -19,16 +19,131 @@
  */
 
 #include <errno.h>
-// #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <zenroom.h>
 #include <zen_error.h>
 
 #include <zen_memory.h>
 
+#include <lua.h>
+#include <lauxlib.h>
+#include <lstate.h>
+#include <lgc.h>
+
+// size class of a small block, its size is (class + 1) * ZMM_ALIGN
+#define ZMM_CLASS(size) (((size) - 1) / ZMM_ALIGN)
+
+zen_mem_t *zen_mem_new(int libc) {
+	zen_mem_t *mem = (zen_mem_t*)calloc(1, sizeof(zen_mem_t));
+	if(mem) mem->libc = libc;
+	return mem;
+}
+
+// slabs are given back to libc all together, blocks still in use
+// by the Lua state at this point are lost: call after lua_close()
+void zen_mem_free(zen_mem_t *mem) {
+	if(!mem) return;
+	void *slab = mem->slabs;
+	while(slab) {
+		void *next = *(void**)slab;
+		free(slab);
+		slab = next;
+	}
+	free(mem);
+}
+
+static inline void _slab_release(zen_mem_t *mem, void *ptr, size_t c) {
+	*(void**)ptr = mem->freelist[c];
+	mem->freelist[c] = ptr;
+}
+
+static void *_slab_alloc(zen_mem_t *mem, size_t c) {
+	void *blk = mem->freelist[c];
+	if(blk) {
+		mem->freelist[c] = *(void**)blk;
+		return blk;
+	}
+	size_t size = (c + 1) * ZMM_ALIGN;
+	if((size_t)(mem->bump_end - mem->bump) < size) {
+		// the tail left in the current slab goes to its own class
+		size_t tail = mem->bump_end - mem->bump;
+		if(tail) _slab_release(mem, mem->bump, ZMM_CLASS(tail));
+		// new slab: the first ZMM_ALIGN bytes link it to the list
+		void **slab = (void**)malloc(ZMM_SLAB);
+		if(!slab) return NULL;
+		mem->libc_calls++;
+		mem->slab_count++;
+		*slab = mem->slabs;
+		mem->slabs = slab;
+		mem->bump = (char*)slab + ZMM_ALIGN;
+		mem->bump_end = (char*)slab + ZMM_SLAB;
+	}
+	blk = mem->bump;
+	mem->bump += size;
+	return blk;
+}
+
+static inline void *_alloc(zen_mem_t *mem, size_t size) {
+	if(size <= ZMM_SMALL) return _slab_alloc(mem, ZMM_CLASS(size));
+	mem->libc_calls++;
+	return malloc(size);
+}
+
+static inline void _release(zen_mem_t *mem, void *ptr, size_t size) {
+	if(size <= ZMM_SMALL) _slab_release(mem, ptr, ZMM_CLASS(size));
+	else free(ptr);
+}
+
+// reallocation of a block, moved across slab classes and libc
+static void *_slab_realloc(zen_mem_t *mem, void *ptr, size_t osize, size_t nsize) {
+	if(osize > ZMM_SMALL && nsize > ZMM_SMALL) {
+		mem->libc_calls++;
+		return realloc(ptr, nsize);
+	}
+	if(osize <= ZMM_SMALL && nsize <= ZMM_SMALL
+	   && ZMM_CLASS(osize) == ZMM_CLASS(nsize)) return ptr;
+	void *ret = _alloc(mem, nsize);
+	if(!ret && osize <= ZMM_SMALL) {
+		// Lua expects shrinking never to fail: keep the slab block,
+		// that is large enough and goes to the class of nsize once
+		// released
+		return nsize < osize ? ptr : NULL;
+	}
+	if(!ret) {
+		// a libc block shrinking to a small size becomes a slab of
+		// its own: linked in front to be freed by zen_mem_free, the
+		// block of nsize follows and is released to its class
+		size_t need = (ZMM_CLASS(nsize) + 2) * ZMM_ALIGN;
+		void **slab = osize >= need ? (void**)ptr : (void**)realloc(ptr, need);
+		if(!slab) return NULL;
+		if(slab != ptr) mem->libc_calls++;
+		memmove((char*)slab + ZMM_ALIGN, slab, nsize);
+		*slab = mem->slabs;
+		mem->slabs = slab;
+		mem->slab_count++;
+		return (char*)slab + ZMM_ALIGN;
+	}
+	memcpy(ret, ptr, osize < nsize ? osize : nsize);
+	_release(mem, ptr, osize);
+	return ret;
+}
+
+static inline void _account(zen_mem_t *mem, size_t osize, size_t nsize) {
+	mem->used += nsize;
+	mem->used -= osize;
+	if(mem->used > mem->peak) mem->peak = mem->used;
+}
+
 /**
  * Implementation of the memory allocator for the Lua state.
  *
  * See: http://www.lua.org/manual/5.3/manual.html#lua_Alloc
  *
+ * The user data pointer is the zenroom context: unless configured
+ * with memmanager=libc, small blocks are served from the slabs of its
+ * memory manager and all sizes are accounted in it.
+ *
  * @param ud User Data Pointer
  * @param ptr Pointer to the memory block being allocated/reallocated/freed.
  * @param osize The original size of the memory block.
@@ -37,12 +152,9 @@
  * @return void* A pointer to the memory block.
  */
 void *zen_memory_manager(void *ud, void *ptr, size_t osize, size_t nsize) {
-	// zenroom_t *ZZ = (zenroom_t*)ud;
-	// if(!ZZ) {
-	// 	zerror(NULL, "Memory manager missing ZEN context");
-	// 	return NULL;
-	// }
-  (void)ud;
+	zenroom_t *ZZ = (zenroom_t*)ud;
+	zen_mem_t *mem = ZZ ? (zen_mem_t*)ZZ->memory : NULL;
+	void *ret;
 	if(ptr == NULL) {
 		// When ptr is NULL, osize encodes the kind of object that Lua
 		// is allocating. osize is any of LUA_TSTRING, LUA_TTABLE,
@@ -50,12 +162,20 @@ void *zen_memory_manager(void *ud, void *ptr, size_t osize, size_t nsize) {
 		// when) Lua is creating a new object of that type. When osize
 		// is some other value, Lua is allocating memory for something
 		// else.
-		if(nsize!=0) {
-			void *ret = malloc(nsize);
-			if(ret) return ret;
+		if(nsize==0) return NULL;
+		if(!mem) ret = malloc(nsize);
+		else if(mem->libc) {
+			mem->libc_calls++;
+			ret = malloc(nsize);
+		} else ret = _alloc(mem, nsize);
+		if(!ret) {
 			zerror(NULL, "Malloc out of memory, requested %lu B", nsize);
-			return NULL;
-		} else return NULL;
+			return NULL; }
+		if(mem) {
+			mem->allocs++;
+			_account(mem, 0, nsize);
+		}
+		return ret;
 
 	} else {
 		// When ptr is not NULL, osize is the size of the block
@@ -64,17 +184,199 @@ void *zen_memory_manager(void *ud, void *ptr, size_t osize, size_t nsize) {
 		if(nsize==0) {
 			// When nsize is zero, the allocator must behave like free
 			// and return NULL.
-			free(ptr);
+			if(!mem || mem->libc) free(ptr);
+			else _release(mem, ptr, osize);
+			if(mem) _account(mem, osize, 0);
 			return NULL; }
 
 		// When nsize is not zero, the allocator must behave like
 		// realloc. The allocator returns NULL if and only if it
 		// cannot fulfill the request. Lua assumes that the allocator
 		// never fails when osize >= nsize.
-		if(osize >= nsize) { // shrink
-			return realloc(ptr, nsize);
-		} else { // extend
-			return realloc(ptr, nsize);
+		if(!mem) return realloc(ptr, nsize);
+		if(mem->libc) {
+			mem->libc_calls++;
+			ret = realloc(ptr, nsize);
+		} else ret = _slab_realloc(mem, ptr, osize, nsize);
+		if(ret) _account(mem, osize, nsize);
+		return ret;
+	}
+}
+
+/// Memory usage of the current VM, as accounted by its allocator
+// @function memory_count
+// @return kilobytes in use, as collectgarbage('count')
+static int lua_memory_count(lua_State *L) {
+	zen_mem_t *mem = NULL;
+	void *ud; lua_getallocf(L, &ud);
+	if(ud) mem = (zen_mem_t*)((zenroom_t*)ud)->memory;
+	if(mem) lua_pushnumber(L, (lua_Number)mem->used / 1024);
+	else lua_pushnumber(L, lua_gc(L, LUA_GCCOUNT, 0)
+						+ (lua_Number)lua_gc(L, LUA_GCCOUNTB, 0) / 1024);
+	return 1;
+}
+
+/// Allocator statistics of the current VM
+// @function memory_stats
+// @return table with manager, used and peak bytes, allocs, libc_calls,
+// slabs and the collector pauses: gc_pauses, gc_full, gc_usec, gc_max_usec
+static int lua_memory_stats(lua_State *L) {
+	zen_mem_t *mem = NULL;
+	void *ud; lua_getallocf(L, &ud);
+	if(ud) mem = (zen_mem_t*)((zenroom_t*)ud)->memory;
+	if(!mem) {
+		lua_pushnil(L);
+		return 1;
+	}
+	lua_createtable(L, 0, 10);
+	lua_pushstring(L, mem->libc ? "libc" : "slab");
+	lua_setfield(L, -2, "manager");
+	lua_pushinteger(L, (lua_Integer)mem->used);
+	lua_setfield(L, -2, "used");
+	lua_pushinteger(L, (lua_Integer)mem->peak);
+	lua_setfield(L, -2, "peak");
+	lua_pushinteger(L, (lua_Integer)mem->allocs);
+	lua_setfield(L, -2, "allocs");
+	lua_pushinteger(L, (lua_Integer)mem->libc_calls);
+	lua_setfield(L, -2, "libc_calls");
+	lua_pushinteger(L, (lua_Integer)mem->slab_count);
+	lua_setfield(L, -2, "slabs");
+	lua_pushinteger(L, (lua_Integer)mem->gc_pauses);
+	lua_setfield(L, -2, "gc_pauses");
+	lua_pushinteger(L, (lua_Integer)mem->gc_full);
+	lua_setfield(L, -2, "gc_full");
+	lua_pushinteger(L, (lua_Integer)mem->gc_usec);
+	lua_setfield(L, -2, "gc_usec");
+	lua_pushinteger(L, (lua_Integer)mem->gc_max_usec);
+	lua_setfield(L, -2, "gc_max_usec");
+	return 1;
+}
+
+static unsigned long long _usec(void) {
+#if defined(ARCH_CORTEX)
+	return 0;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+static void _gc_account(zen_mem_t *mem, unsigned long long start, int full) {
+	unsigned long long t = _usec() - start;
+	mem->gc_pauses++;
+	if(full) mem->gc_full++;
+	mem->gc_usec += t;
+	if(t > mem->gc_max_usec) mem->gc_max_usec = t;
+	mem->gc_mark = mem->used;
+}
+
+// selects the collector mode of a new or restored VM and resets its
+// pause statistics, the collector never runs by itself and is driven
+// by the zencode steps
+void zen_gc_init(zenroom_t *ZZ) {
+	lua_State *L = (lua_State*)ZZ->lua;
+	zen_mem_t *mem = (zen_mem_t*)ZZ->memory;
+	if(ZZ->gcpolicy == GC_GEN) lua_gc(L, LUA_GCGEN, 0, 0);
+	else lua_gc(L, LUA_GCINC, 0, 0, 0);
+	lua_gc(L, LUA_GCSTOP);
+	if(!mem) return;
+	mem->gc_pauses = mem->gc_full = 0;
+	mem->gc_usec = mem->gc_max_usec = 0;
+	mem->gc_mark = mem->used;
+}
+
+// collector work owed by a step: the budget plus what was allocated
+// since the last one and what the caller has just released
+static int _gc_step(lua_State *L, zenroom_t *ZZ, zen_mem_t *mem, int released) {
+	size_t grown = mem->used > mem->gc_mark ? mem->used - mem->gc_mark : 0;
+	unsigned long long start;
+	if(ZZ->gcpolicy == GC_GEN) {
+		// minor collections have no increments, run one when the
+		// young generation has grown past the budget
+		if(grown < (size_t)ZZ->gcstep * 1024 && !released) return 0;
+		start = _usec();
+		lua_gc(L, LUA_GCSTEP, ZZ->gcstep + released);
+		_gc_account(mem, start, 0);
+		return 1;
+	}
+	// the owed work is added to the debt of the collector as Lua
+	// does on allocation: a negative debt is the pause after a cycle
+	global_State *g = G(L);
+	l_mem credit = ((l_mem)ZZ->gcstep + (l_mem)(grown / 1024) + released) * 1024
+		+ g->GCdebt;
+	if(credit <= 0) {
+		luaE_setdebt(g, credit);
+		mem->gc_mark = mem->used;
+		return 0;
+	}
+	int done = 0;
+	start = _usec();
+	if(!ZZ->gctime) {
+		luaE_setdebt(g, 0);
+		done = lua_gc(L, LUA_GCSTEP, (int)(credit / 1024) + 1);
+	} else { // slices of gcstep until paid or out of time
+		const int slice = ZZ->gcstep ? ZZ->gcstep : 1;
+		luaE_setdebt(g, 0);
+		while(!done && credit > 0
+			  && _usec() - start < (unsigned long long)ZZ->gctime) {
+			done = lua_gc(L, LUA_GCSTEP, slice);
+			credit -= (l_mem)slice * 1024;
 		}
 	}
+	_gc_account(mem, start, 0);
+	return done;
+}
+
+/// Collector step between two zencode statements, as configured by
+// the gc, gcstep and gctime switches. Does nothing with gc=full
+// @function gc_step
+// @return true when a collection cycle was completed
+static int lua_gc_step(lua_State *L) {
+	Z(L);
+	zen_mem_t *mem = (zen_mem_t*)Z->memory;
+	if(!mem || Z->gcpolicy == GC_FULL) {
+		lua_pushboolean(L, 0);
+		return 1;
+	}
+	lua_pushboolean(L, _gc_step(L, Z, mem, 0));
+	return 1;
+}
+
+/// Full collection, accounted among the collector pauses
+// @function gc_collect
+static int lua_gc_collect(lua_State *L) {
+	Z(L);
+	zen_mem_t *mem = (zen_mem_t*)Z->memory;
+	unsigned long long start = _usec();
+	lua_gc(L, LUA_GCCOLLECT, 0);
+	if(mem) _gc_account(mem, start, 1);
+	return 0;
+}
+
+/// Reclaims large buffers just dropped, as input strings once
+// decoded: a full collection with gc=full, else a step crediting
+// their size to the collector work
+// @function gc_release
+// @param kib size of the buffers released in KiB
+static int lua_gc_release(lua_State *L) {
+	Z(L);
+	zen_mem_t *mem = (zen_mem_t*)Z->memory;
+	int kib = (int)luaL_optinteger(L, 1, 0);
+	if(!mem || Z->gcpolicy == GC_FULL) return lua_gc_collect(L);
+	_gc_step(L, Z, mem, kib > 0 ? kib : 1);
+	return 0;
+}
+
+void zen_add_memory(lua_State *L) {
+	static const struct luaL_Reg custom_memory [] =
+		{ {"memory_count", lua_memory_count},
+		  {"memory_stats", lua_memory_stats},
+		  {"gc_step", lua_gc_step},
+		  {"gc_collect", lua_gc_collect},
+		  {"gc_release", lua_gc_release},
+		  {NULL, NULL} };
+	lua_getglobal(L, "_G");
+	luaL_setfuncs(L, custom_memory, 0);
+	lua_pop(L, 1);
 }
@@ -27,4 +27,36 @@
 #include <stdlib.h>
 #endif
 
+// the allocator of each Lua state serves small blocks from size
+// classes carved out of slabs, larger ones are left to libc
+#define ZMM_ALIGN 16
+#define ZMM_CLASSES 16 // 16 to 256 bytes in steps of ZMM_ALIGN
+#define ZMM_SMALL (ZMM_ALIGN * ZMM_CLASSES)
+#ifndef ZMM_SLAB
+#define ZMM_SLAB 65536 // bytes requested to libc for each new slab
+#endif
+
+typedef struct {
+	int libc; // bypass slabs, all allocations go to libc
+	void *freelist[ZMM_CLASSES]; // released blocks by size class
+	void *slabs; // list of slabs, released at once on teardown
+	char *bump; // free space in the newest slab
+	char *bump_end;
+	size_t used; // bytes in use by the Lua state and its octets
+	size_t peak;
+	size_t allocs; // new blocks requested by Lua
+	size_t libc_calls; // malloc and realloc calls
+	size_t slab_count;
+	// pauses of the garbage collector driven by zencode
+	size_t gc_pauses;
+	size_t gc_full; // full collections among the pauses
+	unsigned long long gc_usec; // total time paused
+	unsigned long long gc_max_usec; // longest pause
+	size_t gc_mark; // bytes in use after the last generational step
+} zen_mem_t;
+
+zen_mem_t *zen_mem_new(int libc);
+void zen_mem_free(zen_mem_t *mem);
+void *zen_memory_manager(void *ud, void *ptr, size_t osize, size_t nsize);
+
 #endif
@@ -115,11 +115,10 @@ int is_base64(const char *in) {
 }
 
 void push_octet_to_hex_string(lua_State *L, octet *o) {
-	char *s = malloc((o->len<<1)+1); // string len = double +1
-	buf2hex(s, o->val, o->len);
-	lua_pushstring(L,s);
-	free(s);
-	return;
+	luaL_Buffer b;
+	size_t len = (size_t)o->len<<1; // string len = double
+	hex_encode(luaL_buffinitsize(L, &b, len), o->val, o->len);
+	luaL_pushresultsize(&b, len);
 }
 
 extern const int8_t b58digits_map[];
@@ -130,12 +129,12 @@ int is_base58(lua_State *L, const char *in) {
 		return 0; }
 	int c;
 	for(c=0; in[c]!='\0'; c++) {
-		if(b58digits_map[(int8_t)in[c]]==-1) {
-			func(L, "invalid base58 digit");
-			return 0; }
 		if(in[c] & 0x80) {
 			func(L, "high-bit set on invalid digit");
 			return 0; }
+		if(b58digits_map[(int8_t)in[c]]==-1) {
+			func(L, "invalid base58 digit");
+			return 0; }
 	}
 	return c;
 }
@@ -175,18 +174,13 @@ octet* o_alloc(lua_State *L, int size) {
 	if(HEDLEY_UNLIKELY(size>MAX_OCTET)) {
 		zerror(L, "Cannot create octet, size too big: %u", size);
 		return NULL; }
-	register int os = sizeof(octet);
-	octet *o = malloc(os);
+	// header and payload in a single allocation
+	octet *o = malloc(sizeof(octet) +size +0x0f);
 	if(!o) {
 		zerror(L, "Cannot create octet, malloc failure: %s",
 			   strerror(errno));
 		return NULL; }
-	Z(L);
-	o->val = malloc(size +0x0f);
-	if(!o->val) {
-		zerror(L, "Cannot create octet value, malloc: %s",
-			   strerror(errno));
-		return NULL; }
+	o->val = (char*)(o+1);
 	o->max = size;
 	o->len = 0;
 	o->val[0] = 0x0;
@@ -200,7 +194,7 @@ void o_free(lua_State *L, const octet *o) {
 	octet *t = (octet*)o; // remove const static check
 	t->ref--;
 	if(t->ref>0) return;
-	if(HEDLEY_LIKELY(t->val!=NULL)) free(t->val);
+	// the payload follows the header, see o_alloc
 	free(t);
 	return;
 }
@@ -213,17 +207,15 @@ octet* o_new(lua_State *L, const int size) {
 	if(HEDLEY_UNLIKELY(size>MAX_OCTET)) {
 		zerror(L, "Cannot create octet, size too big: %u", size);
 		return NULL; }
-	octet *o = (octet *)lua_newuserdata(L, sizeof(octet));
+	// the payload is inline after the header, so that it is
+	// served and accounted by the memory manager of the Lua state
+	octet *o = (octet *)lua_newuserdata(L, sizeof(octet) +size +0x0f);
 	if(HEDLEY_UNLIKELY(o==NULL)) {
 		zerror(L, "Cannot create octet, lua_newuserdata failure");
 		return NULL; }
 	luaL_getmetatable(L, "zenroom.octet");
 	lua_setmetatable(L, -2);
-	o->val = malloc(size +0x0f);
-	if(HEDLEY_UNLIKELY(o->val==NULL)) {
-		zerror(L, "Cannot create octet, malloc failure");
-		zerror(L, "%s: %s",__func__,strerror(errno));
-		return NULL; }
+	o->val = (char*)(o+1);
 	o->len = 0;
 	o->max = size;
 	o->ref = 1;
@@ -253,9 +245,30 @@ const octet* o_arg(lua_State *L, int n) {
 			zerror(L, "invalid string size: %lu", len);
 			return NULL;
 		}
-		// fallback to a string
-		o = o_alloc(L, len);
-		OCT_jstring(o, (char*)str); // null terminates and updates len
+		// fallback to a string, borrowed for the duration of the call
+		o = malloc(sizeof(octet));
+		if(!o) {
+			zerror(L, "Cannot create octet, malloc failure: %s",
+				   strerror(errno));
+			return NULL; }
+		o->val = (char*)str;
+		o->len = o->max = len;
+		o->ref = 1;
+		return(o);
+	}
+	ud = luaL_testudata(L, n, "zenroom.builder");
+	if(ud) {
+		// borrowed as strings are, see OCTET.builder
+		const octet *b = (octet*)ud;
+		o = malloc(sizeof(octet));
+		if(!o) {
+			zerror(L, "Cannot create octet, malloc failure: %s",
+				   strerror(errno));
+			return NULL; }
+		o->val = b->val;
+		o->len = b->len;
+		o->max = b->max;
+		o->ref = 1;
 		return(o);
 	}
 	// else
@@ -336,6 +349,75 @@ octet *o_dup(lua_State *L, const octet *o) {
 	return(n);
 }
 
+// allocates a new octet in LUA sharing len bytes from offset of the
+// payload of src, which is the o_arg of stack index n: the view keeps
+// its parent alive and is copied on write, see o_mutable. Arguments
+// converted from other types have nothing to share and are copied,
+// as well as slices small enough to be served by a slab block, for
+// which a copy is cheaper than the user value tracking the parent.
+octet *o_view(lua_State *L, int n, const octet *src, int offset, int len) {
+	n = lua_absindex(L, n);
+	octet *p = (octet*)luaL_testudata(L, n, "zenroom.octet");
+	if((!p && lua_type(L, n) != LUA_TSTRING)
+	   || sizeof(octet) +len +0x0f <= ZMM_SMALL) {
+		octet *o = o_new(L, len);
+		if(!o) return NULL;
+		memcpy(o->val, src->val + offset, len);
+		o->len = len;
+		return(o);
+	}
+	octet *o = (octet *)lua_newuserdatauv(L, sizeof(octet), 1);
+	if(HEDLEY_UNLIKELY(o==NULL)) {
+		zerror(L, "Cannot create octet view, lua_newuserdata failure");
+		return NULL; }
+	luaL_getmetatable(L, "zenroom.octet");
+	lua_setmetatable(L, -2);
+	// reference the owner of the payload, never another view
+	if(p && p->val != (char*)(p+1)) lua_getiuservalue(L, n, 1);
+	else lua_pushvalue(L, n);
+	lua_setiuservalue(L, -2, 1);
+	if(p) p->ref++; // the parent payload is shared from now on
+	o->val = src->val + offset;
+	o->len = len;
+	o->max = len;
+	o->ref = 2; // shared with the parent
+	return(o);
+}
+
+// makes the payload of the octet at stack index n private before it is
+// modified in place: shared payloads are copied in a new buffer owned
+// by the octet (as its user value) and with the usual safety bytes
+octet *o_mutable(lua_State *L, int n) {
+	n = lua_absindex(L, n);
+	octet *o = (octet*)luaL_testudata(L, n, "zenroom.octet");
+	if(!o) return NULL;
+	if(o->ref == 1) return(o); // inline or already copied, not shared
+	char *buf = (char*)lua_newuserdatauv(L, o->max +0x0f, 0);
+	if(HEDLEY_UNLIKELY(buf==NULL)) {
+		zerror(L, "Cannot copy octet, lua_newuserdata failure");
+		return NULL; }
+	memcpy(buf, o->val, o->len);
+	lua_setiuservalue(L, n, 1);
+	o->val = buf;
+	o->ref = 1;
+	return(o);
+}
+
+// returns an octet whose payload has safety bytes past its length
+// that can be written, as needed to terminate strings when printing:
+// the o_arg given is freed and replaced by a copy when not owned
+octet *o_writable(lua_State *L, const octet *o) {
+	if(!o) return NULL;
+	if(o->val == (char*)(o+1)) return((octet*)o); // see o_alloc
+	octet *w = o_alloc(L, o->len);
+	if(w) {
+		memcpy(w->val, o->val, o->len);
+		w->len = o->len;
+	}
+	o_free(L, o);
+	return(w);
+}
+
 void push_buffer_to_octet(lua_State *L, char *p, size_t len) {
 	octet* o = o_new(L, len);
 	// newuserdata already pushes the object in lua's stack
@@ -351,9 +433,7 @@ int o_destroy(lua_State *L) {
 	if(!ud) return 0;
 	octet *o = (octet*)ud;
 	o->ref--;
-	if(o->ref > 0) return 0;
-	if(o->val) free(o->val);
-//	free(o);
+	// payload is inline and released by Lua with the userdata
 	return 0;
 }
 
@@ -430,7 +510,7 @@ end:
 static int filloctet(lua_State *L) {
 	BEGIN();
 	int i;
-	octet *o = (octet*) luaL_testudata(L, 1, "zenroom.octet");
+	octet *o = o_mutable(L, 1);
 
 	octet *fill = (octet*) luaL_testudata(L, 2, "zenroom.octet");
 
@@ -641,32 +721,34 @@ static int from_rawlen (lua_State *L) {
 
 static int from_base64(lua_State *L) {
 	BEGIN();
-	const char *s = lua_tostring(L, 1);
+	size_t len;
+	const char *s = lua_tolstring(L, 1, &len);
 	luaL_argcheck(L, s != NULL, 1, "base64 string expected");
-	int len = is_base64(s);
 	if(!len) {
 		lerror(L, "base64 string contains invalid characters");
 		return 0; }
-	int nlen = B64decoded_len(len);
-	octet *o = o_new(L, nlen); // 4 byte header
-
-	OCT_frombase64(o, (char*)s);
+	octet *o = o_new(L, B64decoded_len(len));
+	o->len = base64_decode(o->val, s, len);
+	if(o->len < 0) {
+		lerror(L, "base64 string contains invalid characters");
+		return 0; }
 	END(1);
 }
 
 static int from_url64(lua_State *L) {
 	BEGIN();
-	const char *s = lua_tostring(L, 1);
+	size_t len;
+	const char *s = lua_tolstring(L, 1, &len);
 	luaL_argcheck(L, s != NULL, 1, "url64 string expected");
-	int len = is_url64(s);
 	if(!len) {
 		lerror(L, "url64 string contains invalid characters");
 		return 0; }
-	int nlen = B64decoded_len(len);
-	// func(L,"U64 decode len: %u -> %u",len,nlen);
-	octet *o = o_new(L, nlen);
-	o->len = U64decode(o->val, (char*)s);
-	// func(L,"u64 return len: %u",o->len);
+	if((len & 3) == 1) len--; // a lone trailing sextet carries no byte
+	octet *o = o_new(L, B64decoded_len(len));
+	o->len = url64_decode(o->val, s, len);
+	if(o->len < 0) {
+		lerror(L, "url64 string contains invalid characters");
+		return 0; }
 	END(1);
 }
 
@@ -692,7 +774,9 @@ static int from_base58(lua_State *L) {
 		goto end;
 	}
 	if(binlen>binmax) {
-		memcpy(o->val,&tmp[binlen-binmax],binmax);
+		// leading '1' digits can add more zero bytes than tmp holds
+		memset(o->val,0,binlen-binmax);
+		memcpy(o->val+binlen-binmax,tmp,binmax);
 	} else {
 		memcpy(o->val,&tmp[binmax-binlen],binlen);
 	}
@@ -724,40 +808,43 @@ static int from_string(lua_State *L) {
 
 static int from_hex(lua_State *L) {
 	BEGIN();
-	char *s = (char*)lua_tostring(L, 1);
+	size_t len;
+	const char *s = lua_tolstring(L, 1, &len);
 	if(!s) {
 		zerror(L, "%s :: invalid argument", __func__); // fatal
 		lua_pushboolean(L, 0);
 		END(1); }
-	int len;
-	if ( (s[0] == '0') && (s[1] == 'x') )
-		 len = is_hex(L, s+2);
-	else len = is_hex(L, s);
-	if(!len) {
-		zerror(L, "hex sequence invalid"); // fatal
+	int prefix = (len >= 2 && s[0] == '0' && s[1] == 'x');
+	if(prefix) { s += 2; len -= 2; }
+	func(L,"hex string sequence length: %u",(unsigned)len);
+	if(len>MAX_FILE<<1) { // *2 hex tuples
+		zerror(L, "hex sequence too long: %u bytes", (unsigned)len>>1); // fatal
 		lua_pushboolean(L, 0);
 		END(1); }
-	func(L,"hex string sequence length: %u",len);
-	if(!len || len>MAX_FILE<<1) { // *2 hex tuples
-		zerror(L, "hex sequence too long: %u bytes", len<<1); // fatal
+	if(!len) {
+		zerror(L, "hex sequence invalid"); // fatal
 		lua_pushboolean(L, 0);
 		END(1); }
-	octet *o = o_new(L, len>>1);
-	if ( (s[0] == '0') && (s[1] == 'x') ) {
+	if((len&1) && !prefix) {
+		zerror(L, "%s :: Invalid octet in hex string", __func__);
+		lerror(L, "operation aborted");
+		return 0; }
+	octet *o = o_new(L, (len+1)>>1);
+	if(len&1) {
 		// ethereum elides the leftmost 0 char when value <= 0F
-		if((len&1)==1) { // odd length means elision
-			s[1]='0'; // overwrite a single byte in const
-			o->len = hex2buf(o->val, s+1);
-		} else {
-			o->len = hex2buf(o->val, s+2);
+		const char first[2] = { '0', s[0] };
+		o->len = hex_decode(o->val, first, 2);
+		if(o->len > 0) {
+			o->len = hex_decode(o->val+1, s+1, len-1);
+			if(o->len >= 0) o->len++;
 		}
 	} else {
-		o->len = hex2buf(o->val,s);
+		o->len = hex_decode(o->val, s, len);
 	}
 	if(o->len < 0) {
-		zerror(L, "%s :: Invalid octet in hex string", __func__);
-		lerror(L, "operation aborted");
-		lua_pushnil(L);
+		zerror(L, "hex sequence invalid"); // fatal
+		lua_pop(L, 1);
+		lua_pushboolean(L, 0);
 	}
 	END(1);
 }
@@ -1029,6 +1116,725 @@ end:
 	END(1);
 }
 
+/***
+Create a new octet builder, used to append many octets one after
+the other without copying what was accumulated at each step, as the
+'<b>..</b>' operator does. The builder grows doubling its size when
+needed and can be passed to any function accepting an octet, for
+instance to @{HASH:process}, without converting it.
+
+	@param[opt=64] size initial space reserved in bytes
+	@function OCTET.builder(size)
+	@return a new empty builder
+*/
+static int new_builder(lua_State *L) {
+	BEGIN();
+	int size = luaL_optinteger(L, 1, 64);
+	if(size < 1 || size > MAX_OCTET) {
+		THROW("Invalid size for octet builder");
+	}
+	// the payload is kept outside of the userdata to be reallocated
+	octet *b = (octet *)lua_newuserdatauv(L, sizeof(octet), 0);
+	if(HEDLEY_UNLIKELY(b==NULL)) {
+		THROW("Cannot create octet builder, lua_newuserdata failure");
+	}
+	b->val = NULL;
+	b->len = 0;
+	b->max = 0;
+	b->ref = 1;
+	luaL_getmetatable(L, "zenroom.builder");
+	lua_setmetatable(L, -2);
+	b->val = malloc(size);
+	if(!b->val) {
+		THROW("Cannot create octet builder, malloc failure");
+	}
+	b->max = size;
+	END(1);
+}
+
+// makes room for more bytes at the end of a builder
+static int _builder_grow(lua_State *L, octet *b, int more) {
+	if(more > MAX_OCTET - b->len) {
+		zerror(L, "Octet builder too big: %u + %u bytes", b->len, more);
+		return 0;
+	}
+	if(b->len + more <= b->max) return 1;
+	int max = b->max;
+	while(max < b->len + more)
+		max = (max > MAX_OCTET>>1) ? MAX_OCTET : max<<1;
+	char *val = realloc(b->val, max);
+	if(!val) {
+		zerror(L, "Cannot grow octet builder, realloc failure: %s",
+			   strerror(errno));
+		return 0;
+	}
+	b->val = val;
+	b->max = max;
+	return 1;
+}
+
+/***
+Append one or more octets, or any value that converts to an octet, at
+the end of the builder.
+
+	@param ... octets to append, in order
+	@function builder:append(...)
+	@return the builder itself, to chain calls
+*/
+static int builder_append(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	const octet *o = NULL;
+	octet *b = (octet*)luaL_checkudata(L, 1, "zenroom.builder");
+	int i, top = lua_gettop(L);
+	for(i=2; i<=top; i++) {
+		o = o_arg(L, i);
+		if(!o) {
+			failed_msg = "Could not read octet to append";
+			goto end;
+		}
+		// a builder appended to itself is moved by realloc
+		int self = lua_rawequal(L, 1, i);
+		if(!_builder_grow(L, b, o->len)) {
+			failed_msg = "Could not append to octet builder";
+			goto end;
+		}
+		memcpy(b->val + b->len, self ? b->val : o->val, o->len);
+		b->len += o->len;
+		o_free(L, o);
+		o = NULL;
+	}
+	lua_pushvalue(L, 1);
+end:
+	o_free(L, o);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
+/***
+Append a non negative integer encoded big endian in a fixed number of
+bytes, as I2OSP does in RFC8017.
+
+	@param num integer to encode
+	@param bytes length of the encoding, from 1 to 8
+	@function builder:append_uint(num, bytes)
+	@return the builder itself, to chain calls
+*/
+static int builder_append_uint(lua_State *L) {
+	BEGIN();
+	octet *b = (octet*)luaL_checkudata(L, 1, "zenroom.builder");
+	int isnum;
+	lua_Integer n = lua_tointegerx(L, 2, &isnum);
+	if(!isnum || n < 0) {
+		THROW("Invalid unsigned integer to append");
+	}
+	int bytes = luaL_checkinteger(L, 3);
+	if(bytes < 1 || bytes > 8) {
+		THROW("Invalid number of bytes for unsigned integer");
+	}
+	if(bytes < 8 && (uint64_t)n >> (bytes<<3)) {
+		THROW("Unsigned integer too big for the number of bytes");
+	}
+	if(!_builder_grow(L, b, bytes)) {
+		THROW("Could not append to octet builder");
+	}
+	register int i;
+	for(i=bytes-1; i>=0; i--) {
+		b->val[b->len + i] = n & 0xff;
+		n >>= 8;
+	}
+	b->len += bytes;
+	lua_pushvalue(L, 1);
+	END(1);
+}
+
+/***
+Return a new octet with all the bytes appended so far. The builder
+is left untouched and can be used to append more.
+
+	@function builder:finish()
+	@return a new octet
+*/
+static int builder_finish(lua_State *L) {
+	BEGIN();
+	octet *b = (octet*)luaL_checkudata(L, 1, "zenroom.builder");
+	octet *o = o_new(L, b->len);
+	if(!o) {
+		THROW("Could not create OCTET");
+	}
+	memcpy(o->val, b->val, b->len);
+	o->len = b->len;
+	END(1);
+}
+
+static int builder_size(lua_State *L) {
+	BEGIN();
+	octet *b = (octet*)luaL_checkudata(L, 1, "zenroom.builder");
+	lua_pushinteger(L, b->len);
+	END(1);
+}
+
+static int builder_destroy(lua_State *L) {
+	octet *b = (octet*)luaL_testudata(L, 1, "zenroom.builder");
+	if(!b) return 0;
+	free(b->val);
+	b->val = NULL;
+	b->len = b->max = 0;
+	return 0;
+}
+
+#define SET_MIN_SLOTS 16
+#define SET_FREE 0
+#define SET_GONE 1 // removed, lookups go on past it
+
+typedef struct {
+	uint64_t hash;
+	uint32_t off; // of the bytes in keys
+	int len; // -1 when removed
+} set_entry;
+
+typedef struct {
+	uint64_t k0, k1; // SipHash key
+	uint32_t *slots; // SET_FREE, SET_GONE or index of entry + 2
+	uint32_t mask; // number of slots - 1
+	uint32_t used; // slots not SET_FREE
+	set_entry *entries; // in insertion order
+	uint32_t n, max; // entries used, the removed included, and allocated
+	uint32_t count; // elements present
+	char *keys; // bytes of the elements
+	uint32_t klen, kmax;
+	int map; // values are in the user value table, by entry index
+} octet_set;
+
+#define ROTL64(x,b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+#define SIPROUND do {							\
+		v0 += v1; v1 = ROTL64(v1,13); v1 ^= v0; v0 = ROTL64(v0,32); \
+		v2 += v3; v3 = ROTL64(v3,16); v3 ^= v2;			\
+		v0 += v3; v3 = ROTL64(v3,21); v3 ^= v0;			\
+		v2 += v1; v1 = ROTL64(v1,17); v1 ^= v2; v2 = ROTL64(v2,32); \
+	} while(0)
+
+// SipHash-2-4, keyed so that elements chosen to collide can't be
+// crafted without knowing the key
+static uint64_t _siphash24(uint64_t k0, uint64_t k1,
+						   const uint8_t *in, uint32_t len) {
+	uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+	uint64_t v1 = 0x646f72616e646f6dULL ^ k1;
+	uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+	uint64_t v3 = 0x7465646279746573ULL ^ k1;
+	uint64_t m, b = ((uint64_t)len) << 56;
+	const uint8_t *end = in + (len & ~7U);
+	register int i;
+	for(; in != end; in += 8) {
+		for(m = 0, i = 0; i < 8; i++) m |= (uint64_t)in[i] << (i<<3);
+		v3 ^= m;
+		SIPROUND; SIPROUND;
+		v0 ^= m;
+	}
+	for(i = 0; i < (int)(len & 7); i++) b |= (uint64_t)in[i] << (i<<3);
+	v3 ^= b;
+	SIPROUND; SIPROUND;
+	v0 ^= b;
+	v2 ^= 0xff;
+	SIPROUND; SIPROUND; SIPROUND; SIPROUND;
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+// the bytes of an element: octets and strings are borrowed, other
+// values converted by o_arg and flagged in owned to be freed
+static const octet *_set_key(lua_State *L, int n, octet *tmp, int *owned) {
+	*owned = 0;
+	octet *o = (octet*)luaL_testudata(L, n, "zenroom.octet");
+	if(o) return o;
+	if(lua_type(L, n) == LUA_TSTRING) {
+		size_t len;
+		tmp->val = (char*)lua_tolstring(L, n, &len);
+		if(len > MAX_OCTET) {
+			zerror(L, "invalid string size: %lu", len);
+			return NULL;
+		}
+		tmp->len = tmp->max = len;
+		tmp->ref = 1;
+		return tmp;
+	}
+	*owned = 1;
+	return o_arg(L, n);
+}
+
+// the slot holding k, or else the one where to add it
+static uint32_t _set_find(const octet_set *s, const octet *k, uint64_t h,
+						  int *found) {
+	uint32_t i = h & s->mask, gone = UINT32_MAX;
+	for(;;) {
+		uint32_t e = s->slots[i];
+		if(e == SET_FREE) {
+			*found = 0;
+			return gone != UINT32_MAX ? gone : i;
+		}
+		if(e == SET_GONE) {
+			if(gone == UINT32_MAX) gone = i;
+		} else {
+			const set_entry *x = &s->entries[e-2];
+			if(x->hash == h && x->len == k->len &&
+			   !memcmp(s->keys + x->off, k->val, k->len)) {
+				*found = 1;
+				return i;
+			}
+		}
+		i = (i + 1) & s->mask;
+	}
+}
+
+// rebuilds the slots for at least size elements, dropping the
+// removed entries and moving the values of a map along with them
+static int _set_resize(lua_State *L, int idx, octet_set *s, uint32_t size) {
+	uint32_t slots = SET_MIN_SLOTS;
+	while(slots < (size<<1)) {
+		if(slots > (UINT32_MAX>>2)) {
+			zerror(L, "Octet set too big: %u elements", size);
+			return 0;
+		}
+		slots <<= 1;
+	}
+	uint32_t *ns = calloc(slots, sizeof(uint32_t));
+	if(!ns) {
+		zerror(L, "Cannot resize octet set, calloc failure: %s",
+			   strerror(errno));
+		return 0;
+	}
+	if(s->map) lua_getiuservalue(L, idx, 1);
+	uint32_t i, j, klen = 0, mask = slots - 1;
+	for(i = 0, j = 0; i < s->n; i++) {
+		set_entry x = s->entries[i];
+		if(x.len < 0) continue;
+		// offsets grow with entries, so this moves bytes backwards
+		if(x.off != klen) memmove(s->keys + klen, s->keys + x.off, x.len);
+		x.off = klen;
+		klen += x.len;
+		if(s->map && i != j) {
+			lua_rawgeti(L, -1, i+1);
+			lua_rawseti(L, -2, j+1);
+		}
+		s->entries[j] = x;
+		uint32_t slot = x.hash & mask;
+		while(ns[slot] != SET_FREE) slot = (slot + 1) & mask;
+		ns[slot] = j + 2;
+		j++;
+	}
+	if(s->map) {
+		for(i = j; i < s->n; i++) {
+			lua_pushnil(L);
+			lua_rawseti(L, -2, i+1);
+		}
+		lua_pop(L, 1);
+	}
+	free(s->slots);
+	s->slots = ns;
+	s->mask = mask;
+	s->used = s->count = s->n = j;
+	s->klen = klen;
+	return 1;
+}
+
+// adds k if not present, returns the index of its entry or -1 on
+// errors, added tells if it is new
+static int _set_add(lua_State *L, int idx, octet_set *s, const octet *k,
+					int *added) {
+	uint64_t h = _siphash24(s->k0, s->k1, (uint8_t*)k->val, k->len);
+	int found;
+	uint32_t i = _set_find(s, k, h, &found);
+	*added = 0;
+	if(found) return s->slots[i] - 2;
+	// grow when 3/4 of the slots are taken, compact when the removed
+	// entries outnumber the present ones
+	if((uint64_t)(s->used + 1) << 2 > (uint64_t)(s->mask + 1) * 3
+	   || (s->n >= SET_MIN_SLOTS && s->n - s->count > s->count)) {
+		if(!_set_resize(L, idx, s, s->count + 1)) return -1;
+		i = _set_find(s, k, h, &found);
+	}
+	if(s->n == s->max) {
+		uint32_t max = s->max ? s->max << 1 : SET_MIN_SLOTS;
+		set_entry *e = max > s->max ?
+			realloc(s->entries, max * sizeof(set_entry)) : NULL;
+		if(!e) {
+			zerror(L, "Cannot grow octet set, realloc failure");
+			return -1;
+		}
+		s->entries = e;
+		s->max = max;
+	}
+	if((uint64_t)s->klen + k->len > s->kmax) {
+		uint64_t kmax = s->kmax ? s->kmax : 256;
+		while(kmax < (uint64_t)s->klen + k->len) kmax <<= 1;
+		char *keys = kmax <= UINT32_MAX ? realloc(s->keys, kmax) : NULL;
+		if(!keys) {
+			zerror(L, "Cannot grow octet set, realloc failure");
+			return -1;
+		}
+		s->keys = keys;
+		s->kmax = kmax;
+	}
+	memcpy(s->keys + s->klen, k->val, k->len);
+	s->entries[s->n].hash = h;
+	s->entries[s->n].off = s->klen;
+	s->entries[s->n].len = k->len;
+	s->klen += k->len;
+	if(s->slots[i] == SET_FREE) s->used++;
+	s->slots[i] = s->n + 2;
+	s->count++;
+	*added = 1;
+	return s->n++;
+}
+
+// pushes a new empty set or map
+static octet_set *_set_new(lua_State *L, int map) {
+	octet_set *s = (octet_set *)lua_newuserdatauv(L, sizeof(octet_set), 1);
+	if(HEDLEY_UNLIKELY(s==NULL)) {
+		zerror(L, "Cannot create octet set, lua_newuserdata failure");
+		return NULL;
+	}
+	memset(s, 0, sizeof(octet_set));
+	luaL_getmetatable(L, "zenroom.octet_set");
+	lua_setmetatable(L, -2);
+	s->slots = calloc(SET_MIN_SLOTS, sizeof(uint32_t));
+	if(!s->slots) {
+		zerror(L, "Cannot create octet set, calloc failure");
+		return NULL;
+	}
+	s->mask = SET_MIN_SLOTS - 1;
+	// the key is drawn in init with the runtime random, to leave
+	// the random stream of the script as it is
+	Z(L);
+	register int i;
+	const uint8_t *r = (const uint8_t*)Z->runtime_random256;
+	for(i = 0; i < 8; i++) {
+		s->k0 |= (uint64_t)r[i] << (i<<3);
+		s->k1 |= (uint64_t)r[i+8] << (i<<3);
+	}
+	if(map) {
+		s->map = 1;
+		lua_newtable(L);
+		lua_setiuservalue(L, -2, 1);
+	}
+	return s;
+}
+
+// builds a set or map from the array at index 1, and the values at 2
+static int _set_from_array(lua_State *L, int map) {
+	BEGIN();
+	char *failed_msg = NULL;
+	const octet *k = NULL;
+	octet tmp;
+	int owned = 0, added;
+	int n = lua_istable(L, 1) ? lua_rawlen(L, 1) : 0;
+	if(!lua_isnoneornil(L, 1) && !lua_istable(L, 1)) {
+		THROW("Octet set argument is not an array");
+	}
+	if(map && !lua_isnoneornil(L, 2) &&
+	   (!lua_istable(L, 2) || (int)lua_rawlen(L, 2) != n)) {
+		THROW("Octet map values are not an array of the same length");
+	}
+	octet_set *s = _set_new(L, map);
+	if(!s) {
+		THROW("Could not create octet set");
+	}
+	int idx = lua_gettop(L);
+	if(n > 0 && !_set_resize(L, idx, s, n)) {
+		THROW("Could not create octet set");
+	}
+	register int i;
+	for(i = 1; i <= n; i++) {
+		lua_rawgeti(L, 1, i);
+		k = _set_key(L, -1, &tmp, &owned);
+		if(!k) {
+			failed_msg = "Could not read octet set element";
+			goto end;
+		}
+		int e = _set_add(L, idx, s, k, &added);
+		if(e < 0) {
+			failed_msg = "Could not add octet set element";
+			goto end;
+		}
+		lua_pop(L, 1);
+		if(owned) o_free(L, k);
+		k = NULL;
+		if(map) {
+			lua_getiuservalue(L, idx, 1);
+			if(lua_istable(L, 2)) lua_rawgeti(L, 2, i);
+			else lua_pushboolean(L, 1);
+			lua_rawseti(L, -2, e+1);
+			lua_pop(L, 1);
+		}
+	}
+end:
+	if(owned) o_free(L, k);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
+/***
+Create a new set of octets, a hash table answering if it contains an
+octet in constant time with no allocation, where a loop comparing
+each element with '<b>==</b>' takes time proportional to the number of
+elements. Strings and any value that converts to an octet can be used
+as well, equal bytes make equal elements. Elements are kept in the
+order they were added.
+
+	@param[opt] array of elements to add, duplicates are added once
+	@function OCTET.set(array)
+	@return a new set
+*/
+static int new_set(lua_State *L) {
+	return _set_from_array(L, 0);
+}
+
+/***
+Create a new map of octets, a set holding a value for each element,
+see @{OCTET.set}.
+
+	@param[opt] keys array of elements to add
+	@param[opt] values array of their values, by default true
+	@function OCTET.map(keys, values)
+	@return a new map
+*/
+static int new_map(lua_State *L) {
+	return _set_from_array(L, 1);
+}
+
+// the index of the entry of the element at index 2, or -1
+static int _set_lookup(lua_State *L, const octet_set *s) {
+	octet tmp;
+	int owned, found;
+	const octet *k = _set_key(L, 2, &tmp, &owned);
+	if(!k) return -2;
+	uint64_t h = _siphash24(s->k0, s->k1, (uint8_t*)k->val, k->len);
+	uint32_t i = _set_find(s, k, h, &found);
+	if(owned) o_free(L, k);
+	return found ? (int)s->slots[i] - 2 : -1;
+}
+
+/***
+Tell if an element is in the set or map.
+
+	@param element octet, or value converting to it, to look up
+	@function set:has(element)
+	@return true if present, false otherwise
+*/
+static int set_has(lua_State *L) {
+	BEGIN();
+	octet_set *s = (octet_set*)luaL_checkudata(L, 1, "zenroom.octet_set");
+	int e = _set_lookup(L, s);
+	if(e < -1) {
+		THROW("Could not read octet set element");
+	}
+	lua_pushboolean(L, e >= 0);
+	END(1);
+}
+
+/***
+Return the value of an element in a map, or true if it is in a set.
+
+	@param element octet, or value converting to it, to look up
+	@function map:get(element)
+	@return its value, or nil if not present
+*/
+static int set_get(lua_State *L) {
+	BEGIN();
+	octet_set *s = (octet_set*)luaL_checkudata(L, 1, "zenroom.octet_set");
+	int e = _set_lookup(L, s);
+	if(e < -1) {
+		THROW("Could not read octet set element");
+	}
+	if(e < 0) {
+		lua_pushnil(L);
+	} else if(s->map) {
+		lua_getiuservalue(L, 1, 1);
+		lua_rawgeti(L, -1, e+1);
+		lua_remove(L, -2);
+	} else {
+		lua_pushboolean(L, 1);
+	}
+	END(1);
+}
+
+/***
+Add an element to the set or map, setting its value in a map also
+when it is already present.
+
+	@param element octet, or value converting to it, to add
+	@param[opt=true] value of the element in a map
+	@function set:add(element, value)
+	@return true if the element is new, false otherwise
+*/
+static int set_add(lua_State *L) {
+	BEGIN();
+	octet_set *s = (octet_set*)luaL_checkudata(L, 1, "zenroom.octet_set");
+	octet tmp;
+	int owned, added;
+	const octet *k = _set_key(L, 2, &tmp, &owned);
+	if(!k) {
+		THROW("Could not read octet set element");
+	}
+	int e = _set_add(L, 1, s, k, &added);
+	if(owned) o_free(L, k);
+	if(e < 0) {
+		THROW("Could not add octet set element");
+	}
+	if(s->map) {
+		lua_getiuservalue(L, 1, 1);
+		if(lua_isnoneornil(L, 3)) lua_pushboolean(L, 1);
+		else lua_pushvalue(L, 3);
+		lua_rawseti(L, -2, e+1);
+		lua_pop(L, 1);
+	}
+	lua_pushboolean(L, added);
+	END(1);
+}
+
+/***
+Remove an element from the set or map.
+
+	@param element octet, or value converting to it, to remove
+	@function set:remove(element)
+	@return true if the element was present, false otherwise
+*/
+static int set_remove(lua_State *L) {
+	BEGIN();
+	octet_set *s = (octet_set*)luaL_checkudata(L, 1, "zenroom.octet_set");
+	octet tmp;
+	int owned, found;
+	const octet *k = _set_key(L, 2, &tmp, &owned);
+	if(!k) {
+		THROW("Could not read octet set element");
+	}
+	uint64_t h = _siphash24(s->k0, s->k1, (uint8_t*)k->val, k->len);
+	uint32_t i = _set_find(s, k, h, &found);
+	if(owned) o_free(L, k);
+	if(found) {
+		uint32_t e = s->slots[i] - 2;
+		s->entries[e].len = -1;
+		s->slots[i] = SET_GONE;
+		s->count--;
+		if(s->map) {
+			lua_getiuservalue(L, 1, 1);
+			lua_pushnil(L);
+			lua_rawseti(L, -2, e+1);
+			lua_pop(L, 1);
+		}
+	}
+	lua_pushboolean(L, found);
+	END(1);
+}
+
+/***
+Return the elements of an array, set or map which are also in this
+set or map, in the order they have in the argument. The cost is
+proportional to the size of the argument only.
+
+	@param other array, set or map
+	@function set:intersection(other)
+	@return a new set
+*/
+static int set_intersection(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	const octet *k = NULL;
+	octet tmp;
+	int owned = 0, found, added;
+	octet_set *s = (octet_set*)luaL_checkudata(L, 1, "zenroom.octet_set");
+	octet_set *o = (octet_set*)luaL_testudata(L, 2, "zenroom.octet_set");
+	if(!o && !lua_istable(L, 2)) {
+		THROW("Octet set intersection argument is not a set or array");
+	}
+	octet_set *r = _set_new(L, 0);
+	if(!r) {
+		THROW("Could not create octet set");
+	}
+	int idx = lua_gettop(L);
+	uint32_t i, n = o ? o->n : lua_rawlen(L, 2);
+	for(i = 0; i < n; i++) {
+		if(o) {
+			if(o->entries[i].len < 0) continue;
+			tmp.val = o->keys + o->entries[i].off;
+			tmp.len = tmp.max = o->entries[i].len;
+			k = &tmp;
+		} else {
+			lua_rawgeti(L, 2, i+1);
+			k = _set_key(L, -1, &tmp, &owned);
+			lua_pop(L, 1);
+			if(!k) {
+				failed_msg = "Could not read octet set element";
+				goto end;
+			}
+		}
+		uint64_t h = _siphash24(s->k0, s->k1, (uint8_t*)k->val, k->len);
+		_set_find(s, k, h, &found);
+		if(found && _set_add(L, idx, r, k, &added) < 0) {
+			failed_msg = "Could not add octet set element";
+			goto end;
+		}
+		if(owned) o_free(L, k);
+		owned = 0;
+		k = NULL;
+	}
+end:
+	if(owned) o_free(L, k);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
+/***
+Return all the elements of the set or map in an array, in the order
+they were added.
+
+	@function set:array()
+	@return array of octets
+*/
+static int set_array(lua_State *L) {
+	BEGIN();
+	octet_set *s = (octet_set*)luaL_checkudata(L, 1, "zenroom.octet_set");
+	lua_createtable(L, s->count, 0);
+	uint32_t i, j;
+	for(i = 0, j = 1; i < s->n; i++) {
+		const set_entry *x = &s->entries[i];
+		if(x->len < 0) continue;
+		octet *o = o_new(L, x->len);
+		if(!o) {
+			THROW("Could not create OCTET");
+		}
+		memcpy(o->val, s->keys + x->off, x->len);
+		o->len = x->len;
+		lua_rawseti(L, -2, j++);
+	}
+	END(1);
+}
+
+static int set_size(lua_State *L) {
+	BEGIN();
+	octet_set *s = (octet_set*)luaL_checkudata(L, 1, "zenroom.octet_set");
+	lua_pushinteger(L, s->count);
+	END(1);
+}
+
+static int set_destroy(lua_State *L) {
+	octet_set *s = (octet_set*)luaL_testudata(L, 1, "zenroom.octet_set");
+	if(!s) return 0;
+	free(s->slots);
+	free(s->entries);
+	free(s->keys);
+	s->slots = NULL;
+	s->entries = NULL;
+	s->keys = NULL;
+	s->n = s->count = s->used = 0;
+	return 0;
+}
+
 
 /// Object Methods
 // @type OCTET
@@ -1073,7 +1879,6 @@ print(msg:base64())
 static int to_base64 (lua_State *L) {
 	BEGIN();
 	char *failed_msg = NULL;
-	char *b = NULL;
 	const octet *o = o_arg(L, 1);
 	if(!o) {
 		failed_msg = "Could not allocate OCTET";
@@ -1084,13 +1889,11 @@ static int to_base64 (lua_State *L) {
 		failed_msg = "base64 cannot encode an empty octet";
 		goto end;
 	}
-	int newlen;
-	newlen = ((3+(4*(o->len/3))) & ~0x03)+0x0f;
-	b = malloc(newlen);
-	OCT_tobase64(b,(octet*)o);
-	lua_pushstring(L,b);
+	luaL_Buffer b;
+	size_t len = base64_len(o->len);
+	base64_encode(luaL_buffinitsize(L, &b, len), o->val, o->len);
+	luaL_pushresultsize(&b, len);
 end:
-	free(b);
 	o_free(L,o);
 	if(failed_msg) {
 		THROW(failed_msg);
@@ -1101,7 +1904,6 @@ end:
 static int to_url64 (lua_State *L) {
 	BEGIN();
 	char *failed_msg = NULL;
-	char *b = NULL;
 	const octet *o = o_arg(L,1);
 	if(!o) {
 		failed_msg = "Could not allocate OCTET";
@@ -1112,14 +1914,11 @@ static int to_url64 (lua_State *L) {
 		failed_msg = "url64 cannot encode an empty octet";
 		goto end;
 	}
-	int newlen;
-	newlen = B64encoded_len(o->len);
-	b = malloc(newlen);
-	// b[0]='u';b[1]='6';b[2]='4';b[3]=':';
-	U64encode(b,o->val,o->len);
-	lua_pushstring(L,b);
+	luaL_Buffer b;
+	size_t len = url64_len(o->len);
+	url64_encode(luaL_buffinitsize(L, &b, len), o->val, o->len);
+	luaL_pushresultsize(&b, len);
 end:
-	free(b);
 	o_free(L,o);
 	if(failed_msg) {
 		THROW(failed_msg);
@@ -1155,24 +1954,13 @@ static int to_base58(lua_State *L) {
 		failed_msg = "base58 cannot encode an empty octet";
 		goto end;
 	}
-	if(o->len < 3) {
-		// there is a bug in luke-jr's implementation of base58 (fixed
-		// in bitcoin-core) when encoding strings smaller than 3 bytes
-		// the 'j' counter being unsigned and initialised at size-2 in
-		// the carry inner loop flips to 18446744073709551615
-		failed_msg = "base58 cannot encode octets smaller than 3 bytes";
-		goto end;
-	}
-	size_t maxlen = o->len <<1;
-	// TODO: find out why this breaks!
-	// debug builds work, optimized build breaks here
-	// this workaround will break base58 encoding when using memmanager=lw
-	//char *b = malloc(maxlen);
-	b = malloc(maxlen);
-	size_t b58len = maxlen;
-	b58enc(b, &b58len, o->val, o->len);
-	// b[b58len] = '\0'; // already present in libbase58
-	lua_pushstring(L,b);
+	size_t b58len = (o->len <<1) + 2;
+	b = malloc(b58len);
+	if(!b58enc(b, &b58len, o->val, o->len)) {
+		failed_msg = "Error in conversion to base58";
+		goto end;
+	}
+	lua_pushlstring(L, b, b58len-1); // b58len counts the terminator
 end:
 	free(b);
 	o_free(L, o);
@@ -1429,15 +2217,8 @@ static int trim(lua_State *L) {
 		size--;
 		end--;
 	}
-	if(size == (size_t)src->len) {
-		// no changes
-		res = o_dup(L, src);
-	} else {
-		// new octet
-		res = o_new(L, size+4);
-		memcpy(res->val,front,size);
-		res->len = size;
-	}
+	res = o_view(L, 1, src, front - src->val, size);
+	if(!res) failed_msg = "Could not create OCTET";
 end:
 	o_free(L, src);
 	if(failed_msg) {
@@ -1465,17 +2246,9 @@ static int chop(lua_State *L) {
 		failed_msg = "Could not chop OCTET";
 		goto end;
 	}
-	octet *l = o_dup(L, src);
-	if(!l) {
-		failed_msg = "Could not duplicate OCTET";
-		goto end;
-	}
-	octet *r = o_new(L, src->len - len);
-	if(!r) {
+	if(!o_view(L, 1, src, 0, len)
+	   || !o_view(L, 1, src, len, src->len - len))
 		failed_msg = "Could not create OCTET";
-		goto end;
-	}
-	OCT_chop(l, r, len);
 end:
 	o_free(L, src);
 	if(failed_msg) {
@@ -1530,7 +2303,6 @@ end:
 static int sub(lua_State *L) {
 	BEGIN();
 	char *failed_msg = NULL;
-	register int i, c;
 	const octet *src = NULL;
 	octet *dst = NULL;
 	int start, end;
@@ -1556,14 +2328,8 @@ static int sub(lua_State *L) {
 		failed_msg = "Could not extract sub OCTET";
 		goto end;
 	}
-	dst = o_new(L, end - start + 1);
-	if(!dst) {
-		failed_msg = "Could not create OCTET";
-		goto end;
-	}
-	for(i=start-1, c=0; i<=end; i++, c++)
-		dst->val[c] = src->val[i];
-	dst->len = end - start + 1;
+	dst = o_view(L, 1, src, start - 1, end - start + 1);
+	if(!dst) failed_msg = "Could not create OCTET";
 end:
 	o_free(L, src);
 	if(failed_msg) {
@@ -1933,11 +2699,8 @@ static int elide_at_start(lua_State *L) {
 	if (i != prefix->len) {
 		lua_pushnil(L);
 	} else {
-		octet* res = o_new(L, o->len - prefix->len);
-		if (i < o->len) {
-			memmove(res->val, o->val + i, o->len - i);
-			res->len = o->len - prefix->len;
-		}
+		if(!o_view(L, 1, o, i, o->len - i))
+			failed_msg = "Could not create OCTET";
 	}
 
 end:
@@ -2225,20 +2988,18 @@ static int and_grow(lua_State *L) {
 		goto end;
 	}
 
-	// pad first arg with zeroes
-	if(x->len < max) {
-		x->val = realloc(x->val, max);
-		x->max = max;
-		OCT_pad(x, max);
-	}
-	if(y->len < max) {
-		y->val = realloc(y->val, max);
-		y->max = max;
-		OCT_pad(y, max);
-	}
-
+	// pad copies of both args with zeroes, leaving them untouched
 	OCT_copy(n, x);
-	OCT_and(n, y);
+	OCT_pad(n, max);
+	octet *p = o_alloc(L, max);
+	if(!p) {
+		failed_msg = "Could not allocate OCTET";
+		goto end;
+	}
+	OCT_copy(p, y);
+	OCT_pad(p, max);
+	OCT_and(n, p);
+	o_free(L, p);
 end:
 	o_free(L, x);
 	o_free(L, y);
@@ -2308,20 +3069,18 @@ static int or_grow(lua_State *L) {
 		goto end;
 	}
 
-	// pad first arg with zeroes
-	if(x->len < max) {
-		x->val = realloc(x->val, max);
-		x->max = max;
-		OCT_pad(x, max);
-	}
-	if(y->len < max) {
-		y->val = realloc(y->val, max);
-		y->max = max;
-		OCT_pad(y, max);
-	}
-
+	// pad copies of both args with zeroes, leaving them untouched
 	OCT_copy(n, x);
-	OCT_or(n, y);
+	OCT_pad(n, max);
+	octet *p = o_alloc(L, max);
+	if(!p) {
+		failed_msg = "Could not allocate OCTET";
+		goto end;
+	}
+	OCT_copy(p, y);
+	OCT_pad(p, max);
+	OCT_or(n, p);
+	o_free(L, p);
 end:
 	o_free(L, x);
 	o_free(L, y);
@@ -2497,13 +3256,8 @@ static int memcopy(lua_State *L) {
 		failed_msg = "Cannot copy octet";
 		goto end;
 	}
-	dst = o_new(L, length+1);
-	if(!dst) {
-		failed_msg = "Cannot allocate octet memory";
-		goto end;
-	}
-	memcpy(dst->val, src->val+start, length);
-	dst->len = length;
+	dst = o_view(L, 1, src, start, length);
+	if(!dst) failed_msg = "Cannot allocate octet memory";
 end:
 	o_free(L, src);
 	if(failed_msg) {
@@ -2635,6 +3389,9 @@ int luaopen_octet(lua_State *L) {
 		{"find", memfind},
 		{"copy", memcopy},
 		{"paste", mempaste},
+		{"builder", new_builder},
+		{"set", new_set},
+		{"map", new_map},
 
 		{NULL,NULL}
 	};
@@ -2705,6 +3462,38 @@ int luaopen_octet(lua_State *L) {
 		{"__bnot", bit_not},
 		{NULL,NULL}
 	};
+	const struct luaL_Reg builder_methods[] = {
+		{"append", builder_append},
+		{"append_uint", builder_append_uint},
+		{"finish", builder_finish},
+		{"octet", builder_finish},
+		{"__len", builder_size},
+		{"__gc", builder_destroy},
+		{NULL,NULL}
+	};
+	const struct luaL_Reg set_methods[] = {
+		{"has", set_has},
+		{"get", set_get},
+		{"add", set_add},
+		{"remove", set_remove},
+		{"intersection", set_intersection},
+		{"array", set_array},
+		{"__len", set_size},
+		{"__gc", set_destroy},
+		{NULL,NULL}
+	};
+	// builders have methods but no class table, see OCTET.builder
+	luaL_newmetatable(L, "zenroom.builder");
+	lua_pushvalue(L, -1);
+	lua_setfield(L, -2, "__index");
+	luaL_setfuncs(L, builder_methods, 0);
+	lua_pop(L, 1);
+	// so have sets and maps, see OCTET.set
+	luaL_newmetatable(L, "zenroom.octet_set");
+	lua_pushvalue(L, -1);
+	lua_setfield(L, -2, "__index");
+	luaL_setfuncs(L, set_methods, 0);
+	lua_pop(L, 1);
 	zen_add_class(L, "octet", octet_class, octet_methods);
 	return 1;
 }
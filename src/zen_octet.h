@@ -36,9 +36,22 @@ HEDLEY_NON_NULL(1,2)
 octet *o_dup(lua_State *L, const octet *o);
 
 // REMEMBER: o_arg returns a new allocated octet to be freed with o_free
+// its payload may be borrowed from the argument and must not be modified
 HEDLEY_NON_NULL(1)
 const octet* o_arg(lua_State *L, int n);
 
+// views share the payload of the octet or string argument at index n
+HEDLEY_NON_NULL(1,3)
+octet *o_view(lua_State *L, int n, const octet *src, int offset, int len);
+
+// copy on write of the octet at index n, to be called before changing it
+HEDLEY_NON_NULL(1)
+octet *o_mutable(lua_State *L, int n);
+
+// replaces an o_arg with a copy when its payload has no safety bytes
+HEDLEY_NON_NULL(1)
+octet *o_writable(lua_State *L, const octet *o);
+
 // These functions are internal and not exposed to lua's stack
 // to make an octet visible to lua can be done using o_dup
 HEDLEY_MALLOC
@@ -0,0 +1,48 @@
+/* This file is part of Zenroom (https://zenroom.dyne.org)
+ *
+ * Copyright (C) 2017-2025 Dyne.org foundation
+ * designed, written and maintained by Denis Roio <jaromil@dyne.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __ZEN_ONCE_H__
+#define __ZEN_ONCE_H__
+
+// state of data built once and shared by all threads
+#define ZEN_ONCE_MISSING 0
+#define ZEN_ONCE_BUILDING 1
+#define ZEN_ONCE_READY 2
+
+// runs build the first time it is called on state, from a single
+// thread: the others wait until its results are published. build
+// must not fail, it should work on static storage only
+static inline void zen_once(volatile int *state, void (*build)(void)) {
+	if(*state == ZEN_ONCE_READY) {
+		__sync_synchronize();
+		return;
+	}
+	if(__sync_bool_compare_and_swap(state, ZEN_ONCE_MISSING,
+									ZEN_ONCE_BUILDING)) {
+		build();
+		__sync_synchronize();
+		*state = ZEN_ONCE_READY;
+	} else {
+		while(*state != ZEN_ONCE_READY) ; // built by another thread
+		__sync_synchronize();
+	}
+}
+
+#endif
@@ -188,10 +188,7 @@ static int p256_sign(lua_State *L)
 
 	ASSERT_OCT_LEN(sk, SK_SIZE, "Invalid size for ECDSA secret key")
 	HASH256_init(&sha256);
-	for (int i = 0; i < m->len; i++)
-	{
-		HASH256_process(&sha256, m->val[i]);
-	}
+	HASH256_process_array(&sha256, m->val, m->len);
 	HASH256_hash(&sha256, hash);
 
 	sig = o_new(L, SIG_SIZE);
@@ -255,10 +252,7 @@ static int p256_verify(lua_State *L)
 	ASSERT_OCT_LEN(sig, SIG_SIZE, "Invalid size for P256 signature")
 
 	HASH256_init(&sha256);
-	for (int i = 0; i < m->len; i++)
-	{
-		HASH256_process(&sha256, m->val[i]);
-	}
+	HASH256_process_array(&sha256, m->val, m->len);
 	HASH256_hash(&sha256, hash);
 
 	lua_pushboolean(L, p256_ecdsa_verify((uint8_t *)sig->val,
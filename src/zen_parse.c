@@ -23,17 +23,28 @@
 
 // #include <stdio.h>
 #include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include <strings.h>
+#include <stdarg.h>
+
+#include <amcl.h>
 
 #include <zenroom.h>
+#include <encoding.h>
 #include <zen_memory.h>
 #include <zen_error.h>
+#include <zen_octet.h>
+#include <mutt_sprintf.h>
 
 #include <lualib.h>
 #include <lauxlib.h>
 
 #define MAX_DEPTH 4096
 
+extern int b58enc(char *b58, size_t *b58sz, const void *data, size_t binsz);
+
 static char low[MAX_LINE]; // 1KB max for a single zencode line
 // parse the first word until the first space, returns a new string
 static int lua_parse_prefix(lua_State* L) { 
@@ -56,6 +67,102 @@ static int lua_parse_prefix(lua_State* L) {
 	return 1;
 }
 
+// replaces in s the first occurrence of pat, or all of them, with
+// rep which is not longer, returns the new length. Anchored patterns
+// only match at the beginning. Same as string.gsub with plain text
+// patterns: matches don't overlap and the scan goes on after each.
+static size_t stmt_replace(char *s, size_t len, const char *pat,
+						   const char *rep, int anchored, int all) {
+	const size_t pl = strlen(pat), rl = strlen(rep);
+	register size_t i, o;
+	int done = 0;
+	for(i = 0, o = 0; i < len; ) {
+		if(!done && len - i >= pl && !memcmp(s + i, pat, pl)) {
+			memcpy(s + o, rep, rl);
+			o += rl;
+			i += pl;
+			if(!all) done = 1;
+			continue;
+		}
+		if(anchored) done = 1;
+		s[o++] = s[i++];
+	}
+	return o;
+}
+
+/*
+  Normalises a Zencode statement into the key of its step and
+  extracts its arguments, replacing the chain of string.gsub in
+  set_sentence with the same results:
+  - contents of single quotes are emptied and returned as arguments,
+    with spaces converted to underscores as uscore() does
+  - the first pronoun ' I ' is removed, then all is lower cased
+  - particles are removed, as the 'to' state of the parser requires
+  - the prefix and the articles are removed, spaces collapsed
+  Returns the key and the array of arguments.
+*/
+static int lua_zencode_statement(lua_State* L) {
+	size_t len;
+	const char *line = luaL_checklstring(L, 1, &len);
+	const char *to = luaL_optstring(L, 2, "");
+	register size_t i, o;
+	int nargs = 0;
+	// a userdata buffer is collected even if a push below raises
+	char *s = (char*)lua_newuserdatauv(L, len + 1, 0);
+	lua_newtable(L);
+	// empty the quotes and collect their contents
+	for(i = 0, o = 0; i < len; ) {
+		const char *close;
+		if(line[i] != '\'' ||
+		   !(close = memchr(line + i + 1, '\'', len - i - 1))) {
+			s[o++] = line[i++];
+			continue;
+		}
+		const size_t alen = close - (line + i + 1);
+		char *arg = s + o + 2; // room left by the quoted text
+		memcpy(arg, line + i + 1, alen);
+		register size_t c;
+		for(c = 0; c < alen; c++) if(arg[c] == ' ') arg[c] = '_';
+		lua_pushlstring(L, arg, alen);
+		lua_rawseti(L, -2, ++nargs);
+		s[o++] = '\'';
+		s[o++] = '\'';
+		i += alen + 2;
+	}
+	len = stmt_replace(s, o, " I ", " ", 0, 0);
+	for(i = 0; i < len; i++) s[i] = tolower((unsigned char)s[i]);
+	if(!strcmp(to, "then") || !strcmp(to, "thenif")) {
+		len = stmt_replace(s, len, " the ", " ", 0, 0);
+	}
+	if(!strcmp(to, "given")) {
+		static const char *const given[] =
+			{ " the ", " a ", " an ", " have ", " known as ", " valid ", NULL };
+		for(i = 0; given[i]; i++)
+			len = stmt_replace(s, len, given[i], " ", 0, 0);
+	}
+	// prefixes found at beginning of statement
+	static const char *const prefix[] =
+		{ "when ", "then ", "given ", "if ", "foreach ", "and ", NULL };
+	for(i = 0; prefix[i]; i++)
+		len = stmt_replace(s, len, prefix[i], "", 1, 0);
+	// generic particles
+	len = stmt_replace(s, len, "that ", " ", 1, 0);
+	len = stmt_replace(s, len, " the ", " ", 0, 1);
+	len = stmt_replace(s, len, "an ", "a ", 1, 0);
+	len = stmt_replace(s, len, " valid ", " ", 0, 0);
+	len = stmt_replace(s, len, " all ", " ", 0, 0);
+	len = stmt_replace(s, len, " inside ", " in ", 0, 0);
+	// collapse spaces and trim them at both ends
+	for(i = 0, o = 0; i < len; i++) {
+		if(s[i] == ' ' && (o == 0 || s[o-1] == ' ')) continue;
+		s[o++] = s[i];
+	}
+	if(o && s[o-1] == ' ') o--;
+	lua_pushlstring(L, s, o);
+	lua_insert(L, -2);
+	return 2;
+}
+
 // internal use, trims the string to a provided destination which is
 // pre-allocated
 static size_t trimto(char *dest, const char *src, const size_t len) {
@@ -197,6 +304,668 @@ static int lua_unserialize_json(lua_State* L) {
 	return 0;
 }
 
+// single pass JSON decoder building the Lua tables in place, used by
+// JSON.decode in zenroom_json.lua. Follows the semantics of the pure
+// Lua raw_decode in json.lua: numbers are converted as by tonumber(),
+// null values are skipped, errors report line and column.
+typedef struct {
+	lua_State *L;
+	const char *start;
+	const char *p;
+	const char *end;
+	int depth;
+} json_dec;
+
+#define JSON_SPACE(c) ((c)==' ' || (c)=='\t' || (c)=='\r' || (c)=='\n')
+#define JSON_DELIM(c) (JSON_SPACE(c) || (c)==']' || (c)=='}' || (c)==',')
+
+static void json_error(json_dec *d, const char *at, const char *fmt, ...) {
+	char msg[MAX_LINE];
+	const char *c;
+	int line = 1, col = 1;
+	va_list arg;
+	va_start(arg, fmt);
+	mutt_vsnprintf(msg, MAX_LINE, fmt, arg);
+	va_end(arg);
+	for(c = d->start; c < at && c < d->end; c++) {
+		col++;
+		if(*c == '\n') { line++; col = 1; }
+	}
+	luaL_error(d->L, "The JSON input is not valid: %s at line %d col %d",
+		   msg, line, col);
+}
+
+static inline void json_skip_space(json_dec *d) {
+	while(d->p < d->end && JSON_SPACE(*d->p)) d->p++;
+}
+
+static int json_hex4(const char *s, const char *end) {
+	int i, n = 0;
+	if(end - s < 4) return -1;
+	for(i=0; i<4; i++) {
+		char c = s[i];
+		n <<= 4;
+		if(c >= '0' && c <= '9') n |= c - '0';
+		else if(c >= 'a' && c <= 'f') n |= c - 'a' + 10;
+		else if(c >= 'A' && c <= 'F') n |= c - 'A' + 10;
+		else return -1;
+	}
+	return n;
+}
+
+static void json_add_utf8(luaL_Buffer *b, unsigned int n) {
+	if(n <= 0x7f) {
+		luaL_addchar(b, n);
+	} else if(n <= 0x7ff) {
+		luaL_addchar(b, 0xc0 | (n >> 6));
+		luaL_addchar(b, 0x80 | (n & 0x3f));
+	} else if(n <= 0xffff) {
+		luaL_addchar(b, 0xe0 | (n >> 12));
+		luaL_addchar(b, 0x80 | ((n >> 6) & 0x3f));
+		luaL_addchar(b, 0x80 | (n & 0x3f));
+	} else {
+		luaL_addchar(b, 0xf0 | (n >> 18));
+		luaL_addchar(b, 0x80 | ((n >> 12) & 0x3f));
+		luaL_addchar(b, 0x80 | ((n >> 6) & 0x3f));
+		luaL_addchar(b, 0x80 | (n & 0x3f));
+	}
+}
+
+// d->p is on the opening quote, pushes the string
+static void json_string(json_dec *d) {
+	const char *open = d->p;
+	register const unsigned char *c = (const unsigned char*)open + 1;
+	const unsigned char *end = (const unsigned char*)d->end;
+	luaL_Buffer b;
+	// fast path: no escapes, push straight from the input
+	while(c < end && *c != '"' && *c != '\\' && *c >= 32) c++;
+	if(c < end && *c == '"') {
+		lua_pushlstring(d->L, open + 1, (const char*)c - open - 1);
+		d->p = (const char*)c + 1;
+		return;
+	}
+	luaL_buffinit(d->L, &b);
+	luaL_addlstring(&b, open + 1, (const char*)c - open - 1);
+	for(; c < end; c++) {
+		if(*c == '"') {
+			luaL_pushresult(&b);
+			d->p = (const char*)c + 1;
+			return;
+		}
+		if(*c < 32)
+			json_error(d, (const char*)c, "control character in string");
+		if(*c != '\\') { luaL_addchar(&b, *c); continue; }
+		if(++c >= end) break;
+		switch(*c) {
+		case '"': case '\\': case '/': luaL_addchar(&b, *c); break;
+		case 'b': luaL_addchar(&b, '\b'); break;
+		case 'f': luaL_addchar(&b, '\f'); break;
+		case 'n': luaL_addchar(&b, '\n'); break;
+		case 'r': luaL_addchar(&b, '\r'); break;
+		case 't': luaL_addchar(&b, '\t'); break;
+		case 'u': {
+			int n = json_hex4((const char*)c + 1, d->end), n2;
+			if(n < 0)
+				json_error(d, (const char*)c, "invalid unicode escape in string");
+			c += 4;
+			// surrogate pair
+			if(n >= 0xd800 && n <= 0xdbff && end - c > 6
+			   && c[1] == '\\' && c[2] == 'u'
+			   && (n2 = json_hex4((const char*)c + 3, d->end)) >= 0xdc00
+			   && n2 <= 0xdfff) {
+				n = ((n - 0xd800) << 10) + (n2 - 0xdc00) + 0x10000;
+				c += 6;
+			}
+			json_add_utf8(&b, n);
+			break; }
+		default:
+			json_error(d, (const char*)c, "invalid escape char '%c' in string", *c);
+		}
+	}
+	json_error(d, open, "expected closing quote for string");
+}
+
+// numbers and literals extend up to the next delimiter
+static size_t json_token(json_dec *d) {
+	const char *c = d->p;
+	while(c < d->end && !JSON_DELIM(*c)) c++;
+	return c - d->p;
+}
+
+static void json_number(json_dec *d) {
+	lua_State *L = d->L;
+	size_t len = json_token(d);
+	char num[64];
+	if(len < sizeof(num)) {
+		memcpy(num, d->p, len);
+		num[len] = '\0';
+		if(!lua_stringtonumber(L, num))
+			json_error(d, d->p, "invalid number '%s'", num);
+	} else {
+		lua_pushlstring(L, d->p, len);
+		if(!lua_stringtonumber(L, lua_tostring(L, -1))) {
+			memcpy(num, d->p, sizeof(num) - 4);
+			strcpy(&num[sizeof(num) - 4], "...");
+			json_error(d, d->p, "invalid number '%s'", num);
+		}
+		lua_remove(L, -2);
+	}
+	d->p += len;
+}
+
+static void json_literal(json_dec *d) {
+	size_t len = json_token(d);
+	char word[16];
+	if(len == 4 && strncmp(d->p, "true", 4) == 0)
+		lua_pushboolean(d->L, 1);
+	else if(len == 5 && strncmp(d->p, "false", 5) == 0)
+		lua_pushboolean(d->L, 0);
+	else if(len == 4 && strncmp(d->p, "null", 4) == 0)
+		lua_pushnil(d->L);
+	else {
+		if(len >= sizeof(word)) len = sizeof(word) - 1;
+		memcpy(word, d->p, len);
+		word[len] = '\0';
+		json_error(d, d->p, "invalid literal '%s'", word);
+	}
+	d->p += len;
+}
+
+static void json_value(json_dec *d);
+
+// fill the table on top of the stack, d->p is on the opening '{'
+static void json_object(json_dec *d) {
+	lua_State *L = d->L;
+	d->p++;
+	for(;;) {
+		json_skip_space(d);
+		if(d->p < d->end && *d->p == '}') { d->p++; return; }
+		if(d->p >= d->end || *d->p != '"')
+			json_error(d, d->p, "expected string for key");
+		json_string(d);
+		json_skip_space(d);
+		if(d->p >= d->end || *d->p != ':')
+			json_error(d, d->p, "expected ':' after key");
+		d->p++;
+		json_skip_space(d);
+		json_value(d);
+		lua_rawset(L, -3); // a nil value (null) leaves the key unset
+		json_skip_space(d);
+		if(d->p < d->end && *d->p == '}') { d->p++; return; }
+		if(d->p >= d->end || *d->p != ',')
+			json_error(d, d->p, "expected '}' or ','");
+		d->p++;
+	}
+}
+
+// fill the table on top of the stack, d->p is on the opening '['
+static void json_array(json_dec *d) {
+	lua_State *L = d->L;
+	lua_Integer n = 1;
+	d->p++;
+	for(;;) {
+		json_skip_space(d);
+		if(d->p < d->end && *d->p == ']') { d->p++; return; }
+		json_value(d);
+		if(lua_isnil(L, -1)) lua_pop(L, 1);
+		else lua_rawseti(L, -2, n);
+		n++;
+		json_skip_space(d);
+		if(d->p < d->end && *d->p == ']') { d->p++; return; }
+		if(d->p >= d->end || *d->p != ',')
+			json_error(d, d->p, "expected ']' or ','");
+		d->p++;
+	}
+}
+
+static void json_value(json_dec *d) {
+	if(d->p >= d->end)
+		json_error(d, d->p, "unexpected end of input");
+	switch(*d->p) {
+	case '{':
+	case '[':
+		if(++d->depth > MAX_DEPTH)
+			json_error(d, d->p, "maximum depth of %d levels exceeded", MAX_DEPTH);
+		luaL_checkstack(d->L, 4, "JSON decode nesting too deep");
+		lua_newtable(d->L);
+		if(*d->p == '{') json_object(d);
+		else json_array(d);
+		d->depth--;
+		break;
+	case '"':
+		json_string(d);
+		break;
+	case '-': case '0': case '1': case '2': case '3': case '4':
+	case '5': case '6': case '7': case '8': case '9':
+		json_number(d);
+		break;
+	case 't': case 'f': case 'n':
+		json_literal(d);
+		break;
+	default:
+		json_error(d, d->p, "unexpected character '%c'", *d->p);
+	}
+}
+
+// decode one or more concatenated JSON objects or arrays merging
+// their contents in a single table, returns nil if the input is not
+// made of tables
+static int lua_json_decode(lua_State* L) {
+	size_t size;
+	json_dec d;
+	d.L = L;
+	d.start = d.p = luaL_checklstring(L, 1, &size);
+	d.end = d.start + size;
+	d.depth = 0;
+	lua_newtable(L);
+	for(;;) {
+		while(d.p < d.end && (JSON_SPACE(*d.p) || *d.p == 0x0)) d.p++;
+		if(d.p >= d.end) break;
+		if(*d.p != '{' && *d.p != '[') {
+			func(L, "JSON doesn't starts with '{' nor '[', char found: %c (%02x)", *d.p, *d.p);
+			lua_pushnil(L);
+			return 1;
+		}
+		// top level blocks are decoded straight in the result table
+		d.depth = 1;
+		if(*d.p == '{') json_object(&d);
+		else json_array(&d);
+	}
+	return 1;
+}
+
+// single walk JSON encoder used by JSON.encode in zenroom_json.lua,
+// replaces INSPECT.process followed by the pure Lua raw_encode in
+// json.lua: zenroom types are exported while the table is walked,
+// without a deep copy, and the output is streamed in one buffer.
+// OCTET, ECP and ECP2 values are encoded here when the format is
+// one of the basic encodings, any other zenroom value is passed to
+// the Lua function returned by get_encoding_function(format).
+typedef enum { JSON_ENC_LUA, JSON_ENC_HEX, JSON_ENC_BASE64,
+	JSON_ENC_URL64, JSON_ENC_BASE58, JSON_ENC_STRING } json_encoding;
+
+typedef struct {
+	lua_State *L;
+	char *buf;
+	size_t len;
+	size_t max;
+	int bufidx; // stack index of the userdata holding buf
+	int visitidx; // tables being encoded, to detect circular references
+	int formatidx; // encoding name or function given by the caller
+	int convidx; // conversion function, resolved on first use
+	json_encoding fast;
+	int sorting;
+	int whitespace;
+	int depth;
+} json_enc;
+
+typedef struct {
+	const char *str;
+	size_t len;
+} json_key;
+
+// the buffer is a userdata on the stack, so that an error raised
+// while encoding leaves no memory behind
+static char *json_reserve(json_enc *e, size_t n) {
+	if(e->len + n > e->max) {
+		size_t max = e->max << 1;
+		char *nb;
+		while(max < e->len + n) max <<= 1;
+		nb = (char*)lua_newuserdatauv(e->L, max, 0);
+		memcpy(nb, e->buf, e->len);
+		lua_replace(e->L, e->bufidx);
+		e->buf = nb;
+		e->max = max;
+	}
+	return e->buf + e->len;
+}
+
+static inline void json_put(json_enc *e, const char *s, size_t len) {
+	memcpy(json_reserve(e, len), s, len);
+	e->len += len;
+}
+
+static inline void json_putc(json_enc *e, char c) {
+	*json_reserve(e, 1) = c;
+	e->len++;
+}
+
+// escapes the same characters as encode_string in json.lua
+static void json_put_string(json_enc *e, const char *s, size_t len) {
+	static const char hexes[] = "0123456789abcdef";
+	register const unsigned char *c = (const unsigned char*)s;
+	const unsigned char *end = c + len;
+	const unsigned char *run;
+	json_reserve(e, len + 2);
+	e->buf[e->len++] = '"';
+	while(c < end) {
+		run = c;
+		while(c < end && *c >= 32 && *c != '"' && *c != '\\') c++;
+		if(c > run) json_put(e, (const char*)run, c - run);
+		if(c == end) break;
+		switch(*c) {
+		case '"': json_put(e, "\\\"", 2); break;
+		case '\\': json_put(e, "\\\\", 2); break;
+		case '\b': json_put(e, "\\b", 2); break;
+		case '\f': json_put(e, "\\f", 2); break;
+		case '\n': json_put(e, "\\n", 2); break;
+		case '\r': json_put(e, "\\r", 2); break;
+		case '\t': json_put(e, "\\t", 2); break;
+		default: {
+			char u[6] = { '\\', 'u', '0', '0',
+				hexes[*c >> 4], hexes[*c & 0xf] };
+			json_put(e, u, 6); }
+		}
+		c++;
+	}
+	json_putc(e, '"');
+}
+
+// true if the value at idx is a zenroom type
+static int json_iszen(lua_State *L, int idx) {
+	const char *name;
+	int res = 0;
+	if(lua_type(L, idx) != LUA_TUSERDATA || !lua_getmetatable(L, idx))
+		return 0;
+	lua_getfield(L, -1, "__name");
+	name = lua_tostring(L, -1);
+	if(name && strstr(name, "zenroom")) res = 1;
+	lua_pop(L, 2);
+	return res;
+}
+
+// encode an OCTET, ECP or ECP2 value at idx, returns 0 when it
+// should be exported by the Lua conversion function instead
+static int json_put_octet(json_enc *e, int idx) {
+	lua_State *L = e->L;
+	const octet *o;
+	char *dst;
+	size_t sz;
+	if(e->fast == JSON_ENC_LUA) return 0;
+	if(!luaL_testudata(L, idx, "zenroom.octet")
+	   && !luaL_testudata(L, idx, "zenroom.ecp")
+	   && !luaL_testudata(L, idx, "zenroom.ecp2")) return 0;
+	o = o_arg(L, idx);
+	if(!o) return 0;
+	// base58 refuses short octets, leave the error to O.to_base58
+	if(e->fast == JSON_ENC_BASE58 && o->len > 0 && o->len < 3) {
+		o_free(L, o);
+		return 0;
+	}
+	if(o->len <= 0) { // exported as empty string
+		json_put(e, "\"\"", 2);
+		o_free(L, o);
+		return 1;
+	}
+	switch(e->fast) {
+	case JSON_ENC_STRING:
+		json_put_string(e, o->val, o->len);
+		break;
+	case JSON_ENC_HEX:
+		dst = json_reserve(e, (o->len << 1) + 2);
+		*dst = '"';
+		hex_encode(dst + 1, o->val, o->len);
+		e->len += (o->len << 1) + 1;
+		json_putc(e, '"');
+		break;
+	case JSON_ENC_BASE64:
+		dst = json_reserve(e, base64_len(o->len) + 2);
+		*dst = '"';
+		e->len += base64_encode(dst + 1, o->val, o->len) + 1;
+		json_putc(e, '"');
+		break;
+	case JSON_ENC_URL64:
+		dst = json_reserve(e, url64_len(o->len) + 2);
+		*dst = '"';
+		e->len += url64_encode(dst + 1, o->val, o->len) + 1;
+		json_putc(e, '"');
+		break;
+	case JSON_ENC_BASE58:
+		sz = o->len << 1;
+		dst = json_reserve(e, sz + 2);
+		*dst = '"';
+		b58enc(dst + 1, &sz, o->val, o->len);
+		e->len += strlen(dst + 1) + 1;
+		json_putc(e, '"');
+		break;
+	default:
+		break;
+	}
+	o_free(L, o);
+	return 1;
+}
+
+// replace the zenroom value on top of the stack with its export
+static void json_convert(json_enc *e) {
+	lua_State *L = e->L;
+	if(lua_isnil(L, e->convidx)) {
+		if(lua_type(L, e->formatidx) == LUA_TFUNCTION) {
+			lua_pushvalue(L, e->formatidx);
+		} else {
+			lua_getglobal(L, "get_encoding_function");
+			lua_pushvalue(L, e->formatidx);
+			lua_call(L, 1, 1);
+		}
+		if(lua_type(L, -1) != LUA_TFUNCTION)
+			luaL_error(L, "export_arr conversion function not configured");
+		lua_replace(L, e->convidx);
+	}
+	lua_pushvalue(L, e->convidx);
+	lua_insert(L, -2);
+	lua_call(L, 1, 1);
+}
+
+static int json_keycmp(const void *a, const void *b) {
+	const json_key *ka = (const json_key*)a;
+	const json_key *kb = (const json_key*)b;
+	size_t len = ka->len < kb->len ? ka->len : kb->len;
+	int res = memcmp(ka->str, kb->str, len);
+	if(res) return res;
+	return (ka->len > kb->len) - (ka->len < kb->len);
+}
+
+static void json_put_value(json_enc *e);
+
+// encode the value at top of the stack as an object member or array
+// element, converting zenroom values first. Returns 0 and pops the
+// value when the export is nil.
+static int json_put_member(json_enc *e, const char *key, size_t keylen,
+						   int first) {
+	lua_State *L = e->L;
+	int fast = 0;
+	if(json_iszen(L, -1)) {
+		// key and separator go first when the value is encoded in place
+		if(e->fast != JSON_ENC_LUA) {
+			size_t mark = e->len;
+			if(!first) json_put(e, e->whitespace ? ", " : ",", e->whitespace ? 2 : 1);
+			if(key) {
+				json_put_string(e, key, keylen);
+				json_put(e, e->whitespace ? ": " : ":", e->whitespace ? 2 : 1);
+			}
+			fast = json_put_octet(e, -1);
+			if(fast) { lua_pop(L, 1); return 1; }
+			e->len = mark;
+		}
+		json_convert(e);
+		if(lua_isnil(L, -1)) { lua_pop(L, 1); return 0; }
+		if(json_iszen(L, -1))
+			luaL_error(L, "unexpected type '%s'", luaL_typename(L, -1));
+	}
+	if(!first) json_put(e, e->whitespace ? ", " : ",", e->whitespace ? 2 : 1);
+	if(key) {
+		json_put_string(e, key, keylen);
+		json_put(e, e->whitespace ? ": " : ":", e->whitespace ? 2 : 1);
+	}
+	json_put_value(e);
+	return 1;
+}
+
+static void json_put_table(json_enc *e) {
+	lua_State *L = e->L;
+	const void *ptr = lua_topointer(L, -1);
+	int t = lua_gettop(L);
+	lua_Integer n = 0, i;
+	int array, first = 1;
+	if(++e->depth > MAX_DEPTH)
+		luaL_error(L, "JSON encode nesting deeper than %d levels", MAX_DEPTH);
+	luaL_checkstack(L, 8, "JSON encode nesting too deep");
+	if(lua_rawgetp(L, e->visitidx, ptr) != LUA_TNIL)
+		luaL_error(L, "circular reference");
+	lua_pop(L, 1);
+	lua_pushboolean(L, 1);
+	lua_rawsetp(L, e->visitidx, ptr);
+	array = (lua_rawgeti(L, t, 1) != LUA_TNIL);
+	lua_pop(L, 1);
+	lua_pushnil(L);
+	if(!lua_next(L, t)) array = 1; // empty table
+	else lua_pop(L, 2);
+	if(array) {
+		lua_pushnil(L);
+		while(lua_next(L, t)) {
+			if(lua_type(L, -2) != LUA_TNUMBER)
+				luaL_error(L, "invalid table: mixed or invalid key types");
+			n++;
+			lua_pop(L, 1);
+		}
+		if(n != (lua_Integer)lua_rawlen(L, t))
+			luaL_error(L, "invalid table: sparse array (n=%d, #val=%d)",
+					   (int)n, (int)lua_rawlen(L, t));
+		json_putc(e, '[');
+		for(i = 1; i <= n; i++) {
+			lua_rawgeti(L, t, i);
+			if(!json_put_member(e, NULL, 0, first))
+				luaL_error(L, "invalid table: sparse array (n=%d, #val=%d)",
+						   (int)n, (int)n);
+			first = 0;
+		}
+		json_putc(e, ']');
+	} else if(e->sorting) {
+		json_key *keys;
+		size_t k = 0, nkeys = 0;
+		lua_pushnil(L);
+		while(lua_next(L, t)) { nkeys++; lua_pop(L, 1); }
+		keys = (json_key*)lua_newuserdatauv(L, nkeys * sizeof(json_key), 0);
+		lua_pushnil(L);
+		while(lua_next(L, t)) {
+			if(lua_type(L, -2) != LUA_TSTRING)
+				luaL_error(L, "invalid table: mixed or invalid key types");
+			// key strings are kept alive by the table itself
+			keys[k].str = lua_tolstring(L, -2, &keys[k].len);
+			k++;
+			lua_pop(L, 1);
+		}
+		qsort(keys, nkeys, sizeof(json_key), json_keycmp);
+		json_putc(e, '{');
+		for(k = 0; k < nkeys; k++) {
+			lua_pushlstring(L, keys[k].str, keys[k].len);
+			lua_rawget(L, t);
+			if(json_put_member(e, keys[k].str, keys[k].len, first))
+				first = 0;
+		}
+		json_putc(e, '}');
+		lua_pop(L, 1); // keys
+	} else {
+		const char *key;
+		size_t keylen;
+		json_putc(e, '{');
+		lua_pushnil(L);
+		while(lua_next(L, t)) {
+			if(lua_type(L, -2) != LUA_TSTRING)
+				luaL_error(L, "invalid table: mixed or invalid key types");
+			key = lua_tolstring(L, -2, &keylen);
+			if(json_put_member(e, key, keylen, first)) first = 0;
+		}
+		json_putc(e, '}');
+	}
+	lua_pushnil(L);
+	lua_rawsetp(L, e->visitidx, ptr);
+	e->depth--;
+	lua_pop(L, 1);
+}
+
+// encode and pop the value on top of the stack
+static void json_put_value(json_enc *e) {
+	lua_State *L = e->L;
+	const char *s;
+	size_t len;
+	switch(lua_type(L, -1)) {
+	case LUA_TNIL:
+		json_put(e, "null", 4);
+		break;
+	case LUA_TBOOLEAN:
+		if(lua_toboolean(L, -1)) json_put(e, "true", 4);
+		else json_put(e, "false", 5);
+		break;
+	case LUA_TSTRING:
+		s = lua_tolstring(L, -1, &len);
+		json_put_string(e, s, len);
+		break;
+	case LUA_TNUMBER:
+		if(!lua_isinteger(L, -1)) {
+			lua_Number n = lua_tonumber(L, -1);
+			if(n != n || n == HUGE_VAL || n == -HUGE_VAL)
+				luaL_error(L, "Not a number: %s", luaL_tolstring(L, -1, NULL));
+		}
+		// same format as tostring()
+		s = luaL_tolstring(L, -1, &len);
+		json_put(e, s, len);
+		lua_pop(L, 1);
+		break;
+	case LUA_TTABLE:
+		json_put_table(e);
+		return;
+	case LUA_TFUNCTION: {
+		// the address printed by tostring()
+		const char *sp;
+		s = luaL_tolstring(L, -1, &len);
+		sp = strrchr(s, ' ');
+		if(sp) { len -= (sp + 1 - s); s = sp + 1; }
+		json_putc(e, '"');
+		json_put(e, s, len);
+		json_putc(e, '"');
+		lua_pop(L, 1);
+		break; }
+	default:
+		luaL_error(L, "unexpected type '%s'", luaL_typename(L, -1));
+	}
+	lua_pop(L, 1);
+}
+
+// jsonencode(table, format, sorting, whitespace) format may be an
+// encoding name or a conversion function for zenroom values
+static int lua_json_encode(lua_State* L) {
+	json_enc e;
+	const char *format;
+	luaL_checktype(L, 1, LUA_TTABLE);
+	e.L = L;
+	e.sorting = lua_toboolean(L, 3);
+	e.whitespace = lua_toboolean(L, 4);
+	e.depth = 0;
+	e.fast = JSON_ENC_LUA;
+	format = lua_type(L, 2) == LUA_TSTRING ? lua_tostring(L, 2) : NULL;
+	if(format) {
+		if(strcmp(format, "hex") == 0) e.fast = JSON_ENC_HEX;
+		else if(strcmp(format, "base64") == 0) e.fast = JSON_ENC_BASE64;
+		else if(strcmp(format, "url64") == 0) e.fast = JSON_ENC_URL64;
+		else if(strcmp(format, "base58") == 0) e.fast = JSON_ENC_BASE58;
+		else if(strcmp(format, "string") == 0) e.fast = JSON_ENC_STRING;
+	}
+	lua_settop(L, 2);
+	e.formatidx = 2;
+	lua_pushnil(L);
+	e.convidx = 3;
+	lua_newtable(L);
+	e.visitidx = 4;
+	e.max = 1024;
+	e.len = 0;
+	e.buf = (char*)lua_newuserdatauv(L, e.max, 0);
+	e.bufidx = 5;
+	lua_pushvalue(L, 1);
+	json_put_table(&e);
+	lua_pushlstring(L, e.buf, e.len);
+	return 1;
+}
+
 // removed because of unexplained segfault when used inside pcall to
 // parse zencode: set_rule and set_scenario will explode, also seems
 // to perform worse than pure Lua (see PR #709)
@@ -279,10 +1048,13 @@ void zen_add_parse(lua_State *L) {
 	// override print() and io.write()
 	static const struct luaL_Reg custom_parser [] =
 		{ {"parse_prefix", lua_parse_prefix},
+		  {"zencode_statement", lua_zencode_statement},
 		  {"strcasecmp", lua_strcasecmp},
 		  {"trim", lua_trim_spaces},
 		  {"trimq", lua_trim_quotes},
 		  {"jsontok", lua_unserialize_json},
+		  {"jsondecode", lua_json_decode},
+		  {"jsonencode", lua_json_encode},
 		  {"zencode_scenarios", lua_list_scenarios},
 		  {NULL, NULL} };
 	lua_getglobal(L, "_G");
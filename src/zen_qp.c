@@ -127,6 +127,23 @@ extern int pqcrystals_ml_dsa_44_zen_keypair(uint8_t *pk, uint8_t *sk, const uint
 extern int pqcrystals_ml_dsa_44_zen_signature(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *ctx, size_t ctxlen, const uint8_t *sk, const uint8_t *randbytes);
 extern int pqcrystals_ml_dsa_44_ref_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *ctx, size_t ctxlen, const uint8_t *pk);
 extern int pqcrystals_ml_dsa_44_zen_pub_gen(uint8_t *pk, uint8_t *sk);
+extern int pqcrystals_ml_dsa_44_zen_verify_batch(const uint8_t *pk, size_t n,
+	const uint8_t **sigs, const size_t *siglens,
+	const uint8_t **ms, const size_t *mlens,
+	const uint8_t *ctx, size_t ctxlen, int *valid);
+
+/*
+  Vectorized backends of ML-KEM and ML-DSA-44, see QP.backend
+*/
+#define QP_C    0
+#define QP_AVX2 1
+extern int pqclean_backend(int max);
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+#define QP_X86
+extern int mlkem512_x86_64_backend(int max);
+extern int mlkem768_x86_64_backend(int max);
+extern int mlkem1024_x86_64_backend(int max);
+#endif
 
 
 /*#######################################*/
@@ -1090,6 +1107,165 @@ end:
 	END(1);
 }
 
+// sizes and functions of each ML-KEM type, indexed by mlkem_type
+static const struct {
+	int pk, sk, ct;
+	int (*enc)(uint8_t *ct, uint8_t *ss, const uint8_t *pk, const uint8_t *coins);
+	int (*dec)(uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
+} mlkem_params[] = {
+	{ MLKEM512_PUBLICKEYBYTES, MLKEM512_SECRETKEYBYTES, MLKEM512_CIPHERTEXTBYTES,
+	  mlkem512_enc_derand, mlkem512_dec },
+	{ MLKEM768_PUBLICKEYBYTES, MLKEM768_SECRETKEYBYTES, MLKEM768_CIPHERTEXTBYTES,
+	  mlkem768_enc_derand, mlkem768_dec },
+	{ MLKEM1024_PUBLICKEYBYTES, MLKEM1024_SECRETKEYBYTES, MLKEM1024_CIPHERTEXTBYTES,
+	  mlkem1024_enc_derand, mlkem1024_dec }
+};
+
+/*
+  Encapsulate a secret for each public key in a table, optionally
+  followed by the ML-KEM type (default mlkem512). Returns a table of
+  { secret, cipher } in the same order.
+*/
+static int mlkem_enc_batch(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	const octet *pk = NULL;
+	octet *ss, *ct;
+	uint8_t randbytes[32];
+	int i, j, n;
+	const char *s = luaL_optstring(L, 2, "mlkem512");
+	mlkem_type t = _get_mlkem_type(s);
+	if(t == UNKNOWN) {
+		zerror(L, "Unknown MLKEM type: %s (%s)", s, __func__);
+		failed_msg = "MLKEM error";
+		goto end;
+	}
+	if(!lua_istable(L, 1)) {
+		failed_msg = "MLKEM batch encapsulation needs a table of public keys";
+		goto end;
+	}
+	n = lua_rawlen(L, 1);
+	Z(L);
+	lua_createtable(L, n, 0);
+	for(i = 1; i <= n; i++) {
+		lua_rawgeti(L, 1, i);
+		pk = o_arg(L, -1);
+		lua_pop(L, 1);
+		if(pk == NULL) {
+			failed_msg = "Could not allocate public key";
+			goto end;
+		}
+		if(pk->len != mlkem_params[t].pk) {
+			failed_msg = "invalid size for public key";
+			goto end;
+		}
+		lua_createtable(L, 0, 2);
+		ss = o_new(L, MLKEM_BYTES);
+		if(ss == NULL) {
+			failed_msg = "Could not allocate kem secret";
+			goto end;
+		}
+		lua_setfield(L, -2, "secret");
+		ct = o_new(L, mlkem_params[t].ct);
+		if(ct == NULL) {
+			failed_msg = "Could not allocate kem ciphertext";
+			goto end;
+		}
+		lua_setfield(L, -2, "cipher");
+		for(j = 0; j < 32; j++) {
+			randbytes[j] = RAND_byte(Z->random_generator);
+		}
+		if(mlkem_params[t].enc((unsigned char*)ct->val,
+							   (unsigned char*)ss->val,
+							   (unsigned char*)pk->val,
+							   randbytes)) {
+			failed_msg = "error in the creation of the shared secret";
+			goto end;
+		}
+		ss->len = MLKEM_BYTES;
+		ct->len = mlkem_params[t].ct;
+		lua_rawseti(L, -2, i);
+		o_free(L, pk);
+		pk = NULL;
+	}
+end:
+	o_free(L, pk);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
+/*
+  Decapsulate with one secret key all the ciphertexts in a table,
+  optionally followed by the ML-KEM type (default mlkem512). Returns
+  the table of shared secrets in the same order.
+*/
+static int mlkem_dec_batch(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	const octet *sk = NULL, *ct = NULL;
+	octet *ss;
+	int i, n;
+	const char *s = luaL_optstring(L, 3, "mlkem512");
+	mlkem_type t = _get_mlkem_type(s);
+	if(t == UNKNOWN) {
+		zerror(L, "Unknown MLKEM type: %s (%s)", s, __func__);
+		failed_msg = "MLKEM error";
+		goto end;
+	}
+	sk = o_arg(L, 1);
+	if(sk == NULL) {
+		failed_msg = "Could not allocate secret key";
+		goto end;
+	}
+	if(sk->len != mlkem_params[t].sk) {
+		failed_msg = "invalid size for secret key";
+		goto end;
+	}
+	if(!lua_istable(L, 2)) {
+		failed_msg = "MLKEM batch decapsulation needs a table of ciphertexts";
+		goto end;
+	}
+	n = lua_rawlen(L, 2);
+	lua_createtable(L, n, 0);
+	for(i = 1; i <= n; i++) {
+		lua_rawgeti(L, 2, i);
+		ct = o_arg(L, -1);
+		lua_pop(L, 1);
+		if(ct == NULL) {
+			failed_msg = "Could not allocate kem ciphertext";
+			goto end;
+		}
+		if(ct->len != mlkem_params[t].ct) {
+			failed_msg = "invalid size for ciphertext key";
+			goto end;
+		}
+		ss = o_new(L, MLKEM_BYTES);
+		if(ss == NULL) {
+			failed_msg = "Could not allocate kem secret";
+			goto end;
+		}
+		if(mlkem_params[t].dec((unsigned char*)ss->val,
+							   (unsigned char*)ct->val,
+							   (unsigned char*)sk->val)) {
+			failed_msg = "error in while deciphering the shared secret";
+			goto end;
+		}
+		ss->len = MLKEM_BYTES;
+		lua_rawseti(L, -2, i);
+		o_free(L, ct);
+		ct = NULL;
+	}
+end:
+	o_free(L, ct);
+	o_free(L, sk);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(1);
+}
+
 
 /*#######################################*/
 /*              SNTRUP 761               */
@@ -1508,6 +1684,100 @@ end:
 	END(1);
 }
 
+/*
+  Verify a batch of signatures by the same public key, given the key,
+  a table of signatures, a table of messages of the same length and
+  optionally a context. The matrix of the public key is expanded only
+  once. Returns true when all signatures are valid, false otherwise
+  and a table with the indexes of the invalid ones.
+*/
+static int ml_dsa_44_verify_batch(lua_State *L) {
+	BEGIN();
+	char *failed_msg = NULL;
+	const octet *pk = NULL, *ctx = NULL;
+	const octet **o = NULL; // n signatures, n messages
+	const uint8_t **ptr = NULL;
+	size_t *len = NULL;
+	int *valid = NULL;
+	int i, j, n = 0;
+	pk = o_arg(L, 1);
+	if(pk == NULL) {
+		failed_msg = "Could not allocate space for public key";
+		goto end;
+	}
+	if(pk->len != pqcrystals_ml_dsa_44_PUBLICKEYBYTES) {
+		failed_msg = "invalid size for public key";
+		goto end;
+	}
+	if(!lua_istable(L, 2) || !lua_istable(L, 3)) {
+		failed_msg = "ML-DSA-44 batch verification needs two tables";
+		goto end;
+	}
+	n = lua_rawlen(L, 2);
+	if(n != (int)lua_rawlen(L, 3)) {
+		failed_msg = "ML-DSA-44 batch verification tables differ in length";
+		goto end;
+	}
+	o = calloc(2 * n + 1, sizeof(octet*));
+	ptr = malloc(sizeof(uint8_t*) * (2 * n + 1));
+	len = malloc(sizeof(size_t) * (2 * n + 1));
+	valid = malloc(sizeof(int) * (n + 1));
+	if(!o || !ptr || !len || !valid) {
+		failed_msg = "Could not allocate ML-DSA-44 batch";
+		goto end;
+	}
+	for(j = 0; j < 2; j++) {
+		for(i = 0; i < n; i++) {
+			lua_rawgeti(L, j+2, i+1);
+			o[j*n+i] = o_arg(L, -1);
+			lua_pop(L, 1);
+			if(!o[j*n+i]) {
+				failed_msg = "Could not allocate ML-DSA-44 batch argument";
+				goto end;
+			}
+			ptr[j*n+i] = (const uint8_t*)o[j*n+i]->val;
+			len[j*n+i] = o[j*n+i]->len;
+		}
+	}
+	if(!lua_isnoneornil(L, 4)) {
+		ctx = o_arg(L, 4);
+		if(ctx == NULL) {
+			failed_msg = "Could not allocate ML-DSA-44 batch ctx";
+			goto end;
+		}
+	}
+	if(ctx && ctx->len > 255) {
+		failed_msg = "Wrong ctx size";
+		goto end;
+	}
+	pqcrystals_ml_dsa_44_zen_verify_batch((const uint8_t*)pk->val, n,
+					      &ptr[0], &len[0], &ptr[n], &len[n],
+					      ctx ? (const uint8_t*)ctx->val : NULL,
+					      ctx ? ctx->len : 0, valid);
+	lua_newtable(L);
+	for(i = 0, j = 1; i < n; i++) {
+		if(valid[i]) continue;
+		lua_pushinteger(L, i+1);
+		lua_rawseti(L, -2, j++);
+	}
+	lua_pushboolean(L, j == 1);
+	lua_insert(L, -2);
+end:
+	if(o) {
+		for(i = 0; i < 2 * n; i++) o_free(L, o[i]);
+	}
+	free(o);
+	free(ptr);
+	free(len);
+	free(valid);
+	o_free(L, ctx);
+	o_free(L, pk);
+	if(failed_msg) {
+		THROW(failed_msg);
+	}
+	END(2);
+}
+
 static int mldsa44_signature_pubcheck(lua_State *L) {
 	BEGIN();
 	const octet *pk = o_arg(L, 1);
@@ -1544,6 +1814,37 @@ end:
 }
 
 
+/*
+   Tells which implementation of ML-KEM and ML-DSA-44 is in use,
+   'avx2' or 'c', and if a name is given switches to it when the cpu
+   supports it. Both give the same output.
+
+   @param[opt] name of the implementation to use
+   @function backend(name)
+   @return name of the implementation in use
+*/
+static int qp_set_backend(lua_State *L) {
+	BEGIN();
+	static const char *names[] = { "c", "avx2" };
+	const char *name = luaL_optstring(L, 1, NULL);
+	int level = -1;
+	if(name) {
+		if(strcmp(name, "avx2") == 0) level = QP_AVX2;
+		else if(strcmp(name, "c") == 0) level = QP_C;
+		else {
+			THROW("QP.backend accepts 'avx2' or 'c'");
+		}
+	}
+	level = pqclean_backend(level);
+#ifdef QP_X86
+	mlkem512_x86_64_backend(level);
+	mlkem768_x86_64_backend(level);
+	mlkem1024_x86_64_backend(level);
+#endif
+	lua_pushstring(L, names[level]);
+	END(1);
+}
+
 int luaopen_qp(lua_State *L) {
 	(void)L;
 	const struct luaL_Reg qp_class[] = {
@@ -1573,6 +1874,8 @@ int luaopen_qp(lua_State *L) {
 		{"mlkem_ctcheck",  mlkem_ctcheck},
 		{"mlkem_enc",      mlkem_enc},
 		{"mlkem_dec",      mlkem_dec},
+		{"mlkem_enc_batch", mlkem_enc_batch},
+		{"mlkem_dec_batch", mlkem_dec_batch},
 		// SNTRUP761
 		{"ntrup_keygen", qp_sntrup_kem_keygen},
 		{"ntrup_pubgen", qp_sntrup_kem_pubgen},
@@ -1585,9 +1888,11 @@ int luaopen_qp(lua_State *L) {
 		{"mldsa44_keypair",   ml_dsa_44_keypair},
 		{"mldsa44_signature", ml_dsa_44_signature},
 		{"mldsa44_verify",    ml_dsa_44_verify},
+		{"mldsa44_verify_batch", ml_dsa_44_verify_batch},
 		{"mldsa44_pubgen", ml_dsa_44_signature_pubgen},
 		{"mldsa44_pubcheck", mldsa44_signature_pubcheck},
 		{"mldsa44_signature_check", mldsa44_signature_check},
+		{"backend", qp_set_backend},
 		{NULL,NULL}
 	};
 	const struct luaL_Reg qp_methods[] = {
@@ -50,13 +50,8 @@
 #include <zen_octet.h>
 #include <randombytes.h>
 
-void* rng_alloc(zenroom_t *ZZ) {
-	RNG *rng = (RNG*)malloc(sizeof(csprng));
-	if(!rng) {
-		_err( "Error allocating new random number generator");
-		return NULL;
-	}
-
+// gather a new random seed from the system, unless provided externally
+static void rng_gather_seed(zenroom_t *ZZ) {
 	// random seed provided externally 
 	if(ZZ->random_external) {
 #ifndef ARCH_CORTEX
@@ -71,6 +66,23 @@ void* rng_alloc(zenroom_t *ZZ) {
 		ZZ->random_seed[63] =  ttmp & 0xff;
 #endif
 	}
+}
+
+// pre-fill runtime_random used in init
+static void rng_preroll(zenroom_t *Z) {
+	register int i;
+	register char *p = Z->runtime_random256;
+	for(i=0;i<PRNG_PREROLL;i++,p++)
+	  *p = RAND_byte(Z->random_generator);
+}
+
+void* rng_alloc(zenroom_t *ZZ) {
+	RNG *rng = (RNG*)malloc(sizeof(csprng));
+	if(!rng) {
+		_err( "Error allocating new random number generator");
+		return NULL;
+	}
+	rng_gather_seed(ZZ);
 	// RAND_seed is destructive, preserve seed here
 	char tseed[RANDOM_SEED_LEN];
 	memcpy(tseed,ZZ->random_seed,RANDOM_SEED_LEN);
@@ -79,6 +91,22 @@ void* rng_alloc(zenroom_t *ZZ) {
 	return(rng);
 }
 
+// reseed the generator of an already initialized VM (zen_pool_exec)
+// reproducing the same random stream of a fresh zen_init: 4 bytes
+// are taken by lua_newstate for its string hash seed, then the
+// PRNG_PREROLL bytes of runtime_random256 by zen_add_random
+void rng_reseed(zenroom_t *ZZ) {
+	rng_gather_seed(ZZ);
+	char tseed[RANDOM_SEED_LEN];
+	memcpy(tseed,ZZ->random_seed,RANDOM_SEED_LEN);
+	AMCL_(RAND_seed)(ZZ->random_generator, RANDOM_SEED_LEN, tseed);
+	RAND_byte(ZZ->random_generator);
+	RAND_byte(ZZ->random_generator);
+	RAND_byte(ZZ->random_generator);
+	RAND_byte(ZZ->random_generator);
+	rng_preroll(ZZ);
+}
+
 
 static int rng_uint8(lua_State *L) {
 	BEGIN();
@@ -156,12 +184,5 @@ void zen_add_random(lua_State *L) {
 	lua_pop(L, 1);
 	zenroom_t *Z = NULL;
 	void *_zv; lua_getallocf(L, &_zv); Z = _zv;
-	{ // pre-fill runtime_random
-		// used in
-		register int i;
-		register char *p = Z->runtime_random256;
-		for(i=0;i<PRNG_PREROLL;i++,p++)
-		  *p = RAND_byte(Z->random_generator);
-	}
-
+	rng_preroll(Z);
 }
@@ -27,10 +27,19 @@
 #include <amcl.h>
 #include <rsa_4096.h>
 
+// BIG type of the 4096 bits finite field depends on milagro's limb size
+#if CHUNK==64
+#define RSA_4096_BIG BIG_512_60
+#define RSA_4096_MODBYTES MODBYTES_512_60
+#else
+#define RSA_4096_BIG BIG_512_29
+#define RSA_4096_MODBYTES MODBYTES_512_29
+#endif
+
 #define RSA_4096_PRIVATE_KEY_BIG_SIZE FFLEN_4096 / 2
-#define RSA_4096_PRIVATE_KEY_BIG_BYTES MODBYTES_512_29 * FFLEN_4096 / 2
+#define RSA_4096_PRIVATE_KEY_BIG_BYTES RSA_4096_MODBYTES * FFLEN_4096 / 2
 #define RSA_4096_PRIVATE_KEY_BYTES  5 *RSA_4096_PRIVATE_KEY_BIG_BYTES
-#define RSA_4096_PUBLIC_KEY_BYTES MODBYTES_512_29*FFLEN_4096+4
+#define RSA_4096_PUBLIC_KEY_BYTES RSA_4096_MODBYTES*FFLEN_4096+4
 #define RSA_4096_PUBLIC_EXPONENT (int32_t) 65537
 
 void RSA_sk_to_octet(lua_State *L, rsa_private_key_4096 *sk, octet *o) {
@@ -58,7 +67,7 @@ void RSA_octet_to_pk(lua_State *L, octet *o, rsa_public_key_4096 *pk){
 	octet *x = o_alloc(L,o->len);
 	OCT_copy(x, o);
 	FF_4096_fromOctet(pk->n, x, FFLEN_4096);
-	OCT_shl(x, MODBYTES_512_29 * FFLEN_4096);
+	OCT_shl(x, RSA_4096_MODBYTES * FFLEN_4096);
 	pk->e =  ((uint32_t)x->val[3] & 0xFF) |
 		((uint32_t)x->val[2] << 8 & 0xFF00) |
 		((uint32_t)x->val[1] << 16 & 0xFF0000) |
@@ -66,17 +75,24 @@ void RSA_octet_to_pk(lua_State *L, octet *o, rsa_public_key_4096 *pk){
 	o_free(L,x);
 }
 
-void RSA_octet_to_sk(octet *o, rsa_private_key_4096 *sk){
-	FF_4096_fromOctet(sk->p, o, RSA_4096_PRIVATE_KEY_BIG_SIZE);
-	OCT_shl(o, RSA_4096_PRIVATE_KEY_BIG_BYTES);
-	FF_4096_fromOctet(sk->q, o, RSA_4096_PRIVATE_KEY_BIG_SIZE);
-	OCT_shl(o, RSA_4096_PRIVATE_KEY_BIG_BYTES);
-	FF_4096_fromOctet(sk->dp, o, RSA_4096_PRIVATE_KEY_BIG_SIZE);
-	OCT_shl(o, RSA_4096_PRIVATE_KEY_BIG_BYTES);
-	FF_4096_fromOctet(sk->dq, o, RSA_4096_PRIVATE_KEY_BIG_SIZE);
-	OCT_shl(o, RSA_4096_PRIVATE_KEY_BIG_BYTES);
-	FF_4096_fromOctet(sk->c, o, RSA_4096_PRIVATE_KEY_BIG_SIZE);
-	OCT_shl(o, RSA_4096_PRIVATE_KEY_BIG_BYTES);
+// returns 0 when the private copy cannot be allocated
+int RSA_octet_to_sk(lua_State *L, const octet *o, rsa_private_key_4096 *sk){
+	// the argument may share its payload, shift a private copy
+	octet *x = o_alloc(L,o->len);
+	if(x == NULL) return 0;
+	OCT_copy(x, (octet*)o);
+	FF_4096_fromOctet(sk->p, x, RSA_4096_PRIVATE_KEY_BIG_SIZE);
+	OCT_shl(x, RSA_4096_PRIVATE_KEY_BIG_BYTES);
+	FF_4096_fromOctet(sk->q, x, RSA_4096_PRIVATE_KEY_BIG_SIZE);
+	OCT_shl(x, RSA_4096_PRIVATE_KEY_BIG_BYTES);
+	FF_4096_fromOctet(sk->dp, x, RSA_4096_PRIVATE_KEY_BIG_SIZE);
+	OCT_shl(x, RSA_4096_PRIVATE_KEY_BIG_BYTES);
+	FF_4096_fromOctet(sk->dq, x, RSA_4096_PRIVATE_KEY_BIG_SIZE);
+	OCT_shl(x, RSA_4096_PRIVATE_KEY_BIG_BYTES);
+	FF_4096_fromOctet(sk->c, x, RSA_4096_PRIVATE_KEY_BIG_SIZE);
+	OCT_clear(x);
+	o_free(L,x);
+	return 1;
 }
 
 static int rsa_keypair(lua_State *L)   {
@@ -100,21 +116,17 @@ static int rsa_keypair(lua_State *L)   {
 		void *p =luaL_testudata(L,1,"zenroom.octet");
 		void* q =luaL_testudata(L,2,"zenroom.octet");
 		if ((p) && (q)){
-			octet *P = o_alloc(L, sizeof(p));
-			P = (octet*) p;
+			octet *P = (octet*) p;
 			if (P->len > RSA_4096_PRIVATE_KEY_BIG_BYTES) {
 				failed_msg = "Wrong prime size";
 				goto end;
 			}
-			octet *Q = o_alloc(L, sizeof(q));
-			Q = (octet*) q;
+			octet *Q = (octet*) q;
 			if (Q->len > RSA_4096_PRIVATE_KEY_BIG_BYTES) {
 				failed_msg = "Wrong prime size";
 				goto end;
 			}
 			RSA_4096_KEY_PAIR(NULL, RSA_4096_PUBLIC_EXPONENT, &priv , &pub ,P, Q);
-			o_free(L,P);
-			o_free(L,Q);
 		}
 	} else if (lua_gettop(L)==3){
 		if(!lua_isinteger(L,1)) {
@@ -125,21 +137,17 @@ static int rsa_keypair(lua_State *L)   {
 		void *p =luaL_testudata(L,2,"zenroom.octet");
 		void* q =luaL_testudata(L,3,"zenroom.octet");
 		if ((p) && (q)){
-			octet *P = o_alloc(L, sizeof(p));
-			P = (octet*) p;
+			octet *P = (octet*) p;
 			if (P->len > RSA_4096_PRIVATE_KEY_BIG_BYTES) {
 				failed_msg = "Wrong prime size";
 				goto end;
 			}
-			octet *Q = o_alloc(L, sizeof(q));
-			Q = (octet*) q;
+			octet *Q = (octet*) q;
 			if (Q->len > RSA_4096_PRIVATE_KEY_BIG_BYTES) {
 				failed_msg = "Wrong prime size";
 				goto end;
 			}
 			RSA_4096_KEY_PAIR(NULL, e, &priv , &pub ,P, Q);
-			o_free(L,P);
-			o_free(L,Q);
 		}
 	} else {
 		Z(L);
@@ -175,7 +183,7 @@ end:
 static int rsa_pubgen(lua_State *L){
 	BEGIN();
 	char *failed_msg = NULL;
-	BIG_512_29 p[HFLEN_4096], e[HFLEN_4096], n[FFLEN_4096];
+	RSA_4096_BIG p[HFLEN_4096], e[HFLEN_4096], n[FFLEN_4096];
 	octet *octet_sk = NULL, *e_octet = NULL;
 
 	octet_sk = o_arg(L, 1);
@@ -186,7 +194,10 @@ static int rsa_pubgen(lua_State *L){
 
 	rsa_private_key_4096 sk;
 
-	RSA_octet_to_sk(octet_sk, &sk);
+	if(!RSA_octet_to_sk(L, octet_sk, &sk)) {
+		failed_msg = "Could not allocate a copy of the secret key";
+		goto end;
+	}
 
 	FF_4096_mul(n, (&sk)->p ,(&sk)->q, HFLEN_4096);
 	FF_4096_copy(p,(&sk)->p,HFLEN_4096);
@@ -312,7 +323,10 @@ static int rsa_decrypt(lua_State *L) {
 	}
 
 	rsa_private_key_4096 sk; 
-	RSA_octet_to_sk(octet_sk, &sk);
+	if(!RSA_octet_to_sk(L, octet_sk, &sk)) {
+		failed_msg = "Could not allocate a copy of the secret key";
+		goto end;
+	}
 	octet *p = o_new(L, RFS_4096);
 	RSA_4096_DECRYPT(&sk, c, p);
 	OAEP_DECODE(HASH_TYPE_RSA_4096,NULL,p);
@@ -346,7 +360,10 @@ static int rsa_sign(lua_State *L) {
 	}
 
 	rsa_private_key_4096 sk; 
-	RSA_octet_to_sk(octet_sk, &sk);
+	if(!RSA_octet_to_sk(L, octet_sk, &sk)) {
+		failed_msg = "Could not allocate a copy of the secret key";
+		goto end;
+	}
 	p = o_alloc(L, RFS_4096);
 	octet *sig = o_new(L,RFS_4096);
 	PKCS15(HASH_TYPE_RSA_4096,msg,p);
@@ -22,14 +22,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <errno.h>
 
 #include <zenroom.h>
+#include <encoding.h>
+#include <amcl.h>
 
 #if !defined(ARCH_WIN)
 #include <sys/poll.h>
+#include <unistd.h>
 #endif
 
+// size of the stdout and stderr buffers of each job in serve mode
+#define SERVE_BUF (MAX_OCTET<<1)
+
 static void _getline(char *in) {
 	register int ret;
 	if( ! fgets(in, MAX_FILE, stdin) ) { in[0]=0x0; return; }
@@ -47,12 +54,286 @@ static void _getline(char *in) {
 	exit(EXIT_FAILURE);
 }
 
+#if !defined(ARCH_WIN)
+// reads one newline terminated line of any length, removing the
+// ending LF or CRLF. returns -1 on end of stream
+static ssize_t _serve_getline(char **line, size_t *size) {
+	ssize_t ret = getline(line, size, stdin);
+	if(ret<0) return -1;
+	if(ret>0 && (*line)[ret-1]=='\n') (*line)[--ret] = 0x0;
+	if(ret>0 && (*line)[ret-1]=='\r') (*line)[--ret] = 0x0;
+	return ret;
+}
+
+// decodes a base64 line into a new string, NULL when empty
+static char *_serve_decode(const char *b64, ssize_t len) {
+	if(len<=0) return NULL;
+	char *res = malloc(B64decoded_len(len)+1);
+	U64decode(res, b64);
+	return res;
+}
+
+// header of each result frame followed by the stdout and stderr
+// contents, the two sizes are in bytes
+static void _serve_result(int exitcode, const char *out, const char *err) {
+	size_t outlen = out ? strlen(out) : 0;
+	size_t errlen = err ? strlen(err) : 0;
+	fprintf(stdout, "%i %zu %zu\n", exitcode, outlen, errlen);
+	if(outlen) fwrite(out, 1, outlen, stdout);
+	if(errlen) fwrite(err, 1, errlen, stdout);
+	fflush(stdout);
+}
+
+// contracts kept in serve mode, replaced in order of insertion when
+// full. A script is compiled only once seen again or referenced by
+// its digest, the first job runs it as it is
+#define SERVE_COMPILED 256
+typedef struct {
+	char *conf;
+	char *script; // NULL when loaded from the cache directory
+	char digest[68]; // sha256 of the script, hex encoded
+	int failed; // the script does not compile, it runs as it is
+	zen_compiled_t *compiled; // NULL until compiled
+} serve_compiled_t;
+static serve_compiled_t compiled[SERVE_COMPILED];
+static int compiled_next = 0;
+
+static serve_compiled_t *_serve_add(const char *conf, const char *script,
+									zen_compiled_t *c) {
+	serve_compiled_t *e = &compiled[compiled_next];
+	compiled_next = (compiled_next + 1) % SERVE_COMPILED;
+	free(e->conf);
+	free(e->script);
+	zencode_compiled_free(e->compiled);
+	e->conf = strdup(conf);
+	e->script = script ? strdup(script) : NULL;
+	e->failed = 0;
+	e->compiled = c;
+	if(c) {
+		memcpy(e->digest, zencode_compiled_digest(c), 65);
+	} else {
+		hash256 sh;
+		char digest[32];
+		HASH256_init(&sh);
+		HASH256_process_array(&sh, (char*)script, (int)strlen(script));
+		HASH256_hash(&sh, digest);
+		buf2hex(e->digest, digest, 32);
+		e->digest[64] = 0x0;
+	}
+	return e;
+}
+
+// path of a compiled contract in the cache directory, NULL if the
+// digest is not made of 64 hex digits or on allocation failure
+static char *_serve_path(const char *cachedir, const char *digest) {
+	int i;
+	for(i=0; i<64; i++)
+		if(!isxdigit((unsigned char)digest[i])) return NULL;
+	if(digest[64] != 0x0) return NULL;
+	size_t len = strlen(cachedir) + 64 + 7;
+	char *path = malloc(len);
+	if(!path) return NULL;
+	snprintf(path, len, "%s/%s.json", cachedir, digest);
+	return path;
+}
+
+static char *_serve_read(const char *path) {
+	FILE *fd = fopen(path, "r");
+	if(!fd) return NULL;
+	char *res = NULL;
+	long len = -1;
+	if(fseek(fd, 0, SEEK_END) == 0) len = ftell(fd);
+	if(len > 0 && fseek(fd, 0, SEEK_SET) == 0) res = malloc(len+1);
+	if(res && fread(res, 1, len, fd) == (size_t)len) {
+		res[len] = 0x0;
+	} else {
+		free(res);
+		res = NULL;
+	}
+	fclose(fd);
+	return res;
+}
+
+// saves a compiled contract in the cache directory: written in a
+// temporary file first and renamed in place, so that other processes
+// never read it incomplete
+static int _serve_write(const char *cachedir, const char *digest,
+						const char *dump) {
+	char *path = _serve_path(cachedir, digest);
+	if(!path) return 0;
+	size_t len = strlen(cachedir) + 64 + 10;
+	char *tmp = malloc(len);
+	if(!tmp) {
+		free(path);
+		return 0;
+	}
+	snprintf(tmp, len, "%s/.%s.XXXXXX", cachedir, digest);
+	int ok = 0;
+	int tfd = mkstemp(tmp);
+	FILE *fd = tfd >= 0 ? fdopen(tfd, "w") : NULL;
+	if(fd) {
+		ok = fputs(dump, fd) >= 0;
+		ok = (fclose(fd) == 0) && ok;
+	} else if(tfd >= 0) close(tfd);
+	if(ok) ok = rename(tmp, path) == 0;
+	if(!ok && tfd >= 0) unlink(tmp);
+	free(tmp);
+	free(path);
+	return ok;
+}
+
+// finds the contract seen with conf from script, or else named by
+// digest, looking into the cache directory when not kept in memory
+static serve_compiled_t *_serve_find(const char *conf, const char *script,
+									 const char *digest, const char *cachedir) {
+	int i;
+	for(i=0; i<SERVE_COMPILED; i++) {
+		serve_compiled_t *e = &compiled[i];
+		if(!e->conf || strcmp(e->conf, conf)) continue;
+		if(script && e->script && strcmp(e->script, script) == 0)
+			return e;
+		if(digest && strcmp(e->digest, digest) == 0)
+			return e;
+	}
+	if(!digest || !cachedir) return NULL;
+	char *path = _serve_path(cachedir, digest);
+	if(!path) return NULL;
+	char *dump = _serve_read(path);
+	free(path);
+	if(!dump) return NULL;
+	zen_compiled_t *c = zencode_compiled_load(dump, conf);
+	free(dump);
+	// the name of the file is not trusted, its contents must match
+	if(c && strcmp(zencode_compiled_digest(c), digest)) {
+		fprintf(stderr,"zencode-exec error: compiled contract in %s/%.64s.json"
+				" has another digest\n", cachedir, digest);
+		zencode_compiled_free(c);
+		return NULL;
+	}
+	return c ? _serve_add(conf, NULL, c) : NULL;
+}
+
+// compiles the script of a contract found by _serve_find, writing the
+// parser logs in err and saving its compiled form in the cache
+// directory if any
+static zen_compiled_t *_serve_compile(serve_compiled_t *e, const char *cachedir,
+									  char *err, size_t errlen) {
+	if(e->compiled || e->failed) return e->compiled;
+	e->compiled = zencode_compile_tobuf(e->script, e->conf, err, errlen);
+	if(!e->compiled) {
+		e->failed = 1;
+		return NULL;
+	}
+	if(cachedir && !_serve_write(cachedir, e->digest,
+								 zencode_compiled_dump(e->compiled)))
+		fprintf(stderr,"zencode-exec error: cannot write in %s: %s\n",
+				cachedir, strerror(errno));
+	return e->compiled;
+}
+
+// persistent mode: executes all jobs found on stdin, each made of the
+// same 6 lines read in one-shot mode, and writes one framed result per
+// job on stdout. A warm VM is reused across jobs until the conf changes
+// and each script run again is compiled once: the script line may then
+// be '@' followed by its digest. Compiled contracts are also saved in
+// the cache directory, when given, and found there by later processes
+static int serve(const char *cachedir) {
+	zen_pool_t *pool = NULL;
+	char *pool_conf = NULL;
+	char *line[6] = { NULL, NULL, NULL, NULL, NULL, NULL };
+	size_t size[6] = { 0, 0, 0, 0, 0, 0 };
+	ssize_t len[6];
+	char *dec[5];
+	char conf[MAX_CONFIG];
+	char *out = malloc(SERVE_BUF);
+	char *err = malloc(SERVE_BUF);
+	int i, exitcode = EXIT_SUCCESS;
+
+	while( (len[0] = _serve_getline(&line[0], &size[0])) >= 0 ) {
+		for(i=1; i<6; i++) {
+			len[i] = _serve_getline(&line[i], &size[i]);
+			if(len[i]<0) {
+				fprintf(stderr,"zencode-exec error: truncated job at line %i\n",i+1);
+				exitcode = EXIT_FAILURE;
+				goto end;
+			}
+		}
+		if(len[0] + 13 >= MAX_CONFIG) {
+			_serve_result(ERR_INIT, NULL, "[ \"[!] Configuration string out of bounds\" ]\n");
+			continue;
+		}
+		if(len[0]) snprintf(conf, MAX_CONFIG, "%s,logfmt=json", line[0]);
+		else snprintf(conf, MAX_CONFIG, "logfmt=json");
+		// a digest is not decoded
+		dec[0] = line[1][0] == '@' ? NULL : _serve_decode(line[1], len[1]);
+		for(i=1; i<5; i++) dec[i] = _serve_decode(line[i+1], len[i+1]);
+		serve_compiled_t *e = NULL;
+		zen_compiled_t *c = NULL;
+		const char *script = dec[0];
+		if(line[1][0] == '@')
+			e = _serve_find(conf, NULL, line[1]+1, cachedir);
+		else if(dec[0] && !(e = _serve_find(conf, dec[0], NULL, cachedir)))
+			_serve_add(conf, dec[0], NULL);
+		if(e) {
+			c = _serve_compile(e, cachedir, err, SERVE_BUF);
+			script = e->script;
+		}
+		if(line[1][0] == '@' && !e) {
+			snprintf(err, SERVE_BUF,
+					 "[ \"[!] Compiled contract not found: %.64s\" ]\n",
+					 line[1]+1);
+			_serve_result(ERR_INIT, NULL, err);
+		} else if(!script && !c) {
+			_serve_result(ERR_INIT, NULL, "[ \"[!] Missing script\" ]\n");
+		} else {
+			// scope and rngseed are fixed in the pool: renew it on change
+			if(!pool || strcmp(pool_conf, conf)) {
+				zen_pool_free(pool);
+				free(pool_conf);
+				pool = zen_pool_new(1, conf);
+				pool_conf = strdup(conf);
+			}
+			out[0] = 0x0;
+			err[0] = 0x0;
+			// scripts failing to compile run as they are to report errors
+			int res;
+			if(c) res = zen_pool_exec_compiled_tobuf
+					  (pool, c, dec[1], dec[2], dec[3], dec[4],
+					   out, SERVE_BUF, err, SERVE_BUF);
+			else res = zen_pool_exec_tobuf
+					 (pool, script, conf, dec[1], dec[2], dec[3], dec[4],
+					  out, SERVE_BUF, err, SERVE_BUF);
+			_serve_result(res, out, err);
+		}
+		for(i=0; i<5; i++) free(dec[i]);
+	}
+end:
+	for(i=0; i<SERVE_COMPILED; i++) {
+		free(compiled[i].conf);
+		free(compiled[i].script);
+		zencode_compiled_free(compiled[i].compiled);
+	}
+	zen_pool_free(pool);
+	free(pool_conf);
+	for(i=0; i<6; i++) free(line[i]);
+	free(out);
+	free(err);
+	return exitcode;
+}
+#endif
+
 int main(int argc, char **argv) {
-  (void)argc;
-  (void)argv;
   register int ret;
   zenroom_t *Z;
 
+#if !defined(ARCH_WIN)
+  if(argc > 1 && strcmp(argv[1], "--serve") == 0)
+	return serve(argc > 2 ? argv[2] : NULL);
+#else
+  (void)argc;
+  (void)argv;
+#endif
+
 #if !defined(ARCH_WIN)
   struct pollfd fds;
 #endif
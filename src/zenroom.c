@@ -45,10 +45,14 @@
 
 #include <zenroom.h>
 #include <zen_memory.h>
+#include <zen_once.h>
 
 // hex2oct used to import hex sequence into rng seed
 #include <encoding.h>
 
+// sha256 used to identify compiled contracts
+#include <amcl.h>
+
 // print functions
 #include <mutt_sprintf.h>
 
@@ -66,8 +70,9 @@ extern void zen_add_parse(lua_State *L);
 // prototype from zen_config.c
 extern int zen_conf_parse(zenroom_t *ZZ, const char *configuration);
 
-// prototype from zen_memory.c
-extern void *zen_memory_manager(void *ud, void *ptr, size_t osize, size_t nsize);
+// prototypes from zen_memory.c
+extern void zen_add_memory(lua_State *L);
+extern void zen_gc_init(zenroom_t *ZZ);
 
 // prototypes from lua_functions.c
 extern int zen_setenv(lua_State *L, const char *key, const char *val);
@@ -76,8 +81,12 @@ extern void zen_add_function(lua_State *L, lua_CFunction func,
 
 // prototype from zen_random.c
 extern void* rng_alloc(zenroom_t *ZZ);
+extern void rng_reseed(zenroom_t *ZZ);
 extern void zen_add_random(lua_State *L);
 
+// lua embedded at build time in lualibs_detected.c
+extern zen_extension_t zen_extensions[];
+
 //////////////////////////////////////////////////////////////
 
 int zen_lua_panic (lua_State *L) {
@@ -86,6 +95,52 @@ int zen_lua_panic (lua_State *L) {
 	return 0;  /* return to Lua to abort */
 }
 
+// reflect the configuration switches inside the lua CONF table
+static void zen_conf_apply(lua_State *L, zenroom_t *Z) {
+	if(Z->logformat == LOG_JSON)
+	  luaL_dostring(L, "CONF.debug.format='compact'");
+	if(Z->scope == SCOPE_GIVEN) {
+	  luaL_dostring(L, "CONF.exec.scope='given'");
+	  luaL_dostring(L, "CONF.parser.strict_match=false");
+	  luaL_dostring(L, "CONF.missing.fatal=false");
+	  luaL_dostring(L, "CONF.debug.format='compact'");
+	} else { // SCOPE_FULL is default
+	  luaL_dostring(L, "CONF.exec.scope='full'");
+	}
+}
+
+// default values of all configuration switches, before zen_conf_parse
+static void zen_conf_defaults(zenroom_t *ZZ) {
+	ZZ->errorlevel = 0;
+	ZZ->scope = SCOPE_FULL;
+	ZZ->debuglevel = 2;
+	ZZ->random_external = 0;
+	// set zero rngseed as config flag
+	ZZ->zconf_rngseed[0] = '\0';
+	ZZ->exitcode = 1; // success
+#if defined(__EMSCRIPTEN__)
+	ZZ->logformat = LOG_JSON;
+#else
+	ZZ->logformat = LOG_TEXT;
+#endif
+	ZZ->memmanager = MEM_SLAB;
+	ZZ->gcpolicy = GC_INC;
+	ZZ->gcstep = 64;
+	ZZ->gctime = 0;
+	// default maxiter 1000 steps
+	ZZ->str_maxiter[0] = '1';
+	ZZ->str_maxiter[1] = '0';
+	ZZ->str_maxiter[2] = '0';
+	ZZ->str_maxiter[3] = '0';
+	ZZ->str_maxiter[4] = '\0';
+	// default maxmem 1GB
+	ZZ->str_maxmem[0] = '1';
+	ZZ->str_maxmem[1] = '0';
+	ZZ->str_maxmem[2] = '2';
+	ZZ->str_maxmem[3] = '4';
+	ZZ->str_maxmem[4] = '\0';
+}
+
 int zen_init_pmain(lua_State *L) { // protected mode init
 
 	// Set zenroom context as a global in lua
@@ -124,14 +179,17 @@ int zen_init_pmain(lua_State *L) { // protected mode init
 	zen_setenv(L, "GITLOG", GITLOG);
 #endif
 
-	// zen_setenv(L, "MEMMANAGER", "libc");
-	// act(L,"Memory manager: libc");
+	Z(L);
+	const char *memmanager = Z->memmanager == MEM_LIBC ? "libc" : "slab";
+	zen_setenv(L, "MEMMANAGER", memmanager);
+	act(L,"Memory manager: %s", memmanager);
 
 	// open all standard lua libraries
 	luaL_openlibs(L);
 	// load our own openlibs and extensions
 	zen_add_io(L);
 	zen_add_parse(L);
+	zen_add_memory(L);
 
 	zen_add_random(L);
 
@@ -141,17 +199,7 @@ int zen_init_pmain(lua_State *L) { // protected mode init
 		return(LUA_ERRRUN);
 	}
 
-	Z(L);
-	if(Z->logformat == LOG_JSON)
-	  luaL_dostring(L, "CONF.debug.format='compact'");
-	if(Z->scope == SCOPE_GIVEN) {
-	  luaL_dostring(L, "CONF.exec.scope='given'");
-	  luaL_dostring(L, "CONF.parser.strict_match=false");
-	  luaL_dostring(L, "CONF.missing.fatal=false");
-	  luaL_dostring(L, "CONF.debug.format='compact'");
-	} else { // SCOPE_FULL is default
-	  luaL_dostring(L, "CONF.exec.scope='full'");
-	}
+	zen_conf_apply(L, Z);
 	return(LUA_OK);
 }
 
@@ -172,31 +220,10 @@ zenroom_t *zen_init(const char *conf, const char *keys, const char *data) {
 	ZZ->stderr_len = 0;
 	ZZ->stderr_full = 0;
 	ZZ->userdata = NULL;
-	ZZ->errorlevel = 0;
-	ZZ->scope = SCOPE_FULL;
-	ZZ->debuglevel = 2;
 	ZZ->random_generator = NULL;
-	ZZ->random_external = 0;
-	// set zero rngseed as config flag
-	ZZ->zconf_rngseed[0] = '\0';
-	ZZ->exitcode = 1; // success
-#if defined(__EMSCRIPTEN__)
-	ZZ->logformat = LOG_JSON;
-#else
-	ZZ->logformat = LOG_TEXT;
-#endif
-	// default maxiter 1000 steps
-	ZZ->str_maxiter[0] = '1';
-	ZZ->str_maxiter[1] = '0';
-	ZZ->str_maxiter[2] = '0';
-	ZZ->str_maxiter[3] = '0';
-	ZZ->str_maxiter[4] = '\0';
-	// default maxmem 1GB
-	ZZ->str_maxmem[0] = '1';
-	ZZ->str_maxmem[1] = '0';
-	ZZ->str_maxmem[2] = '2';
-	ZZ->str_maxmem[3] = '4';
-	ZZ->str_maxmem[4] = '\0';
+	ZZ->memory = NULL;
+	ZZ->logpos = 0;
+	zen_conf_defaults(ZZ);
 
 	if(conf) {
 		if( ! zen_conf_parse(ZZ, conf) ) { // stb parsing
@@ -204,6 +231,7 @@ zenroom_t *zen_init(const char *conf, const char *keys, const char *data) {
 			return(NULL);
 		}
 	}
+	zen_log_level = ZZ->debuglevel;
 
 	// use RNGseed from configuration if present (deterministic mode)
 	if(ZZ->zconf_rngseed[0] != 0x0) {
@@ -215,7 +243,13 @@ zenroom_t *zen_init(const char *conf, const char *keys, const char *data) {
 	// initialize the random generator
 	ZZ->random_generator = rng_alloc(ZZ);
 
-	// initialize Lua's context
+	// initialize the memory manager and Lua's context
+	ZZ->memory = zen_mem_new(ZZ->memmanager == MEM_LIBC);
+	if(!ZZ->memory) {
+	  _err( "%s: memory manager creation failed\n", __func__);
+	  zen_teardown(ZZ);
+	  return NULL;
+	}
 	ZZ->lua = lua_newstate(zen_memory_manager, ZZ);
 	if(!ZZ->lua) {
 	  _err( "%s: Lua newstate creation failed\n", __func__);
@@ -223,9 +257,8 @@ zenroom_t *zen_init(const char *conf, const char *keys, const char *data) {
 	  return NULL;
 	}
 
-	// use the generative garbage collector
-	lua_gc(ZZ->lua, LUA_GCGEN);
-	lua_gc(ZZ->lua, LUA_GCSTOP); // runs GC only manually
+	// GC runs only between zencode statements, see zen_memory.c
+	zen_gc_init(ZZ);
 
 	// init log format if needed
 	if(ZZ->logformat == LOG_JSON) json_start(ZZ->lua);
@@ -261,8 +294,10 @@ zenroom_t *zen_init(const char *conf, const char *keys, const char *data) {
 	}
 
 	lua_gc(ZZ->lua, LUA_GCCOLLECT, 0);
-	func(ZZ->lua,"Initialized memory: %u KB",
-	    lua_gc(ZZ->lua,LUA_GCCOUNT,0));
+	// collector steps account the growth from here
+	((zen_mem_t*)ZZ->memory)->gc_mark = ((zen_mem_t*)ZZ->memory)->used;
+	func(ZZ->lua,"Initialized memory: %lu KB",
+	    (unsigned long)((zen_mem_t*)ZZ->memory)->used / 1024);
 	// uncomment to restrict further requires
 	// zen_require_override(L,1);
 
@@ -305,9 +340,17 @@ zenroom_t *zen_init_extra(const char *conf, const char *keys, const char *data,
 }
 
 void zen_teardown(zenroom_t *ZZ) {
+	zen_log_level = ZZ->debuglevel;
 	notice(ZZ->lua,"Zenroom teardown.");
-	act(ZZ->lua,"Memory used: %u KB",
-	    lua_gc(ZZ->lua,LUA_GCCOUNT,0));
+	zen_mem_t *mem = (zen_mem_t*)ZZ->memory;
+	if(mem && ZZ->lua)
+		act(ZZ->lua,"Memory used: %lu KB, peak %lu KB, %lu allocations, %lu libc calls",
+			(unsigned long)mem->used / 1024, (unsigned long)mem->peak / 1024,
+			(unsigned long)mem->allocs, (unsigned long)mem->libc_calls);
+	if(mem && ZZ->lua && mem->gc_pauses)
+		act(ZZ->lua,"GC pauses: %lu (%lu full), %llu us total, %llu us max",
+			(unsigned long)mem->gc_pauses, (unsigned long)mem->gc_full,
+			mem->gc_usec, mem->gc_max_usec);
 
 	// stateful RNG instance for deterministic mode
 	if(ZZ->random_generator) {
@@ -317,10 +360,15 @@ void zen_teardown(zenroom_t *ZZ) {
 
 	if(ZZ->logformat == LOG_JSON) json_end(ZZ->lua);
 
-	lua_gc((lua_State*)ZZ->lua, LUA_GCCOLLECT, 0);
-	// this call here frees also Z (lightuserdata)
-	lua_close((lua_State*)ZZ->lua);
-	ZZ->lua = NULL;
+	if(ZZ->lua) {
+		lua_gc((lua_State*)ZZ->lua, LUA_GCCOLLECT, 0);
+		// this call here frees also Z (lightuserdata)
+		lua_close((lua_State*)ZZ->lua);
+		ZZ->lua = NULL;
+	}
+	// all slabs are released at once after Lua freed its objects
+	zen_mem_free(mem);
+	ZZ->memory = NULL;
 
 	free(ZZ);
 }
@@ -330,6 +378,7 @@ int zen_exec_zencode(zenroom_t *ZZ, const char *script) {
 	HEDLEY_ASSUME(ZZ!=NULL);
 	HEDLEY_ASSUME(ZZ->lua!=NULL);
   lua_State* L = (lua_State*)ZZ->lua;
+  zen_log_level = ZZ->debuglevel;
   // introspection on code being executed
   zen_setenv(L,"CODE",(char*)script);
   ZZ->exitcode = luaL_dostring
@@ -371,6 +420,7 @@ int zen_exec_lua(zenroom_t *ZZ, const char *script) {
 	HEDLEY_ASSUME(ZZ!=NULL);
 	HEDLEY_ASSUME(ZZ->lua!=NULL);
 	lua_State *L = (lua_State*)ZZ->lua;
+	zen_log_level = ZZ->debuglevel;
 	// introspection on code being executed
 	zen_setenv(L,"CODE",(char*)script);
 	int ret = luaL_dostring(L, script);
@@ -626,3 +676,495 @@ int zencode_get_statements(const char *scenario) {
 	}
 	return( _check_zenroom_result(Z));
 }
+
+/////////////////////////////////////////
+// compiled contracts: parsed once and executed many times
+
+struct zen_compiled_s {
+	char digest[68]; // sha256 of the script, hex encoded
+	char *conf; // configuration used to compile and to execute
+	char *dump; // JSON encoded compiled form, see ZEN:compile
+};
+
+static void _sha256_hex(char *dst, const char *buf, size_t len) {
+	hash256 sh;
+	char digest[32];
+	HASH256_init(&sh);
+	HASH256_process_array(&sh, buf, (int)len);
+	HASH256_hash(&sh, digest);
+	buf2hex(dst, digest, 32);
+	dst[64] = 0x0;
+}
+
+// identifies the VMs a compiled contract can be loaded in: the
+// sha256 of all the lua embedded at build, which holds the scenarios
+// and the statements they register, followed by the release version
+static char compiled_build[128] = { 0x0 };
+static volatile int compiled_build_state = ZEN_ONCE_MISSING;
+
+static void _compiled_build_once(void) {
+	hash256 sh;
+	char digest[32];
+	char hex[68];
+	zen_extension_t *p;
+	HASH256_init(&sh);
+	for (p = zen_extensions; p->name != NULL; ++p) {
+		HASH256_process_array(&sh, p->name, (int)strlen(p->name)+1);
+		HASH256_process_array(&sh, p->code, (int)*p->size);
+	}
+	HASH256_hash(&sh, digest);
+	buf2hex(hex, digest, 32);
+	hex[64] = 0x0;
+#if defined(VERSION)
+	snprintf(compiled_build, sizeof(compiled_build), "%s:%s", hex, VERSION);
+#else
+	snprintf(compiled_build, sizeof(compiled_build), "%s:", hex);
+#endif
+}
+
+static const char *_compiled_build(void) {
+	zen_once(&compiled_build_state, _compiled_build_once);
+	return compiled_build;
+}
+
+// runs lua code with the compiled contract in COMPILED, fills in the
+// digest from it and returns the exit code of the Zencode phases
+static int _compiled_check(zenroom_t *Z, zen_compiled_t *res) {
+	lua_State *L = (lua_State*)Z->lua;
+	zen_setenv(L, "ZENROOM_BUILD", (char*)_compiled_build());
+	zen_setenv(L, "COMPILED", res->dump);
+	Z->exitcode = luaL_dostring
+		(L,"local _res, _err <const> = pcall( function()\n"
+		 "  local c <const> = JSON.decode(COMPILED)\n"
+		 "  ZEN:load(c)\n"
+		 "  DIGEST = c.digest end)\n"
+		 "if not _res then exitcode(3) ZEN.OK = false error(_err,2) end\n");
+	if(Z->exitcode != SUCCESS) {
+		zerror(L, "Zencode compiled contract error");
+		zerror(L, "%s", lua_tostring(L, -1));
+		return Z->exitcode;
+	}
+	lua_getglobal(L, "DIGEST");
+	const char *digest = lua_tostring(L, -1);
+	if(!digest || strlen(digest) != 64) {
+		zerror(L, "Zencode compiled contract without digest");
+		return (Z->exitcode = ERR_PARSE);
+	}
+	memcpy(res->digest, digest, 65);
+	return SUCCESS;
+}
+
+static zen_compiled_t *_compiled_new(const char *conf, const char *dump) {
+	zen_compiled_t *res = (zen_compiled_t*)calloc(1, sizeof(zen_compiled_t));
+	res->conf = conf ? strdup(conf) : NULL;
+	res->dump = dump ? strdup(dump) : NULL;
+	return res;
+}
+
+zen_compiled_t *zencode_compile(const char *script, const char *conf) {
+	return zencode_compile_tobuf(script, conf, NULL, 0);
+}
+
+zen_compiled_t *zencode_compile_tobuf(const char *script, const char *conf,
+									  char *stderr_buf, size_t stderr_len) {
+	const char *c = conf ? (conf[0] == '\0') ? NULL : conf : NULL;
+	zenroom_t *Z = zen_init(c, NULL, NULL);
+	if (_check_zenroom_init(Z) != SUCCESS) return NULL;
+	if (_check_script_arg(Z, script) != SUCCESS) return NULL;
+	Z->stderr_buf = stderr_buf;
+	Z->stderr_len = stderr_len;
+	lua_State *L = (lua_State*)Z->lua;
+	zen_compiled_t *res = _compiled_new(c, NULL);
+	_sha256_hex(res->digest, script, strlen(script));
+	zen_setenv(L, "CODE", (char*)script);
+	zen_setenv(L, "DIGEST", res->digest);
+	zen_setenv(L, "ZENROOM_BUILD", (char*)_compiled_build());
+	Z->exitcode = luaL_dostring
+		(L,"local _res, _err <const> = pcall( function()\n"
+		 "  ZEN:begin()\n"
+		 "  ZEN:parse(CONF.code.encoding.fun(CODE))\n"
+		 "  COMPILED = JSON.encode(ZEN:compile()) end)\n"
+		 "if not _res then exitcode(3) ZEN.OK = false error(_err,2) end\n");
+	if(Z->exitcode != SUCCESS) {
+		zerror(L, "Zencode parser error");
+		zerror(L, "%s", lua_tostring(L, -1));
+	} else {
+		lua_getglobal(L, "COMPILED");
+		res->dump = strdup(lua_tostring(L, -1));
+		lua_pop(L, 1);
+	}
+	if(_check_zenroom_result(Z) != SUCCESS) {
+		zencode_compiled_free(res);
+		return NULL;
+	}
+	return res;
+}
+
+zen_compiled_t *zencode_compiled_load(const char *dump, const char *conf) {
+	const char *c = conf ? (conf[0] == '\0') ? NULL : conf : NULL;
+	zenroom_t *Z = zen_init(c, NULL, NULL);
+	if (_check_zenroom_init(Z) != SUCCESS) return NULL;
+	if (_check_script_arg(Z, dump) != SUCCESS) return NULL;
+	zen_compiled_t *res = _compiled_new(c, dump);
+	_compiled_check(Z, res);
+	if(_check_zenroom_result(Z) != SUCCESS) {
+		zencode_compiled_free(res);
+		return NULL;
+	}
+	return res;
+}
+
+const char *zencode_compiled_digest(const zen_compiled_t *compiled) {
+	return compiled ? compiled->digest : NULL;
+}
+
+const char *zencode_compiled_dump(const zen_compiled_t *compiled) {
+	return compiled ? compiled->dump : NULL;
+}
+
+void zencode_compiled_free(zen_compiled_t *compiled) {
+	if(!compiled) return;
+	free(compiled->conf);
+	free(compiled->dump);
+	free(compiled);
+}
+
+// same as zen_exec_zencode, loading a compiled contract in place of
+// ZEN:begin and ZEN:parse
+HEDLEY_NON_NULL(1,2)
+int zen_exec_compiled(zenroom_t *ZZ, zen_compiled_t *compiled) {
+	HEDLEY_ASSUME(ZZ->lua!=NULL);
+  lua_State* L = (lua_State*)ZZ->lua;
+  zen_log_level = ZZ->debuglevel;
+  zen_setenv(L,"ZENROOM_BUILD",(char*)_compiled_build());
+  zen_setenv(L,"COMPILED",compiled->dump);
+  ZZ->exitcode = luaL_dostring
+	(L,"local _res, _err <const> = pcall( function() ZEN:load(JSON.decode(COMPILED)) end)\n"
+	 "COMPILED = nil\n"
+	 "if not _res then exitcode(3) ZEN.OK = false error(_err,2) end\n");
+  if(ZZ->exitcode != SUCCESS) {
+	zerror(L, "Zencode compiled contract error");
+	zerror(L, "%s", lua_tostring(L, -1));
+	return ZZ->exitcode;
+  }
+  ZZ->exitcode = luaL_dostring
+	(L,"local _res, _err <const> = pcall( function() ZEN:run() end)\n"
+	 "if not _res then exitcode(2) ZEN.OK = false error(_err,2) end\n");
+  if(ZZ->exitcode != SUCCESS) {
+	zerror(L, "Zencode runtime error");
+	zerror(L, "%s", lua_tostring(L, -1));
+	return ZZ->exitcode;
+  }
+  if(ZZ->exitcode == SUCCESS) func(L, "Zencode successfully executed");
+  return ZZ->exitcode;
+}
+
+// runs either the script or the compiled contract when not NULL
+static int _cold_exec(const char *script, zen_compiled_t *compiled,
+					  const char *conf, const char *keys,
+					  const char *data, const char *extra, const char *context,
+					  char *stdout_buf, size_t stdout_len,
+					  char *stderr_buf, size_t stderr_len) {
+	zenroom_t *Z = zen_init_extra(conf, keys, data, extra, context);
+	if (_check_zenroom_init(Z) != SUCCESS) return ERR_INIT;
+	if (!compiled && _check_script_arg(Z, script) != SUCCESS) return ERR_INIT;
+	Z->stdout_buf = stdout_buf;
+	Z->stdout_len = stdout_len;
+	Z->stderr_buf = stderr_buf;
+	Z->stderr_len = stderr_len;
+	if(compiled) zen_exec_compiled(Z, compiled);
+	else zen_exec_zencode(Z, script);
+	return( _check_zenroom_result(Z) );
+}
+
+int zencode_exec_compiled(zen_compiled_t *compiled,
+						  const char *keys, const char *data,
+						  const char *extra, const char *context) {
+	return zencode_exec_compiled_tobuf(compiled, keys, data, extra, context,
+									   NULL, 0, NULL, 0);
+}
+
+int zencode_exec_compiled_tobuf(zen_compiled_t *compiled,
+								const char *keys, const char *data,
+								const char *extra, const char *context,
+								char *stdout_buf, size_t stdout_len,
+								char *stderr_buf, size_t stderr_len) {
+	const char *k, *d, *e, *x;
+	k = keys ? (keys[0] == '\0') ? NULL : keys : NULL;
+	d = data ? (data[0] == '\0') ? NULL : data : NULL;
+	e = extra ? (extra[0] == '\0') ? NULL : extra : NULL;
+	x = context ? (context[0] == '\0') ? NULL : context : NULL;
+	if(!compiled) {
+		_err( "%s: NULL compiled contract", __func__);
+		return ERR_INIT;
+	}
+	return _cold_exec(NULL, compiled, compiled->conf, k, d, e, x,
+					  stdout_buf, stdout_len, stderr_buf, stderr_len);
+}
+
+/////////////////////////////////////////
+// warm VM pool: zencode executions reusing pre-initialized contexts
+
+struct zen_pool_s {
+	int size;
+	char *conf; // base configuration of all pooled VMs
+	int scope; // parsed from conf: VMs are only reused for the same scope
+	char rngseed[(RANDOM_SEED_LEN*2)+4]; // and the same rngseed if any
+	zenroom_t **vm; // NULL until initialized
+	int *busy;
+};
+
+// push the zenroom_pool lua module and its function named fn
+static int _pool_call(lua_State *L, const char *fn) {
+	lua_getfield(L, LUA_REGISTRYINDEX, "zenroom_pool");
+	lua_getfield(L, -1, fn);
+	lua_remove(L, -2);
+	if(lua_pcall(L, 0, 0, 0) != LUA_OK) {
+		zerror(L, "VM pool %s error: %s", fn, lua_tostring(L, -1));
+		lua_pop(L, 1);
+		return ERR_INIT;
+	}
+	return SUCCESS;
+}
+
+// initialize a VM and take the snapshot restored before each use
+static zenroom_t *_pool_warm(zen_pool_t *pool) {
+	zenroom_t *ZZ = zen_init(pool->conf, NULL, NULL);
+	if(!ZZ) return NULL;
+	lua_State *L = (lua_State*)ZZ->lua;
+	lua_getglobal(L, "require");
+	lua_pushstring(L, "zenroom_pool");
+	if(lua_pcall(L, 1, 1, 0) != LUA_OK || !lua_istable(L, -1)) {
+		zerror(L, "VM pool module not found");
+		zen_teardown(ZZ);
+		return NULL;
+	}
+	lua_setfield(L, LUA_REGISTRYINDEX, "zenroom_pool");
+	if(_pool_call(L, "snapshot") != SUCCESS) {
+		zen_teardown(ZZ);
+		return NULL;
+	}
+	lua_gc(L, LUA_GCCOLLECT, 0);
+	return ZZ;
+}
+
+zen_pool_t *zen_pool_new(int size, const char *conf) {
+	if(size < 1) {
+		_err( "%s: invalid pool size: %i", __func__, size);
+		return NULL;
+	}
+	const char *c = conf ? (conf[0] == '\0') ? NULL : conf : NULL;
+	zen_pool_t *pool = (zen_pool_t*)calloc(1, sizeof(zen_pool_t));
+	zenroom_t parsed;
+	zen_conf_defaults(&parsed);
+	if(c && !zen_conf_parse(&parsed, c)) {
+		_err( "Error parsing configuration: %s\n", c);
+		free(pool);
+		return NULL;
+	}
+	pool->scope = parsed.scope;
+	memcpy(pool->rngseed, parsed.zconf_rngseed, sizeof(pool->rngseed));
+	pool->conf = c ? strdup(c) : NULL;
+	pool->size = size;
+	pool->vm = (zenroom_t**)calloc(size, sizeof(zenroom_t*));
+	pool->busy = (int*)calloc(size, sizeof(int));
+	for(int i=0; i<size; i++) {
+		pool->vm[i] = _pool_warm(pool);
+		if(!pool->vm[i]) {
+			_err( "%s: initialisation of VM %i failed", __func__, i);
+			zen_pool_free(pool);
+			return NULL;
+		}
+	}
+	return pool;
+}
+
+void zen_pool_free(zen_pool_t *pool) {
+	if(!pool) return;
+	for(int i=0; i<pool->size; i++) {
+		if(pool->vm[i]) {
+			pool->vm[i]->debuglevel = 0;
+			pool->vm[i]->logformat = LOG_TEXT;
+			zen_teardown(pool->vm[i]);
+		}
+	}
+	free(pool->vm);
+	free(pool->busy);
+	free(pool->conf);
+	free(pool);
+}
+
+// restore a pooled VM and configure it for a new execution
+static int _pool_reset(zen_pool_t *pool, zenroom_t *ZZ, const char *conf,
+					   char *stdout_buf, size_t stdout_len,
+					   char *stderr_buf, size_t stderr_len) {
+	zen_conf_defaults(ZZ);
+	if(conf) zen_conf_parse(ZZ, conf); // already validated
+	zen_log_level = ZZ->debuglevel;
+	ZZ->stdout_buf = stdout_buf;
+	ZZ->stdout_len = stdout_len;
+	ZZ->stdout_pos = ZZ->stdout_full = 0;
+	ZZ->stderr_buf = stderr_buf;
+	ZZ->stderr_len = stderr_len;
+	ZZ->stderr_pos = ZZ->stderr_full = 0;
+	if(ZZ->zconf_rngseed[0] != 0x0) {
+		ZZ->random_external = 1;
+		memset(ZZ->random_seed, 0x0, RANDOM_SEED_LEN);
+		hex2buf(ZZ->random_seed, ZZ->zconf_rngseed);
+	}
+	rng_reseed(ZZ);
+
+	lua_State *L = (lua_State*)ZZ->lua;
+	lua_settop(L, 0);
+	if(ZZ->logformat == LOG_JSON) json_start(L);
+	if(_pool_call(L, "restore") != SUCCESS) return ERR_INIT;
+	lua_pushinteger(L, ZZ->debuglevel);
+	lua_setglobal(L, "DEBUG");
+	lua_pushstring(L, ZZ->str_maxiter);
+	lua_setglobal(L, "STR_MAXITER");
+	lua_pushstring(L, ZZ->str_maxmem);
+	lua_setglobal(L, "STR_MAXMEM");
+	if(_pool_call(L, "configure") != SUCCESS) return ERR_INIT;
+	if(pool->scope == SCOPE_FULL &&
+	   luaL_dostring(L, "CONF.debug.format='log'") != LUA_OK) {
+		zerror(L, "VM pool configure error: %s", lua_tostring(L, -1));
+		lua_pop(L, 1);
+		return ERR_INIT;
+	}
+	zen_conf_apply(L, ZZ);
+	lua_gc(L, LUA_GCCOLLECT, 0);
+	zen_gc_init(ZZ);
+	push_buffer_to_octet(L, ZZ->random_seed, RANDOM_SEED_LEN);
+	lua_setglobal(L, "RNGSEED");
+	if(ZZ->zconf_rngseed[0] != 0x0)
+	  act(L, "RNG seed fed by external configuration");
+	zen_setenv(L, "LOGFMT",
+			   ZZ->logformat == LOG_JSON ? "JSON" : "TEXT");
+	return SUCCESS;
+}
+
+// release a pooled VM, destroying it when its state can't be trusted
+static void _pool_release(zen_pool_t *pool, int i, int discard) {
+	// caller buffers are not valid beyond this execution
+	pool->vm[i]->stdout_buf = NULL;
+	pool->vm[i]->stderr_buf = NULL;
+	if(discard) {
+		pool->vm[i]->debuglevel = 0;
+		pool->vm[i]->logformat = LOG_TEXT;
+		zen_teardown(pool->vm[i]);
+		pool->vm[i] = NULL; // initialized again on next use
+	}
+	__sync_lock_release(&pool->busy[i]);
+}
+
+int zen_pool_exec(zen_pool_t *pool, const char *script, const char *conf,
+				  const char *keys, const char *data,
+				  const char *extra, const char *context) {
+	return zen_pool_exec_tobuf(pool, script, conf, keys, data, extra, context,
+							   NULL, 0, NULL, 0);
+}
+
+static int _pool_exec(zen_pool_t *pool, const char *script,
+					  zen_compiled_t *compiled, const char *conf,
+					  const char *keys, const char *data,
+					  const char *extra, const char *context,
+					  char *stdout_buf, size_t stdout_len,
+					  char *stderr_buf, size_t stderr_len) {
+	const char *c, *k, *d, *e, *x;
+	c = conf ? (conf[0] == '\0') ? NULL : conf : NULL;
+	k = keys ? (keys[0] == '\0') ? NULL : keys : NULL;
+	d = data ? (data[0] == '\0') ? NULL : data : NULL;
+	e = extra ? (extra[0] == '\0') ? NULL : extra : NULL;
+	x = context ? (context[0] == '\0') ? NULL : context : NULL;
+	if(!pool || (!compiled && (!script || script[0] == '\0')))
+		return _cold_exec(script, compiled, c, k, d, e, x,
+						  stdout_buf, stdout_len, stderr_buf, stderr_len);
+	zenroom_t parsed;
+	zen_conf_defaults(&parsed);
+	if(c && !zen_conf_parse(&parsed, c)) {
+		_err( "Error parsing configuration: %s\n", c);
+		return ERR_INIT;
+	}
+	// the scope selects which scenarios are bootstrapped and the
+	// rngseed also seeds lua string hashes: both are fixed at init
+	if(parsed.scope != pool->scope
+	   || (parsed.zconf_rngseed[0] != 0x0
+		   && strcmp(parsed.zconf_rngseed, pool->rngseed) != 0))
+		return _cold_exec(script, compiled, c, k, d, e, x,
+						  stdout_buf, stdout_len, stderr_buf, stderr_len);
+
+	// checkout the first idle VM, or fall back to a cold start
+	int i;
+	for(i=0; i<pool->size; i++)
+		if(__sync_bool_compare_and_swap(&pool->busy[i], 0, 1)) break;
+	if(i == pool->size)
+		return _cold_exec(script, compiled, c, k, d, e, x,
+						  stdout_buf, stdout_len, stderr_buf, stderr_len);
+	if(!pool->vm[i]) pool->vm[i] = _pool_warm(pool);
+	if(!pool->vm[i]) {
+		__sync_lock_release(&pool->busy[i]);
+		return _cold_exec(script, compiled, c, k, d, e, x,
+						  stdout_buf, stdout_len, stderr_buf, stderr_len);
+	}
+	zenroom_t *ZZ = pool->vm[i];
+	if(_pool_reset(pool, ZZ, c, stdout_buf, stdout_len,
+				   stderr_buf, stderr_len) != SUCCESS) {
+		_pool_release(pool, i, 1);
+		return _cold_exec(script, compiled, c, k, d, e, x,
+						  stdout_buf, stdout_len, stderr_buf, stderr_len);
+	}
+	lua_State *L = (lua_State*)ZZ->lua;
+	if(d) zen_setenv(L, "DATA", d);
+	if(k) zen_setenv(L, "KEYS", k);
+	if(e) zen_setenv(L, "EXTRA", e);
+	if(x) zen_setenv(L, "CONTEXT", x);
+
+	int exitcode = compiled ? zen_exec_compiled(ZZ, compiled)
+		: zen_exec_zencode(ZZ, script);
+	if(exitcode != SUCCESS) {
+		zerror(L, "Execution aborted with errors.");
+	} else {
+		act(L, "Zenroom execution completed.");
+	}
+	act(L, "Memory used: %u KB", lua_gc(L, LUA_GCCOUNT, 0));
+	zen_mem_t *mem = (zen_mem_t*)ZZ->memory;
+	if(mem && mem->gc_pauses)
+		act(L, "GC pauses: %lu (%lu full), %llu us total, %llu us max",
+			(unsigned long)mem->gc_pauses, (unsigned long)mem->gc_full,
+			mem->gc_usec, mem->gc_max_usec);
+	if(ZZ->logformat == LOG_JSON) json_end(L);
+	// errors caught inside the zencode phases leave the VM usable
+	_pool_release(pool, i, exitcode != SUCCESS && exitcode != ERR_PARSE
+				  && exitcode != ERR_EXEC && exitcode != ERR_GENERIC);
+	return exitcode;
+}
+
+int zen_pool_exec_tobuf(zen_pool_t *pool, const char *script, const char *conf,
+						const char *keys, const char *data,
+						const char *extra, const char *context,
+						char *stdout_buf, size_t stdout_len,
+						char *stderr_buf, size_t stderr_len) {
+	return _pool_exec(pool, script, NULL, conf, keys, data, extra, context,
+					  stdout_buf, stdout_len, stderr_buf, stderr_len);
+}
+
+int zen_pool_exec_compiled(zen_pool_t *pool, zen_compiled_t *compiled,
+						   const char *keys, const char *data,
+						   const char *extra, const char *context) {
+	return zen_pool_exec_compiled_tobuf(pool, compiled, keys, data, extra,
+										context, NULL, 0, NULL, 0);
+}
+
+int zen_pool_exec_compiled_tobuf(zen_pool_t *pool, zen_compiled_t *compiled,
+								 const char *keys, const char *data,
+								 const char *extra, const char *context,
+								 char *stdout_buf, size_t stdout_len,
+								 char *stderr_buf, size_t stderr_len) {
+	if(!compiled) {
+		_err( "%s: NULL compiled contract", __func__);
+		return ERR_INIT;
+	}
+	return _pool_exec(pool, NULL, compiled, compiled->conf,
+					  keys, data, extra, context,
+					  stdout_buf, stdout_len, stderr_buf, stderr_len);
+}
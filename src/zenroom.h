@@ -82,9 +82,15 @@ int zenroom_sign_verify(const char *algo, const char *pk, const char *msg, const
 #define RANDOM_SEED_LEN 64
 #define STR_MAXITER_LEN 10
 
+#ifndef MAX_ERRMSG
+#define MAX_ERRMSG 256 // maximum length of an error message line
+#endif
+#define LOG_RING 4 // log lines formatted without allocation, see zen_error.c
+
 // conf switches
 typedef enum { STB, MUTT, LIBC } printftype;
-typedef enum { NIL, VERBOSE, SCOPE, RNGSEED, LOGFMT, MAXITER, MAXMEM } zconf;
+typedef enum { NIL, VERBOSE, SCOPE, RNGSEED, LOGFMT, MAXITER, MAXMEM, MEMMANAGER,
+		GCPOLICY, GCSTEP, GCTIME } zconf;
 
 // zenroom context, also available as "_Z" global in lua space
 // contents are opaque in lua and available only as lightuserdata
@@ -102,6 +108,7 @@ typedef struct {
 	size_t stderr_full;
 
 	void *random_generator; // cast to RNG
+	void *memory; // cast to zen_mem_t, used by the Lua allocator
 	char random_seed[RANDOM_SEED_LEN+4];
     char runtime_random256[256+4];
 	int random_external; // signal when rngseed is external
@@ -110,8 +117,15 @@ typedef struct {
 	int debuglevel;
 	int errorlevel;
     int logformat;
+	int memmanager;
+	int gcpolicy;
+	int gcstep; // KiB of collector work for each step between statements
+	int gctime; // microseconds budget of each step, 0 for a single step
 	void *userdata; // anything passed at init (reserved for caller)
 
+	char logring[LOG_RING][MAX_ERRMSG+16];
+	unsigned int logpos;
+
   	char zconf_rngseed[(RANDOM_SEED_LEN*2)+4]; // 0x and terminating \0
 
         char str_maxiter[STR_MAXITER_LEN + 1];
@@ -128,6 +142,15 @@ typedef struct {
 #define LOG_TEXT 0
 #define LOG_JSON  1
 
+// MEMORY MANAGERS
+#define MEM_SLAB 0
+#define MEM_LIBC 1
+
+// GARBAGE COLLECTION POLICIES
+#define GC_FULL 0 // full collections on section switches only
+#define GC_INC 1 // incremental steps between statements
+#define GC_GEN 2 // generational minor collections between statements
+
 // EXIT CODES
 #define ERR_INIT 4
 #define ERR_PARSE 3
@@ -141,6 +164,59 @@ int  zen_exec_lua(zenroom_t *Z, const char *script);
 int  zen_exec_zencode(zenroom_t *Z, const char *script);
 void zen_teardown(zenroom_t *zenroom);
 
+// warm VM pool: keeps 'size' initialized contexts and reuses them for
+// zencode executions, restoring their state in between so that each
+// run is isolated as in a fresh zen_init. The pool conf fixes scope
+// and rngseed of all VMs: executions with a conf asking for another
+// scope or rngseed, or finding no idle VM, fall back to a cold start.
+typedef struct zen_pool_s zen_pool_t;
+zen_pool_t *zen_pool_new(int size, const char *conf);
+int  zen_pool_exec(zen_pool_t *pool, const char *script, const char *conf,
+                   const char *keys, const char *data,
+                   const char *extra, const char *context);
+// same as zen_pool_exec, printing into caller buffers as zencode_exec_tobuf
+int  zen_pool_exec_tobuf(zen_pool_t *pool, const char *script, const char *conf,
+                         const char *keys, const char *data,
+                         const char *extra, const char *context,
+                         char *stdout_buf, size_t stdout_len,
+                         char *stderr_buf, size_t stderr_len);
+void zen_pool_free(zen_pool_t *pool);
+
+// compiled contracts: a script parsed once by zencode_compile can be
+// executed many times with different inputs, skipping the parser. The
+// handle keeps the conf it was compiled with and is used to execute
+// it. Its compiled form, a JSON string that can be cached in memory
+// or on disk, is restored by zencode_compiled_load only in a Zenroom
+// built with the same version and scenarios, and the digest (sha256
+// of the script, hex encoded) names the contract to its callers.
+typedef struct zen_compiled_s zen_compiled_t;
+zen_compiled_t *zencode_compile(const char *script, const char *conf);
+zen_compiled_t *zencode_compile_tobuf(const char *script, const char *conf,
+                                      char *stderr_buf, size_t stderr_len);
+zen_compiled_t *zencode_compiled_load(const char *dump, const char *conf);
+const char *zencode_compiled_digest(const zen_compiled_t *compiled);
+const char *zencode_compiled_dump(const zen_compiled_t *compiled);
+void zencode_compiled_free(zen_compiled_t *compiled);
+int  zencode_exec_compiled(zen_compiled_t *compiled,
+                           const char *keys, const char *data,
+                           const char *extra, const char *context);
+int  zencode_exec_compiled_tobuf(zen_compiled_t *compiled,
+                                 const char *keys, const char *data,
+                                 const char *extra, const char *context,
+                                 char *stdout_buf, size_t stdout_len,
+                                 char *stderr_buf, size_t stderr_len);
+// lower level api, same as zen_exec_zencode on an initialized context
+int  zen_exec_compiled(zenroom_t *Z, zen_compiled_t *compiled);
+// same as zen_pool_exec with a compiled contract and its conf
+int  zen_pool_exec_compiled(zen_pool_t *pool, zen_compiled_t *compiled,
+                            const char *keys, const char *data,
+                            const char *extra, const char *context);
+int  zen_pool_exec_compiled_tobuf(zen_pool_t *pool, zen_compiled_t *compiled,
+                                  const char *keys, const char *data,
+                                  const char *extra, const char *context,
+                                  char *stdout_buf, size_t stdout_len,
+                                  char *stderr_buf, size_t stderr_len);
+
 #define MAX_LINE 1024 // 1KiB maximum length for a newline terminated line (Zencode)
 
 #ifndef MAX_ZENCODE_LINE
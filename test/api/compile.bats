@@ -0,0 +1,80 @@
+# setup paths for BATS test units
+setup() {
+    bats_require_minimum_version 1.5.0
+    T="$BATS_TEST_DIRNAME"
+    TR=`cd "$T"/.. && pwd`
+    R=`cd "$TR"/.. && pwd`
+    TMP="$BATS_TEST_TMPDIR"
+    load "$TR"/test_helper/bats-support/load
+    load "$TR"/test_helper/bats-assert/load
+    load "$TR"/test_helper/bats-file/load
+    ZTMP="$BATS_FILE_TMPDIR"
+    cd $ZTMP
+    SEED='74eeeab870a394175fae808dd5dd3b047f3ee2d6a8d01e14bff94271565625e98a63babe8dd6cbea6fedf3e19de4bc80314b861599522e44409fdd20f7cd6cfc'
+}
+
+@test "COMPILE API :: Compile tests" {
+    LDADD="-L$R -lzenroom"
+    CFLAGS="$CFLAGS -I$R/src"
+    cc ${CFLAGS} -ggdb -o compile_exec $T/compile_exec.c ${LDADD}
+    cat <<EOF > random.zen
+Scenario 'ecdh': keys
+Given nothing
+When I create the ecdh key
+and I create the random of '256' bits
+Then print the 'keyring'
+and print the 'random'
+EOF
+    cat <<EOF > items.zen
+Given I have a 'string array' named 'items'
+Given I have a 'string' named 'wanted'
+When I create the 'string array' named 'found'
+Foreach 'item' in 'items'
+If I verify 'item' is equal to 'wanted'
+When I move 'item' in 'found'
+EndIf
+EndForeach
+Then print the 'found'
+EOF
+    cat <<EOF > items.json
+{"items":["apple","pear","apple"],"wanted":"apple"}
+EOF
+}
+
+@test "COMPILE API :: Digest is the sha256 of the script" {
+    run --separate-stderr env LD_LIBRARY_PATH=$R ./compile_exec compile "" random.zen random.json
+    assert_success
+    digest=`sha256sum random.zen | cut -d' ' -f1`
+    assert_output "digest: $digest"
+}
+
+@test "COMPILE API :: Compiled executions match parsed ones" {
+    LD_LIBRARY_PATH=$R ./compile_exec compile "rngseed=hex:$SEED" \
+                   random.zen random.json
+    $R/zenroom -c "rngseed=hex:$SEED" -z random.zen > cold.json
+    LD_LIBRARY_PATH=$R ./compile_exec exec "rngseed=hex:$SEED" \
+                   random.json "" 2 > compiled.txt
+    cold=`cat cold.json`
+    run grep -c "exitcode: 0" compiled.txt
+    assert_output '3'
+    run grep -v exitcode compiled.txt
+    assert_output "$cold
+$cold
+$cold"
+}
+
+@test "COMPILE API :: Branching and loops are compiled" {
+    LD_LIBRARY_PATH=$R ./compile_exec compile "" items.zen items_compiled.json
+    $R/zenroom -a items.json -z items.zen > cold.json
+    LD_LIBRARY_PATH=$R ./compile_exec exec "" \
+                   items_compiled.json items.json 1 > compiled.txt
+    run grep -v exitcode compiled.txt
+    assert_output "`cat cold.json`
+`cat cold.json`"
+}
+
+@test "COMPILE API :: Compiled forms of another build are refused" {
+    sed 's/"zenroom":"[^"]*"/"zenroom":"other"/' random.json > other.json
+    run -1 --separate-stderr env LD_LIBRARY_PATH=$R ./compile_exec exec "" other.json
+    assert_output 'load failed'
+}
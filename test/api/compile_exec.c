@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zenroom.h>
+
+// usage: compile_exec compile conf script.zen compiled.json
+//        compile_exec exec conf compiled.json [keys.json] [times]
+// compiles a script saving its compiled form and printing its digest,
+// or loads a compiled form and executes it on a pool made of one VM
+static char *load(const char *path) {
+  FILE *fd = fopen(path, "r");
+  if(!fd) { fprintf(stderr,"Cannot open %s\n",path); exit(1); }
+  fseek(fd, 0, SEEK_END);
+  long len = ftell(fd);
+  fseek(fd, 0, SEEK_SET);
+  char *buf = calloc(len+1, 1);
+  if(fread(buf, 1, len, fd) != (size_t)len) { fprintf(stderr,"Cannot read %s\n",path); exit(1); }
+  fclose(fd);
+  return buf;
+}
+
+int main(int argc, char **argv) {
+  if(argc<5 && !(argc==4 && strcmp(argv[1],"exec")==0)) {
+    fprintf(stderr,"usage: %s compile|exec conf file [...]\n",argv[0]); exit(1); }
+  char *in = load(argv[3]);
+  if(strcmp(argv[1],"compile")==0) {
+    zen_compiled_t *c = zencode_compile(in, argv[2]);
+    if(!c) { fprintf(stdout,"compile failed\n"); exit(1); }
+    FILE *fd = fopen(argv[4], "w");
+    fputs(zencode_compiled_dump(c), fd);
+    fclose(fd);
+    fprintf(stdout,"digest: %s\n",zencode_compiled_digest(c));
+    zencode_compiled_free(c);
+    free(in);
+    exit(0);
+  }
+  zen_compiled_t *c = zencode_compiled_load(in, argv[2]);
+  if(!c) { fprintf(stdout,"load failed\n"); exit(1); }
+  char *keys = argc>4 && argv[4][0] ? load(argv[4]) : NULL;
+  int times = argc>5 ? atoi(argv[5]) : 1;
+  fprintf(stdout,"exitcode: %i\n",zencode_exec_compiled(c, keys, NULL, NULL, NULL));
+  fflush(stdout);
+  zen_pool_t *pool = zen_pool_new(1, argv[2]);
+  if(!pool) { fprintf(stderr,"Abort on pool init\n"); exit(1); }
+  for(int i=0; i<times; i++) {
+    int res = zen_pool_exec_compiled(pool, c, keys, NULL, NULL, NULL);
+    fprintf(stdout,"exitcode: %i\n",res);
+    fflush(stdout);
+  }
+  zen_pool_free(pool);
+  zencode_compiled_free(c);
+  free(keys);
+  free(in);
+  exit(0);
+}
@@ -0,0 +1,63 @@
+# setup paths for BATS test units
+setup() {
+    bats_require_minimum_version 1.5.0
+    T="$BATS_TEST_DIRNAME"
+    TR=`cd "$T"/.. && pwd`
+    R=`cd "$TR"/.. && pwd`
+    TMP="$BATS_TEST_TMPDIR"
+    load "$TR"/test_helper/bats-support/load
+    load "$TR"/test_helper/bats-assert/load
+    load "$TR"/test_helper/bats-file/load
+    ZTMP="$BATS_FILE_TMPDIR"
+    cd $ZTMP
+    SEED='74eeeab870a394175fae808dd5dd3b047f3ee2d6a8d01e14bff94271565625e98a63babe8dd6cbea6fedf3e19de4bc80314b861599522e44409fdd20f7cd6cfc'
+}
+
+@test "POOL API :: Compile tests" {
+    LDADD="-L$R -lzenroom"
+    CFLAGS="$CFLAGS -I$R/src"
+    cc ${CFLAGS} -ggdb -o pool_exec $T/pool_exec.c ${LDADD}
+    cat <<EOF > random.zen
+Scenario 'ecdh': keys
+Given nothing
+When I create the ecdh key
+and I create the random of '256' bits
+and I create the array of '4' random objects of '64' bits
+Then print the 'keyring'
+and print the 'random'
+and print the 'array'
+EOF
+    cat <<EOF > missing.zen
+Given I have a 'string' named 'missing'
+Then print the 'missing'
+EOF
+    cat <<EOF > noscenario.zen
+Given nothing
+When I create the ecdh key
+Then print the 'keyring'
+EOF
+}
+
+@test "POOL API :: Warm executions are deterministic as cold ones" {
+    $R/zenroom -c "rngseed=hex:$SEED" -z random.zen > cold.json
+    LD_LIBRARY_PATH=$R ./pool_exec "rngseed=hex:$SEED" \
+                   random.zen random.zen missing.zen random.zen > warm.txt
+    cold=`cat cold.json`
+    run sed -n 1p warm.txt
+    assert_output "$cold"
+    run sed -n 3p warm.txt
+    assert_output "$cold"
+    run sed -n 5p warm.txt
+    assert_output 'exitcode: 1'
+    run sed -n 6p warm.txt
+    assert_output "$cold"
+}
+
+@test "POOL API :: Scenarios loaded by a run are not kept by the next" {
+    LD_LIBRARY_PATH=$R ./pool_exec "" \
+                   noscenario.zen random.zen noscenario.zen > scenarios.txt
+    run grep exitcode scenarios.txt
+    assert_output 'exitcode: 1
+exitcode: 0
+exitcode: 1'
+}
@@ -0,0 +1,32 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <zenroom.h>
+
+// usage: pool_exec conf script.zen [script.zen ...]
+// executes all scripts in sequence on a pool made of one VM
+static char *load(const char *path) {
+  FILE *fd = fopen(path, "r");
+  if(!fd) { fprintf(stderr,"Cannot open %s\n",path); exit(1); }
+  fseek(fd, 0, SEEK_END);
+  long len = ftell(fd);
+  fseek(fd, 0, SEEK_SET);
+  char *buf = calloc(len+1, 1);
+  if(fread(buf, 1, len, fd) != (size_t)len) { fprintf(stderr,"Cannot read %s\n",path); exit(1); }
+  fclose(fd);
+  return buf;
+}
+
+int main(int argc, char **argv) {
+  if(argc<3) { fprintf(stderr,"usage: %s conf script.zen [...]\n",argv[0]); exit(1); }
+  zen_pool_t *pool = zen_pool_new(1, argv[1]);
+  if(!pool) { fprintf(stderr,"Abort on pool init\n"); exit(1); }
+  for(int i=2; i<argc; i++) {
+    char *script = load(argv[i]);
+    int res = zen_pool_exec(pool, script, argv[1], NULL, NULL, NULL, NULL);
+    fprintf(stdout,"exitcode: %i\n",res);
+    fflush(stdout);
+    free(script);
+  }
+  zen_pool_free(pool);
+  exit(0);
+}
@@ -0,0 +1,180 @@
+/* Zenroom AES-GCM and AES-CTR benchmark
+ *
+ * Checks the AES-NI backend against milagro's AES_GCM_ENCRYPT on all
+ * key sizes, with 12 and 16 bytes IVs, headers up to 40 bytes and
+ * messages up to 600 bytes, fed at once and in random chunks to the
+ * streaming API, then measures the throughput of each backend on
+ * buffers of the given size.
+ *
+ * usage: aes_bench [size] [seconds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <amcl.h>
+#include <aes_gcm.h>
+
+extern void AES_GCM_ENCRYPT(octet *K, octet *IV, octet *H, octet *P, octet *C, octet *T);
+
+static const char *backends[] = { "milagro", "aes-ni" };
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static octet oct(char *val, int len) {
+	octet o;
+	o.val = val;
+	o.len = o.max = len;
+	return o;
+}
+
+// streams in through random chunks
+static void gcm_stream(int decrypt, char *key, int nk, char *iv, int niv,
+                       char *aad, int naad, char *in, int len, char *out, char *tag) {
+	aes_gcm c;
+	int n;
+	aes_gcm_init(&c, decrypt, key, nk, iv, niv, aad, naad);
+	while(len) {
+		n = rand() % 150;
+		if(n > len) n = len;
+		aes_gcm_update(&c, out, in, n);
+		in += n; out += n; len -= n;
+	}
+	aes_gcm_final(&c, tag);
+}
+
+static int check_gcm(int backend, char *buf) {
+	static const int keys[] = { 16, 24, 32 };
+	static const int ivs[] = { 12, 16, 7 };
+	char ref[600], out[600], dec[600], rtag[16], tag[16];
+	int k, v, naad, len;
+	octet K, IV, H, P, C, T, O, D;
+	for(k=0; k<3; k++) for(v=0; v<3; v++)
+	for(naad=0; naad<=40; naad+=13)
+	for(len=0; len<=600; len++) {
+		K = oct(buf, keys[k]); IV = oct(buf+32, ivs[v]);
+		H = oct(buf+48, naad); P = oct(buf+100, len);
+		C = oct(ref, len); T = oct(rtag, 16);
+		AES_GCM_ENCRYPT(&K, &IV, &H, &P, &C, &T);
+		aes_backend(backend);
+		O = oct(out, len); T = oct(tag, 16);
+		AES_GCM_encrypt(&K, &IV, &H, &P, &O, &T);
+		if(memcmp(ref, out, len) || memcmp(rtag, tag, 16)) {
+			fprintf(stderr,"gcm %s encrypt mismatch key %u iv %u aad %u len %u\n",
+			        backends[backend], keys[k], ivs[v], naad, len);
+			return 1; }
+		memset(out, 0, len);
+		gcm_stream(0, K.val, K.len, IV.val, IV.len, H.val, H.len, P.val, len, out, tag);
+		if(memcmp(ref, out, len) || memcmp(rtag, tag, 16)) {
+			fprintf(stderr,"gcm %s stream mismatch key %u iv %u aad %u len %u\n",
+			        backends[backend], keys[k], ivs[v], naad, len);
+			return 1; }
+		gcm_stream(1, K.val, K.len, IV.val, IV.len, H.val, H.len, ref, len, dec, tag);
+		if(memcmp(buf+100, dec, len) || memcmp(rtag, tag, 16)) {
+			fprintf(stderr,"gcm %s stream decrypt mismatch key %u iv %u aad %u len %u\n",
+			        backends[backend], keys[k], ivs[v], naad, len);
+			return 1; }
+		C = oct(ref, len); D = oct(out, len); T = oct(tag, 16);
+		AES_GCM_decrypt(&K, &IV, &H, &C, &D, &T);
+		if(memcmp(buf+100, out, len) || memcmp(rtag, tag, 16)) {
+			fprintf(stderr,"gcm %s decrypt mismatch key %u iv %u aad %u len %u\n",
+			        backends[backend], keys[k], ivs[v], naad, len);
+			return 1; }
+	}
+	return 0;
+}
+
+static int check_ctr(int backend, char *buf) {
+	// NIST SP800-38A F.5.1 CTR-AES128.Encrypt
+	static const unsigned char key[16] = {
+		0x2b,0x7e,0x15,0x16,0x28,0xae,0xd2,0xa6,0xab,0xf7,0x15,0x88,0x09,0xcf,0x4f,0x3c };
+	static const unsigned char ctr[16] = {
+		0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xfe,0xff };
+	static const unsigned char pt[64] = {
+		0x6b,0xc1,0xbe,0xe2,0x2e,0x40,0x9f,0x96,0xe9,0x3d,0x7e,0x11,0x73,0x93,0x17,0x2a,
+		0xae,0x2d,0x8a,0x57,0x1e,0x03,0xac,0x9c,0x9e,0xb7,0x6f,0xac,0x45,0xaf,0x8e,0x51,
+		0x30,0xc8,0x1c,0x46,0xa3,0x5c,0xe4,0x11,0xe5,0xfb,0xc1,0x19,0x1a,0x0a,0x52,0xef,
+		0xf6,0x9f,0x24,0x45,0xdf,0x4f,0x9b,0x17,0xad,0x2b,0x41,0x7b,0xe6,0x6c,0x37,0x10 };
+	static const unsigned char ct[64] = {
+		0x87,0x4d,0x61,0x91,0xb6,0x20,0xe3,0x26,0x1b,0xef,0x68,0x64,0x99,0x0d,0xb6,0xce,
+		0x98,0x06,0xf6,0x6b,0x79,0x70,0xfd,0xff,0x86,0x17,0x18,0x7b,0xb9,0xff,0xfd,0xff,
+		0x5a,0xe4,0xdf,0x3e,0xdb,0xd5,0xd3,0x5e,0x5b,0x4f,0x09,0x02,0x0d,0xb0,0x3e,0xab,
+		0x1e,0x03,0x1d,0xda,0x2f,0xbe,0x03,0xd1,0x79,0x21,0x70,0xa0,0xf3,0x00,0x9c,0xee };
+	char ref[1100], out[1100];
+	unsigned char iv[16];
+	int k, len;
+	aes_backend(backend);
+	aes_ctr(out, (const char*)pt, 64, (const char*)key, 16, ctr);
+	if(memcmp(out, ct, 64)) {
+		fprintf(stderr,"ctr %s NIST vector mismatch\n", backends[backend]);
+		return 1; }
+	// counters wrapping over 32 and 64 bits
+	memset(iv, 0xff, 16);
+	for(k=16; k<=32; k+=8)
+	for(len=0; len<=1100; len+=11) {
+		iv[7] = (unsigned char)len;
+		iv[15] = (unsigned char)(len >> 2);
+		aes_backend(AES_MILAGRO);
+		aes_ctr(ref, buf+64, len, buf, k, iv);
+		aes_backend(backend);
+		aes_ctr(out, buf+64, len, buf, k, iv);
+		if(memcmp(ref, out, len)) {
+			fprintf(stderr,"ctr %s mismatch key %u len %u\n", backends[backend], k, len);
+			return 1; }
+	}
+	return 0;
+}
+
+static void bench(const char *what, int backend, size_t size, double secs,
+                  char *buf, char *out) {
+	double start = now(), end;
+	long n = 0;
+	unsigned char iv[16];
+	char tag[16];
+	octet K = oct(buf, 32), IV = oct(buf+32, 12), H = oct(buf+48, 20);
+	octet P = oct(buf, (int)size), C = oct(out, (int)size), T = oct(tag, 16);
+	memcpy(iv, buf+32, 16);
+	aes_backend(backend);
+	do {
+		int i;
+		for(i=0; i<16; i++) {
+			if(!strcmp(what, "gcm")) AES_GCM_encrypt(&K, &IV, &H, &P, &C, &T);
+			else if(!strcmp(what, "ctr")) aes_ctr(out, buf, (int)size, buf, 32, iv);
+			else AES_GCM_ENCRYPT(&K, &IV, &H, &P, &C, &T);
+		}
+		n += 16;
+		end = now();
+	} while(end - start < secs);
+	fprintf(stderr,"%-8s %-10s %8.3f GB/s\n", what, backends[backend],
+	        (double)n * (double)size / (end - start) / 1e9);
+}
+
+int main(int argc, char **argv) {
+	size_t size = argc > 1 ? (size_t)atol(argv[1]) : 16384;
+	double secs = argc > 2 ? atof(argv[2]) : 1.0;
+	size_t max = size > 2048 ? size : 2048;
+	char *buf = malloc(max);
+	char *out = malloc(max);
+	int cpu = aes_backend(-1), backend;
+	size_t i;
+
+	srand(1);
+	for(i=0; i<max; i++) buf[i] = (char)rand();
+	for(backend = AES_MILAGRO; backend <= cpu; backend++)
+		if(check_gcm(backend, buf) || check_ctr(backend, buf)) return 1;
+
+	fprintf(stderr,"AES-256 benchmark on %zu bytes, best backend %s\n",
+	            size, backends[cpu]);
+	bench("gcm-pbc", AES_MILAGRO, size, secs, buf, out);
+	for(backend = AES_MILAGRO; backend <= cpu; backend++) {
+		bench("gcm", backend, size, secs, buf, out);
+		bench("ctr", backend, size, secs, buf, out);
+	}
+	free(buf); free(out);
+	return 0;
+}
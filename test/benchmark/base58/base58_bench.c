@@ -0,0 +1,226 @@
+/* Zenroom base58 benchmark
+ *
+ * Compares the base58 conversions in src/base58.c with the byte at a
+ * time implementation they replaced, reproduced below, over a sweep
+ * of sizes. Outputs of both are checked to be identical, including
+ * leading zero bytes and their '1' digits.
+ *
+ * usage: base58_bench [max size] [seconds per size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+extern const int8_t b58digits_map[];
+extern const char b58digits_ordered[];
+extern int b58tobin(void *bin, size_t *binszp, const char *b58, size_t b58sz);
+extern int b58enc(char *b58, size_t *b58sz, const void *data, size_t binsz);
+
+typedef uint64_t b58_maxint_t;
+typedef uint32_t b58_almostmaxint_t;
+#define b58_almostmaxint_bits (sizeof(b58_almostmaxint_t) * 8)
+static const b58_almostmaxint_t b58_almostmaxint_mask = ((((b58_maxint_t)1) << b58_almostmaxint_bits) - 1);
+
+
+
+static int ref_b58tobin(void *bin, size_t *binszp, const char *b58, size_t b58sz)
+{
+	size_t binsz = *binszp;
+	const unsigned char *b58u = (void*)b58;
+	unsigned char *binu = bin;
+	size_t outisz = (binsz + sizeof(b58_almostmaxint_t) - 1) / sizeof(b58_almostmaxint_t);
+	b58_almostmaxint_t outi[outisz];
+	b58_maxint_t t;
+	b58_almostmaxint_t c;
+	size_t i, j;
+	uint8_t bytesleft = binsz % sizeof(b58_almostmaxint_t);
+	b58_almostmaxint_t zeromask = bytesleft ? (b58_almostmaxint_mask << (bytesleft * 8)) : 0;
+	unsigned zerocount = 0;
+	
+	if (!b58sz)
+		b58sz = strlen(b58);
+	
+	for (i = 0; i < outisz; ++i) {
+		outi[i] = 0;
+	}
+	
+	// Leading zeros, just count
+	for (i = 0; i < b58sz && b58u[i] == '1'; ++i)
+		++zerocount;
+	
+	for ( ; i < b58sz; ++i)
+	{
+		if (b58u[i] & 0x80)
+			// High-bit set on invalid digit
+			return 0;
+		if (b58digits_map[b58u[i]] == -1)
+			// Invalid base58 digit
+			return 0;
+		c = (unsigned)b58digits_map[b58u[i]];
+		for (j = outisz; j--; )
+		{
+			t = ((b58_maxint_t)outi[j]) * 58 + c;
+			c = t >> b58_almostmaxint_bits;
+			outi[j] = t & b58_almostmaxint_mask;
+		}
+		if (c)
+			// Output number too big (carry to the next int32)
+			return 0;
+		if (outi[0] & zeromask)
+			// Output number too big (last int32 filled too far)
+			return 0;
+	}
+	
+	j = 0;
+	if (bytesleft) {
+		for (i = bytesleft; i > 0; --i) {
+			*(binu++) = (outi[0] >> (8 * (i - 1))) & 0xff;
+		}
+		++j;
+	}
+	
+	for (; j < outisz; ++j)
+	{
+		for (i = sizeof(*outi); i > 0; --i) {
+			*(binu++) = (outi[j] >> (8 * (i - 1))) & 0xff;
+		}
+	}
+	
+	// Count canonical base58 byte count
+	binu = bin;
+	for (i = 0; i < binsz; ++i)
+	{
+		if (binu[i])
+			break;
+		--*binszp;
+	}
+	*binszp += zerocount;
+	
+	return 1;
+}
+
+static int ref_b58enc(char *b58, size_t *b58sz, const void *data, size_t binsz)
+{
+	const uint8_t *bin = data;
+	int carry;
+	size_t i, j, high, zcount = 0;
+	size_t size;
+	
+	while (zcount < binsz && !bin[zcount])
+		++zcount;
+	
+	size = (binsz - zcount) * 138 / 100 + 1;
+	uint8_t buf[size];
+	memset(buf, 0, size);
+	
+	for (i = zcount, high = size - 1; i < binsz; ++i, high = j)
+	{
+		for (carry = bin[i], j = size - 1; (j > high) || carry; --j)
+		{
+			carry += 256 * buf[j];
+			buf[j] = carry % 58;
+			carry /= 58;
+			if (!j) {
+				// Otherwise j wraps to maxint which is > high
+				break;
+			}
+		}
+	}
+	
+	for (j = 0; j < size && !buf[j]; ++j);
+	
+	if (*b58sz <= zcount + size - j)
+	{
+		*b58sz = zcount + size - j + 1;
+		return 0;
+	}
+	
+	if (zcount)
+		memset(b58, '1', zcount);
+	for (i = zcount; j < size; ++i, ++j)
+		b58[i] = b58digits_ordered[buf[j]];
+	b58[i] = '\0';
+	*b58sz = i + 1;
+	
+	return 1;
+}
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static char *txt;
+static unsigned char *bin, *out;
+static size_t txtlen;
+
+static void enc_new(size_t n) { size_t sz = (n << 1) + 2; b58enc(txt, &sz, bin, n); }
+static void enc_ref(size_t n) { size_t sz = (n << 1) + 2; ref_b58enc(txt, &sz, bin, n); }
+static void dec_new(size_t n) { size_t sz = n; b58tobin(out, &sz, txt, txtlen); }
+static void dec_ref(size_t n) { size_t sz = n; ref_b58tobin(out, &sz, txt, txtlen); }
+
+static double rate(void (*f)(size_t), size_t n, double secs) {
+	double start = now(), end;
+	long i = 0;
+	do {
+		f(n);
+		i++;
+		end = now();
+	} while(end - start < secs);
+	return (double)i / (end - start);
+}
+
+static int check(size_t n, size_t zeros) {
+	char *a = malloc((n << 1) + 2), *b = malloc((n << 1) + 2);
+	unsigned char *x = malloc(n + 4), *y = malloc(n + 4);
+	size_t i, sa = (n << 1) + 2, sb = sa, xa = n + 4, xb = n + 4;
+	int res = 0;
+	for(i=0; i<n; i++) bin[i] = i < zeros ? 0 : (unsigned char)rand();
+	if(!b58enc(a, &sa, bin, n) | !ref_b58enc(b, &sb, bin, n)
+	   || sa != sb || strcmp(a, b)) {
+		fprintf(stderr,"encode mismatch at size %zu\n", n);
+		res = 1; goto end; }
+	if(!b58tobin(x, &xa, a, 0) | !ref_b58tobin(y, &xb, a, 0)
+	   || xa != xb || memcmp(x, y, n + 4)) {
+		fprintf(stderr,"decode mismatch at size %zu\n", n);
+		res = 1; goto end; }
+end:
+	free(a); free(b); free(x); free(y);
+	return res;
+}
+
+int main(int argc, char **argv) {
+	size_t max = argc > 1 ? (size_t)atol(argv[1]) : 16384;
+	double secs = argc > 2 ? atof(argv[2]) : 0.5;
+	size_t n;
+	bin = malloc(max + 4);
+	out = malloc(max + 4);
+	txt = malloc((max << 1) + 2);
+
+	srand(1);
+	for(n=0; n<=1200 && n<=max; n++)
+		if(check(n, n % 5)) return 1;
+	for(n=1201; n<=max; n+=n/3)
+		if(check(n, 0) || check(n, 7)) return 1;
+
+	fprintf(stderr,"%8s %12s %12s %8s %12s %12s %8s\n", "bytes",
+	        "enc ref/s", "enc new/s", "speedup", "dec ref/s", "dec new/s", "speedup");
+	for(n=32; n<=max; n<<=1) {
+		size_t i;
+		double er, en, dr, dn;
+		for(i=0; i<n; i++) bin[i] = (unsigned char)rand();
+		txtlen = (n << 1) + 2;
+		b58enc(txt, &txtlen, bin, n);
+		txtlen--;
+		er = rate(enc_ref, n, secs); en = rate(enc_new, n, secs);
+		dr = rate(dec_ref, n, secs); dn = rate(dec_new, n, secs);
+		fprintf(stderr,"%8zu %12.0f %12.0f %7.1fx %12.0f %12.0f %7.1fx\n",
+		        n, er, en, en / er, dr, dn, dn / dr);
+	}
+	free(bin); free(out); free(txt);
+	return 0;
+}
@@ -0,0 +1,143 @@
+/* Zenroom hex, base64 and url64 codec benchmark
+ *
+ * Checks every SIMD level against the scalar code on all lengths up
+ * to 512 bytes, then measures encode and decode throughput of each
+ * level on buffers of the given size. The milagro base64 codec that
+ * used to back OCTET:base64() is measured as a reference.
+ *
+ * usage: codec_bench [size] [seconds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <amcl.h>
+#include <encoding.h>
+
+static const char *levels[] = { "scalar", "sse4.1", "avx2" };
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+typedef struct {
+	const char *name;
+	size_t (*enc)(char *dst, const char *src, size_t len);
+	int (*dec)(char *dst, const char *src, size_t len);
+} codec;
+
+static size_t hex_enc(char *dst, const char *src, size_t len) {
+	hex_encode(dst, src, len);
+	return len << 1;
+}
+
+static const codec codecs[] = {
+	{ "hex",    hex_enc,       hex_decode },
+	{ "base64", base64_encode, base64_decode },
+	{ "url64",  url64_encode,  url64_decode },
+	{ NULL, NULL, NULL }
+};
+
+static int check(const codec *c, int level, const char *buf, char *a, char *b, char *d) {
+	size_t len, na, nb, i;
+	for(len=0; len<=512; len++) {
+		encoding_simd(ENCODING_SCALAR);
+		na = c->enc(a, buf, len);
+		encoding_simd(level);
+		nb = c->enc(b, buf, len);
+		if(na != nb || memcmp(a, b, na)) {
+			fprintf(stderr,"%s %s encode mismatch at length %zu\n",
+			        c->name, levels[level], len);
+			return 1; }
+		if(c->dec(d, b, nb) != (int)len || memcmp(d, buf, len)) {
+			fprintf(stderr,"%s %s decode mismatch at length %zu\n",
+			        c->name, levels[level], len);
+			return 1; }
+		// a single invalid char anywhere must be caught
+		for(i=0; i<nb; i+=7) {
+			char save = b[i];
+			b[i] = '!';
+			if(c->dec(d, b, nb) >= 0) {
+				fprintf(stderr,"%s %s invalid char at %zu/%zu accepted\n",
+				        c->name, levels[level], i, nb);
+				return 1; }
+			b[i] = save;
+		}
+	}
+	return 0;
+}
+
+static void bench(const char *name, const char *what, size_t size, double secs,
+                  size_t (*enc)(char*,const char*,size_t),
+                  int (*dec)(char*,const char*,size_t),
+                  char *buf, char *txt, size_t txtlen, char *out) {
+	double start = now(), end;
+	long n = 0;
+	do {
+		int i;
+		for(i=0; i<64; i++) {
+			if(enc) enc(txt, buf, size);
+			else dec(out, txt, txtlen);
+		}
+		n += 64;
+		end = now();
+	} while(end - start < secs);
+	fprintf(stderr,"%-8s %-8s %-7s %9.1f MB/s\n", name, what,
+	        enc ? "encode" : "decode",
+	        (double)n * (double)size / (end - start) / 1e6);
+}
+
+static octet b64oct;
+static size_t milagro_enc(char *dst, const char *src, size_t len) {
+	b64oct.len = b64oct.max = (int)len;
+	b64oct.val = (char*)src;
+	OCT_tobase64(dst, &b64oct);
+	return 0;
+}
+static int milagro_dec(char *dst, const char *src, size_t len) {
+	(void)len;
+	b64oct.len = 0;
+	b64oct.val = dst;
+	OCT_frombase64(&b64oct, (char*)src);
+	return b64oct.len;
+}
+
+int main(int argc, char **argv) {
+	size_t size = argc > 1 ? (size_t)atol(argv[1]) : 4096;
+	double secs = argc > 2 ? atof(argv[2]) : 1.0;
+	size_t max = size > 512 ? size : 512;
+	char *buf = malloc(max);
+	char *txt = malloc((max << 1) + 4);
+	char *tmp = malloc((max << 1) + 4);
+	char *out = malloc(max + 4);
+	const codec *c;
+	int cpu = encoding_simd(-1), level;
+	size_t i, txtlen;
+
+	srand(1);
+	for(i=0; i<max; i++) buf[i] = (char)rand();
+	for(level = ENCODING_SSE41; level <= cpu; level++)
+		for(c = codecs; c->name; c++)
+			if(check(c, level, buf, txt, tmp, out)) return 1;
+
+	fprintf(stderr,"codec benchmark on %zu bytes, best level %s\n", size, levels[cpu]);
+	for(c = codecs; c->name; c++) {
+		for(level = ENCODING_SCALAR; level <= cpu; level++) {
+			encoding_simd(level);
+			txtlen = c->enc(txt, buf, size);
+			bench(c->name, levels[level], size, secs, c->enc, NULL, buf, txt, txtlen, out);
+			bench(c->name, levels[level], size, secs, NULL, c->dec, buf, txt, txtlen, out);
+		}
+		if(c->enc == base64_encode) {
+			txtlen = base64_encode(txt, buf, size);
+			txt[txtlen] = 0;
+			bench(c->name, "milagro", size, secs, milagro_enc, NULL, buf, txt, txtlen, out);
+			bench(c->name, "milagro", size, secs, NULL, milagro_dec, buf, txt, txtlen, out);
+		}
+	}
+	free(buf); free(txt); free(tmp); free(out);
+	return 0;
+}
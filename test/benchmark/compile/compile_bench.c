@@ -0,0 +1,109 @@
+/* Zenroom compiled contract benchmark
+ *
+ * Compares the throughput of executions parsing the script every
+ * time with executions of the same script compiled once, both on a
+ * warm VM pool and cold. Contract output goes to stdout, results to
+ * stderr.
+ *
+ * usage: compile_bench [iterations] [script.zen] [keys.json]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <zenroom.h>
+
+static const char *default_script =
+	"Given I have a 'string dictionary' named 'sale'\n"
+	"and I have a 'string array' named 'items'\n"
+	"and I have a 'string' named 'buyer'\n"
+	"When I create the 'string array' named 'sold'\n"
+	"and I create the 'string dictionary' named 'receipt'\n"
+	"Foreach 'item' in 'items'\n"
+	"If I verify 'item' is found in 'sale'\n"
+	"When I copy 'item' in 'sold'\n"
+	"EndIf\n"
+	"EndForeach\n"
+	"When I create the size of 'sold'\n"
+	"and I copy 'buyer' in 'receipt'\n"
+	"and I copy 'size' in 'receipt'\n"
+	"and I create the hash of 'receipt'\n"
+	"and I rename 'hash' to 'receipt hash'\n"
+	"If I verify 'buyer' is found in 'receipt'\n"
+	"Then print the string 'receipt for buyer'\n"
+	"EndIf\n"
+	"Then print the 'sold'\n"
+	"and print the 'receipt'\n"
+	"and print the 'receipt hash'\n";
+
+static const char *default_keys =
+	"{\"sale\":{\"cow\":\"100\",\"hen\":\"5\"},"
+	"\"items\":[\"cow\",\"hen\",\"pig\"],\"buyer\":\"Alice\"}";
+
+static char *load(const char *path) {
+	FILE *fd = fopen(path, "r");
+	if(!fd) { fprintf(stderr,"Cannot open %s\n",path); exit(1); }
+	fseek(fd, 0, SEEK_END);
+	long len = ftell(fd);
+	fseek(fd, 0, SEEK_SET);
+	char *buf = calloc(len+1, 1);
+	if(fread(buf, 1, len, fd) != (size_t)len) {
+		fprintf(stderr,"Cannot read %s\n",path); exit(1); }
+	fclose(fd);
+	return buf;
+}
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void report(const char *name, int iter, double secs) {
+	fprintf(stderr,"%s %.3f s\t%.1f exec/s\t%.3f ms/exec\n",
+			name, secs, iter/secs, secs*1000/iter);
+}
+
+int main(int argc, char **argv) {
+	int iter = argc > 1 ? atoi(argv[1]) : 1000;
+	char *script = argc > 2 ? load(argv[2]) : (char*)default_script;
+	char *keys = argc > 3 ? load(argv[3]) :
+		argc > 2 ? NULL : (char*)default_keys;
+	const char *conf = "debug=0";
+	double start, t;
+	int i, res = 0;
+
+	start = now();
+	zen_compiled_t *compiled = zencode_compile(script, conf);
+	t = now() - start;
+	if(!compiled) { fprintf(stderr,"Compilation failed\n"); exit(1); }
+	fprintf(stderr,"compilation: %.3f ms\n", t*1000);
+
+	zen_pool_t *pool = zen_pool_new(1, conf);
+	if(!pool) { fprintf(stderr,"Pool initialisation failed\n"); exit(1); }
+	start = now();
+	for(i=0; i<iter; i++)
+		res |= zen_pool_exec(pool, script, conf, keys, NULL, NULL, NULL);
+	report("warm parsed:  ", iter, now() - start);
+	start = now();
+	for(i=0; i<iter; i++)
+		res |= zen_pool_exec_compiled(pool, compiled, keys, NULL, NULL, NULL);
+	report("warm compiled:", iter, now() - start);
+	zen_pool_free(pool);
+
+	iter = iter / 10 + 1;
+	start = now();
+	for(i=0; i<iter; i++)
+		res |= zencode_exec(script, conf, keys, NULL);
+	report("cold parsed:  ", iter, now() - start);
+	start = now();
+	for(i=0; i<iter; i++)
+		res |= zencode_exec_compiled(compiled, keys, NULL, NULL, NULL);
+	report("cold compiled:", iter, now() - start);
+	zencode_compiled_free(compiled);
+
+	if(res) fprintf(stderr,"(with errors)\n");
+	if(argc > 2) free(script);
+	if(argc > 3) free(keys);
+	return res;
+}
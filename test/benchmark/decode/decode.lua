@@ -0,0 +1,51 @@
+-- Transaction and RLP decoding benchmark
+--
+-- Measures the decodings per second of an ethereum RLP list and of a
+-- raw bitcoin transaction, both parsed slicing a large octet in many
+-- sub-sections: RLP fields are size bytes long, transaction inputs are
+-- made of small fields.
+
+local ETH <const> = require'crypto_ethereum'
+local BTC <const> = require'crypto_bitcoin'
+local params <const> = JSON.decode(DATA)
+local count <const> = params.count or 1000
+local size <const> = params.size or 32
+
+local fields = { }
+for i = 1, count do fields[i] = O.random(size) end
+local rlp <const> = ETH.encodeRLP(fields)
+
+-- raw transaction with count inputs and a single segwit v0 output
+local le <const> = O.from_hex(string.format('%04x', count)):reverse()
+local raw = O.from_hex('02000000') .. O.from_hex('fd') .. le
+local amounts <const> = { }
+for i = 1, count do
+   raw = raw .. O.random(32) .. O.from_hex('00000000')
+      .. O.from_hex('00') .. O.from_hex('ffffffff')
+   amounts[i] = INT.new(1000)
+end
+raw = raw .. O.from_hex('01') .. O.from_hex('e803000000000000')
+   .. O.from_hex('160014') .. O.random(20) .. O.from_hex('00000000')
+
+local function bench(fun)
+   collectgarbage('collect')
+   local runs = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      fun()
+      runs = runs + 1
+      elapsed = os.clock() - start
+   until elapsed > 1
+   return runs / elapsed
+end
+
+local rlp_rate <const> = bench(function()
+      assert(#ETH.decodeRLP(rlp) == count)
+end)
+local btc_rate <const> = bench(function()
+      assert(#BTC.decode_raw_transaction(raw, O.random(20), amounts).txIn == count)
+end)
+print(string.format('%-28s %12s', 'decode ('..count..' items)', 'ops/s'))
+print(string.format('%-28s %12.1f', 'RLP list ('..#rlp..' B)', rlp_rate))
+print(string.format('%-28s %12.1f', 'BTC raw tx ('..#raw..' B)', btc_rate))
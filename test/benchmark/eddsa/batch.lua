@@ -0,0 +1,39 @@
+-- EdDSA batch verification benchmark
+--
+-- Measures the signatures per second verified by ED.verify_batch
+-- against a loop of single ED.verify calls on the same signatures.
+
+local ED <const> = require'ed'
+local params <const> = JSON.decode(DATA)
+local count <const> = params.count or 1000
+
+local pks, sigs, msgs = { }, { }, { }
+for i = 1, count do
+   local sk <const> = ED.secgen()
+   pks[i] = ED.pubgen(sk)
+   msgs[i] = O.random(64)
+   sigs[i] = ED.sign(sk, msgs[i])
+end
+
+local function bench(fun)
+   collectgarbage('collect')
+   local runs = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      fun()
+      runs = runs + 1
+      elapsed = os.clock() - start
+   until elapsed > 1
+   return (count * runs) / elapsed
+end
+
+local single <const> = bench(function()
+      for i = 1, count do assert(ED.verify(pks[i], sigs[i], msgs[i])) end
+end)
+local batch <const> = bench(function()
+      assert(ED.verify_batch(pks, sigs, msgs))
+end)
+print(string.format('%-8s %12s', 'verify', 'sigs/s'))
+print(string.format('%-8s %12.0f', 'single', single))
+print(string.format('%-8s %12.0f', 'batch', batch))
@@ -0,0 +1,43 @@
+-- Transaction and RLP encoding benchmark
+--
+-- Measures the encodings per second of an ethereum RLP list and of a
+-- raw bitcoin transaction, both serialized appending many small
+-- octets one after the other.
+
+local ETH <const> = require'crypto_ethereum'
+local BTC <const> = require'crypto_bitcoin'
+local params <const> = JSON.decode(DATA)
+local count <const> = params.count or 1000
+
+local fields = { }
+for i = 1, count do fields[i] = O.random(32) end
+
+local tx <const> = { txIn = { }, txOut = { } }
+for i = 1, count do
+   tx.txIn[i] = { txid = O.random(32), vout = INT.new(i) }
+end
+tx.txOut[1] = { amount = INT.new(1000), address = O.random(20) }
+
+local function bench(fun)
+   collectgarbage('collect')
+   local runs = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      fun()
+      runs = runs + 1
+      elapsed = os.clock() - start
+   until elapsed > 1
+   return runs / elapsed
+end
+
+local rlp_len, raw_len
+local rlp_rate <const> = bench(function()
+      rlp_len = #ETH.encodeRLP(fields)
+end)
+local btc_rate <const> = bench(function()
+      raw_len = #BTC.build_raw_transaction(tx)
+end)
+print(string.format('%-28s %12s', 'encode ('..count..' items)', 'ops/s'))
+print(string.format('%-28s %12.1f', 'RLP list ('..rlp_len..' B)', rlp_rate))
+print(string.format('%-28s %12.1f', 'BTC raw tx ('..raw_len..' B)', btc_rate))
@@ -0,0 +1,37 @@
+-- P-256 benchmark
+--
+-- Measures the operations per second of public key generation, ECDSA
+-- signature and verification, with plain and compressed public keys,
+-- on the P-256 backend the binary was built with (p256=m or p256=64).
+
+local P256 <const> = require'es256'
+local sk <const> = P256.keygen()
+local pk <const> = P256.pubgen(sk)
+local msg <const> = O.random(64)
+local sig <const> = P256.sign(sk, msg)
+local cpk <const> = P256.compress_public_key(pk)
+local ops <const> = {
+   { 'pubgen', function() return P256.pubgen(sk) end },
+   { 'sign',   function() return P256.sign(sk, msg) end },
+   { 'verify', function() return P256.verify(pk, msg, sig) end },
+   { 'verify compressed', function() return P256.verify(cpk, msg, sig) end },
+}
+
+-- operations per second
+local function bench(fun)
+   collectgarbage('collect')
+   local runs = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      for i = 1, 10 do fun() end
+      runs = runs + 10
+      elapsed = os.clock() - start
+   until elapsed > 1
+   return runs / elapsed
+end
+
+print(string.format('%-18s %10s', 'op', 'ops/s'))
+for _, op in ipairs(ops) do
+   print(string.format('%-18s %10.0f', op[1], bench(op[2])))
+end
@@ -0,0 +1,39 @@
+-- Hash throughput benchmark
+--
+-- Measures the GB/s hashed by each algorithm of the HASH class on a
+-- large random octet, plus the same data fed in 1 KiB chunks.
+
+local params <const> = JSON.decode(DATA)
+local size <const> = (params.size or 3) * 1024 * 1024
+local algos <const> = { 'sha256', 'sha384', 'sha512', 'sha3_256',
+                        'sha3_512', 'shake256', 'keccak256', 'ripemd160' }
+
+local data <const> = O.random(size)
+local chunks <const> = { }
+for i = 1, size, 1024 do
+   chunks[#chunks+1] = data:sub(i, i + 1023)
+end
+
+local function bench(name, fun)
+   collectgarbage('collect')
+   local runs = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      fun()
+      runs = runs + 1
+      elapsed = os.clock() - start
+   until elapsed > 1
+   return (size * runs) / elapsed / 1e9
+end
+
+print(string.format('%-10s %10s %14s', 'algorithm', 'GB/s', 'GB/s (1KiB)'))
+for _, algo in ipairs(algos) do
+   local h <const> = HASH.new(algo)
+   local whole <const> = bench(algo, function() h:process(data) end)
+   local fed <const> = bench(algo, function()
+         for _, c in ipairs(chunks) do h:feed(c) end
+         if algo == 'shake256' then h:process(chunks[1]) else h:yeld() end
+   end)
+   print(string.format('%-10s %10.3f %14.3f', algo, whole, fed))
+end
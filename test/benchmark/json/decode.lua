@@ -0,0 +1,66 @@
+-- JSON decode throughput benchmark
+--
+-- Generates a large JSON document shaped like the KEYS and DATA
+-- inputs of a contract (dictionaries of base64 strings, numbers and
+-- arrays) and measures the MiB/s decoded by JSON.decode, comparing it
+-- with the pure Lua decoder (jsontok and JSON.raw_decode) used before.
+
+local params <const> = JSON.decode(DATA)
+local size <const> = (params.size or 8) * 1024 * 1024
+
+local function legacy_decode(data)
+   local res = { }
+   local right = data
+   local left
+   while right and right ~= "" do
+      left, right = jsontok(right)
+      for k, v in pairs(JSON.raw_decode(left)) do res[k] = v end
+   end
+   return res
+end
+
+local function generate(len)
+   local parts = { }
+   local total = 0
+   local i = 0
+   while total < len do
+      i = i + 1
+      local entry = string.format(
+         '"key_%u":{"value":"%s","amount":%u,"ratio":%u.%u,'
+         ..'"list":["%s","escaped \\"quote\\" \\u00e8",true,null,%u]}',
+         i, O.random(48):base64(), i * 7, i, i % 100,
+         O.random(24):hex(), i)
+      parts[#parts+1] = entry
+      total = total + #entry + 1
+   end
+   return '{'..table.concat(parts, ',')..'}', i
+end
+
+local function bench(name, fun, data)
+   collectgarbage('collect')
+   local runs = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      fun(data)
+      runs = runs + 1
+      elapsed = os.clock() - start
+   until elapsed > 2
+   print(string.format('%-12s %10.2f MiB/s', name,
+                       (#data * runs) / elapsed / (1024 * 1024)))
+end
+
+local data <const>, entries <const> = generate(size)
+print(string.format('JSON input: %.2f MiB, %u entries',
+                    #data / (1024 * 1024), entries))
+
+local a <const> = JSON.decode(data)
+local b <const> = legacy_decode(data)
+for k, v in pairs(b) do
+   assert(a[k].value == v.value and a[k].amount == v.amount
+          and a[k].ratio == v.ratio and a[k].list[2] == v.list[2]
+          and a[k].list[5] == v.list[5], 'decoders disagree on '..k)
+end
+
+bench('JSON.decode', JSON.decode, data)
+bench('Lua decode', legacy_decode, data)
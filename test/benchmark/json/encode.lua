@@ -0,0 +1,52 @@
+-- JSON encode throughput benchmark
+--
+-- Builds a large nested table shaped like the OUT of a contract, both
+-- with values already encoded by Then statements and with OCTET and
+-- ECP values left to the output encoding, then measures the MiB/s of
+-- JSON produced by JSON.encode against the previous Lua path
+-- (INSPECT.process followed by JSON.raw_encode).
+
+local params <const> = JSON.decode(DATA)
+local count <const> = params.entries or 20000
+
+local function legacy_encode(tab)
+   return JSON.raw_encode(INSPECT.process(tab, CONF.output.encoding.name))
+end
+
+local encoded = { }
+local zentypes = { }
+local G <const> = ECP.generator()
+for i = 1, count do
+   local key <const> = string.format('key_%u', i)
+   local value <const> = O.random(48)
+   encoded[key] = { value = value:base64(), amount = i * 7,
+                    list = { value:hex(), 'quote " \n', true, i } }
+   zentypes[key] = { value = value, point = G,
+                     list = { O.random(32), i, BIG.new(i) } }
+end
+
+local function bench(name, fun, data)
+   collectgarbage('collect')
+   local runs = 0
+   local bytes = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      bytes = bytes + #fun(data)
+      runs = runs + 1
+      elapsed = os.clock() - start
+   until elapsed > 2
+   print(string.format('%-28s %10.2f MiB/s', name,
+                       bytes / elapsed / (1024 * 1024)))
+end
+
+assert(JSON.encode(encoded) == legacy_encode(encoded))
+assert(JSON.encode(zentypes) == legacy_encode(zentypes))
+print(string.format('JSON output: %.2f MiB encoded, %.2f MiB zenroom types',
+                    #JSON.encode(encoded) / (1024 * 1024),
+                    #JSON.encode(zentypes) / (1024 * 1024)))
+
+bench('JSON.encode (encoded)', JSON.encode, encoded)
+bench('Lua encode (encoded)', legacy_encode, encoded)
+bench('JSON.encode (zenroom types)', JSON.encode, zentypes)
+bench('Lua encode (zenroom types)', legacy_encode, zentypes)
@@ -0,0 +1,35 @@
+-- Logging overhead benchmark
+--
+-- Measures the nanoseconds spent on each call of a tight loop of
+-- cheap octet operations, where the cost is dominated by the entry
+-- and exit tracing of the C functions more than by their work.
+
+local a <const> = O.random(32)
+local b <const> = O.random(32)
+local ops <const> = {
+   { 'len',  function() return #a end },
+   { 'eq',   function() return a == b end },
+   { 'xor',  function() return a ~ b end },
+   { 'concat', function() return a .. b end },
+   { 'sub',  function() return a:sub(1, 16) end },
+   { 'hex',  function() return a:hex() end },
+}
+
+-- nanoseconds per call
+local function bench(fun)
+   collectgarbage('collect')
+   local runs = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      for i = 1, 1000 do fun() end
+      runs = runs + 1000
+      elapsed = os.clock() - start
+   until elapsed > 0.5
+   return elapsed * 1e9 / runs
+end
+
+print(string.format('%-8s %10s', 'op', 'ns/call'))
+for _, op in ipairs(ops) do
+   print(string.format('%-8s %10.1f', op[1], bench(op[2])))
+end
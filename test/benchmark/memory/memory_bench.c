@@ -0,0 +1,94 @@
+/* Zenroom memory manager benchmark
+ *
+ * Replays the zencode executions recorded from the test suites (see
+ * the Makefile) with the memory manager given on the commandline and
+ * prints the allocations made by the Lua states, how many of them
+ * reached libc, the peak memory of a single execution and the peak
+ * RSS of the whole process.
+ *
+ * usage: memory_bench corpus_dir [slab|libc]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <zenroom.h>
+#include <zen_memory.h>
+
+static char *load(const char *dir, const char *name, const char *ext) {
+	char path[1024];
+	snprintf(path, sizeof(path), "%s/%.*s%s", dir,
+			 (int)(strlen(name) - 4), name, ext); // name ends with .zen
+	FILE *fd = fopen(path, "r");
+	if(!fd) return NULL;
+	fseek(fd, 0, SEEK_END);
+	long len = ftell(fd);
+	fseek(fd, 0, SEEK_SET);
+	char *buf = calloc(len+1, 1);
+	if(fread(buf, 1, len, fd) != (size_t)len) {
+		fprintf(stderr,"Cannot read %s\n",path); exit(1); }
+	fclose(fd);
+	return buf;
+}
+
+static int is_zen(const struct dirent *d) {
+	size_t len = strlen(d->d_name);
+	return len > 4 && strcmp(d->d_name + len - 4, ".zen") == 0;
+}
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+	if(argc < 2) {
+		fprintf(stderr,"usage: %s corpus_dir [slab|libc]\n", argv[0]);
+		return 1;
+	}
+	const char *dir = argv[1];
+	const char *manager = argc > 2 ? argv[2] : "slab";
+	struct dirent **list;
+	int n = scandir(dir, &list, is_zen, alphasort);
+	if(n <= 0) { fprintf(stderr,"No contracts found in %s\n", dir); return 1; }
+
+	static char out[MAX_OCTET], err[MAX_OCTET];
+	char conf[MAX_CONFIG];
+	size_t allocs = 0, libc_calls = 0, peak = 0;
+	int i, fails = 0;
+	double start = now();
+	for(i=0; i<n; i++) {
+		char *script = load(dir, list[i]->d_name, ".zen");
+		char *c = load(dir, list[i]->d_name, ".conf");
+		char *data = load(dir, list[i]->d_name, ".data");
+		char *keys = load(dir, list[i]->d_name, ".keys");
+		snprintf(conf, sizeof(conf), "%s%smemmanager=%s",
+				 c ? c : "", c && c[0] ? "," : "", manager);
+		zenroom_t *Z = zen_init(conf, keys, data);
+		if(Z) {
+			Z->stdout_buf = out; Z->stdout_len = sizeof(out);
+			Z->stderr_buf = err; Z->stderr_len = sizeof(err);
+			if(zen_exec_zencode(Z, script) != SUCCESS) fails++;
+			zen_mem_t *mem = (zen_mem_t*)Z->memory;
+			allocs += mem->allocs;
+			libc_calls += mem->libc_calls;
+			if(mem->peak > peak) peak = mem->peak;
+			zen_teardown(Z);
+		} else fails++;
+		free(script); free(c); free(data); free(keys);
+		free(list[i]);
+	}
+	double elapsed = now() - start;
+	free(list);
+	struct rusage ru;
+	getrusage(RUSAGE_SELF, &ru);
+	fprintf(stderr,"%s: %i executions (%i failed) in %.3f s\n",
+			manager, n, fails, elapsed);
+	fprintf(stderr,"%s: allocations: %zu\tlibc calls: %zu\tpeak: %zu KB\tpeak RSS: %li KB\n",
+			manager, allocs, libc_calls, peak / 1024, ru.ru_maxrss);
+	return 0;
+}
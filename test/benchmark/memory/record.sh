@@ -0,0 +1,23 @@
+#!/usr/bin/env bash
+# records each zencode execution in $CORPUS as script, conf, data
+# and keys files, then runs it with the $ZENROOM executable
+args=("$@")
+zencode=0; conf=""; data=""; keys=""
+while [ $# -gt 1 ]; do
+	case "$1" in
+		-z) zencode=1 ;;
+		-c) conf="$2"; shift ;;
+		-a) data="$2"; shift ;;
+		-k) keys="$2"; shift ;;
+	esac
+	shift
+done
+if [ $zencode = 1 ] && [ -r "$1" ]; then
+	n=`mktemp -p "$CORPUS" XXXXXXXX`
+	echo -n "$conf" > $n.conf
+	[ "$data" != "" ] && cp "$data" $n.data
+	[ "$keys" != "" ] && cp "$keys" $n.keys
+	cp "$1" $n.zen
+	rm -f $n
+fi
+exec "$ZENROOM" "${args[@]}"
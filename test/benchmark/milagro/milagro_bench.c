@@ -0,0 +1,86 @@
+/* Milagro arithmetic benchmark
+ *
+ * Measures the operations per second of the BIG, BLS381 pairing and
+ * SECP256K1 primitives at the core of Zenroom's ECP, ECP2 and ECDH
+ * modules. It is built once for each limb size of milagro (see the
+ * Makefile) and prints one line per operation.
+ *
+ * usage: milagro_bench [seconds per operation]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <amcl.h>
+#include <pair_BLS381.h>
+#include <ecdh_SECP256K1.h>
+
+#if CHUNK==64
+#define BS 384_58
+#else
+#define BS 384_29
+#endif
+#define _CAT(a,b) a ## _ ## b
+#define CAT(a,b) _CAT(a,b)
+#define BIG CAT(BIG,BS)
+#define BIG_rcopy CAT(BIG,rcopy)
+#define BIG_randomnum CAT(BIG,randomnum)
+#define BIG_modmul CAT(BIG,modmul)
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// run op in batches until the time budget is over, print ops/sec
+#define BENCH(name, op) do { \
+	long _n = 0; double _start = now(), _elapsed; \
+	do { for(int _i=0; _i<8; _i++) { op; } _n += 8; \
+		_elapsed = now() - _start; } while(_elapsed < budget); \
+	printf("%-22s %2d bit %14.1f ops/sec\n", name, CHUNK, \
+		   (double)_n / _elapsed); \
+} while(0)
+
+int main(int argc, char **argv) {
+	double budget = argc > 1 ? atof(argv[1]) : 1.0;
+	char seed[32];
+	for(int i=0; i<32; i++) seed[i] = (char)i; // fixed seed
+	csprng rng;
+	AMCL_(RAND_seed)(&rng, sizeof(seed), seed);
+
+	BIG p, r, a, b;
+	BIG_rcopy(p, Modulus_BLS381);
+	BIG_rcopy(r, CURVE_Order_BLS381);
+	BIG_randomnum(a, p, &rng);
+	BIG_randomnum(b, p, &rng);
+	BENCH("BIG modmul", BIG_modmul(a, a, b, p));
+
+	ECP_BLS381 G1, P;
+	ECP2_BLS381 G2, Q;
+	FP12_BLS381 e;
+	ECP_BLS381_generator(&G1);
+	ECP2_BLS381_generator(&G2);
+	BIG_randomnum(a, r, &rng);
+	BENCH("PAIR_G1mul", ECP_BLS381_copy(&P, &G1); PAIR_BLS381_G1mul(&P, a));
+	BENCH("PAIR_G2mul", ECP2_BLS381_copy(&Q, &G2); PAIR_BLS381_G2mul(&Q, a));
+	BENCH("PAIR_ate+PAIR_fexp",
+		  PAIR_BLS381_ate(&e, &G2, &G1); PAIR_BLS381_fexp(&e));
+
+	char sk[EGS_SECP256K1], pk[2*EFS_SECP256K1+1];
+	char c[EGS_SECP256K1], d[EGS_SECP256K1];
+	char msg[] = "Zenroom benchmark message";
+	octet SK = { 0, sizeof(sk), sk }, PK = { 0, sizeof(pk), pk };
+	octet C = { 0, sizeof(c), c }, D = { 0, sizeof(d), d };
+	octet M = { (int)strlen(msg), sizeof(msg), msg };
+	ECP_SECP256K1_KEY_PAIR_GENERATE(&rng, &SK, &PK);
+	BENCH("SECP256K1 sign",
+		  ECP_SECP256K1_SP_DSA(SHA256, &rng, NULL, &SK, &M, &C, &D));
+	BENCH("SECP256K1 verify",
+		  if(ECP_SECP256K1_VP_DSA(SHA256, &PK, &M, &C, &D) != 0) {
+			  fprintf(stderr, "SECP256K1 verification failed\n");
+			  return 1; });
+	return 0;
+}
@@ -0,0 +1,70 @@
+/* Zenroom warm VM pool benchmark
+ *
+ * Compares the throughput of cold zencode_exec() calls, each one
+ * bootstrapping a new VM, with zen_pool_exec() calls reusing a VM
+ * initialized once. Contract output goes to stdout, results to stderr.
+ *
+ * usage: pool_bench [iterations] [script.zen]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <zenroom.h>
+
+static const char *default_script =
+	"Scenario 'ecdh': keys\n"
+	"Given nothing\n"
+	"When I create the ecdh key\n"
+	"and I create the random of '256' bits\n"
+	"Then print the 'keyring'\n"
+	"and print the 'random'\n";
+
+static char *load(const char *path) {
+	FILE *fd = fopen(path, "r");
+	if(!fd) { fprintf(stderr,"Cannot open %s\n",path); exit(1); }
+	fseek(fd, 0, SEEK_END);
+	long len = ftell(fd);
+	fseek(fd, 0, SEEK_SET);
+	char *buf = calloc(len+1, 1);
+	if(fread(buf, 1, len, fd) != (size_t)len) {
+		fprintf(stderr,"Cannot read %s\n",path); exit(1); }
+	fclose(fd);
+	return buf;
+}
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+	int iter = argc > 1 ? atoi(argv[1]) : 100;
+	char *script = argc > 2 ? load(argv[2]) : (char*)default_script;
+	const char *conf = "debug=0";
+	double start, cold, warm;
+	int i, res = 0;
+
+	start = now();
+	for(i=0; i<iter; i++)
+		res |= zencode_exec(script, conf, NULL, NULL);
+	cold = now() - start;
+
+	zen_pool_t *pool = zen_pool_new(1, conf);
+	if(!pool) { fprintf(stderr,"Pool initialisation failed\n"); exit(1); }
+	start = now();
+	for(i=0; i<iter; i++)
+		res |= zen_pool_exec(pool, script, conf, NULL, NULL, NULL, NULL);
+	warm = now() - start;
+	zen_pool_free(pool);
+
+	fprintf(stderr,"executions: %i %s\n", iter, res ? "(with errors)" : "");
+	fprintf(stderr,"cold start: %.3f s\t%.1f exec/s\t%.3f ms/exec\n",
+			cold, iter/cold, cold*1000/iter);
+	fprintf(stderr,"warm start: %.3f s\t%.1f exec/s\t%.3f ms/exec\n",
+			warm, iter/warm, warm*1000/iter);
+	fprintf(stderr,"speedup:    %.2fx\n", cold/warm);
+	if(argc > 2) free(script);
+	return res;
+}
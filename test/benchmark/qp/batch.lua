@@ -0,0 +1,61 @@
+-- Post-quantum batch API benchmark
+--
+-- Measures the microseconds spent on each item by the QP batch calls
+-- against a loop of the single calls, as the batch grows: ML-DSA-44
+-- verification by one public key and ML-KEM-512 encapsulation and
+-- decapsulation.
+
+local QP <const> = require'qp'
+local params <const> = JSON.decode(DATA)
+local sizes <const> = params.sizes or { 1, 4, 16, 64, 256 }
+local largest <const> = sizes[#sizes]
+
+local dsa <const> = QP.mldsa44_keypair(O.random(32))
+local kem <const> = QP.mlkem_keygen(O.random(32), O.random(32))
+local msgs, sigs, pks, cts = { }, { }, { }, { }
+for i = 1, largest do
+   msgs[i] = O.random(64)
+   sigs[i] = QP.mldsa44_signature(dsa.private, msgs[i])
+   pks[i] = kem.public
+   cts[i] = QP.mlkem_enc(kem.public).cipher
+end
+
+local function slice(t, n)
+   return table.move(t, 1, n, 1, { })
+end
+
+-- microseconds per item
+local function bench(count, fun)
+   collectgarbage('collect')
+   local runs = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      fun()
+      runs = runs + 1
+      elapsed = os.clock() - start
+   until elapsed > 0.5
+   return elapsed * 1000000 / (count * runs)
+end
+
+print(string.format('%-8s %6s %10s %10s', 'op', 'size', 'single', 'batch'))
+for _, n in ipairs(sizes) do
+   local m <const>, s <const> = slice(msgs, n), slice(sigs, n)
+   print(string.format('%-8s %6u %10.1f %10.1f', 'verify', n,
+      bench(n, function()
+            for i = 1, n do assert(QP.mldsa44_verify(dsa.public, s[i], m[i])) end
+      end),
+      bench(n, function() assert(QP.mldsa44_verify_batch(dsa.public, s, m)) end)))
+end
+for _, n in ipairs(sizes) do
+   local p <const> = slice(pks, n)
+   print(string.format('%-8s %6u %10.1f %10.1f', 'enc', n,
+      bench(n, function() for i = 1, n do QP.mlkem_enc(p[i]) end end),
+      bench(n, function() QP.mlkem_enc_batch(p) end)))
+end
+for _, n in ipairs(sizes) do
+   local c <const> = slice(cts, n)
+   print(string.format('%-8s %6u %10.1f %10.1f', 'dec', n,
+      bench(n, function() for i = 1, n do QP.mlkem_dec(kem.private, c[i]) end end),
+      bench(n, function() QP.mlkem_dec_batch(kem.private, c) end)))
+end
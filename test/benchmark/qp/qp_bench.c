@@ -0,0 +1,187 @@
+/* Zenroom ML-KEM and ML-DSA-44 benchmark
+ *
+ * Checks that the AVX2 backend gives the same keys, ciphertexts,
+ * shared secrets and signatures as the portable C code on random
+ * seeds, then measures the cycles per operation of each backend:
+ * read from the time stamp counter on x86_64, elsewhere estimated
+ * from the elapsed time at the nominal frequency given in MHz.
+ *
+ * usage: qp_bench [seconds] [mhz]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#define QP_C    0
+#define QP_AVX2 1
+extern int pqclean_backend(int max);
+extern int mlkem512_x86_64_backend(int max);
+extern int mlkem768_x86_64_backend(int max);
+extern int mlkem1024_x86_64_backend(int max);
+
+#define KEM(k) \
+	extern int mlkem##k##_keypair_derand(uint8_t *pk, uint8_t *sk, const uint8_t *coins); \
+	extern int mlkem##k##_enc_derand(uint8_t *ct, uint8_t *ss, const uint8_t *pk, const uint8_t *coins); \
+	extern int mlkem##k##_dec(uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
+KEM(512)
+KEM(768)
+KEM(1024)
+
+extern int pqcrystals_ml_dsa_44_zen_keypair(uint8_t *pk, uint8_t *sk, const uint8_t *randbytes);
+extern int pqcrystals_ml_dsa_44_zen_signature(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *ctx, size_t ctxlen, const uint8_t *sk, const uint8_t *randbytes);
+extern int pqcrystals_ml_dsa_44_ref_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *ctx, size_t ctxlen, const uint8_t *pk);
+
+typedef struct {
+	const char *name;
+	int (*keypair)(uint8_t*, uint8_t*, const uint8_t*);
+	int (*enc)(uint8_t*, uint8_t*, const uint8_t*, const uint8_t*);
+	int (*dec)(uint8_t*, const uint8_t*, const uint8_t*);
+	size_t pk, sk, ct;
+} kem;
+
+static const kem kems[] = {
+	{ "mlkem512", mlkem512_keypair_derand, mlkem512_enc_derand, mlkem512_dec, 800, 1632, 768 },
+	{ "mlkem768", mlkem768_keypair_derand, mlkem768_enc_derand, mlkem768_dec, 1184, 2400, 1088 },
+	{ "mlkem1024", mlkem1024_keypair_derand, mlkem1024_enc_derand, mlkem1024_dec, 1568, 3168, 1568 }
+};
+
+#define DSA_PK  1312
+#define DSA_SK  2560
+#define DSA_SIG 2420
+
+static const char *backends[] = { "c", "avx2" };
+
+// only the deterministic functions are measured
+int randombytes(void *buf, size_t n) {
+	memset(buf, 0, n);
+	return 0;
+}
+
+static int backend(int level) {
+	level = pqclean_backend(level);
+	mlkem512_x86_64_backend(level);
+	mlkem768_x86_64_backend(level);
+	mlkem1024_x86_64_backend(level);
+	return level;
+}
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// nominal frequency used when there is no cycle counter
+static double mhz = 3000.0;
+
+static uint64_t cycles(void) {
+#if defined(__x86_64__)
+	return __rdtsc();
+#else
+	return (uint64_t)(now() * mhz * 1e6);
+#endif
+}
+
+// all outputs of one round on the given seed, concatenated
+static size_t run_kem(const kem *k, const uint8_t *seed, uint8_t *out) {
+	uint8_t *pk = out, *sk = pk + k->pk, *ct = sk + k->sk;
+	uint8_t *ss = ct + k->ct, *ss2 = ss + 32;
+	k->keypair(pk, sk, seed);
+	k->enc(ct, ss, pk, seed + 64);
+	k->dec(ss2, ct, sk);
+	if(memcmp(ss, ss2, 32)) return 0;
+	ct[0] ^= 1; // implicit rejection
+	k->dec(ss2 + 32, ct, sk);
+	return k->pk + k->sk + k->ct + 96;
+}
+
+static size_t run_dsa(const uint8_t *seed, uint8_t *out) {
+	uint8_t *pk = out, *sk = pk + DSA_PK, *sig = sk + DSA_SK;
+	size_t siglen;
+	pqcrystals_ml_dsa_44_zen_keypair(pk, sk, seed);
+	pqcrystals_ml_dsa_44_zen_signature(sig, &siglen, seed + 32, 64, seed + 96, 16, sk, seed + 112);
+	if(siglen != DSA_SIG || pqcrystals_ml_dsa_44_ref_verify(sig, siglen, seed + 32, 64, seed + 96, 16, pk))
+		return 0;
+	sig[7] ^= 1;
+	if(!pqcrystals_ml_dsa_44_ref_verify(sig, siglen, seed + 32, 64, seed + 96, 16, pk))
+		return 0;
+	return DSA_PK + DSA_SK + DSA_SIG;
+}
+
+static int check(int cpu) {
+	static uint8_t ref[8192], out[8192];
+	uint8_t seed[144];
+	size_t i, k, n, m;
+	int round;
+	for(round = 0; round < 200; round++) {
+		for(i=0; i<sizeof(seed); i++) seed[i] = (uint8_t)rand();
+		for(k=0; k<3; k++) {
+			backend(QP_C);
+			n = run_kem(&kems[k], seed, ref);
+			backend(cpu);
+			m = run_kem(&kems[k], seed, out);
+			if(!n || n != m || memcmp(ref, out, n)) {
+				fprintf(stderr,"%s %s mismatch in round %u\n", kems[k].name, backends[cpu], round);
+				return 1; }
+		}
+		if(round % 10) continue; // signing is slower
+		backend(QP_C);
+		n = run_dsa(seed, ref);
+		backend(cpu);
+		m = run_dsa(seed, out);
+		if(!n || n != m || memcmp(ref, out, n)) {
+			fprintf(stderr,"mldsa44 %s mismatch in round %u\n", backends[cpu], round);
+			return 1; }
+	}
+	return 0;
+}
+
+#define BENCH(what, level, secs, call) do { \
+	double start_ = now(), end_; long n_ = 0; \
+	uint64_t c_ = cycles(); \
+	backend(level); \
+	do { call; n_++; end_ = now(); } while(end_ - start_ < secs); \
+	c_ = cycles() - c_; \
+	fprintf(stderr,"%-20s %-5s %10.0f cycles %10.1f us\n", what, \
+	        backends[level], (double)c_ / (double)n_, \
+	        (end_ - start_) / (double)n_ * 1e6); \
+} while(0)
+
+int main(int argc, char **argv) {
+	double secs = argc > 1 ? atof(argv[1]) : 0.5;
+	if(argc > 2) mhz = atof(argv[2]);
+	uint8_t seed[144], pk[1568], sk[3168], ct[1568], ss[32], sig[DSA_SIG];
+	char what[32];
+	size_t i, k, siglen;
+	int cpu = backend(-1), level;
+
+	srand(1);
+	for(i=0; i<sizeof(seed); i++) seed[i] = (uint8_t)rand();
+	if(check(cpu)) return 1;
+
+	fprintf(stderr,"ML-KEM and ML-DSA-44 benchmark, best backend %s\n", backends[cpu]);
+	for(k=0; k<3; k++) for(level = QP_C; level <= cpu; level++) {
+		const kem *K = &kems[k];
+		snprintf(what, sizeof(what), "%s keypair", K->name);
+		BENCH(what, level, secs, K->keypair(pk, sk, seed));
+		snprintf(what, sizeof(what), "%s enc", K->name);
+		BENCH(what, level, secs, K->enc(ct, ss, pk, seed + 64));
+		snprintf(what, sizeof(what), "%s dec", K->name);
+		BENCH(what, level, secs, K->dec(ss, ct, sk));
+	}
+	for(level = QP_C; level <= cpu; level++) {
+		BENCH("mldsa44 keypair", level, secs,
+		      pqcrystals_ml_dsa_44_zen_keypair(pk, sk, seed));
+		BENCH("mldsa44 sign", level, secs,
+		      pqcrystals_ml_dsa_44_zen_signature(sig, &siglen, seed, 64, NULL, 0, sk, seed + 64));
+		BENCH("mldsa44 verify", level, secs,
+		      pqcrystals_ml_dsa_44_ref_verify(sig, siglen, seed, 64, NULL, 0, pk));
+	}
+	return 0;
+}
@@ -0,0 +1,49 @@
+-- secp256k1 benchmark
+--
+-- Measures the operations per second of ECDSA verification and public
+-- key recovery of pre-hashed messages, one by one and in batches of
+-- 64, on the backend the binary was built with (secp256k1=glv or
+-- secp256k1=milagro).
+
+local BATCH <const> = 64
+local sk <const> = ECDH.keygen().private
+local pk <const> = ECDH.pubgen(sk)
+local pks, hashes, sigs, xs, parities = {}, {}, {}, {}, {}
+for i = 1, BATCH do
+   local h = sha256(O.random(64))
+   local sig, parity = ECDH.sign_hashed(sk, h, #h)
+   pks[i] = pk
+   hashes[i] = h
+   sigs[i] = sig
+   xs[i] = sig.r
+   parities[i] = parity and 1 or 0
+end
+local h <const>, sig <const>, x <const>, y <const> =
+   hashes[1], sigs[1], xs[1], parities[1]
+local ops <const> = {
+   { 'verify', 1, function() return ECDH.verify_hashed(pk, h, sig, #h) end },
+   { 'recovery', 1, function() return ECDH.recovery(x, y, h, sig) end },
+   { 'verify batch', BATCH,
+     function() return ECDH.verify_batch(pks, hashes, sigs) end },
+   { 'recovery batch', BATCH,
+     function() return ECDH.recover_batch(xs, parities, hashes, sigs) end },
+}
+
+-- operations per second, each call doing n of them
+local function bench(n, fun)
+   collectgarbage('collect')
+   local runs = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      fun()
+      runs = runs + n
+      elapsed = os.clock() - start
+   until elapsed > 1
+   return runs / elapsed
+end
+
+print(string.format('%-18s %10s', 'op', 'ops/s'))
+for _, op in ipairs(ops) do
+   print(string.format('%-18s %10.0f', op[1], bench(op[2], op[3])))
+end
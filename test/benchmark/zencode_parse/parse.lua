@@ -0,0 +1,108 @@
+-- Zencode parser throughput benchmark
+--
+-- Parses the contracts found in the bats tests of test/zencode and
+-- measures the statements per second normalised by zencode_statement
+-- and parsed by ZEN:parse, comparing them with the chain of
+-- string.gsub used before to normalise statements in set_sentence.
+
+local corpus <const> = JSON.decode(DATA).corpus
+
+local function legacy_statement(sentence, to)
+   local gsub <const> = string.gsub
+   local tt = gsub(sentence, "'(.-)'", "''")
+   tt = gsub(tt, ' I ', ' ', 1)
+   tt = tt:lower()
+   if to == 'then' or to == 'thenif' then
+      tt = gsub(tt, ' the ', ' ', 1)
+   end
+   if to == 'given' then
+      tt = gsub(tt, ' the ', ' ', 1)
+      tt = gsub(tt, ' a ', ' ', 1)
+      tt = gsub(tt, ' an ', ' ', 1)
+      tt = gsub(tt, ' have ', ' ', 1)
+      tt = gsub(tt, ' known as ', ' ', 1)
+      tt = gsub(tt, ' valid ', ' ', 1)
+   end
+   tt = gsub(tt, '^when ', '', 1)
+   tt = gsub(tt, '^then ', '', 1)
+   tt = gsub(tt, '^given ', '', 1)
+   tt = gsub(tt, '^if ', '', 1)
+   tt = gsub(tt, '^foreach ', '', 1)
+   tt = gsub(tt, '^and ', '', 1)
+   tt = gsub(tt, '^that ', ' ', 1)
+   tt = gsub(tt, ' the ', ' ')
+   tt = gsub(tt, '^an ', 'a ', 1)
+   tt = gsub(tt, ' valid ', ' ', 1)
+   tt = gsub(tt, ' all ', ' ', 1)
+   tt = gsub(tt, ' inside ', ' in ', 1)
+   tt = gsub(tt, ' +', ' ')
+   tt = gsub(tt, '^ +', '')
+   tt = gsub(tt, ' +$', '')
+   local args = {}
+   for arg in string.gmatch(sentence, "'(.-)'") do
+      table.insert(args, (uscore(arg)))
+   end
+   return tt, args
+end
+
+-- statements and contracts which parse, with their number of lines
+local lines <const> = { }
+local contracts <const> = { }
+local total = 0
+for text in corpus:gmatch('(.-)\f\n') do
+   local n = 0
+   for l in text:gmatch('[^\n]+') do
+      l = trim(l)
+      if l ~= '' and l:sub(1, 1) ~= '#' then
+         n = n + 1
+         lines[#lines+1] = l
+      end
+   end
+   AST = { }
+   ZEN:begin()
+   if n > 0 and pcall(ZEN.parse, ZEN, text) then
+      contracts[#contracts+1] = text
+      total = total + n
+   end
+end
+
+-- operations per second, each call doing n of them
+local function bench(n, fun)
+   collectgarbage('collect')
+   local runs = 0
+   local start = os.clock()
+   local elapsed
+   repeat
+      fun()
+      runs = runs + n
+      elapsed = os.clock() - start
+   until elapsed > 1
+   return runs / elapsed
+end
+
+local function normalise(fun)
+   return function()
+      for i = 1, #lines do fun(lines[i], 'when') end
+   end
+end
+
+local function parse()
+   for i = 1, #contracts do
+      AST = { }
+      ZEN:begin()
+      ZEN:parse(contracts[i])
+   end
+end
+
+local native <const> = zencode_statement
+print(string.format('%u statements, %u contracts parsed with %u statements',
+                    #lines, #contracts, total))
+print(string.format('%-18s %14s %14s', 'statements/s', 'gsub', 'native'))
+print(string.format('%-18s %14.0f %14.0f', 'normalise',
+                    bench(#lines, normalise(legacy_statement)),
+                    bench(#lines, normalise(native))))
+zencode_statement = legacy_statement
+local legacy_parse <const> = bench(total, parse)
+zencode_statement = native
+print(string.format('%-18s %14.0f %14.0f', 'parse', legacy_parse,
+                    bench(total, parse)))
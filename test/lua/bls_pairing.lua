@@ -122,6 +122,17 @@ assert( PAIR.ate(pk2, hm) == PAIR.ate(G2, sm2),
 assert( PAIR.ate(pk + pk2, hm) == PAIR.ate(G2, sm + sm2),
         "BLS Signature aggregation doesn't validates")
 
+print'Test multi-pairing product and check'
+assert( ECP2.pairing_product({ { pk, hm } }) == PAIR.ate(pk, hm) )
+assert( ECP2.pairing_product({ { pk, hm }, { pk2, hm } })
+		== PAIR.ate(pk, hm) * PAIR.ate(pk2, hm) )
+assert( ECP2.pairing_check({ { pk, hm }, { G2, sm:negative() } }),
+		"BLS Signature doesn't validates with pairing check")
+assert( not ECP2.pairing_check({ { pk, hmwrong }, { G2, sm:negative() } }),
+		"BLS Signature validates incorrectly with pairing check")
+assert( ECP2.pairing_check({ { pk, hm }, { pk2, hm },
+							 { G2, (sm + sm2):negative() } }),
+		"BLS aggregated signature doesn't validates with pairing check")
 
 print("Test tripartite shared secret")
 -- Parties A,B,C generate random a,b,c ∈ Zr
@@ -107,5 +107,46 @@ while (tot<100) or (not shorter) do
 	tot = tot+1
 end
 
+print 'batch verify and recovery of pre-hashed signatures'
+local pks, hashes, sigs, xs, parities = {}, {}, {}, {}, {}
+for i=1,20 do
+	local h = sha256(O.from_string(tostring(i)))
+	local sig, parity = ecdh.sign_hashed(alice.private, h, #h)
+	table.insert(pks, alice.public)
+	table.insert(hashes, h)
+	table.insert(sigs, sig)
+	table.insert(xs, sig.r)
+	table.insert(parities, parity and 1 or 0)
+end
+local valid, invalid = ECDH.verify_batch(pks, hashes, sigs)
+assert(valid and #invalid == 0, "ecdh batch verify failed")
+local recovered, invalid = ECDH.recover_batch(xs, parities, hashes, sigs)
+assert(#invalid == 0, "ecdh batch recovery failed")
+for i=1,20 do
+	assert(recovered[i] == alice.public, "ecdh batch recovery failed")
+end
+hashes[3] = sha256(hashes[3])
+pks[7] = bob.public
+sigs[11] = { r = sigs[11].s, s = sigs[11].r }
+valid, invalid = ECDH.verify_batch(pks, hashes, sigs)
+assert(not valid and #invalid == 3
+	   and invalid[1] == 3 and invalid[2] == 7 and invalid[3] == 11,
+	   "ecdh batch verify failed")
+for i=1,20 do
+	assert(ECDH.verify_hashed(pks[i], hashes[i], sigs[i], #hashes[i])
+		   == (i ~= 3 and i ~= 7 and i ~= 11), "ecdh batch verify failed")
+end
+recovered, invalid = ECDH.recover_batch(xs, parities, hashes, sigs)
+local j = 1
+for i=1,20 do
+	local pk, ok = ECDH.recovery(xs[i], parities[i], hashes[i], sigs[i])
+	assert(recovered[i] == pk, "ecdh batch recovery failed")
+	if not ok then
+		assert(invalid[j] == i, "ecdh batch recovery failed")
+		j = j + 1
+	end
+end
+assert(#invalid == j - 1, "ecdh batch recovery failed")
+
 print "OK"
 -- vk, sk = ecdh:keygen()
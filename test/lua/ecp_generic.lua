@@ -49,6 +49,39 @@ Aw2 = (g1*k) * c + g1 * rk
 
 assert(Aw1 == Aw2, 'Error in zero-knowledge proof')
 
+-- test multi-scalar multiplication, Straus below 64 points and
+-- Pippenger above
+for _,n in ipairs({1, 5, 64, 100}) do
+   local P, S = { }, { }
+   local R1, R2 = ECP.infinity(), ECP2.infinity()
+   for i=1,n do
+      P[i] = g1 * INT.random()
+      S[i] = INT.random()
+      R1 = R1 + P[i] * S[i]
+   end
+   assert(ECP.msm(P, S) == R1, 'Error in ECP multi-scalar multiplication of '..n)
+   for i=1,n do
+      P[i] = ECP2.generator() * INT.random()
+      R2 = R2 + P[i] * S[i]
+   end
+   assert(ECP2.msm(P, S) == R2, 'Error in ECP2 multi-scalar multiplication of '..n)
+end
+assert(ECP.msm({ }, { }):isinf())
+assert(ECP.msm({g1, g1}, {o, INT.new(0)}):isinf())
+
+-- test fixed-base precomputation, generators are registered at init
+for _,C in ipairs({ECP, ECP2}) do
+   local G = C.generator()
+   local P = G * INT.random()
+   local k = INT.random()
+   local Q = P * k
+   assert(C.precompute(P))
+   assert(P * k == Q, 'Error in fixed-base multiplication')
+   assert((P * o):isinf(), 'Error in fixed-base multiplication by order')
+   assert(G * k + G * k == (G + G) * k, 'Error in generator multiplication')
+   assert(G * INT.new(1) == G and (G * INT.new(0)):isinf())
+end
+
 -- test import / export octet
 e = ECP.random()
 eo = e:octet()
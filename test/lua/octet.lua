@@ -156,4 +156,156 @@ dotest(oct:fillrepeat(6),O.from_hex('001122334400'))
 dotest(oct:fillrepeat(10),O.from_hex('00112233440011223344'))
 dotest(oct:fillrepeat(14),O.from_hex('0011223344001122334400112233'))
 
+print '== views'
+-- slices larger than a slab block share the payload of their parent
+oct = O.zero(512) .. O.random(512)
+local view = oct:sub(513, 1024)
+local left, right = oct:chop(512)
+local str = oct:string()
+local tail = right:hex()
+dotest(view, right)
+dotest(left, O.zero(512))
+dotest(view:sub(1, 300), right:sub(1, 300))
+dotest(O.sub(str, 1, 512), left)
+dotest(O.new(str):elide_at_start(left), right)
+oct:fill(O.from_hex('ff'))
+dotest(oct:sub(1, 4), O.from_hex('ffffffff'))
+dotest(left, O.zero(512))
+dotest(view:hex(), tail)
+view:fill(O.from_hex('ee'))
+dotest(view:sub(509, 512), O.from_hex('eeeeeeee'))
+dotest(oct:sub(1021, 1024), O.from_hex('ffffffff'))
+dotest(right:hex(), tail)
+dotest(O.sub(str, 1, 512), left)
+
+print '== builder'
+local b = O.builder(1)
+local parts = O.empty()
+for i = 1, 100 do
+   local r = O.random(i)
+   b:append(r)
+   parts = parts .. r
+end
+assert(#b == #parts)
+dotest(b:finish(), parts)
+b:append_uint(258, 2):append('ab', O.from_hex('ff'))
+dotest(b:finish(), parts .. O.from_hex('0102') .. O.from_string('ab') .. O.from_hex('ff'))
+b:append(b)
+assert(#b == 2 * (#parts + 5))
+dotest(O.builder():append_uint(1, 8):finish(), O.from_hex('0000000000000001'))
+assert(not pcall(function() O.builder():append_uint(256, 1) end))
+assert(not pcall(function() O.builder():append_uint(-1, 4) end))
+-- builders are read as octets without converting them
+local H = HASH.new('sha256')
+dotest(H:process(O.builder():append(parts)), H:process(parts))
+dotest(O.builder():append(parts) .. O.empty(), parts)
+
+print '== set and map'
+local elems = { }
+for i = 1, 1000 do elems[i] = O.random(i % 40) end
+local set = O.set(elems)
+for i = 1, 1000 do assert(set:has(elems[i])) end
+assert(not set:has(O.from_hex('ff') .. O.zero(40))) -- longer than any element
+local count = 0
+for i, v in ipairs(set:array()) do
+   count = i
+   assert(set:has(v))
+end
+assert(count == #set)
+-- duplicates are added once, strings equal octets with the same bytes
+set = O.set({ 'a', O.from_string('a'), 'b' })
+assert(#set == 2)
+assert(set:add('c') and not set:add(O.from_string('c')))
+assert(set:has(O.from_string('b')) and set:has('c'))
+assert(set:remove('a') and not set:remove('a') and not set:has('a'))
+assert(#set == 2)
+dotest(set:array()[1], O.from_string('b'))
+dotest(set:array()[2], O.from_string('c'))
+-- removals and additions across resizes keep the order
+set = O.set()
+for i = 1, 500 do set:add(O.from_number(i)) end
+for i = 1, 500, 2 do assert(set:remove(O.from_number(i))) end
+for i = 501, 1000 do set:add(O.from_number(i)) end
+local arr = set:array()
+assert(#arr == 750 and #set == 750)
+dotest(arr[1], O.from_number(2))
+dotest(arr[250], O.from_number(500))
+dotest(arr[251], O.from_number(501))
+local inter = set:intersection({ O.from_number(3), O.from_number(4), 'x', O.from_number(600) })
+assert(#inter == 2 and inter:has(O.from_number(4)) and inter:has(O.from_number(600)))
+inter = O.set({ O.from_number(1000), O.from_number(2), O.from_number(1) }):intersection(set)
+dotest(inter:array()[1], O.from_number(2))
+dotest(inter:array()[2], O.from_number(1000))
+-- maps hold a value for each element
+local map = O.map({ 'k1', 'k2', 'k3' }, { 1, 'two', O.from_hex('03') })
+assert(map:get('k1') == 1 and map:get(O.from_string('k2')) == 'two')
+dotest(map:get('k3'), O.from_hex('03'))
+assert(map:get('k4') == nil)
+assert(not map:add('k1', 10) and map:get('k1') == 10)
+assert(map:remove('k2') and map:get('k2') == nil)
+for i = 1, 100 do map:add(O.from_number(i), i) end
+for i = 1, 100, 3 do map:remove(O.from_number(i)) end
+for i = 101, 200 do map:add(O.from_number(i), i) end
+for i = 1, 200 do
+   assert(map:get(O.from_number(i)) == ((i > 100 or i % 3 ~= 1) and i or nil))
+end
+assert(map:get('k1') == 10)
+dotest(map:get('k3'), O.from_hex('03'))
+assert(O.map({ 'a', 'b' }):get('b') == true)
+-- churn of distinct keys compacts the removed entries away
+set = O.set({ 'keep' })
+map = O.map({ 'keep' }, { 'kept' })
+for i = 1, 5000 do
+   set:add(O.from_number(i))
+   map:add(O.from_number(i), i)
+   if i > 2 then
+      assert(set:remove(O.from_number(i - 2)))
+      assert(map:remove(O.from_number(i - 2)))
+   end
+end
+assert(#set == 3 and #map == 3 and set:has('keep'))
+arr = set:array()
+dotest(arr[1], O.from_string('keep'))
+dotest(arr[2], O.from_number(4999))
+dotest(arr[3], O.from_number(5000))
+assert(map:get('keep') == 'kept' and map:get(O.from_number(4999)) == 4999)
+assert(map:get(O.from_number(5000)) == 5000 and map:get(O.from_number(1)) == nil)
+assert(not pcall(O.map, { 'a', 'b' }, { 1 }))
+
+print '== codecs'
+-- RFC4648 test vectors
+local rfc = { f = 'Zg==', fo = 'Zm8=', foo = 'Zm9v', foob = 'Zm9vYg==',
+			  fooba = 'Zm9vYmE=', foobar = 'Zm9vYmFy' }
+for k, v in pairs(rfc) do
+   assert(O.from_string(k):base64() == v)
+   dotest(O.from_base64(v), O.from_string(k))
+end
+-- lengths crossing all the SIMD block sizes
+for i = 1, 200 do
+   local r = O.random(i)
+   local b64 = r:base64()
+   local u64 = b64:gsub('%+', '-'):gsub('/', '_'):gsub('=', '')
+   assert(r:url64() == u64)
+   assert(#r:hex() == i * 2)
+   dotest(O.from_hex(r:hex()), r)
+   dotest(O.from_hex(r:hex():upper()), r)
+   dotest(O.from_base64(b64), r)
+   dotest(O.from_url64(u64), r)
+end
+local long = O.from_string(string.rep('zenroom', 40))
+dotest(O.from_hex('0x'..long:hex()), long)
+dotest(O.from_hex('0xf'), O.from_hex('0f'))
+assert(O.from_hex(long:hex():sub(1, 99)..'g'..long:hex():sub(101)) == false)
+assert(not pcall(O.from_base64, long:base64():sub(1, 99)..'*'..long:base64():sub(101)))
+assert(not pcall(O.from_url64, long:url64():sub(1, 99)..'+'..long:url64():sub(101)))
+
+-- base58 keeps leading zero bytes as '1' digits, large values go
+-- through the divide and conquer conversion
+dotest(O.from_hex('00000102'):base58(), '115T')
+dotest(O.from_base58('115T'), O.from_hex('00000102'))
+for _, i in ipairs({1, 2, 31, 190, 191, 1024, 4000}) do
+   local r = O.zero(i % 3) .. O.random(i)
+   dotest(O.from_base58(r:base58()), r)
+end
+
 print '= OK'
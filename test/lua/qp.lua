@@ -49,3 +49,43 @@ for i=1,100 do
    local bob_secret = QP.ntrup_dec(kp.private, alice.cipher)
    assert(alice.secret == bob_secret, "ntrup decpription failed")
 end
+
+print()
+print' ML-KEM AND ML-DSA-44 BACKENDS'
+local cpu = QP.backend()
+print('best backend: '..cpu)
+local seed = O.random(32)
+local coins = O.random(32)
+local res = {}
+local sig = {}
+for _,b in ipairs{'c', cpu} do
+   assert(QP.backend(b) == b, "backend not switched to "..b)
+   local kem = QP.mlkem_keygen(seed, coins)
+   local enc = QP.mlkem_enc(kem.public, coins)
+   local dsa = QP.mldsa44_keypair(seed)
+   res[b] = kem.private..enc.cipher..enc.secret..dsa.private
+   -- signatures are hedged with fresh randomness
+   sig[b] = QP.mldsa44_signature(dsa.private, seed, coins)
+end
+assert(res.c == res[cpu], "ML-KEM and ML-DSA-44 backends differ")
+local pk = QP.mldsa44_pubgen(QP.mldsa44_keypair(seed).private)
+for _,b in ipairs{'c', cpu} do
+   QP.backend(b)
+   assert(QP.mldsa44_verify(pk, sig.c, seed, coins), "ML-DSA-44 verify failed on "..b)
+   assert(QP.mldsa44_verify(pk, sig[cpu], seed, coins), "ML-DSA-44 verify failed on "..b)
+end
+
+print()
+print' ML-KEM AND ML-DSA-44 BATCH ARGUMENTS'
+assert(not pcall(QP.mlkem_enc_batch, {}, 'bogus'), "unknown ML-KEM type accepted")
+assert(not pcall(QP.mlkem_dec_batch, {}, {}, 'bogus'), "unknown ML-KEM type accepted")
+local kp = QP.mldsa44_keypair(O.random(32))
+local pk = QP.mldsa44_pubgen(kp.private)
+local ctx = O.from_string('batch context')
+local msgs = { O.random(32), O.random(64) }
+local sigs = { QP.mldsa44_signature(kp.private, msgs[1], ctx),
+			   QP.mldsa44_signature(kp.private, msgs[2], ctx) }
+assert(QP.mldsa44_verify_batch(pk, sigs, msgs, ctx), "ML-DSA-44 batch verify failed")
+assert(QP.mldsa44_verify_batch(pk, sigs, msgs, 'batch context'), "ML-DSA-44 batch verify ignored string ctx")
+assert(not QP.mldsa44_verify_batch(pk, sigs, msgs), "ML-DSA-44 batch verify ignored ctx")
+assert(not pcall(QP.mldsa44_verify_batch, pk, sigs, msgs, {}), "ML-DSA-44 batch verify accepted a table ctx")
@@ -67,4 +67,14 @@ Ciphertext = O.from_hex('1e031dda2fbe03d1792170a0f3009cee')
 Plaintext  = O.from_hex('f69f2445df4f9b17ad2b417be66c3710')
 assert( AES.ctr_encrypt(Key, Ciphertext, Input) == Plaintext, "Error in block #4" )
 
+print(' F.5.1 CTR-AES128.Encrypt as a single message')
+Plaintext  = O.from_hex('6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e5130c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710')
+Ciphertext = O.from_hex('874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee')
+for _,b in ipairs({'milagro', 'aes-ni'}) do
+   AES.backend(b)
+   assert( AES.ctr_encrypt(Key, Plaintext, Counter) == Ciphertext, "Error in message" )
+   assert( AES.ctr_decrypt(Key, Ciphertext, Counter) == Plaintext, "Error in message" )
+   assert( AES.ctr_encrypt(Key, Plaintext:sub(1,37), Counter) == Ciphertext:sub(1,37), "Error in partial message" )
+end
+
 print('OK')
@@ -5,15 +5,36 @@ print()
 -- MACsec GCM-AES Test Vectors - IEEE P802.1
 -- http://www.ieee802.org/1/files/public/docs2011/bn-randall-test-vectors-0511-v1.pdf
 
-function Test(t)
-   print ("Test vector: " .. t.name)
-   out, tag_out = AES.gcm_encrypt(hex(t.key), hex(t.msg), hex(t.iv), hex(t.header))
+-- all the backends the cpu supports
+backends = { 'milagro' }
+if AES.backend('aes-ni') == 'aes-ni' then table.insert(backends, 'aes-ni') end
 
-   assert(hex(t.ciphermsg) == out)
-   print (' encrypt OK')
+-- feeds a stream pieces of len bytes
+function Stream(s, msg, len)
+   local out = OCTET.builder()
+   for i = 1, #msg, len do
+      out:append(s:update(msg:sub(i, math.min(i + len - 1, #msg))))
+   end
+   return out:octet(), s:final()
+end
 
-   assert(hex(t.tag) == tag_out)
-   print ('    auth OK')
+function Test(t)
+   print ("Test vector: " .. t.name)
+   for _,b in ipairs(backends) do
+      AES.backend(b)
+      out, tag_out = AES.gcm_encrypt(hex(t.key), hex(t.msg), hex(t.iv), hex(t.header))
+      assert(hex(t.ciphermsg) == out)
+      assert(hex(t.tag) == tag_out)
+      out, tag_out = Stream(AES.gcm_encrypt_init(hex(t.key), hex(t.iv), hex(t.header)),
+                            hex(t.msg), 7)
+      assert(hex(t.ciphermsg) == out)
+      assert(hex(t.tag) == tag_out)
+      out, tag_out = Stream(AES.gcm_decrypt_init(hex(t.key), hex(t.iv), hex(t.header)),
+                            hex(t.ciphermsg), 16)
+      assert(hex(t.msg) == out)
+      assert(hex(t.tag) == tag_out)
+      print (' '..b..' encrypt, stream and auth OK')
+   end
 end
 
 Test{
@@ -88,3 +109,30 @@ Test{
     tag = '2611CD7DAA01D61C5C886DC1A8170107',
     ciphermsg = 'BA8AE31BC506486D6873E4FCE460E7DC57591FF00611F31C3834FE1C04AD80B66803AFCF5B27E6333FA67C99DA47C2F0CED68D531BD741A943CFF7A6713BD0'
 }
+
+print '= AES-GCM backends and streams on random data'
+for _,nk in ipairs({16, 24, 32}) do
+   local key = OCTET.random(nk)
+   for _,len in ipairs({0, 1, 15, 16, 17, 127, 128, 129, 1000, 4099}) do
+      local msg = OCTET.random(len)
+      local iv = OCTET.random(len % 2 == 0 and 12 or 16)
+      local h = OCTET.random(len % 33)
+      AES.backend('milagro')
+      local ref, ref_tag = AES.gcm_encrypt(key, msg, iv, h)
+      for _,b in ipairs(backends) do
+         AES.backend(b)
+         local out, tag = AES.gcm_encrypt(key, msg, iv, h)
+         assert(out == ref and tag == ref_tag, b..' mismatch on '..len..' bytes')
+         out, tag = Stream(AES.gcm_encrypt_init(key, iv, h), msg, 1 + len % 37)
+         assert(out == ref and tag == ref_tag, b..' stream mismatch on '..len..' bytes')
+         out, tag = AES.gcm_decrypt(key, ref, iv, h)
+         assert(out == msg and tag == ref_tag, b..' decrypt mismatch on '..len..' bytes')
+      end
+   end
+end
+local s = AES.gcm_encrypt_init(OCTET.zero(16), OCTET.zero(12))
+s:final()
+assert(not pcall(s.update, s, OCTET.zero(16)), 'update after final accepted')
+assert(not pcall(AES.gcm_encrypt, OCTET.zero(20), OCTET.zero(16), OCTET.zero(12), OCTET.zero(1)),
+       'wrong key size accepted')
+print 'OK'
@@ -235,3 +235,115 @@ EOF
     run ${ZENCODE_EXECUTABLE} < zencode_exec_stdin
     assert_line --partial "Zencode line 3: Given I have the 'string array' named 'dictionary'"
 }
+
+@test "Execute zencode-exec in serve mode with framed results" {
+	cat <<EOF | base64 -w0 > serve_script
+Given I have a 'string' named 'myMessage'
+Then print the 'myMessage'
+EOF
+	rm -f zencode_serve_stdin
+	for msg in first second; do
+		echo >> zencode_serve_stdin # conf
+		cat serve_script >> zencode_serve_stdin
+		echo >> zencode_serve_stdin
+		echo >> zencode_serve_stdin # keys
+		echo "{\"myMessage\":\"$msg\"}" | base64 -w0 >> zencode_serve_stdin
+		echo >> zencode_serve_stdin
+		echo >> zencode_serve_stdin # extra
+		echo >> zencode_serve_stdin # context
+	done
+	# missing data fails without ending the stream
+	echo >> zencode_serve_stdin
+	cat serve_script >> zencode_serve_stdin
+	printf '\n\n\n\n\n' >> zencode_serve_stdin
+
+	${ZENCODE_EXECUTABLE} --serve < zencode_serve_stdin 2>/dev/null > serve_out
+	grep -v '^"\|^\[' serve_out > $TMP/out
+	run cat $TMP/out
+	assert_line --index 0 --regexp '^0 22 [0-9]+$'
+	assert_line --index 1 '{"myMessage":"first"}'
+	assert_line --index 2 --regexp '^0 23 [0-9]+$'
+	assert_line --index 3 '{"myMessage":"second"}'
+	assert_line --index 4 --regexp '^1 0 [0-9]+$'
+}
+
+@test "Execute zencode-exec in serve mode referencing compiled contracts by digest" {
+	cat <<EOF > serve_digest.zen
+Given I have a 'string' named 'myMessage'
+Then print the 'myMessage'
+EOF
+	digest=`sha256sum serve_digest.zen | cut -d' ' -f1`
+	frame() {
+		echo # conf
+		echo "$1"
+		echo # keys
+		echo "{\"myMessage\":\"$2\"}" | base64 -w0
+		echo
+		echo # extra
+		echo # context
+	}
+	rm -rf serve_cache && mkdir serve_cache
+	frame `base64 -w0 serve_digest.zen` first > zencode_serve_stdin
+	frame "@$digest" second >> zencode_serve_stdin
+	frame "@0000" third >> zencode_serve_stdin
+	${ZENCODE_EXECUTABLE} --serve serve_cache < zencode_serve_stdin 2>/dev/null > serve_out
+	assert_file_exist serve_cache/$digest.json
+	grep -v '^"\|^\[' serve_out > $TMP/out
+	run cat $TMP/out
+	assert_line --index 0 --regexp '^0 22 [0-9]+$'
+	assert_line --index 1 '{"myMessage":"first"}'
+	assert_line --index 2 --regexp '^0 23 [0-9]+$'
+	assert_line --index 3 '{"myMessage":"second"}'
+	assert_line --index 4 --regexp '^4 0 [0-9]+$'
+	# a new process finds the compiled contract in the cache directory
+	frame "@$digest" fourth > zencode_serve_stdin
+	${ZENCODE_EXECUTABLE} --serve serve_cache < zencode_serve_stdin 2>/dev/null > serve_out
+	grep -v '^"\|^\[' serve_out > $TMP/out
+	run cat $TMP/out
+	assert_line --index 1 '{"myMessage":"fourth"}'
+	# cache files holding another contract or built for another
+	# zenroom are not loaded
+	other=`echo other | sha256sum | cut -d' ' -f1`
+	cp serve_cache/$digest.json serve_cache/$other.json
+	sed -i 's/"zenroom":"[0-9a-f]*/"zenroom":"0000/' serve_cache/$digest.json
+	frame "@$other" fifth > zencode_serve_stdin
+	frame "@$digest" sixth >> zencode_serve_stdin
+	${ZENCODE_EXECUTABLE} --serve serve_cache < zencode_serve_stdin 2>/dev/null > serve_out
+	grep -v '^"\|^\[' serve_out > $TMP/out
+	run cat $TMP/out
+	assert_line --index 0 --regexp '^4 0 [0-9]+$'
+	assert_line --index 1 --regexp '^4 0 [0-9]+$'
+}
+
+@test "Execute zencode-exec in serve mode compiling a contract with debug=3" {
+	cat <<EOF > serve_debug.zen
+rule unknown ignore
+Given nothing matches this line
+Given I have a 'string' named 'myMessage'
+Then print the 'myMessage'
+EOF
+	digest=`sha256sum serve_debug.zen | cut -d' ' -f1`
+	frame() {
+		echo "debug=3"
+		echo "$1"
+		echo # keys
+		echo "{\"myMessage\":\"$2\"}" | base64 -w0
+		echo
+		echo # extra
+		echo # context
+	}
+	frame `base64 -w0 serve_debug.zen` first > zencode_serve_stdin
+	frame `base64 -w0 serve_debug.zen` second >> zencode_serve_stdin
+	frame "@$digest" third >> zencode_serve_stdin
+	${ZENCODE_EXECUTABLE} --serve < zencode_serve_stdin 2>/dev/null > serve_out
+	grep -v '^"\|^\[' serve_out > $TMP/out
+	run cat $TMP/out
+	assert_line --index 0 --regexp '^0 22 [0-9]+$'
+	assert_line --index 1 '{"myMessage":"first"}'
+	assert_line --index 2 --regexp '^0 23 [0-9]+$'
+	assert_line --index 3 '{"myMessage":"second"}'
+	assert_line --index 4 --regexp '^0 22 [0-9]+$'
+	assert_line --index 5 '{"myMessage":"third"}'
+	run grep -c 'Zencode line 2 pattern ignored' serve_out
+	assert_output '3'
+}
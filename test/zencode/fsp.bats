@@ -28,7 +28,7 @@ EOF
 	Then print the 'fsp ciphertext'
 EOF
 	save_output 'message_ciphertext.json'
-	assert_output '{"fsp_ciphertext":{"k":"MLFZQ9dstaNe8xpbVemUCP+t10brKz816VKaHlO7MW3GY6cZNNfVx5k8hDfSw76denOm8/meGfYngrq24HWHzllXs64z4WThkGJD6QVV4T9rBoZK6VgayMh28GdYPwbdWAFPsPJYpLpUXE0HURsar4ded50A/0Y3RT+y0nUV9I3GJT2mtCZuj/F3XNy7gEEyK4eUlJDtch2USxa3szwDJBnOSI7scDzlY7wlHM9oqxKDVT3dQ/0kMYegRvJlZXNBmQlf7BRNEkSzJSMOsDkP0KY3h8y8qhXMh49lY2G4iMJ2BWk3QKetaOwToJmtSA4MewXLJ1qENxZR2w/9XsptvQ==","n":"XdjAYj+RY95+uyYMI8fR3+fmP5LyQaN54vyTTVKxZyA=","p":"NJqJPHzOmR7LOeMIK4q5aHctjrE1Suwgbs96Ni8qGyzi2QJbfzHZGffR7KFONBV5J1jpj9Z4pUNEcO6vYUIt7OsYJhK+UWB/LHvOlPw64DAsjuyHVp/+s2tqfGqZl0HBIQQI8DDYy4Pvs/YYELj6s39F7XK3NEbMNnPiO+APXlB1it7L+otDfZ/jnQUlzUKOjq84f0hvWcthX1Z/9dX1/+zDW1zmYgw8hwKHviTmBFRcinifpsgfc9uJvXn8AFodzRTF/Z5pqPyPeE1fX3Un3b9ZE1PVl3+/i9GQLvv6eksFMRSDMdTMKGu2uzjLvzX4jIfyPZSvl60w6p94bl4vxQ=="}}'
+	assert_output '{"fsp_ciphertext":{"k":"MLFZQ9dstaNe8xpbVemUCP+t10brKz816VKaHlO7MW3GY6cZNNfVx5k8hDfSw76denOm8/meGfYngrq24HWHzllXs64z4WThkGJD6QVV4T9rBoZK6VgayMh28GdYPwbdWAFPsPJYpLpUXE0HURsar4ded50A/0Y3RT+y0nUV9I3GJT2mtCZuj/F3XNy7gEEyK4eUlJDtch2USxa3szwDJBnOSI7scDzlY7wlHM9oqxKDVT3dQ/0kMYegRvJlZXNBmQlf7BRNEkSzJSMOsDkP0KY3h8y8qhXMh49lY2G4iMJ2BWk3QKetaOwToJmtSA4MewXLJ1qENxZR2w/9XsptvQ==","n":"XdjAYj+RY95+uyYMI8fR3+fmP5LyQaN54vyTTVKxZyA=","p":"NJqJPHzOmR7LOeMIK4q5aOw4N/wa9XzXB/MvyJKTsFA3tL95Meb4PhEtM8uuauyIwa3uoYfh0IgyxUihteE2uxY+mflnqsw+UDEMK572042Sp4yFnHz8we/D1WHpKzIDd3aEN6bvjN1R71sL3/R2H76bgYTH4GkM6FN64VELpYhA3NoVYxXtGdiHJMvrLLLReaMIMuzK3XK33bvJ+i/gA+XIjTN4t4R9j1vNrk4Q+VKlN0RohdpTz/ZtMi80pxtM/5XCv+aIrGgV00xpTE6Q362EOHsDrAW4K4WuGkh/Ohy8YnZA0AXj0F4xIfRmSfQU6os0OD41MLeT8i4IHEgHvg=="}}'
 }
 
 
@@ -45,7 +45,7 @@ EOF
 	and print the 'fsp ciphertext'
 EOF
 	save_output 'message_and_response.json'
-	assert_output '{"fsp_ciphertext":{"k":"MLFZQ9dstaNe8xpbVemUCP+t10brKz816VKaHlO7MW3GY6cZNNfVx5k8hDfSw76denOm8/meGfYngrq24HWHzllXs64z4WThkGJD6QVV4T9rBoZK6VgayMh28GdYPwbdWAFPsPJYpLpUXE0HURsar4ded50A/0Y3RT+y0nUV9I3GJT2mtCZuj/F3XNy7gEEyK4eUlJDtch2USxa3szwDJBnOSI7scDzlY7wlHM9oqxKDVT3dQ/0kMYegRvJlZXNBmQlf7BRNEkSzJSMOsDkP0KY3h8y8qhXMh49lY2G4iMJ2BWk3QKetaOwToJmtSA4MewXLJ1qENxZR2w/9XsptvQ==","n":"XdjAYj+RY95+uyYMI8fR3+fmP5LyQaN54vyTTVKxZyA=","p":"NJqJPHzOmR7LOeMIK4q5aHctjrE1Suwgbs96Ni8qGyzi2QJbfzHZGffR7KFONBV5J1jpj9Z4pUNEcO6vYUIt7OsYJhK+UWB/LHvOlPw64DAsjuyHVp/+s2tqfGqZl0HBIQQI8DDYy4Pvs/YYELj6s39F7XK3NEbMNnPiO+APXlB1it7L+otDfZ/jnQUlzUKOjq84f0hvWcthX1Z/9dX1/+zDW1zmYgw8hwKHviTmBFRcinifpsgfc9uJvXn8AFodzRTF/Z5pqPyPeE1fX3Un3b9ZE1PVl3+/i9GQLvv6eksFMRSDMdTMKGu2uzjLvzX4jIfyPZSvl60w6p94bl4vxQ=="},"fsp_cleartext":"bring me a coffe, please. Maybe two","fsp_response":"92beYOHeqomEE+T3zASlwX04mLt3GflMVnbJMT6bNZPlAEF3KIFnxgBhnakDRcw7f2kKLFlu3a+SXFEWEz4a8qiZmK0N4kjHUlyjg0p6jprKDbYgglvVis/xcQtzFARK/FPL8vzsgelEWQuRbUCCYyAGzwX43uaeToWN7BPuCcontRj08eLniqGRwV6kVHPBEbOEvVbLiGd7qPOvwPvzdHfCJZL8xNHsb2PW8KM1kqxZjo8hLfoFgdgQSuv02Ak33upeu1LdfZFS6wcJV2UjDbCqbs1JpeSMgZWBik41UwA2rc60snPo97+JQ84A3EhO4pGZYL9AgPfmosyZnNz2+Q=="}'
+	assert_output '{"fsp_ciphertext":{"k":"MLFZQ9dstaNe8xpbVemUCP+t10brKz816VKaHlO7MW3GY6cZNNfVx5k8hDfSw76denOm8/meGfYngrq24HWHzllXs64z4WThkGJD6QVV4T9rBoZK6VgayMh28GdYPwbdWAFPsPJYpLpUXE0HURsar4ded50A/0Y3RT+y0nUV9I3GJT2mtCZuj/F3XNy7gEEyK4eUlJDtch2USxa3szwDJBnOSI7scDzlY7wlHM9oqxKDVT3dQ/0kMYegRvJlZXNBmQlf7BRNEkSzJSMOsDkP0KY3h8y8qhXMh49lY2G4iMJ2BWk3QKetaOwToJmtSA4MewXLJ1qENxZR2w/9XsptvQ==","n":"XdjAYj+RY95+uyYMI8fR3+fmP5LyQaN54vyTTVKxZyA=","p":"NJqJPHzOmR7LOeMIK4q5aOw4N/wa9XzXB/MvyJKTsFA3tL95Meb4PhEtM8uuauyIwa3uoYfh0IgyxUihteE2uxY+mflnqsw+UDEMK572042Sp4yFnHz8we/D1WHpKzIDd3aEN6bvjN1R71sL3/R2H76bgYTH4GkM6FN64VELpYhA3NoVYxXtGdiHJMvrLLLReaMIMuzK3XK33bvJ+i/gA+XIjTN4t4R9j1vNrk4Q+VKlN0RohdpTz/ZtMi80pxtM/5XCv+aIrGgV00xpTE6Q362EOHsDrAW4K4WuGkh/Ohy8YnZA0AXj0F4xIfRmSfQU6os0OD41MLeT8i4IHEgHvg=="},"fsp_cleartext":"bring me a coffe, please. Maybe two","fsp_response":"92beYOHeqomEE+T3zASlwRIpPzOVn1DY1uyHGE7plBPVCbsaaWmmdQbAucMdJzB2S+9XuC7Kayksbj0ZR76+KCijnE+fk5pEJuanYpCrjlHV1QioFK9NjnUhy6Q7UsN5eB6i9ofO7EeWclNFIdip0U7cWpTBNmCbubS5W/CsiWYCMT8XkxZyNzqbjKEjfI65ZXqyihYMwFyRH+9fr2LKa0lCZcved++S49kgqj8rtG643V/1v81ludqfaGusWmc0JnIVTMflP16xO1Ujq5FHPjCu+7Dzw+lxdEmbb3aH6bdwpQRBGfNdDrD2ge6nxVlP4GJc9vJGdPbSXkfbbLv4AQ=="}'
 }
 
 @test "Create a fsp response from ciphertext" {
@@ -58,12 +58,12 @@ EOF
 	Then print the 'fsp response'
 EOF
 	save_output 'message_response.json'
-	assert_output '{"fsp_response":"92beYOHeqomEE+T3zASlwX04mLt3GflMVnbJMT6bNZPlAEF3KIFnxgBhnakDRcw7f2kKLFlu3a+SXFEWEz4a8qiZmK0N4kjHUlyjg0p6jprKDbYgglvVis/xcQtzFARK/FPL8vzsgelEWQuRbUCCYyAGzwX43uaeToWN7BPuCcontRj08eLniqGRwV6kVHPBEbOEvVbLiGd7qPOvwPvzdHfCJZL8xNHsb2PW8KM1kqxZjo8hLfoFgdgQSuv02Ak33upeu1LdfZFS6wcJV2UjDbCqbs1JpeSMgZWBik41UwA2rc60snPo97+JQ84A3EhO4pGZYL9AgPfmosyZnNz2+Q=="}'
+	assert_output '{"fsp_response":"92beYOHeqomEE+T3zASlwRIpPzOVn1DY1uyHGE7plBPVCbsaaWmmdQbAucMdJzB2S+9XuC7Kayksbj0ZR76+KCijnE+fk5pEJuanYpCrjlHV1QioFK9NjnUhy6Q7UsN5eB6i9ofO7EeWclNFIdip0U7cWpTBNmCbubS5W/CsiWYCMT8XkxZyNzqbjKEjfI65ZXqyihYMwFyRH+9fr2LKa0lCZcved++S49kgqj8rtG643V/1v81ludqfaGusWmc0JnIVTMflP16xO1Ujq5FHPjCu+7Dzw+lxdEmbb3aH6bdwpQRBGfNdDrD2ge6nxVlP4GJc9vJGdPbSXkfbbLv4AQ=="}'
 }
 
 @test "Decrypt a tainted ciphertext (fail)" {
 	cat << EOF | save_asset tainted_ciphertext.json
-{"fsp_ciphertext":{"k":"PLFZQ9dstaNe8xpbVemUCP+t10brKz816VKaHlO7MW3GY6cZNNfVx5k8hDfSw76denOm8/meGfYngrq24HWHzllXs64z4WThkGJD6QVV4T9rBoZK6VgayMh28GdYPwbdWAFPsPJYpLpUXE0HURsar4ded50A/0Y3RT+y0nUV9I3GJT2mtCZuj/F3XNy7gEEyK4eUlJDtch2USxa3szwDJBnOSI7scDzlY7wlHM9oqxKDVT3dQ/0kMYegRvJlZXNBmQlf7BRNEkSzJSMOsDkP0KY3h8y8qhXMh49lY2G4iMJ2BWk3QKetaOwToJmtSA4MewXLJ1qENxZR2w/9XsptvQ==","n":"XdjAYj+RY95+uyYMI8fR3+fmP5LyQaN54vyTTVKxZyA=","p":"NJqJPHzOmR7LOeMIK4q5aHctjrE1Suwgbs96Ni8qGyzi2QJbfzHZGffR7KFONBV5J1jpj9Z4pUNEcO6vYUIt7OsYJhK+UWB/LHvOlPw64DAsjuyHVp/+s2tqfGqZl0HBIQQI8DDYy4Pvs/YYELj6s39F7XK3NEbMNnPiO+APXlB1it7L+otDfZ/jnQUlzUKOjq84f0hvWcthX1Z/9dX1/+zDW1zmYgw8hwKHviTmBFRcinifpsgfc9uJvXn8AFodzRTF/Z5pqPyPeE1fX3Un3b9ZE1PVl3+/i9GQLvv6eksFMRSDMdTMKGu2uzjLvzX4jIfyPZSvl60w6p94bl4vxQ=="}}
+{"fsp_ciphertext":{"k":"PLFZQ9dstaNe8xpbVemUCP+t10brKz816VKaHlO7MW3GY6cZNNfVx5k8hDfSw76denOm8/meGfYngrq24HWHzllXs64z4WThkGJD6QVV4T9rBoZK6VgayMh28GdYPwbdWAFPsPJYpLpUXE0HURsar4ded50A/0Y3RT+y0nUV9I3GJT2mtCZuj/F3XNy7gEEyK4eUlJDtch2USxa3szwDJBnOSI7scDzlY7wlHM9oqxKDVT3dQ/0kMYegRvJlZXNBmQlf7BRNEkSzJSMOsDkP0KY3h8y8qhXMh49lY2G4iMJ2BWk3QKetaOwToJmtSA4MewXLJ1qENxZR2w/9XsptvQ==","n":"XdjAYj+RY95+uyYMI8fR3+fmP5LyQaN54vyTTVKxZyA=","p":"NJqJPHzOmR7LOeMIK4q5aOw4N/wa9XzXB/MvyJKTsFA3tL95Meb4PhEtM8uuauyIwa3uoYfh0IgyxUihteE2uxY+mflnqsw+UDEMK572042Sp4yFnHz8we/D1WHpKzIDd3aEN6bvjN1R71sL3/R2H76bgYTH4GkM6FN64VELpYhA3NoVYxXtGdiHJMvrLLLReaMIMuzK3XK33bvJ+i/gA+XIjTN4t4R9j1vNrk4Q+VKlN0RohdpTz/ZtMi80pxtM/5XCv+aIrGgV00xpTE6Q362EOHsDrAW4K4WuGkh/Ohy8YnZA0AXj0F4xIfRmSfQU6os0OD41MLeT8i4IHEgHvg=="}}
 EOF
 	cat << EOF | save_asset encode_response.zen
 	Scenario fsp
@@ -93,7 +93,7 @@ EOF
 
 @test "Decrypt a tainted response (fail)" {
     cat << EOF | save_asset tainted_response.json
-{"fsp_ciphertext":{"k":"MLFZQ9dstaNe8xpbVemUCP+t10brKz816VKaHlO7MW3GY6cZNNfVx5k8hDfSw76denOm8/meGfYngrq24HWHzllXs64z4WThkGJD6QVV4T9rBoZK6VgayMh28GdYPwbdWAFPsPJYpLpUXE0HURsar4ded50A/0Y3RT+y0nUV9I3GJT2mtCZuj/F3XNy7gEEyK4eUlJDtch2USxa3szwDJBnOSI7scDzlY7wlHM9oqxKDVT3dQ/0kMYegRvJlZXNBmQlf7BRNEkSzJSMOsDkP0KY3h8y8qhXMh49lY2G4iMJ2BWk3QKetaOwToJmtSA4MewXLJ1qENxZR2w/9XsptvQ==","n":"XdjAYj+RY95+uyYMI8fR3+fmP5LyQaN54vyTTVKxZyA=","p":"NJqJPHzOmR7LOeMIK4q5aHctjrE1Suwgbs96Ni8qGyzi2QJbfzHZGffR7KFONBV5J1jpj9Z4pUNEcO6vYUIt7OsYJhK+UWB/LHvOlPw64DAsjuyHVp/+s2tqfGqZl0HBIQQI8DDYy4Pvs/YYELj6s39F7XK3NEbMNnPiO+APXlB1it7L+otDfZ/jnQUlzUKOjq84f0hvWcthX1Z/9dX1/+zDW1zmYgw8hwKHviTmBFRcinifpsgfc9uJvXn8AFodzRTF/Z5pqPyPeE1fX3Un3b9ZE1PVl3+/i9GQLvv6eksFMRSDMdTMKGu2uzjLvzX4jIfyPZSvl60w6p94bl4vxQ=="},"fsp_response":"Z2beYOHeqomEE+T3zASlwX04mLt3GflMVnbJMT6bNZPlAEF3KIFnxgBhnakDRcw7f2kKLFlu3a+SXFEWEz4a8qiZmK0N4kjHUlyjg0p6jprKDbYgglvVis/xcQtzFARK/FPL8vzsgelEWQuRbUCCYyAGzwX43uaeToWN7BPuCcontRj08eLniqGRwV6kVHPBEbOEvVbLiGd7qPOvwPvzdHfCJZL8xNHsb2PW8KM1kqxZjo8hLfoFgdgQSuv02Ak33upeu1LdfZFS6wcJV2UjDbCqbs1JpeSMgZWBik41UwA2rc60snPo97+JQ84A3EhO4pGZYL9AgPfmosyZnNz2+w=="}
+{"fsp_ciphertext":{"k":"MLFZQ9dstaNe8xpbVemUCP+t10brKz816VKaHlO7MW3GY6cZNNfVx5k8hDfSw76denOm8/meGfYngrq24HWHzllXs64z4WThkGJD6QVV4T9rBoZK6VgayMh28GdYPwbdWAFPsPJYpLpUXE0HURsar4ded50A/0Y3RT+y0nUV9I3GJT2mtCZuj/F3XNy7gEEyK4eUlJDtch2USxa3szwDJBnOSI7scDzlY7wlHM9oqxKDVT3dQ/0kMYegRvJlZXNBmQlf7BRNEkSzJSMOsDkP0KY3h8y8qhXMh49lY2G4iMJ2BWk3QKetaOwToJmtSA4MewXLJ1qENxZR2w/9XsptvQ==","n":"XdjAYj+RY95+uyYMI8fR3+fmP5LyQaN54vyTTVKxZyA=","p":"NJqJPHzOmR7LOeMIK4q5aOw4N/wa9XzXB/MvyJKTsFA3tL95Meb4PhEtM8uuauyIwa3uoYfh0IgyxUihteE2uxY+mflnqsw+UDEMK572042Sp4yFnHz8we/D1WHpKzIDd3aEN6bvjN1R71sL3/R2H76bgYTH4GkM6FN64VELpYhA3NoVYxXtGdiHJMvrLLLReaMIMuzK3XK33bvJ+i/gA+XIjTN4t4R9j1vNrk4Q+VKlN0RohdpTz/ZtMi80pxtM/5XCv+aIrGgV00xpTE6Q362EOHsDrAW4K4WuGkh/Ohy8YnZA0AXj0F4xIfRmSfQU6os0OD41MLeT8i4IHEgHvg=="},"fsp_response":"Z2beYOHeqomEE+T3zASlwRIpPzOVn1DY1uyHGE7plBPVCbsaaWmmdQbAucMdJzB2S+9XuC7Kayksbj0ZR76+KCijnE+fk5pEJuanYpCrjlHV1QioFK9NjnUhy6Q7UsN5eB6i9ofO7EeWclNFIdip0U7cWpTBNmCbubS5W/CsiWYCMT8XkxZyNzqbjKEjfI65ZXqyihYMwFyRH+9fr2LKa0lCZcved++S49kgqj8rtG643V/1v81ludqfaGusWmc0JnIVTMflP16xO1Ujq5FHPjCu+7Dzw+lxdEmbb3aH6bdwpQRBGfNdDrD2ge6nxVlP4GJc9vJGdPbSXkfbbLv4AQ=="}
 EOF
 	cat << EOF | save_asset decode_response.zen
 	Scenario fsp
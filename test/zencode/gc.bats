@@ -0,0 +1,34 @@
+load ../bats_setup
+load ../bats_zencode
+SUBDOC=gc
+
+@test "Same results with all the garbage collection policies" {
+    cat <<EOF | save_asset gc.data.json
+{ "strings": [ "first", "second", "third", "fourth" ] }
+EOF
+    cat <<EOF > $TMP/gc.zen
+Given I have a 'string array' named 'strings'
+When I create the new array
+Foreach 'str' in 'strings'
+When I create the hash of 'str'
+and I move 'hash' in 'new array'
+When I create the random of '100000' bytes
+and I remove the 'random'
+EndForeach
+Then print the 'new array'
+EOF
+    for policy in gc=full gc=inc gc=gen "gc=inc,gcstep=8,gctime=100" "gc=gen,gcstep=0"; do
+        conf="$policy"
+        cat $TMP/gc.zen | zexe gc_${policy//[=,]/_}.zen gc.data.json
+        save_output gc_${policy//[=,]/_}.out
+        assert_output '{"new_array":["p5N7ZLjKpY8Dchu2us9ceMsjX+vg5wsbhM2ZVBRhoI4=","FjZ6rLZ6SgF8jairlWgsyzkIY3gPcRTdoKDgxVZEx8Q=","semTJFBb0y2g4fhdz14ZoJ2wSB6KFfYsQesyAwSo6Sc=","3IGx03GkByvn/Pw+GTn1vdrovcFohGpQp4+s6XW5r2M="]}'
+        grep -q 'GC pauses: ' $TMP/err
+    done
+}
+
+@test "Invalid garbage collection policy" {
+    echo "Given nothing" > $TMP/nothing.zen
+    run $ZENROOM_EXECUTABLE -c gc=none -z $TMP/nothing.zen
+    assert_failure
+    assert_line --partial 'Invalid garbage collection policy: none'
+}
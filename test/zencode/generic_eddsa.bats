@@ -172,3 +172,65 @@ EOF
     save_output verify_alice_signature.json
     assert_output '{"output":["Bigfile_Signature_is_valid"]}'
 }
+
+@test "Alice and Bob sign arrays of messages" {
+    for name in Alice Bob; do
+        lower=`echo $name | tr A-Z a-z`
+        cat <<EOF | save_asset ${lower}_messages.json
+{ "messages": [ "First message by $name", "Second message by $name", "Third message by $name" ] }
+EOF
+        cat <<EOF | zexe sign_array_${lower}.zen ${lower}_messages.json ${lower}_keys.json
+Scenario eddsa
+Given that I am known as '$name'
+and I have my 'keyring'
+and I have a 'string array' named 'messages'
+When I create the eddsa public key
+and I create the new array
+and I rename 'new array' to 'eddsa signatures'
+and I create the new array
+and I rename 'new array' to 'eddsa public keys'
+Foreach 'message' in 'messages'
+When I create the eddsa signature of 'message'
+and I move 'eddsa signature' in 'eddsa signatures'
+and I copy 'eddsa public key' in 'eddsa public keys'
+EndForeach
+Then print the 'messages'
+and print the 'eddsa signatures' as 'base58'
+and print the 'eddsa public keys' as 'base58'
+EOF
+        save_output signed_array_${lower}.json
+    done
+    jq -s '{ messages: (.[0].messages + .[1].messages),
+             eddsa_signatures: (.[0].eddsa_signatures + .[1].eddsa_signatures),
+             eddsa_public_keys: (.[0].eddsa_public_keys + .[1].eddsa_public_keys) }' \
+       $BATS_FILE_TMPDIR/signed_array_alice.json $BATS_FILE_TMPDIR/signed_array_bob.json \
+       | save_asset signed_arrays.json
+}
+
+@test "Verify an array of messages signed by Alice and Bob" {
+    cat <<EOF | zexe verify_array.zen signed_arrays.json
+Scenario eddsa
+Given I have a 'string array' named 'messages'
+and I have a 'eddsa signature array' named 'eddsa signatures'
+and I have a 'eddsa public key array' named 'eddsa public keys'
+When I verify the array 'messages' has eddsa signatures in 'eddsa signatures' by 'eddsa public keys'
+Then print the string 'Signatures are valid'
+EOF
+    save_output verify_array.json
+    assert_output '{"output":["Signatures_are_valid"]}'
+}
+
+@test "Fail verification of an array with a different message" {
+    jq '.messages[4] = "This is the wrong message."' \
+       $BATS_FILE_TMPDIR/signed_arrays.json | save_asset wrong_arrays.json
+    cat <<EOF > $BATS_FILE_TMPDIR/wrong_array.zen
+Scenario eddsa
+Given I have a 'string array' named 'messages'
+and I have a 'eddsa signature array' named 'eddsa signatures'
+and I have a 'eddsa public key array' named 'eddsa public keys'
+When I verify the array 'messages' has eddsa signatures in 'eddsa signatures' by 'eddsa public keys'
+Then print the string 'Signatures are valid'
+EOF
+    run $ZENROOM_EXECUTABLE -z -a $BATS_FILE_TMPDIR/wrong_arrays.json $BATS_FILE_TMPDIR/wrong_array.zen
+    assert_line --partial 'The eddsa signatures in eddsa_signatures are not authentic at position: 5'
+}
@@ -172,3 +172,52 @@ EOF
     save_output verify_alice_signature.json
     assert_output '{"output":["Bigfile_Signature_is_valid"]}'
 }
+
+@test "Alice signs an array of messages" {
+    cat <<EOF | save_asset alice_messages.json
+{ "messages": [ "First message by Alice", "Second message by Alice", "Third message by Alice", "Fourth message by Alice" ] }
+EOF
+    cat <<EOF | zexe sign_array.zen alice_messages.json alice_keys.json
+Scenario qp
+Given that I am known as 'Alice'
+and I have my 'keyring'
+and I have a 'string array' named 'messages'
+When I create the new array
+and I rename 'new array' to 'mldsa44 signatures'
+Foreach 'message' in 'messages'
+When I create the mldsa44 signature of 'message'
+and I move 'mldsa44 signature' in 'mldsa44 signatures'
+EndForeach
+Then print the 'messages'
+and print the 'mldsa44 signatures'
+EOF
+    save_output signed_array.json
+}
+
+@test "Verify an array of messages signed by Alice" {
+    cat <<EOF | zexe verify_array.zen signed_array.json alice_pubkey.json
+Scenario qp
+Given I have a 'mldsa44 public key' in 'Alice'
+and I have a 'string array' named 'messages'
+and I have a 'mldsa44 signature array' named 'mldsa44 signatures'
+When I verify the array 'messages' has mldsa44 signatures in 'mldsa44 signatures' by 'Alice'
+Then print the string 'Signatures are valid'
+EOF
+    save_output verify_array.json
+    assert_output '{"output":["Signatures_are_valid"]}'
+}
+
+@test "Fail verification of an array with a different message" {
+    jq '.messages[2] = "This is the wrong message."' \
+       $BATS_FILE_TMPDIR/signed_array.json | save_asset wrong_array.json
+    cat <<EOF > $BATS_FILE_TMPDIR/wrong_array.zen
+Scenario qp
+Given I have a 'mldsa44 public key' in 'Alice'
+and I have a 'string array' named 'messages'
+and I have a 'mldsa44 signature array' named 'mldsa44 signatures'
+When I verify the array 'messages' has mldsa44 signatures in 'mldsa44 signatures' by 'Alice'
+Then print the string 'Signatures are valid'
+EOF
+    run $ZENROOM_EXECUTABLE -z -a $BATS_FILE_TMPDIR/wrong_array.json -k $BATS_FILE_TMPDIR/alice_pubkey.json $BATS_FILE_TMPDIR/wrong_array.zen
+    assert_line --partial 'The mldsa44 signatures in mldsa44_signatures are not authentic at position: 3'
+}
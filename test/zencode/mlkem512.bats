@@ -189,3 +189,43 @@ EOF
     assert_output '{"output":["Success!!!"]}'
 
 }
+
+@test "mlkem512 KEM for an array of public keys" {
+    cat <<EOF | zexe mlkem512_array_keys.zen
+Scenario qp : Alice creates her mlkem512 keys
+Given I am 'Alice'
+When I create the mlkem512 key
+and I create the mlkem512 public key
+Then print the 'keyring'
+and print my 'mlkem512 public key'
+EOF
+    save_output 'mlkem512_array_keys.json'
+    jq '{ mlkem512_public_keys: [ .Alice.mlkem512_public_key, .Alice.mlkem512_public_key, .Alice.mlkem512_public_key ] }' \
+       $BATS_FILE_TMPDIR/mlkem512_array_keys.json | save_asset mlkem512_pubkeys.json
+    cat <<EOF | zexe mlkem512_enc_array.zen mlkem512_pubkeys.json
+Scenario qp : Bob creates a mlkem512 secret for each public key
+Given I have a 'mlkem512 public key array' named 'mlkem512 public keys'
+When I create the mlkem512 kems for 'mlkem512 public keys'
+Then print the 'mlkem512 kems'
+EOF
+    save_output 'mlkem512_kems.json'
+    jq '{ mlkem512_ciphertexts: [ .mlkem512_kems[].mlkem512_ciphertext ],
+          Bob_mlkem512_secrets: [ .mlkem512_kems[].mlkem512_secret ] }' \
+       $BATS_FILE_TMPDIR/mlkem512_kems.json | save_asset mlkem512_ciphertexts.json
+}
+
+@test "mlkem512 secrets from an array of ciphertexts" {
+    cat <<EOF | zexe mlkem512_dec_array.zen mlkem512_array_keys.json mlkem512_ciphertexts.json
+Scenario qp : Alice creates the mlkem512 secrets
+Given I am 'Alice'
+and I have the 'keyring'
+and I have a 'mlkem512 ciphertext array' named 'mlkem512 ciphertexts'
+and I have a 'mlkem512 secret array' named 'Bob mlkem512 secrets'
+When I create the mlkem512 secrets from 'mlkem512 ciphertexts'
+If I verify 'Bob mlkem512 secrets' is equal to 'mlkem512 secrets'
+Then print string 'Success!!!'
+Endif
+EOF
+    save_output 'mlkem512_dec_array.out'
+    assert_output '{"output":["Success!!!"]}'
+}
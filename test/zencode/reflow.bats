@@ -30,7 +30,7 @@ EOF
 generate_participant() {
     local name=$1
     ## PARTICIPANT
-	cat <<EOF | zexe keygen_${1}.zen
+	cat <<EOF | rngzexe keygen_${1}.zen
 Scenario reflow
 Given I am '${1}'
 When I create the reflow key
@@ -182,6 +182,21 @@ EOF
     collect_sign 'Carl'
 }
 
+@test "COLLECT DUPLICATE SIGNATURE fails" {
+	cat << EOF | save_asset collect_sign_duplicate.zen
+Scenario reflow
+Given I have a 'reflow seal'
+and I have a 'issuer public key' in 'The Authority'
+and I have a 'reflow signature'
+When I aggregate all the issuer public keys
+and I verify the reflow signature credential
+and I verify the reflow signature fingerprint is new
+Then print the 'reflow seal'
+EOF
+    run $ZENROOM_EXECUTABLE -z -a reflow_seal.json -k issuer_verifier_signature_Bob.json collect_sign_duplicate.zen
+    assert_line --partial 'Signature fingerprint is not new'
+}
+
 @test "VERIFY SIGNATURE" {
     cat << EOF | zexe verify_sign.zen reflow_seal.json
 Scenario reflow
@@ -170,6 +170,20 @@ EOF
     assert_output '{"output":["OK"]}'
 }
 
+@test "When I remove all occurrences of character '' in ''" {
+    cat <<EOF | save_asset rmallchar.json
+{"dashed": "a-b-c--d", "dash": "-"}
+EOF
+    cat <<EOF | zexe rmallchar.zen rmallchar.json
+Given I have a 'string' named 'dashed'
+and I have a 'string' named 'dash'
+When I remove all occurrences of character 'dash' in 'dashed'
+Then print the 'dashed' as 'string'
+EOF
+    save_output 'rmallchar.out'
+    assert_output '{"dashed":"abcd"}'
+}
+
 
 @test "create the json escaped string of ''" {
     cat <<EOF | save_asset json_encode.json